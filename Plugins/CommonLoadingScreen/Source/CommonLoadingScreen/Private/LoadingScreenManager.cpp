@@ -7,6 +7,7 @@
 #include "Engine/GameInstance.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "GameFramework/GameStateBase.h"
 #include "GameFramework/WorldSettings.h"
 #include "Misc/CommandLine.h"
@@ -64,6 +65,16 @@ bool ILoadingProcessInterface::ShouldShowLoadingScreen(UObject* TestObject, FStr
 	return false;
 }
 
+void ILoadingProcessInterface::NotifyLoadingStateChanged(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (ULoadingScreenManager* LoadingScreenManager = GameInstance ? GameInstance->GetSubsystem<ULoadingScreenManager>() : nullptr)
+	{
+		LoadingScreenManager->NotifyLoadingStateChanged();
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 
 namespace LoadingScreenCVars
@@ -130,8 +141,11 @@ void ULoadingScreenManager::Initialize(FSubsystemCollectionBase& Collection)
 	FCoreUObjectDelegates::PreLoadMapWithContext.AddUObject(this, &ThisClass::HandlePreLoadMap);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
 
-	const UGameInstance* LocalGameInstance = GetGameInstance();
+	UGameInstance* LocalGameInstance = GetGameInstance();
 	check(LocalGameInstance);
+
+	LocalGameInstance->OnLocalPlayerAddedEvent.AddUObject(this, &ThisClass::HandleLocalPlayerAddedOrRemoved);
+	LocalGameInstance->OnLocalPlayerRemovedEvent.AddUObject(this, &ThisClass::HandleLocalPlayerAddedOrRemoved);
 }
 
 void ULoadingScreenManager::Deinitialize()
@@ -142,6 +156,12 @@ void ULoadingScreenManager::Deinitialize()
 
 	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+
+	if (UGameInstance* LocalGameInstance = GetGameInstance())
+	{
+		LocalGameInstance->OnLocalPlayerAddedEvent.RemoveAll(this);
+		LocalGameInstance->OnLocalPlayerRemovedEvent.RemoveAll(this);
+	}
 }
 
 bool ULoadingScreenManager::ShouldCreateSubsystem(UObject* Outer) const
@@ -154,7 +174,11 @@ bool ULoadingScreenManager::ShouldCreateSubsystem(UObject* Outer) const
 
 void ULoadingScreenManager::Tick(float DeltaTime)
 {
-	UpdateLoadingScreen();
+	// Once the loading screen is down there is nothing to do until something changes
+	if (bCurrentlyShowingLoadingScreen || LoadingScreenCVars::LogLoadingScreenReasonEveryFrame || IsLoadingScreenStateDirty())
+	{
+		UpdateLoadingScreen();
+	}
 
 	TimeUntilNextLogHeartbeatSeconds = FMath::Max(TimeUntilNextLogHeartbeatSeconds - DeltaTime, 0.0);
 }
@@ -182,11 +206,18 @@ UWorld* ULoadingScreenManager::GetTickableGameObjectWorld() const
 void ULoadingScreenManager::RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Add(Interface.GetObject());
+	NotifyLoadingStateChanged();
 }
 
 void ULoadingScreenManager::UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface)
 {
 	ExternalLoadingProcessors.Remove(Interface.GetObject());
+	NotifyLoadingStateChanged();
+}
+
+void ULoadingScreenManager::NotifyLoadingStateChanged()
+{
+	bLoadingScreenStateDirty = true;
 }
 
 void ULoadingScreenManager::HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName)
@@ -208,22 +239,71 @@ void ULoadingScreenManager::HandlePostLoadMap(UWorld* World)
 	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
 	{
 		bCurrentlyInLoadMap = false;
+		NotifyLoadingStateChanged();
+	}
+}
+
+void ULoadingScreenManager::HandleLocalPlayerAddedOrRemoved(ULocalPlayer* LocalPlayer)
+{
+	NotifyLoadingStateChanged();
+}
+
+bool ULoadingScreenManager::IsLoadingScreenStateDirty() const
+{
+	if (bLoadingScreenStateDirty || bCurrentlyInLoadMap || LoadingScreenCVars::ForceLoadingScreenVisible)
+	{
+		return true;
+	}
+
+	// Travel does not notify us directly, so watch for the world context changing underneath us
+	const FWorldContext* Context = GetGameInstance()->GetWorldContext();
+	if (Context == nullptr)
+	{
+		return true;
+	}
+
+	UWorld* World = Context->World();
+	if ((World == nullptr) || (World != LastEvaluatedWorld.Get()) || (World->GetGameState() != LastEvaluatedGameState.Get()))
+	{
+		return true;
 	}
+
+	return !Context->TravelURL.IsEmpty() || (Context->PendingNetGame != nullptr) || !World->HasBegunPlay() || World->IsInSeamlessTravel();
 }
 
 void ULoadingScreenManager::UpdateLoadingScreen()
 {
+	const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
+
 	bool bLogLoadingScreenStatus = LoadingScreenCVars::LogLoadingScreenReasonEveryFrame;
+	const bool bHeartbeatLogDue = bCurrentlyShowingLoadingScreen && (Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0);
 
-	if (ShouldShowLoadingScreen())
+	bLoadingScreenStateDirty = false;
+
+	// Only build the (allocating) reason strings when they are going to be logged
+	bBuildDebugReasons = bLogLoadingScreenStatus || bHeartbeatLogDue;
+	bool bShouldShowLoadingScreen = ShouldShowLoadingScreen();
+	if (!bBuildDebugReasons && (bShouldShowLoadingScreen != bCurrentlyShowingLoadingScreen))
+	{
+		// Showing or hiding the loading screen logs the reason, evaluate again to build it
+		bBuildDebugReasons = true;
+		bShouldShowLoadingScreen = ShouldShowLoadingScreen();
+	}
+	bBuildDebugReasons = false;
+
+	if (bShouldShowLoadingScreen)
 	{
-		const UCommonLoadingScreenSettings* Settings = GetDefault<UCommonLoadingScreenSettings>();
-		
 		// If we don't make it to the specified checkpoint in the given time will trigger the hang detector so we can better determine where progress stalled.
  		FThreadHeartBeat::Get().MonitorCheckpointStart(GetFName(), Settings->LoadingScreenHeartbeatHangDuration);
 
 		ShowLoadingScreen();
 
+		if (!bCurrentlyShowingLoadingScreen)
+		{
+			// Could not show it yet (e.g., the engine loading screen is still up), try again next frame
+			bLoadingScreenStateDirty = true;
+		}
+
  		if ((Settings->LogLoadingScreenHeartbeatInterval > 0.0f) && (TimeUntilNextLogHeartbeatSeconds <= 0.0))
  		{
 			bLogLoadingScreenStatus = true;
@@ -246,13 +326,13 @@ void ULoadingScreenManager::UpdateLoadingScreen()
 bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 {
 	// Start out with 'unknown' reason in case someone forgets to put a reason when changing this in the future.
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("Reason for Showing/Hiding LoadingScreen is unknown!");
+	SetDebugReason(TEXT("Reason for Showing/Hiding LoadingScreen is unknown!"));
 
 	const UGameInstance* LocalGameInstance = GetGameInstance();
 
 	if (LoadingScreenCVars::ForceLoadingScreenVisible)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommonLoadingScreen.AlwaysShow is true"));
+		SetDebugReason(TEXT("CommonLoadingScreen.AlwaysShow is true"));
 		return true;
 	}
 
@@ -260,56 +340,58 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	if (Context == nullptr)
 	{
 		// We don't have a world context right now... better show a loading screen
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("The game instance has a null WorldContext"));
+		SetDebugReason(TEXT("The game instance has a null WorldContext"));
 		return true;
 	}
 
 	UWorld* World = Context->World();
+	LastEvaluatedWorld = World;
 	if (World == nullptr)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have no world (FWorldContext's World() is null)"));
+		SetDebugReason(TEXT("We have no world (FWorldContext's World() is null)"));
 		return true;
 	}
 
 	AGameStateBase* GameState = World->GetGameState<AGameStateBase>();
+	LastEvaluatedGameState = GameState;
 	if (GameState == nullptr)
 	{
 		// The game state has not yet replicated.
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("GameState hasn't yet replicated (it's null)"));
+		SetDebugReason(TEXT("GameState hasn't yet replicated (it's null)"));
 		return true;
 	}
 
 	if (bCurrentlyInLoadMap)
 	{
 		// Show a loading screen if we are in LoadMap
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("bCurrentlyInLoadMap is true"));
+		SetDebugReason(TEXT("bCurrentlyInLoadMap is true"));
 		return true;
 	}
 
 	if (!Context->TravelURL.IsEmpty())
 	{
 		// Show a loading screen when pending travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We have pending travel (the TravelURL is not empty)"));
+		SetDebugReason(TEXT("We have pending travel (the TravelURL is not empty)"));
 		return true;
 	}
 
 	if (Context->PendingNetGame != nullptr)
 	{
 		// Connecting to another server
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
+		SetDebugReason(TEXT("We are connecting to another server (PendingNetGame != nullptr)"));
 		return true;
 	}
 
 	if (!World->HasBegunPlay())
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("World hasn't begun play"));
+		SetDebugReason(TEXT("World hasn't begun play"));
 		return true;
 	}
 
 	if (World->IsInSeamlessTravel())
 	{
 		// Show a loading screen during seamless travel
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("We are in seamless travel"));
+		SetDebugReason(TEXT("We are in seamless travel"));
 		return true;
 	}
 
@@ -374,24 +456,24 @@ bool ULoadingScreenManager::CheckForAnyNeedToShowLoadingScreen()
 	}
 
 	UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
-	const bool bIsInSplitscreen = GameViewportClient->GetCurrentSplitscreenConfiguration() != ESplitScreenType::None;
+	const bool bIsInSplitscreen = (GameViewportClient != nullptr) && (GameViewportClient->GetCurrentSplitscreenConfiguration() != ESplitScreenType::None);
 
 	// In splitscreen we need all player controllers to be present
 	if (bIsInSplitscreen && bMissingAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("At least one missing local player controller in splitscreen"));
+		SetDebugReason(TEXT("At least one missing local player controller in splitscreen"));
 		return true;
 	}
 
 	// And in non-splitscreen we need at least one player controller to be present
 	if (!bIsInSplitscreen && !bFoundAnyLocalPC)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("Need at least one local player controller"));
+		SetDebugReason(TEXT("Need at least one local player controller"));
 		return true;
 	}
 
 	// Victory! The loading screen can go away now
-	DebugReasonForShowingOrHidingLoadingScreen = TEXT("(nothing wants to show it anymore)");
+	SetDebugReason(TEXT("(nothing wants to show it anymore)"));
 	return false;
 }
 
@@ -404,7 +486,7 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 	static bool bCmdLineNoLoadingScreen = FParse::Param(FCommandLine::Get(), TEXT("NoLoadingScreen"));
 	if (bCmdLineNoLoadingScreen)
 	{
-		DebugReasonForShowingOrHidingLoadingScreen = FString(TEXT("CommandLine has 'NoLoadingScreen'"));
+		SetDebugReason(TEXT("CommandLine has 'NoLoadingScreen'"));
 		return false;
 	}
 #endif
@@ -437,10 +519,15 @@ bool ULoadingScreenManager::ShouldShowLoadingScreen()
 		{
 			// Make sure we're rendering the world at this point, so that textures will actually stream in
 			//@TODO: If bNeedToShowLoadingScreen bounces back true during this window, we won't turn this off again...
-			UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient();
-			GameViewportClient->bDisableWorldRendering = false;
+			if (UGameViewportClient* GameViewportClient = GetGameInstance()->GetGameViewportClient())
+			{
+				GameViewportClient->bDisableWorldRendering = false;
+			}
 
-			DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+			if (bBuildDebugReasons)
+			{
+				DebugReasonForShowingOrHidingLoadingScreen = FString::Printf(TEXT("Keeping loading screen up for an additional %.2f seconds to allow texture streaming"), HoldLoadingScreenAdditionalSecs);
+			}
 			bWantToForceShowLoadingScreen = true;
 		}
 	}
@@ -504,9 +591,11 @@ void ULoadingScreenManager::ShowLoadingScreen()
 			LoadingScreenWidget = SNew(SThrobber);
 		}
 
-		// Add to the viewport at a high ZOrder to make sure it is on top of most things
-		UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient();
-		GameViewportClient->AddViewportWidgetContent(LoadingScreenWidget.ToSharedRef(), Settings->LoadingScreenZOrder);
+		// Add to the viewport at a high ZOrder to make sure it is on top of most things (there is none when running without a game viewport, e.g. automation tests)
+		if (UGameViewportClient* GameViewportClient = LocalGameInstance->GetGameViewportClient())
+		{
+			GameViewportClient->AddViewportWidgetContent(LoadingScreenWidget.ToSharedRef(), Settings->LoadingScreenZOrder);
+		}
 
 		ChangePerformanceSettings(/*bEnableLoadingScreen=*/ true);
 
@@ -595,10 +684,13 @@ void ULoadingScreenManager::ChangePerformanceSettings(bool bEnabingLoadingScreen
 	FShaderPipelineCache::SetBatchMode(bEnabingLoadingScreen ? FShaderPipelineCache::BatchMode::Fast : FShaderPipelineCache::BatchMode::Background);
 
 	// Don't bother drawing the 3D world while we're loading
-	GameViewportClient->bDisableWorldRendering = bEnabingLoadingScreen;
+	if (GameViewportClient != nullptr)
+	{
+		GameViewportClient->bDisableWorldRendering = bEnabingLoadingScreen;
+	}
 
 	// Make sure to prioritize streaming in levels if the loading screen is up
-	if (UWorld* ViewportWorld = GameViewportClient->GetWorld())
+	if (UWorld* ViewportWorld = GameViewportClient ? GameViewportClient->GetWorld() : nullptr)
 	{
 		if (AWorldSettings* WorldSettings = ViewportWorld->GetWorldSettings(false, false))
 		{
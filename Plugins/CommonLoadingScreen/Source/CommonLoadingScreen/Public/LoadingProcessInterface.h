@@ -7,7 +7,15 @@
 
 #include "LoadingProcessInterface.generated.h"
 
-/** Interface for things that might cause loading to happen which requires a loading screen to be displayed */
+/**
+ * Interface for things that might cause loading to happen which requires a loading screen to be displayed
+ *
+ * The loading screen manager does not poll loading processors while the loading screen is hidden, it only asks them
+ * again after a map load, travel, a change of game state or local players, or a call to NotifyLoadingStateChanged.
+ * Implementers must call NotifyLoadingStateChanged whenever the answer of ShouldShowLoadingScreen changes, otherwise
+ * the loading screen will not come up until one of the events above happens. The game state, player controllers,
+ * their components and registered processors are all queried.
+ */
 UINTERFACE(BlueprintType)
 class COMMONLOADINGSCREEN_API ULoadingProcessInterface : public UInterface
 {
@@ -23,6 +31,10 @@ public:
 	// be currently showing a loading screen
 	static bool ShouldShowLoadingScreen(UObject* TestObject, FString& OutReason);
 
+	// Lets the loading screen manager of the game instance WorldContextObject belongs to know that the answer of
+	// ShouldShowLoadingScreen may have changed, it will ask again on its next tick
+	static void NotifyLoadingStateChanged(const UObject* WorldContextObject);
+
 	virtual bool ShouldShowLoadingScreen(FString& OutReason) const
 	{
 		return false;
@@ -11,9 +11,11 @@
 template <typename InterfaceType> class TScriptInterface;
 
 class FSubsystemCollectionBase;
+class AGameStateBase;
 class IInputProcessor;
 class ILoadingProcessInterface;
 class SWidget;
+class ULocalPlayer;
 class UObject;
 class UWorld;
 struct FFrame;
@@ -21,6 +23,10 @@ struct FWorldContext;
 
 /**
  * Handles showing/hiding the loading screen
+ *
+ * While the loading screen is hidden the manager stays dormant, only re-evaluating whether it is needed when a
+ * map load/travel starts or when something calls NotifyLoadingStateChanged (loading processors should do so
+ * whenever they start wanting to show the loading screen).
  */
 UCLASS()
 class COMMONLOADINGSCREEN_API ULoadingScreenManager : public UGameInstanceSubsystem, public FTickableGameObject
@@ -42,6 +48,7 @@ public:
 	virtual UWorld* GetTickableGameObjectWorld() const override;
 	//~End of FTickableObjectBase interface
 
+	/** Returns the reason the loading screen was last shown or hidden (only kept up to date every frame when logging it) */
 	UFUNCTION(BlueprintCallable, Category=LoadingScreen)
 	FString GetDebugReasonForShowingOrHidingLoadingScreen() const
 	{
@@ -60,14 +67,30 @@ public:
 
 	void RegisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
 	void UnregisterLoadingProcessor(TScriptInterface<ILoadingProcessInterface> Interface);
+
+	/** Lets the manager know that something affecting the need for a loading screen changed, it will be re-evaluated next frame */
+	void NotifyLoadingStateChanged();
 	
 private:
 	void HandlePreLoadMap(const FWorldContext& WorldContext, const FString& MapName);
 	void HandlePostLoadMap(UWorld* World);
+	void HandleLocalPlayerAddedOrRemoved(ULocalPlayer* LocalPlayer);
+
+	/** Returns true if the need for a loading screen has to be re-evaluated (cheap, does not query any loading processors) */
+	bool IsLoadingScreenStateDirty() const;
 
-	/** Determines if we should show or hide the loading screen. Called every frame. */
+	/** Determines if we should show or hide the loading screen. Called every frame while the loading screen is visible or the state is dirty. */
 	void UpdateLoadingScreen();
 
+	/** Sets the debug reason, if we are currently building them */
+	void SetDebugReason(const TCHAR* Reason)
+	{
+		if (bBuildDebugReasons)
+		{
+			DebugReasonForShowingOrHidingLoadingScreen = Reason;
+		}
+	}
+
 	/** Returns true if we need to be showing the loading screen. */
 	bool CheckForAnyNeedToShowLoadingScreen();
 
@@ -110,6 +133,10 @@ private:
 	/** The reason why the loading screen is up (or not) */
 	FString DebugReasonForShowingOrHidingLoadingScreen;
 
+	/** The world and game state seen by the last evaluation, the loading screen is re-evaluated when they change */
+	TWeakObjectPtr<UWorld> LastEvaluatedWorld;
+	TWeakObjectPtr<AGameStateBase> LastEvaluatedGameState;
+
 	/** The time when we started showing the loading screen */
 	double TimeLoadingScreenShown = 0.0;
 
@@ -124,4 +151,10 @@ private:
 
 	/** True when the loading screen is currently being shown */
 	bool bCurrentlyShowingLoadingScreen = false;
+
+	/** True when something changed since the last evaluation while the loading screen was hidden */
+	bool bLoadingScreenStateDirty = true;
+
+	/** True while the current evaluation should fill in DebugReasonForShowingOrHidingLoadingScreen (it is only needed when logging) */
+	bool bBuildDebugReasons = false;
 };
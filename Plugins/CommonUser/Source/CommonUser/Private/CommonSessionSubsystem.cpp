@@ -3,10 +3,12 @@
 #include "CommonSessionSubsystem.h"
 #include "AssetRegistry/AssetData.h"
 #include "CommonUserTypes.h"
+#include "Containers/Ticker.h"
 #include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "Interfaces/OnlineSessionDelegates.h"
 #include "Misc/ConfigCacheIni.h"
 #include "Online/OnlineSessionNames.h"
@@ -32,6 +34,23 @@ using namespace UE::Online;
 DECLARE_LOG_CATEGORY_EXTERN(LogCommonSession, Log, All);
 DEFINE_LOG_CATEGORY(LogCommonSession);
 
+namespace CommonSessionLoopback
+{
+	static int32 NumSessions = 0;
+	static FAutoConsoleVariableRef CVarNumSessions(
+		TEXT("CommonSession.Loopback.NumSessions"),
+		NumSessions,
+		TEXT("When > 0, session searches skip the online system and return this many synthetic sessions instead (OSSv1 only, for testing and benchmarking)"),
+		ECVF_Cheat);
+
+	static float LatencySeconds = 0.25f;
+	static FAutoConsoleVariableRef CVarLatencySeconds(
+		TEXT("CommonSession.Loopback.LatencySeconds"),
+		LatencySeconds,
+		TEXT("Simulated round trip time of a loopback session search"),
+		ECVF_Cheat);
+}
+
 #define LOCTEXT_NAMESPACE "CommonUser"
 
 //////////////////////////////////////////////////////////////////////
@@ -82,6 +101,17 @@ int32 UCommonSession_SearchResult::GetPingInMs() const
 {
 	return Result.PingInMs;
 }
+
+FString UCommonSession_SearchResult::GetSessionIdString() const
+{
+	// Results without session info (such as loopback ones) fall back to the owner name
+	return Result.IsSessionInfoValid() ? Result.GetSessionIdStr() : Result.Session.OwningUserName;
+}
+
+void UCommonSession_SearchResult::UpdateFrom(const UCommonSession_SearchResult& NewerResult)
+{
+	Result = NewerResult.Result;
+}
 #else
 FString UCommonSession_SearchResult::GetDescription() const
 {
@@ -135,6 +165,16 @@ int32 UCommonSession_SearchResult::GetPingInMs() const
 	// TODO:  Not a property of lobbies.  Need to implement with sessions.
 	return 0;
 }
+
+FString UCommonSession_SearchResult::GetSessionIdString() const
+{
+	return ToLogString(Lobby->LobbyId);
+}
+
+void UCommonSession_SearchResult::UpdateFrom(const UCommonSession_SearchResult& NewerResult)
+{
+	Lobby = NewerResult.Lobby;
+}
 #endif //COMMONUSER_OSSV1
 
 
@@ -161,6 +201,9 @@ public:
 
 public:
 	TObjectPtr<UCommonSession_SearchSessionRequest> SearchRequest = nullptr;
+
+	/** Key of the cache entry the results of this search are merged into, see UCommonSessionSubsystem::GetSearchCacheKey */
+	uint32 SearchCacheKey = 0;
 };
 
 #if COMMONUSER_OSSV1
@@ -213,6 +256,26 @@ public:
 	}
 
 	virtual ~FCommonOnlineSearchSettingsOSSv1() {}
+
+	/** Hash of everything that is sent to the online system, two searches with the same hash find the same sessions */
+	uint32 GetQueryHash() const
+	{
+		uint32 Hash = HashCombine(GetTypeHash(bIsLanQuery), GetTypeHash(MaxSearchResults));
+
+		// Sorted, the order the filters were added in does not change the query
+		TArray<FName> Keys;
+		QuerySettings.SearchParams.GetKeys(/*out*/ Keys);
+		Keys.Sort(FNameLexicalLess());
+		for (const FName& Key : Keys)
+		{
+			const FOnlineSessionSearchParam& Param = QuerySettings.SearchParams.FindChecked(Key);
+			Hash = HashCombine(Hash, GetTypeHash(Key));
+			Hash = HashCombine(Hash, GetTypeHash((int32)Param.ComparisonOp));
+			Hash = HashCombine(Hash, GetTypeHash((int32)Param.Data.GetType()));
+			Hash = HashCombine(Hash, GetTypeHash(Param.Data.ToString()));
+		}
+		return Hash;
+	}
 };
 #else
 
@@ -231,6 +294,27 @@ public:
 			FindLobbyParams.Filters.Emplace(FFindLobbySearchFilter{ SEARCH_PRESENCE, ESchemaAttributeComparisonOp::Equals, true });
 		}
 	}
+
+	/** Hash of everything that is sent to the online system, two searches with the same hash find the same lobbies */
+	uint32 GetQueryHash() const
+	{
+		uint32 Hash = GetTypeHash(FindLobbyParams.MaxResults);
+
+		// Sorted, the order the filters were added in does not change the query
+		TArray<FString> Filters;
+		Filters.Reserve(FindLobbyParams.Filters.Num());
+		for (const FFindLobbySearchFilter& Filter : FindLobbyParams.Filters)
+		{
+			Filters.Add(FString::Printf(TEXT("%s %d %s"), *Filter.AttributeName.ToString(), (int32)Filter.ComparisonOp, *ToLogString(Filter.ComparisonValue)));
+		}
+		Filters.Sort();
+		for (const FString& Filter : Filters)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Filter));
+		}
+		return Hash;
+	}
+
 public:
 	FFindLobbies::Params FindLobbyParams;
 };
@@ -714,10 +798,17 @@ void UCommonSessionSubsystem::FindSessions(APlayerController* SearchingPlayer, U
 	}
 
 #if COMMONUSER_OSSV1
-	FindSessionsInternal(SearchingPlayer, MakeShared<FCommonOnlineSearchSettingsOSSv1>(Request));
+	TSharedRef<FCommonOnlineSearchSettings> FindSettings = MakeShared<FCommonOnlineSearchSettingsOSSv1>(Request);
 #else
-	FindSessionsInternal(SearchingPlayer, MakeShared<FCommonOnlineSearchSettingsOSSv2>(Request));
+	TSharedRef<FCommonOnlineSearchSettings> FindSettings = MakeShared<FCommonOnlineSearchSettingsOSSv2>(Request);
 #endif // COMMONUSER_OSSV1
+
+	if (ServeFromSearchCache(SearchingPlayer, FindSettings))
+	{
+		return;
+	}
+
+	FindSessionsInternal(SearchingPlayer, FindSettings);
 }
 
 void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings)
@@ -729,6 +820,7 @@ void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingP
 		// (or enqueue the request and service it when the previous one finishes or fails)
 		UE_LOG(LogCommonSession, Error, TEXT("A previous FindSessions call is still in progress, aborting"));
 		SearchSettings->SearchRequest->NotifySearchFinished(false, LOCTEXT("Error_FindSessionAlreadyInProgress", "Session search already in progress"));
+		AbandonSessionSearch();
 	}
 
 	ULocalPlayer* LocalPlayer = (SearchingPlayer != nullptr) ? SearchingPlayer->GetLocalPlayer() : nullptr;
@@ -740,6 +832,8 @@ void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingP
 	}
 
 	SearchSettings = InSearchSettings;
+	SearchSettings->SearchCacheKey = GetSearchCacheKey(*SearchSettings);
+	SearchCache.FindOrAdd(SearchSettings->SearchCacheKey).bRefreshInProgress = true;
 #if COMMONUSER_OSSV1
 	FindSessionsInternalOSSv1(LocalPlayer);
 #else
@@ -747,9 +841,155 @@ void UCommonSessionSubsystem::FindSessionsInternal(APlayerController* SearchingP
 #endif
 }
 
+uint32 UCommonSessionSubsystem::GetSearchCacheKey(const FCommonOnlineSearchSettings& InSearchSettings) const
+{
+	// Covers the online mode and lobbies along with any filter added by CreateQuickPlaySearchSettings
+	return InSearchSettings.GetQueryHash();
+}
+
+bool UCommonSessionSubsystem::ServeFromSearchCache(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings)
+{
+	if (SearchCacheTimeToLive <= 0.0f)
+	{
+		return false;
+	}
+
+	UCommonSession_SearchSessionRequest* Request = InSearchSettings->SearchRequest;
+	FCommonSession_SearchCacheEntry* CacheEntry = SearchCache.Find(GetSearchCacheKey(*InSearchSettings));
+	if (CacheEntry == nullptr)
+	{
+		return false;
+	}
+
+	const double CacheAge = FPlatformTime::Seconds() - CacheEntry->RefreshTime;
+	if ((CacheEntry->RefreshTime <= 0.0) || (CacheAge >= SearchCacheTimeToLive))
+	{
+		if (CacheEntry->bRefreshInProgress)
+		{
+			// Piggyback on the search in flight rather than aborting it
+			CacheEntry->WaitingRequests.AddUnique(Request);
+			return true;
+		}
+		return false;
+	}
+
+	UE_LOG(LogCommonSession, Log, TEXT("FindSessions served %d results from the cache (age %.1fs)"), CacheEntry->Results.Num(), CacheAge);
+	Request->Results = CacheEntry->Results;
+
+	if (CacheAge >= SearchCacheTimeToLive * SearchCacheRefreshFraction)
+	{
+		StartSearchCacheRefresh(SearchingPlayer, InSearchSettings);
+	}
+
+	Request->NotifySearchFinished(true, FText());
+	return true;
+}
+
+void UCommonSessionSubsystem::StartSearchCacheRefresh(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings)
+{
+	const FCommonSession_SearchCacheEntry* CacheEntry = SearchCache.Find(GetSearchCacheKey(*InSearchSettings));
+	if (SearchSettings.IsValid() || ((CacheEntry != nullptr) && CacheEntry->bRefreshInProgress))
+	{
+		// Never abort another search for a background refresh
+		return;
+	}
+
+	// Runs the same query (filters included) for a request of its own, the one served from the cache is already answered
+	const UCommonSession_SearchSessionRequest* Template = InSearchSettings->SearchRequest;
+	UCommonSession_SearchSessionRequest* RefreshRequest = NewObject<UCommonSession_SearchSessionRequest>(this);
+	RefreshRequest->OnlineMode = Template->OnlineMode;
+	RefreshRequest->bUseLobbies = Template->bUseLobbies;
+	InSearchSettings->SearchRequest = RefreshRequest;
+
+	FindSessionsInternal(SearchingPlayer, InSearchSettings);
+}
+
+void UCommonSessionSubsystem::FinishSessionSearch(bool bWasSuccessful, const FText& ErrorMessage)
+{
+	check(SearchSettings.IsValid());
+	UCommonSession_SearchSessionRequest* SearchRequest = SearchSettings->SearchRequest;
+
+	FCommonSession_SearchCacheEntry& CacheEntry = SearchCache.FindOrAdd(SearchSettings->SearchCacheKey);
+	CacheEntry.bRefreshInProgress = false;
+
+	if (bWasSuccessful)
+	{
+		// Merge incrementally, reusing the result object of every session that was already known
+		TMap<FString, UCommonSession_SearchResult*> PreviousResults;
+		PreviousResults.Reserve(CacheEntry.Results.Num());
+		for (UCommonSession_SearchResult* PreviousResult : CacheEntry.Results)
+		{
+			PreviousResults.Add(PreviousResult->GetSessionIdString(), PreviousResult);
+		}
+
+		for (TObjectPtr<UCommonSession_SearchResult>& Result : SearchRequest->Results)
+		{
+			if (UCommonSession_SearchResult** PreviousResult = PreviousResults.Find(Result->GetSessionIdString()))
+			{
+				(*PreviousResult)->UpdateFrom(*Result);
+				Result = *PreviousResult;
+			}
+		}
+
+		CacheEntry.Results = SearchRequest->Results;
+		CacheEntry.RefreshTime = FPlatformTime::Seconds();
+	}
+
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> WaitingRequests = MoveTemp(CacheEntry.WaitingRequests);
+	TArray<TObjectPtr<UCommonSession_SearchResult>> CachedResults = CacheEntry.Results;
+
+	SearchRequest->NotifySearchFinished(bWasSuccessful, ErrorMessage);
+	SearchSettings.Reset();
+
+	for (UCommonSession_SearchSessionRequest* WaitingRequest : WaitingRequests)
+	{
+		if (WaitingRequest != SearchRequest)
+		{
+			WaitingRequest->Results = bWasSuccessful ? CachedResults : TArray<TObjectPtr<UCommonSession_SearchResult>>();
+			WaitingRequest->NotifySearchFinished(bWasSuccessful, ErrorMessage);
+		}
+	}
+}
+
+void UCommonSessionSubsystem::AbandonSessionSearch()
+{
+	if (!SearchSettings.IsValid())
+	{
+		return;
+	}
+
+	if (FCommonSession_SearchCacheEntry* CacheEntry = SearchCache.Find(SearchSettings->SearchCacheKey))
+	{
+		CacheEntry->bRefreshInProgress = false;
+
+		TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> WaitingRequests = MoveTemp(CacheEntry->WaitingRequests);
+		for (UCommonSession_SearchSessionRequest* WaitingRequest : WaitingRequests)
+		{
+			WaitingRequest->NotifySearchFinished(false, LOCTEXT("Error_FindSessionAlreadyInProgress", "Session search already in progress"));
+		}
+	}
+
+	SearchSettings.Reset();
+}
+
+void UCommonSessionSubsystem::InvalidateSearchCache()
+{
+	for (TPair<uint32, FCommonSession_SearchCacheEntry>& Pair : SearchCache)
+	{
+		Pair.Value.Results.Reset();
+		Pair.Value.RefreshTime = 0.0;
+	}
+}
+
 #if COMMONUSER_OSSV1
 void UCommonSessionSubsystem::FindSessionsInternalOSSv1(ULocalPlayer* LocalPlayer)
 {
+	if (CommonSessionLoopback::NumSessions > 0)
+	{
+		FindSessionsLoopbackOSSv1();
+		return;
+	}
+
 	IOnlineSubsystem* OnlineSub = Online::GetSubsystem(GetWorld());
 	check(OnlineSub);
 	IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
@@ -762,6 +1002,36 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv1(ULocalPlayer* LocalPlaye
 	}
 }
 
+void UCommonSessionSubsystem::FindSessionsLoopbackOSSv1()
+{
+	FCommonOnlineSearchSettingsOSSv1& SearchSettingsV1 = *StaticCastSharedPtr<FCommonOnlineSearchSettingsOSSv1>(SearchSettings);
+	SearchSettingsV1.SearchResults.Reset(CommonSessionLoopback::NumSessions);
+
+	// A fixed seed keeps the synthetic sessions identical across searches, like a real backend would between refreshes
+	FRandomStream RandomStream(0x5E5510);
+	for (int32 SessionIndex = 0; SessionIndex < CommonSessionLoopback::NumSessions; ++SessionIndex)
+	{
+		FOnlineSessionSearchResult& FakeResult = SearchSettingsV1.SearchResults.AddDefaulted_GetRef();
+		FakeResult.Session.OwningUserName = FString::Printf(TEXT("Loopback Session %d"), SessionIndex);
+		FakeResult.Session.SessionSettings.NumPublicConnections = 16;
+		FakeResult.Session.SessionSettings.bShouldAdvertise = true;
+		FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
+		FakeResult.Session.SessionSettings.Set(SETTING_GAMEMODE, FString(TEXT("Loopback")), EOnlineDataAdvertisementType::ViaOnlineService);
+		FakeResult.Session.NumOpenPublicConnections = RandomStream.RandRange(0, FakeResult.Session.SessionSettings.NumPublicConnections);
+		FakeResult.PingInMs = RandomStream.RandRange(10, 250);
+	}
+	SearchSettingsV1.SearchState = EOnlineAsyncTaskState::Done;
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, LocalSearchSettings = SearchSettings](float DeltaTime)
+	{
+		if (LocalSearchSettings == SearchSettings)
+		{
+			OnFindSessionsComplete(true);
+		}
+		return false;
+	}), CommonSessionLoopback::LatencySeconds);
+}
+
 #else
 
 void UCommonSessionSubsystem::FindSessionsInternalOSSv2(ULocalPlayer* LocalPlayer)
@@ -807,7 +1077,7 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv2(ULocalPlayer* LocalPlaye
 					Entry->Lobby = Lobby;
 					SearchSettings->SearchRequest->Results.Add(Entry);
 
-					UE_LOG(LogCommonSession, Log, TEXT("\tFound lobby (UserId: %s, NumOpenConns: %d)"),
+					UE_LOG(LogCommonSession, Verbose, TEXT("\tFound lobby (UserId: %s, NumOpenConns: %d)"),
 						*ToLogString(Lobby->OwnerAccountId), Lobby->MaxMembers - Lobby->Members.Num());
 				}
 			}
@@ -819,8 +1089,7 @@ void UCommonSessionSubsystem::FindSessionsInternalOSSv2(ULocalPlayer* LocalPlaye
 
 		const FText ResultText = bWasSuccessful ? FText() : FindResult.GetErrorValue().GetText();
 
-		SearchSettings->SearchRequest->NotifySearchFinished(bWasSuccessful, ResultText);
-		SearchSettings.Reset();
+		FinishSessionSearch(bWasSuccessful, ResultText);
 	});
 }
 #endif // COMMONUSER_OSSV1
@@ -839,13 +1108,41 @@ void UCommonSessionSubsystem::QuickPlaySession(APlayerController* JoiningOrHosti
 	TWeakObjectPtr<APlayerController> JoiningOrHostingPlayerPtr = TWeakObjectPtr<APlayerController>(JoiningOrHostingPlayer);
 
 	UCommonSession_SearchSessionRequest* QuickPlayRequest = CreateOnlineSearchSessionRequest();
-	QuickPlayRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleQuickPlaySearchFinished, JoiningOrHostingPlayerPtr, HostRequestPtr);
+	QuickPlayRequest->OnSearchFinished.AddUObject(this, &UCommonSessionSubsystem::HandleQuickPlaySearchFinished, TWeakObjectPtr<UCommonSession_SearchSessionRequest>(QuickPlayRequest), JoiningOrHostingPlayerPtr, HostRequestPtr);
 
 	HostRequestPtr->bUseLobbies = bUseLobbiesDefault;
 	QuickPlayRequest->bUseLobbies = bUseLobbiesDefault;
 
 	NotifySessionInformationUpdated(ECommonSessionInformationState::Matchmaking);
-	FindSessionsInternal(JoiningOrHostingPlayer, CreateQuickPlaySearchSettings(HostRequest, QuickPlayRequest));
+
+	// Built up front, the filters it adds are part of the cache key
+	TSharedRef<FCommonOnlineSearchSettings> QuickPlaySettings = CreateQuickPlaySearchSettings(HostRequest, QuickPlayRequest);
+
+	// Join straight from fresh cached results if there is a viable session, and refresh them in the background for next time
+	if (FCommonSession_SearchCacheEntry* CacheEntry = SearchCache.Find(GetSearchCacheKey(*QuickPlaySettings)))
+	{
+		const double CacheAge = FPlatformTime::Seconds() - CacheEntry->RefreshTime;
+		if ((SearchCacheTimeToLive > 0.0f) && (CacheEntry->RefreshTime > 0.0) && (CacheAge < SearchCacheTimeToLive))
+		{
+			if (UCommonSession_SearchResult* CachedSession = ChooseQuickPlaySession(CacheEntry->Results))
+			{
+				UE_LOG(LogCommonSession, Log, TEXT("QuickPlay joining cached session %s (cache age %.1fs)"), *CachedSession->GetDescription(), CacheAge);
+				StartSearchCacheRefresh(JoiningOrHostingPlayer, QuickPlaySettings);
+				JoinSession(JoiningOrHostingPlayer, CachedSession);
+				return;
+			}
+		}
+
+		if (CacheEntry->bRefreshInProgress && SearchSettings.IsValid())
+		{
+			// Share the results of the search in flight, starting a new one would abort it and fail everyone waiting on it
+			UE_LOG(LogCommonSession, Log, TEXT("QuickPlay waiting for the session search in progress"));
+			CacheEntry->WaitingRequests.AddUnique(QuickPlayRequest);
+			return;
+		}
+	}
+
+	FindSessionsInternal(JoiningOrHostingPlayer, QuickPlaySettings);
 }
 
 TSharedRef<FCommonOnlineSearchSettings> UCommonSessionSubsystem::CreateQuickPlaySearchSettings(UCommonSession_HostSessionRequest* HostRequest, UCommonSession_SearchSessionRequest* SearchRequest)
@@ -900,23 +1197,24 @@ TSharedRef<FCommonOnlineSearchSettings> UCommonSessionSubsystem::CreateQuickPlay
 
 #endif // COMMONUSER_OSSV1
 
-void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
+void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<UCommonSession_SearchSessionRequest> QuickPlayRequest, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest)
 {
-	const int32 ResultCount = SearchSettings->SearchRequest->Results.Num();
+	if (!QuickPlayRequest.IsValid())
+	{
+		NotifySessionInformationUpdated(ECommonSessionInformationState::OutOfGame);
+		return;
+	}
+
+	const int32 ResultCount = QuickPlayRequest->Results.Num();
 	UE_LOG(LogCommonSession, Log, TEXT("QuickPlay Search Finished %s (Results %d) (Error: %s)"), bSucceeded ? TEXT("Success") : TEXT("Failed"), ResultCount, *ErrorMessage.ToString());
 
 	//@TODO: We have to check if the error message is empty because some OSS layers report a failure just because there are no sessions.  Please fix with OSS 2.0.
 	if (bSucceeded || ErrorMessage.IsEmpty())
 	{
 		// Join the best search result.
-		if (ResultCount > 0)
+		if (UCommonSession_SearchResult* Result = ChooseQuickPlaySession(QuickPlayRequest->Results))
 		{
-			//@TODO: We should probably look at ping?  maybe some other factors to find the best.  Idk if they come pre-sorted or not.
-			for (UCommonSession_SearchResult* Result : SearchSettings->SearchRequest->Results)
-			{
-				JoinSession(JoiningOrHostingPlayer.Get(), Result);
-				return;
-			}
+			JoinSession(JoiningOrHostingPlayer.Get(), Result);
 		}
 		else
 		{
@@ -930,6 +1228,24 @@ void UCommonSessionSubsystem::HandleQuickPlaySearchFinished(bool bSucceeded, con
 	}
 }
 
+UCommonSession_SearchResult* UCommonSessionSubsystem::ChooseQuickPlaySession(const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results) const
+{
+	// Join the closest session that still has room, full sessions would only fail to join
+	UCommonSession_SearchResult* BestResult = nullptr;
+	for (UCommonSession_SearchResult* Result : Results)
+	{
+		if ((Result != nullptr) && (Result->GetNumOpenPublicConnections() > 0))
+		{
+			if ((BestResult == nullptr) || (Result->GetPingInMs() < BestResult->GetPingInMs()))
+			{
+				BestResult = Result;
+			}
+		}
+	}
+
+	return BestResult;
+}
+
 void UCommonSessionSubsystem::CleanUpSessions()
 {
 	bWantToDestroyPendingSession = true;
@@ -1033,7 +1349,7 @@ void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
 				OwningUserId = Result.Session.OwningUserId->ToString();
 			}
 
-			UE_LOG(LogCommonSession, Log, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
+			UE_LOG(LogCommonSession, Verbose, TEXT("\tFound session (UserId: %s, UserName: %s, NumOpenPrivConns: %d, NumOpenPubConns: %d, Ping: %d ms"),
 				*OwningUserId,
 				*Result.Session.OwningUserName,
 				Result.Session.NumOpenPrivateConnections,
@@ -1047,25 +1363,7 @@ void UCommonSessionSubsystem::OnFindSessionsComplete(bool bWasSuccessful)
 		SearchSettingsV1.SearchRequest->Results.Empty();
 	}
 
-	if (0)
-	{
-		// Fake Sessions OSSV1
-		for (int i = 0; i < 10; i++)
-		{
-			UCommonSession_SearchResult* Entry = NewObject<UCommonSession_SearchResult>(SearchSettings->SearchRequest);
-			FOnlineSessionSearchResult FakeResult;
-			FakeResult.Session.OwningUserName = TEXT("Fake User");
-			FakeResult.Session.SessionSettings.NumPublicConnections = 10;
-			FakeResult.Session.SessionSettings.bShouldAdvertise = true;
-			FakeResult.Session.SessionSettings.bAllowJoinInProgress = true;
-			FakeResult.PingInMs=99;
-			Entry->Result = FakeResult;
-			SearchSettingsV1.SearchRequest->Results.Add(Entry);
-		}
-	}
-	
-	SearchSettingsV1.SearchRequest->NotifySearchFinished(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
-	SearchSettings.Reset();
+	FinishSessionSearch(bWasSuccessful, bWasSuccessful ? FText() : LOCTEXT("Error_FindSessionV1Failed", "Find session failed"));
 }
 #endif // COMMONUSER_OSSV1
 
@@ -1452,4 +1750,65 @@ void UCommonSessionSubsystem::HandlePostLoadMap(UWorld* World)
 #endif // COMMONUSER_OSSV1
 }
 
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+// Measures the time from starting a search to picking the session quick play would join, first with an empty cache and then with a warm one
+static void RunBenchmarkSessionSearch(UCommonSessionSubsystem* SessionSubsystem, APlayerController* SearchingPlayer, bool bWarmCache)
+{
+	if (!bWarmCache)
+	{
+		SessionSubsystem->InvalidateSearchCache();
+	}
+
+	UCommonSession_SearchSessionRequest* Request = SessionSubsystem->CreateOnlineSearchSessionRequest();
+	const double StartTime = FPlatformTime::Seconds();
+	TWeakObjectPtr<APlayerController> WeakPlayer(SearchingPlayer);
+
+	Request->OnSearchFinished.AddWeakLambda(SessionSubsystem, [SessionSubsystem, Request, StartTime, bWarmCache, WeakPlayer](bool bSucceeded, const FText& ErrorMessage)
+	{
+		UCommonSession_SearchResult* ChosenSession = SessionSubsystem->ChooseQuickPlaySession(Request->Results);
+		UE_LOG(LogCommonSession, Log, TEXT("Search-to-join with %s cache: %.2f ms (%s, %d results, would join %s)"),
+			bWarmCache ? TEXT("warm") : TEXT("cold"),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0,
+			bSucceeded ? TEXT("succeeded") : TEXT("failed"),
+			Request->Results.Num(),
+			ChosenSession ? *ChosenSession->GetSessionIdString() : TEXT("nothing"));
+
+		if (bSucceeded && !bWarmCache && WeakPlayer.IsValid())
+		{
+			RunBenchmarkSessionSearch(SessionSubsystem, WeakPlayer.Get(), true);
+		}
+	});
+
+	SessionSubsystem->FindSessions(SearchingPlayer, Request);
+}
+
+static void BenchmarkSessionSearch(const TArray<FString>& Args, UWorld* World)
+{
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	UCommonSessionSubsystem* SessionSubsystem = GameInstance ? GameInstance->GetSubsystem<UCommonSessionSubsystem>() : nullptr;
+	APlayerController* SearchingPlayer = GameInstance ? GameInstance->GetFirstLocalPlayerController() : nullptr;
+	if ((SessionSubsystem == nullptr) || (SearchingPlayer == nullptr))
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("CommonSession.BenchmarkSearch requires a game instance with a local player"));
+		return;
+	}
+
+	if (CommonSessionLoopback::NumSessions <= 0)
+	{
+		UE_LOG(LogCommonSession, Warning, TEXT("CommonSession.BenchmarkSearch is meant to run against the loopback backend, set CommonSession.Loopback.NumSessions first"));
+	}
+
+	RunBenchmarkSessionSearch(SessionSubsystem, SearchingPlayer, false);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkSessionSearch(
+	TEXT("CommonSession.BenchmarkSearch"),
+	TEXT("Measures search-to-join latency with a cold and then a warm session search cache"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkSessionSearch));
+
+#endif // !UE_BUILD_SHIPPING
+
 #undef LOCTEXT_NAMESPACE
@@ -132,6 +132,12 @@ public:
 	UFUNCTION(BlueprintPure, Category=Sessions)
 	int32 GetPingInMs() const;
 
+	/** Returns a string that identifies the session across searches, used to match up cached results */
+	FString GetSessionIdString() const;
+
+	/** Copies the platform-specific session data from a newer search result for the same session */
+	void UpdateFrom(const UCommonSession_SearchResult& NewerResult);
+
 public:
 	/** Pointer to the platform-specific implementation */
 #if COMMONUSER_OSSV1
@@ -182,6 +188,31 @@ private:
 };
 
 
+//////////////////////////////////////////////////////////////////////
+// FCommonSession_SearchCacheEntry
+
+/** Results of the last search for one kind of session search, shared by all requests of that kind */
+USTRUCT()
+struct FCommonSession_SearchCacheEntry
+{
+	GENERATED_BODY()
+
+	/** Result objects are reused across refreshes for sessions that are still found, so UI entries stay valid */
+	UPROPERTY()
+	TArray<TObjectPtr<UCommonSession_SearchResult>> Results;
+
+	/** Requests that arrived while the cache was stale and a refresh was already in flight */
+	UPROPERTY()
+	TArray<TObjectPtr<UCommonSession_SearchSessionRequest>> WaitingRequests;
+
+	/** Platform time of the last successful refresh, 0 if there has never been one */
+	double RefreshTime = 0.0;
+
+	/** True while a search that will refresh this entry is in flight */
+	bool bRefreshInProgress = false;
+};
+
+
 //////////////////////////////////////////////////////////////////////
 // CommonSessionSubsystem Events
 
@@ -279,6 +310,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Session)
 	virtual void CleanUpSessions();
 
+	/** Throws away all cached search results, the next search will always query the online system */
+	UFUNCTION(BlueprintCallable, Category=Session)
+	void InvalidateSearchCache();
+
+	/** Picks the session quick play should join from a list of search results, returns null if a new session should be hosted instead */
+	virtual UCommonSession_SearchResult* ChooseQuickPlaySession(const TArray<TObjectPtr<UCommonSession_SearchResult>>& Results) const;
+
 	//////////////////////////////////////////////////////////////////////
 	// Events
 
@@ -315,14 +353,32 @@ public:
 	UPROPERTY(Config)
 	bool bUseLobbiesDefault = true;
 
+	/** How long in seconds search results are served from the cache instead of querying the online system again, 0 disables the cache */
+	UPROPERTY(Config)
+	float SearchCacheTimeToLive = 30.0f;
+
+	/** Once cached results are older than this fraction of the time to live, serving them also starts a refresh in the background */
+	UPROPERTY(Config)
+	float SearchCacheRefreshFraction = 0.5f;
+
 protected:
 	// Functions called during the process of creating or joining a session, these can be overidden for game-specific behavior
 
 	/** Called to fill in a session request from quick play host settings, can be overridden for game-specific behavior */
 	virtual TSharedRef<FCommonOnlineSearchSettings> CreateQuickPlaySearchSettings(UCommonSession_HostSessionRequest* Request, UCommonSession_SearchSessionRequest* QuickPlayRequest);
 
-	/** Called when a quick play search finishes, can be overridden for game-specific behavior */
-	virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
+	/**
+	 * Called when a quick play search finishes, can be overridden for game-specific behavior.
+	 * QuickPlayRequest holds the results, the search may have been shared with other requests and already be reset
+	 */
+	virtual void HandleQuickPlaySearchFinished(bool bSucceeded, const FText& ErrorMessage, TWeakObjectPtr<UCommonSession_SearchSessionRequest> QuickPlayRequest, TWeakObjectPtr<APlayerController> JoiningOrHostingPlayer, TStrongObjectPtr<UCommonSession_HostSessionRequest> HostRequest);
+
+	/**
+	 * Returns the key that search results are cached under, a hash of the online query including any filter added by
+	 * CreateQuickPlaySearchSettings, so searches with different filters never share results.
+	 * Games that filter results on state the query does not capture should override this to include that state.
+	 */
+	virtual uint32 GetSearchCacheKey(const FCommonOnlineSearchSettings& InSearchSettings) const;
 
 	/** Called when traveling to a session fails */
 	virtual void TravelLocalSessionFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ReasonString);
@@ -350,8 +406,18 @@ protected:
 	void NotifySessionInformationUpdated(ECommonSessionInformationState SessionStatusStr, const FString& GameMode = FString(), const FString& MapName = FString());
 	void SetCreateSessionError(const FText& ErrorText);
 
+	/** Serves the request from the search cache, or queues it on a refresh already in flight. Returns false if a new search is needed */
+	bool ServeFromSearchCache(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings);
+	/** Starts a search with the same query that only refreshes the cache, if no other search is in flight. The settings are retargeted to a new request */
+	void StartSearchCacheRefresh(APlayerController* SearchingPlayer, const TSharedRef<FCommonOnlineSearchSettings>& InSearchSettings);
+	/** Merges the results of the current search into the cache, notifies its request and any waiting ones, and clears the current search */
+	void FinishSessionSearch(bool bWasSuccessful, const FText& ErrorMessage);
+	/** Fails the requests waiting on the cache refresh for the search that is being abandoned */
+	void AbandonSessionSearch();
+
 #if COMMONUSER_OSSV1
 	void BindOnlineDelegatesOSSv1();
+	void FindSessionsLoopbackOSSv1();
 	void CreateOnlineSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_HostSessionRequest* Request);
 	void FindSessionsInternalOSSv1(ULocalPlayer* LocalPlayer);
 	void JoinSessionInternalOSSv1(ULocalPlayer* LocalPlayer, UCommonSession_SearchResult* Request);
@@ -407,4 +473,8 @@ protected:
 
 	/** Settings for the current host request */
 	TSharedPtr<FCommonSession_OnlineSessionSettings> HostSettings;
+
+	/** Cached search results, see GetSearchCacheKey */
+	UPROPERTY(Transient)
+	TMap<uint32, FCommonSession_SearchCacheEntry> SearchCache;
 };
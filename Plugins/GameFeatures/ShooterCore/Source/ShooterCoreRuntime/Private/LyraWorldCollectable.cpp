@@ -3,6 +3,9 @@
 #include "LyraWorldCollectable.h"
 
 #include "Async/TaskGraphInterfaces.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Interaction/LyraInteractableSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWorldCollectable)
 
@@ -12,11 +15,61 @@ ALyraWorldCollectable::ALyraWorldCollectable()
 {
 }
 
+void ALyraWorldCollectable::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ULyraInteractableSubsystem* InteractableSubsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(GetWorld()))
+	{
+		InteractableSubsystem->RegisterInteractable(this, GetActorLocation(), GetSimpleCollisionRadius());
+
+		USceneComponent* Root = GetRootComponent();
+		if ((Root != nullptr) && (Root->Mobility == EComponentMobility::Movable))
+		{
+			Root->TransformUpdated.AddUObject(this, &ThisClass::HandleRootTransformUpdated);
+		}
+	}
+}
+
+void ALyraWorldCollectable::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USceneComponent* Root = GetRootComponent())
+	{
+		Root->TransformUpdated.RemoveAll(this);
+	}
+
+	if (ULyraInteractableSubsystem* InteractableSubsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(GetWorld()))
+	{
+		InteractableSubsystem->UnregisterInteractable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ALyraWorldCollectable::GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder)
 {
 	InteractionBuilder.AddInteractionOption(Option);
 }
 
+void ALyraWorldCollectable::SetInteractionOption(const FInteractionOption& NewOption)
+{
+	Option = NewOption;
+
+	// The registry caches the options of collectables, since they don't depend on who asks
+	if (ULyraInteractableSubsystem* InteractableSubsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(GetWorld()))
+	{
+		InteractableSubsystem->InvalidateInteractionOptions(this);
+	}
+}
+
+void ALyraWorldCollectable::HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (ULyraInteractableSubsystem* InteractableSubsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(GetWorld()))
+	{
+		InteractableSubsystem->UpdateInteractableLocation(this, GetActorLocation(), GetSimpleCollisionRadius());
+	}
+}
+
 FInventoryPickup ALyraWorldCollectable::GetPickupInventory() const
 {
 	return StaticInventory;
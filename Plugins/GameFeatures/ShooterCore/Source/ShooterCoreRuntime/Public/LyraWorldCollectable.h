@@ -10,6 +10,7 @@
 #include "LyraWorldCollectable.generated.h"
 
 class UObject;
+class USceneComponent;
 struct FInteractionQuery;
 
 /**
@@ -24,10 +25,23 @@ public:
 
 	ALyraWorldCollectable();
 
+	//~AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	//~End of AActor interface
+
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& InteractionBuilder) override;
+	virtual bool CanCacheInteractionOptions() const override { return true; }
 	virtual FInventoryPickup GetPickupInventory() const override;
 
+	// Replaces the interaction option offered by this collectable
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void SetInteractionOption(const FInteractionOption& NewOption);
+
 protected:
+	// Keeps the interactable registry in sync when a movable collectable moves
+	void HandleRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 	UPROPERTY(EditAnywhere)
 	FInteractionOption Option;
 
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "GameSetting.h"
+#include "GameSettingCollection.h"
 #include "Framework/Text/ITextDecorator.h"
 #include "Framework/Text/RichTextMarkupProcessing.h"
 #include "Engine/LocalPlayer.h"
@@ -99,7 +100,7 @@ void UGameSetting::Apply()
 void UGameSetting::OnInitialized()
 {
 	ensureMsgf(bReady, TEXT("OnInitialized called directly instead of via StartupComplete."));
-	EditableStateCache = ComputeEditableState();
+	SetEditableStateCache(ComputeEditableState());
 }
 
 void UGameSetting::OnApply()
@@ -233,7 +234,7 @@ void UGameSetting::RefreshEditableState(bool bNotifyEditConditionsChanged)
 	{
 		TGuardValue<bool> Guard(bOnEditConditionsChangedEventGuard, true);
 	
-		EditableStateCache = ComputeEditableState();
+		SetEditableStateCache(ComputeEditableState());
 
 		if (bNotifyEditConditionsChanged)
 		{
@@ -242,6 +243,29 @@ void UGameSetting::RefreshEditableState(bool bNotifyEditConditionsChanged)
 	}
 }
 
+void UGameSetting::SetEditableStateCache(FGameSettingEditableState&& NewEditableState)
+{
+	const bool bFilterStateChanged =
+		(NewEditableState.IsVisible() != EditableStateCache.IsVisible()) ||
+		(NewEditableState.IsEnabled() != EditableStateCache.IsEnabled()) ||
+		(NewEditableState.IsResetable() != EditableStateCache.IsResetable());
+
+	EditableStateCache = MoveTemp(NewEditableState);
+
+	if (bFilterStateChanged)
+	{
+		InvalidateParentFilterCache();
+	}
+}
+
+void UGameSetting::InvalidateParentFilterCache()
+{
+	if (UGameSettingCollection* ParentCollection = Cast<UGameSettingCollection>(SettingParent))
+	{
+		ParentCollection->InvalidateFilterCache();
+	}
+}
+
 void UGameSetting::NotifyEditConditionsChanged()
 {
 	OnEditConditionsChanged();
@@ -25,6 +25,7 @@ void UGameSettingCollection::AddSetting(UGameSetting* Setting)
 
 	Settings.Add(Setting);
 	Setting->SetSettingParent(this);
+	InvalidateFilterCache();
 
 	if (LocalPlayer)
 	{
@@ -48,6 +49,37 @@ TArray<UGameSettingCollection*> UGameSettingCollection::GetChildCollections() co
 }
 
 void UGameSettingCollection::GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings) const
+{
+	static const int32 MaxFilterCacheEntries = 2;
+
+	for (int32 EntryIndex = FilterCache.Num() - 1; EntryIndex >= 0; EntryIndex--)
+	{
+		if (FilterCache[EntryIndex].FilterState.IsEquivalentTo(FilterState))
+		{
+			InOutSettings.Append(FilterCache[EntryIndex].FilteredSettings);
+			return;
+		}
+	}
+
+	if (FilterCache.Num() >= MaxFilterCacheEntries)
+	{
+		FilterCache.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	FFilterCacheEntry& NewEntry = FilterCache.AddDefaulted_GetRef();
+	NewEntry.FilterState = FilterState;
+	GatherSettingsForFilter(FilterState, NewEntry.FilteredSettings);
+
+	InOutSettings.Append(NewEntry.FilteredSettings);
+}
+
+void UGameSettingCollection::InvalidateFilterCache()
+{
+	FilterCache.Reset();
+	InvalidateParentFilterCache();
+}
+
+void UGameSettingCollection::GatherSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings) const
 {
 	for (UGameSetting* ChildSetting : Settings)
 	{
@@ -49,9 +49,21 @@ void FGameSettingFilterState::AddSettingToAllowList(UGameSetting* InSetting)
 
 void FGameSettingFilterState::SetSearchText(const FString& InSearchText)
 {
+	SearchText = InSearchText;
 	SearchTextEvaluator.SetFilterText(FText::FromString(InSearchText));
 }
 
+bool FGameSettingFilterState::IsEquivalentTo(const FGameSettingFilterState& Other) const
+{
+	return bIncludeDisabled == Other.bIncludeDisabled &&
+		bIncludeHidden == Other.bIncludeHidden &&
+		bIncludeResetable == Other.bIncludeResetable &&
+		bIncludeNestedPages == Other.bIncludeNestedPages &&
+		SettingRootList == Other.SettingRootList &&
+		SettingAllowList == Other.SettingAllowList &&
+		SearchText.Equals(Other.SearchText, ESearchCase::CaseSensitive);
+}
+
 bool FGameSettingFilterState::DoesSettingPassFilter(const UGameSetting& InSetting) const
 {
 	const FGameSettingEditableState& EditableState = InSetting.GetEditState();
@@ -86,6 +86,17 @@ void UGameSettingRegistry::GetSettingsForFilter(const FGameSettingFilterState& F
 	}
 }
 
+void UGameSettingRegistry::InvalidateFilterCaches()
+{
+	for (UGameSetting* Setting : RegisteredSettings)
+	{
+		if (UGameSettingCollection* Collection = Cast<UGameSettingCollection>(Setting))
+		{
+			Collection->InvalidateFilterCache();
+		}
+	}
+}
+
 UGameSetting* UGameSettingRegistry::FindSettingByDevName(const FName& SettingDevName)
 {
 	for (UGameSetting* Setting : RegisteredSettings)
@@ -174,7 +174,13 @@ protected:
 
 	/** Regenerates the plain searchable text if it has been dirtied. */
 	void RefreshPlainText() const;
-	void InvalidateSearchableText() { bRefreshPlainSearchableText = true; }
+	void InvalidateSearchableText() { bRefreshPlainSearchableText = true; InvalidateParentFilterCache(); }
+
+	/** Lets the collection owning this setting know its cached filter results are out of date. */
+	void InvalidateParentFilterCache();
+
+	/** Updates the cached editable state, invalidating the parent filter cache if anything the filter looks at changed. */
+	void SetEditableStateCache(FGameSettingEditableState&& NewEditableState);
 
 	/** Notify that the setting changed */
 	void NotifySettingChanged(EGameSettingChangeReason Reason);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameSetting.h"
+#include "GameSettingFilterState.h"
 
 #include "GameSettingCollection.generated.h"
 
@@ -26,12 +27,34 @@ public:
 	void AddSetting(UGameSetting* Setting);
 	virtual void GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings) const;
 
+	/**
+	 * Throws away the cached filter results of this collection and the collections above it, called whenever
+	 * anything the filter looks at changes for a setting in this collection.
+	 */
+	void InvalidateFilterCache();
+
 	virtual bool IsSelectable() const { return false; }
 
+protected:
+	/** Walks the child settings and gathers the ones passing the filter, using the child collection caches. */
+	void GatherSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings) const;
+
 protected:
 	/** The settings owned by this collection. */
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UGameSetting>> Settings;
+
+private:
+	struct FFilterCacheEntry
+	{
+		FGameSettingFilterState FilterState;
+
+		// Only ever contains settings under this collection, which are kept alive by Settings
+		TArray<UGameSetting*> FilteredSettings;
+	};
+
+	/** Results for the most recently used filters, most recent last (screens usually alternate between a couple). */
+	mutable TArray<FFilterCacheEntry, TInlineAllocator<2>> FilterCache;
 };
 
 //--------------------------------------
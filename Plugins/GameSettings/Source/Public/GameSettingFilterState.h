@@ -63,9 +63,15 @@ public:
 		return SettingRootList.Contains(InSetting);
 	}
 
+	/** Returns true if both filter states would let through the same settings, used to reuse cached filter results. */
+	bool IsEquivalentTo(const FGameSettingFilterState& Other) const;
+
 private:
 	FTextFilterExpressionEvaluator SearchTextEvaluator;
 
+	// The search text the evaluator was set up with
+	FString SearchText;
+
 	UPROPERTY()
 	TArray<TObjectPtr<UGameSetting>> SettingRootList;
 
@@ -53,6 +53,9 @@ public:
 	
 	void GetSettingsForFilter(const FGameSettingFilterState& FilterState, TArray<UGameSetting*>& InOutSettings);
 
+	/** Throws away the cached filter results of every collection, they are rebuilt on the next GetSettingsForFilter. */
+	void InvalidateFilterCaches();
+
 	UGameSetting* FindSettingByDevName(const FName& SettingDevName);
 
 	template<typename T = UGameSetting>
@@ -3,6 +3,7 @@
 #include "BPFunctionLibrary.h"
 
 #include "Engine/StaticMesh.h"
+#include "LyraMeshMaterialBatchEdit.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BPFunctionLibrary)
 
@@ -10,17 +11,6 @@ class UMaterialInterface;
 
 bool UBPFunctionLibrary::ChangeMeshMaterials(TArray<UStaticMesh*> Mesh, UMaterialInterface* Material)
 {
-
-	for (int i = 0; i < Mesh.Num(); i++)
-	{
-		Mesh[i]->Modify();
-		TArray<FStaticMaterial>& Mats = Mesh[i]->GetStaticMaterials();
-		for (int j = 0; j < Mats.Num(); j++)
-		{
-			Mats[j].MaterialInterface = Material;
-
-		}
-		Mesh[i]->PostEditChange();
-	}
-	return true;
+	const FLyraMeshMaterialBatchEditResult Result = FLyraMeshMaterialBatchEdit::ChangeMeshMaterials(Mesh, Material);
+	return !Result.bCancelled;
 }
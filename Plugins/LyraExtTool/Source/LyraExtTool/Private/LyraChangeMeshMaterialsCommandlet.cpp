@@ -0,0 +1,103 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraChangeMeshMaterialsCommandlet.h"
+
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+#include "FileHelpers.h"
+#include "LyraExtTool.h"
+#include "LyraMeshMaterialBatchEdit.h"
+#include "Materials/MaterialInterface.h"
+#include "StaticMeshCompiler.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraChangeMeshMaterialsCommandlet)
+
+ULyraChangeMeshMaterialsCommandlet::ULyraChangeMeshMaterialsCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 ULyraChangeMeshMaterialsCommandlet::Main(const FString& FullCommandLine)
+{
+	UE_LOG(LogLyraExtTool, Display, TEXT("Running LyraChangeMeshMaterials commandlet..."));
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Params;
+	ParseCommandLine(*FullCommandLine, Tokens, Switches, Params);
+
+	const FString* PathString = Params.Find(TEXT("Path"));
+	const FString* MaterialString = Params.Find(TEXT("Material"));
+	if ((PathString == nullptr) || PathString->IsEmpty() || (MaterialString == nullptr) || MaterialString->IsEmpty())
+	{
+		UE_LOG(LogLyraExtTool, Error, TEXT("Usage: -run=LyraChangeMeshMaterials -Path=/Game/Some/Folder -Material=/Game/Some/M_Material [-NoRecursive] [-NoSave]"));
+		return 1;
+	}
+
+	UMaterialInterface* Material = LoadObject<UMaterialInterface>(nullptr, **MaterialString);
+	if (Material == nullptr)
+	{
+		UE_LOG(LogLyraExtTool, Error, TEXT("Failed to load material %s"), **MaterialString);
+		return 1;
+	}
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(**PathString));
+	Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = !Switches.Contains(TEXT("NoRecursive"));
+
+	TArray<FAssetData> AssetDataList;
+	AssetRegistry.GetAssets(Filter, AssetDataList);
+
+	TArray<UStaticMesh*> Meshes;
+	Meshes.Reserve(AssetDataList.Num());
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		if (UStaticMesh* Mesh = Cast<UStaticMesh>(AssetData.GetAsset()))
+		{
+			Meshes.Add(Mesh);
+		}
+		else
+		{
+			UE_LOG(LogLyraExtTool, Warning, TEXT("Failed to load %s"), *AssetData.GetObjectPathString());
+		}
+	}
+
+	UE_LOG(LogLyraExtTool, Display, TEXT("Found %d static meshes under %s"), Meshes.Num(), **PathString);
+
+	const FLyraMeshMaterialBatchEditResult Result = FLyraMeshMaterialBatchEdit::ChangeMeshMaterials(Meshes, Material);
+
+	// Make sure every async build has landed before the packages are written
+	FStaticMeshCompilingManager::Get().FinishAllCompilation();
+
+	if ((Result.NumChanged > 0) && !Switches.Contains(TEXT("NoSave")))
+	{
+		TArray<UPackage*> PackagesToSave;
+		for (UStaticMesh* Mesh : Meshes)
+		{
+			if (Mesh->GetPackage()->IsDirty())
+			{
+				PackagesToSave.Add(Mesh->GetPackage());
+			}
+		}
+
+		if (!UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, /*bOnlyDirty=*/ true))
+		{
+			UE_LOG(LogLyraExtTool, Error, TEXT("Failed to save some of the %d changed packages"), PackagesToSave.Num());
+			return 1;
+		}
+	}
+
+	UE_LOG(LogLyraExtTool, Display, TEXT("LyraChangeMeshMaterials changed %d meshes, skipped %d"), Result.NumChanged, Result.NumSkipped);
+	return Result.bCancelled ? 1 : 0;
+}
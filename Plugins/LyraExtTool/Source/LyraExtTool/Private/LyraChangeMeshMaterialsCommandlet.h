@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "LyraChangeMeshMaterialsCommandlet.generated.h"
+
+class UObject;
+
+/**
+ * Headless entry point for FLyraMeshMaterialBatchEdit, assigns one material to every static mesh in a folder.
+ *
+ * Usage: -run=LyraChangeMeshMaterials -Path=/Game/Some/Folder -Material=/Game/Some/M_Material [-NoRecursive] [-NoSave]
+ */
+UCLASS()
+class ULyraChangeMeshMaterialsCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	// Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet Interface
+};
@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogLyraExtTool);
+
 #define LOCTEXT_NAMESPACE "FLyraExtToolModule"
 
 void FLyraExtToolModule::StartupModule()
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraMeshMaterialBatchEdit.h"
+
+#include "Engine/StaticMesh.h"
+#include "LyraExtTool.h"
+#include "Misc/ScopedSlowTask.h"
+#include "StaticMeshResources.h"
+#include "UObject/UnrealType.h"
+
+#define LOCTEXT_NAMESPACE "LyraMeshMaterialBatchEdit"
+
+FLyraMeshMaterialBatchEditResult FLyraMeshMaterialBatchEdit::ChangeMeshMaterials(TConstArrayView<UStaticMesh*> Meshes, UMaterialInterface* Material)
+{
+	FLyraMeshMaterialBatchEditResult Result;
+
+	// Only touch meshes that actually change, so re-running an edit is cheap
+	TArray<UStaticMesh*> MeshesToEdit;
+	MeshesToEdit.Reserve(Meshes.Num());
+	for (UStaticMesh* Mesh : Meshes)
+	{
+		const bool bNeedsEdit = (Mesh != nullptr) && Mesh->GetStaticMaterials().ContainsByPredicate([Material](const FStaticMaterial& StaticMaterial)
+		{
+			return StaticMaterial.MaterialInterface != Material;
+		});
+
+		if (bNeedsEdit)
+		{
+			MeshesToEdit.AddUnique(Mesh);
+		}
+		else
+		{
+			++Result.NumSkipped;
+		}
+	}
+
+	if (MeshesToEdit.Num() == 0)
+	{
+		return Result;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// One unit of work per mesh for the edit and another for the build
+	FScopedSlowTask SlowTask((float)MeshesToEdit.Num() * 2.0f, LOCTEXT("ChangingMeshMaterials", "Changing mesh materials..."));
+	SlowTask.MakeDialog(/*bShowCancelButton=*/ true);
+
+	TArray<UStaticMesh*> EditedMeshes;
+	EditedMeshes.Reserve(MeshesToEdit.Num());
+	{
+		// Tear the render state of every component using these meshes down once for the whole batch,
+		// instead of once per mesh
+		FStaticMeshComponentRecreateRenderStateContext RecreateRenderStateContext(MeshesToEdit, /*InUnbuildLighting=*/ false, /*InRefreshBounds=*/ false);
+
+		for (UStaticMesh* Mesh : MeshesToEdit)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				Result.bCancelled = true;
+				break;
+			}
+			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("EditingMesh", "Editing {0}"), FText::FromName(Mesh->GetFName())));
+
+			Mesh->Modify();
+			for (FStaticMaterial& StaticMaterial : Mesh->GetStaticMaterials())
+			{
+				StaticMaterial.MaterialInterface = Material;
+			}
+			EditedMeshes.Add(Mesh);
+		}
+
+		// Rebuild everything that was edited, even when cancelled, so no mesh is left half updated
+		if (EditedMeshes.Num() > 0)
+		{
+			UStaticMesh::FBuildParameters BuildParameters;
+			BuildParameters.bInSilent = true;
+			BuildParameters.bInRebuildUVChannelData = false;
+			BuildParameters.bInEnforceLightmapRestrictions = false;
+
+			UStaticMesh::BatchBuild(EditedMeshes, BuildParameters, [&SlowTask](UStaticMesh* BuiltMesh)
+			{
+				SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("BuildingMesh", "Building {0}"), FText::FromName(BuiltMesh->GetFName())));
+				return true;
+			});
+		}
+	}
+
+	// Let editors and details panels know the material slots changed, without going through
+	// PostEditChange which would rebuild each mesh again
+	FProperty* StaticMaterialsProperty = FindFProperty<FProperty>(UStaticMesh::StaticClass(), UStaticMesh::GetStaticMaterialsName());
+	FPropertyChangedEvent PropertyChangedEvent(StaticMaterialsProperty, EPropertyChangeType::ValueSet);
+	for (UStaticMesh* Mesh : EditedMeshes)
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Broadcast(Mesh, PropertyChangedEvent);
+	}
+
+	Result.NumChanged = EditedMeshes.Num();
+	Result.NumSkipped += MeshesToEdit.Num() - EditedMeshes.Num();
+
+	UE_LOG(LogLyraExtTool, Log, TEXT("Changed materials on %d meshes (%d skipped%s) in %.2f s"),
+		Result.NumChanged, Result.NumSkipped, Result.bCancelled ? TEXT(", cancelled") : TEXT(""), FPlatformTime::Seconds() - StartTime);
+
+	return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
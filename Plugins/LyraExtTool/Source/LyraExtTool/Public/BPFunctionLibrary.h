@@ -20,6 +20,7 @@ class UBPFunctionLibrary : public UBlueprintFunctionLibrary
 {
     GENERATED_BODY()
 
+    // Assigns Material to every slot of the meshes, rebuilding them once as a batch. Returns false if cancelled.
     UFUNCTION(BlueprintCallable, Category="LyraExt")
     static bool ChangeMeshMaterials(TArray<UStaticMesh*> Mesh, UMaterialInterface* Material);
 };
@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include "Logging/LogMacros.h"
 #include "Modules/ModuleInterface.h"
 
+LYRAEXTTOOL_API DECLARE_LOG_CATEGORY_EXTERN(LogLyraExtTool, Log, All);
+
 class FLyraExtToolModule : public IModuleInterface
 {
 public:
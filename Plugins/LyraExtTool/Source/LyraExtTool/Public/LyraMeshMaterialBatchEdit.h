@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+
+class UMaterialInterface;
+class UStaticMesh;
+
+// Outcome of a batch material edit
+struct FLyraMeshMaterialBatchEditResult
+{
+	// Meshes that had at least one material slot reassigned (and were rebuilt)
+	int32 NumChanged = 0;
+
+	// Meshes that were null or already using the material in every slot
+	int32 NumSkipped = 0;
+
+	// True if the user cancelled before every mesh was edited, meshes edited up to that point are still rebuilt
+	bool bCancelled = false;
+};
+
+/**
+ * FLyraMeshMaterialBatchEdit
+ *
+ * Reassigns materials on many static meshes at once. Unlike calling Modify / PostEditChange on every
+ * mesh in turn, the render state of every component using one of the meshes is torn down once, all of
+ * the edits are applied, and then all changed meshes are rebuilt together through UStaticMesh::BatchBuild
+ * (which builds them in parallel when async static mesh compilation is enabled).
+ */
+class LYRAEXTTOOL_API FLyraMeshMaterialBatchEdit
+{
+public:
+	// Assigns Material to every material slot of Meshes, reporting progress and allowing cancellation
+	static FLyraMeshMaterialBatchEditResult ChangeMeshMaterials(TConstArrayView<UStaticMesh*> Meshes, UMaterialInterface* Material);
+};
@@ -41,6 +41,14 @@ void UPocketCapture::Deinitialize()
 {
 	CaptureComponent->UnregisterComponent();
 
+	GetThumbnailSystem()->CancelQueuedCaptures(this);
+
+	// Widgets may still display the render targets, so they are only pooled by ReleaseRenderTargets (which
+	// DestroyThumbnailRenderer calls), otherwise they are garbage collected once nothing references them anymore
+	DiffuseRT = nullptr;
+	AlphaMaskRT = nullptr;
+	EffectsRT = nullptr;
+
 	//UE_LOG(LogPocketLevels, Log, TEXT("ThumbnailRenderer: Deinitialize:%s"), *GetName());
 }
 
@@ -76,6 +84,18 @@ void UPocketCapture::SetRenderTargetSize(int32 Width, int32 Height)
 		{
 			EffectsRT->ResizeTarget(SurfaceWidth, SurfaceHeight);
 		}
+
+		// Resizing drops the contents of the render targets
+		EPocketCaptureFlags RecaptureFlags = EPocketCaptureFlags::None;
+		if (DiffuseRT)
+		{
+			RecaptureFlags |= EPocketCaptureFlags::Diffuse;
+		}
+		if (AlphaMaskRT)
+		{
+			RecaptureFlags |= EPocketCaptureFlags::AlphaMask;
+		}
+		GetThumbnailSystem()->QueueCapture(this, RecaptureFlags);
 	}
 
 	//UE_LOG(LogPocketLevels, Log, TEXT("ThumbnailRenderer: SetRenderTargetSize:%dx%d"), Width, Height);
@@ -85,10 +105,7 @@ UTextureRenderTarget2D* UPocketCapture::GetOrCreateDiffuseRenderTarget()
 {
 	if (DiffuseRT == nullptr)
 	{
-		DiffuseRT = NewObject<UTextureRenderTarget2D>(this, TEXT("ThumbnailRenderer_Diffuse"));
-		DiffuseRT->RenderTargetFormat = RTF_RGBA8;
-		DiffuseRT->InitAutoFormat(SurfaceWidth, SurfaceHeight);
-		DiffuseRT->UpdateResourceImmediate(true);
+		DiffuseRT = GetThumbnailSystem()->AcquireRenderTarget(SurfaceWidth, SurfaceHeight, RTF_RGBA8);
 	}
 
 	return DiffuseRT;
@@ -98,10 +115,7 @@ UTextureRenderTarget2D* UPocketCapture::GetOrCreateAlphaMaskRenderTarget()
 {
 	if (AlphaMaskRT == nullptr)
 	{
-		AlphaMaskRT = NewObject<UTextureRenderTarget2D>(this, TEXT("ThumbnailRenderer_AlphaMask"));
-		AlphaMaskRT->RenderTargetFormat = RTF_R8;
-		AlphaMaskRT->InitAutoFormat(SurfaceWidth, SurfaceHeight);
-		AlphaMaskRT->UpdateResourceImmediate(true);
+		AlphaMaskRT = GetThumbnailSystem()->AcquireRenderTarget(SurfaceWidth, SurfaceHeight, RTF_R8);
 	}
 
 	return AlphaMaskRT;
@@ -111,10 +125,7 @@ UTextureRenderTarget2D* UPocketCapture::GetOrCreateEffectsRenderTarget()
 {
 	if (EffectsRT == nullptr)
 	{
-		EffectsRT = NewObject<UTextureRenderTarget2D>(this, TEXT("ThumbnailRenderer_Fx"));
-		EffectsRT->RenderTargetFormat = RTF_R8;
-		EffectsRT->InitAutoFormat(SurfaceWidth, SurfaceHeight);
-		EffectsRT->UpdateResourceImmediate(true);
+		EffectsRT = GetThumbnailSystem()->AcquireRenderTarget(SurfaceWidth, SurfaceHeight, RTF_R8);
 	}
 
 	return EffectsRT;
@@ -125,6 +136,11 @@ void UPocketCapture::SetCaptureTarget(AActor* InCaptureTarget)
 	CaptureTargetPtr = InCaptureTarget;
 
 	OnCaptureTargetChanged(InCaptureTarget);
+
+	if (InCaptureTarget)
+	{
+		RequestCaptureDiffuse();
+	}
 }
 
 void UPocketCapture::SetAlphaMaskedActors(const TArray<AActor*>& InCaptureTargets)
@@ -135,6 +151,45 @@ void UPocketCapture::SetAlphaMaskedActors(const TArray<AActor*>& InCaptureTarget
 	{
 		AlphaMaskActorPtrs.Add(CaptureTarget);
 	}
+
+	if (AlphaMaskActorPtrs.Num() > 0)
+	{
+		RequestCaptureAlphaMask();
+	}
+}
+
+void UPocketCapture::RequestCaptureDiffuse()
+{
+	GetThumbnailSystem()->QueueCapture(this, EPocketCaptureFlags::Diffuse);
+}
+
+void UPocketCapture::RequestCaptureAlphaMask()
+{
+	GetThumbnailSystem()->QueueCapture(this, EPocketCaptureFlags::AlphaMask);
+}
+
+void UPocketCapture::ReleaseRenderTargets()
+{
+	UPocketCaptureSubsystem* CaptureSubsystem = GetThumbnailSystem();
+	CaptureSubsystem->CancelQueuedCaptures(this);
+
+	if (DiffuseRT)
+	{
+		CaptureSubsystem->ReleaseRenderTarget(DiffuseRT);
+		DiffuseRT = nullptr;
+	}
+
+	if (AlphaMaskRT)
+	{
+		CaptureSubsystem->ReleaseRenderTarget(AlphaMaskRT);
+		AlphaMaskRT = nullptr;
+	}
+
+	if (EffectsRT)
+	{
+		CaptureSubsystem->ReleaseRenderTarget(EffectsRT);
+		EffectsRT = nullptr;
+	}
 }
 
 UPocketCaptureSubsystem* UPocketCapture::GetThumbnailSystem() const
@@ -277,6 +332,9 @@ bool UPocketCapture::CaptureScene(UTextureRenderTarget2D* InRenderTarget, const
 
 void UPocketCapture::CaptureDiffuse()
 {
+	// Rendered now, no need to render it again if it was queued
+	GetThumbnailSystem()->CancelQueuedCaptures(this, EPocketCaptureFlags::Diffuse);
+
 	if (UTextureRenderTarget2D* RenderTarget = GetOrCreateDiffuseRenderTarget())
 	{
 		TArray<AActor*> CaptureActors;
@@ -292,6 +350,8 @@ void UPocketCapture::CaptureDiffuse()
 
 void UPocketCapture::CaptureAlphaMask()
 {
+	GetThumbnailSystem()->CancelQueuedCaptures(this, EPocketCaptureFlags::AlphaMask);
+
 	if (UTextureRenderTarget2D* RenderTarget = GetOrCreateAlphaMaskRenderTarget())
 	{
 		TArray<AActor*> CaptureActors;
@@ -3,12 +3,31 @@
 #include "PocketCaptureSubsystem.h"
 
 #include "Components/PrimitiveComponent.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/IConsoleManager.h"
 #include "PocketCapture.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(PocketCaptureSubsystem)
 
 class FSubsystemCollectionBase;
 
+namespace PocketCaptureCVars
+{
+	static int32 MaxSceneCapturesPerFrame = 2;
+	static FAutoConsoleVariableRef CVarMaxSceneCapturesPerFrame(
+		TEXT("PocketWorlds.MaxSceneCapturesPerFrame"),
+		MaxSceneCapturesPerFrame,
+		TEXT("Maximum number of queued pocket captures (diffuse or alpha mask) rendered per frame (<= 0 means no limit)"),
+		ECVF_Default);
+
+	static int32 MaxPooledRenderTargets = 8;
+	static FAutoConsoleVariableRef CVarMaxPooledRenderTargets(
+		TEXT("PocketWorlds.MaxPooledRenderTargets"),
+		MaxPooledRenderTargets,
+		TEXT("Maximum number of render targets kept around for reuse once pocket captures release them"),
+		ECVF_Default);
+}
+
 // UPocketCaptureSubsystem
 //---------------------------------------------------------------------------------
 
@@ -34,6 +53,8 @@ void UPocketCaptureSubsystem::Deinitialize()
 	}
 
 	ThumbnailRenderers.Reset();
+	QueuedCaptures.Reset();
+	PooledRenderTargets.Reset();
 }
 
 UPocketCapture* UPocketCaptureSubsystem::CreateThumbnailRenderer(TSubclassOf<UPocketCapture> ThumbnailRendererClass)
@@ -63,6 +84,7 @@ void UPocketCaptureSubsystem::DestroyThumbnailRenderer(UPocketCapture* Thumbnail
 		if (ThumbnailIndex != INDEX_NONE)
 		{
 			ThumbnailRenderers[ThumbnailIndex] = nullptr;
+			ThumbnailRenderer->ReleaseRenderTargets();
 			ThumbnailRenderer->Deinitialize();
 		}
 	}
@@ -79,10 +101,146 @@ void UPocketCaptureSubsystem::StreamThisFrame(TArray<UPrimitiveComponent*>& Prim
 	StreamNextFrame.Append(PrimitiveComponents);
 }
 
+UTextureRenderTarget2D* UPocketCaptureSubsystem::AcquireRenderTarget(int32 Width, int32 Height, ETextureRenderTargetFormat Format)
+{
+	for (int32 PoolIndex = PooledRenderTargets.Num() - 1; PoolIndex >= 0; PoolIndex--)
+	{
+		UTextureRenderTarget2D* RenderTarget = PooledRenderTargets[PoolIndex];
+		if (RenderTarget && (RenderTarget->SizeX == Width) && (RenderTarget->SizeY == Height) && (RenderTarget->RenderTargetFormat == Format))
+		{
+			PooledRenderTargets.RemoveAtSwap(PoolIndex, 1, EAllowShrinking::No);
+
+			// The previous user may have released the resource (see UPocketCapture::ReleaseResources)
+			if (RenderTarget->GetResource() == nullptr)
+			{
+				RenderTarget->UpdateResource();
+			}
+
+			// Don't show whatever the previous user captured into it
+			RenderTarget->UpdateResourceImmediate(true);
+			return RenderTarget;
+		}
+	}
+
+	UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>(this);
+	RenderTarget->RenderTargetFormat = Format;
+	RenderTarget->InitAutoFormat(Width, Height);
+	RenderTarget->UpdateResourceImmediate(true);
+
+	return RenderTarget;
+}
+
+void UPocketCaptureSubsystem::ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget)
+{
+	if (RenderTarget == nullptr)
+	{
+		return;
+	}
+
+	if (PooledRenderTargets.Num() < PocketCaptureCVars::MaxPooledRenderTargets)
+	{
+		PooledRenderTargets.AddUnique(RenderTarget);
+	}
+	else
+	{
+		// Pool is full, let it be garbage collected
+		RenderTarget->ReleaseResource();
+	}
+}
+
+void UPocketCaptureSubsystem::QueueCapture(UPocketCapture* Capture, EPocketCaptureFlags Flags)
+{
+	if ((Capture == nullptr) || (Flags == EPocketCaptureFlags::None))
+	{
+		return;
+	}
+
+	for (FQueuedCapture& QueuedCapture : QueuedCaptures)
+	{
+		if (QueuedCapture.Capture == Capture)
+		{
+			QueuedCapture.Flags |= Flags;
+			return;
+		}
+	}
+
+	FQueuedCapture& QueuedCapture = QueuedCaptures.AddDefaulted_GetRef();
+	QueuedCapture.Capture = Capture;
+	QueuedCapture.Flags = Flags;
+}
+
+void UPocketCaptureSubsystem::CancelQueuedCaptures(UPocketCapture* Capture)
+{
+	QueuedCaptures.RemoveAll([Capture](const FQueuedCapture& QueuedCapture) { return QueuedCapture.Capture == Capture; });
+}
+
+void UPocketCaptureSubsystem::CancelQueuedCaptures(UPocketCapture* Capture, EPocketCaptureFlags Flags)
+{
+	// Only clears the flags, this can be called while ProcessQueuedCaptures iterates the queue and entries left
+	// without flags are removed as completed
+	for (FQueuedCapture& QueuedCapture : QueuedCaptures)
+	{
+		if (QueuedCapture.Capture == Capture)
+		{
+			EnumRemoveFlags(QueuedCapture.Flags, Flags);
+			return;
+		}
+	}
+}
+
+int32 UPocketCaptureSubsystem::ProcessQueuedCaptures(int32 MaxSceneCaptures)
+{
+	int32 NumSceneCaptures = 0;
+	int32 NumCompletedEntries = 0;
+
+	for (FQueuedCapture& QueuedCapture : QueuedCaptures)
+	{
+		UPocketCapture* Capture = QueuedCapture.Capture.Get();
+		if (Capture == nullptr)
+		{
+			NumCompletedEntries++;
+			continue;
+		}
+
+		if (EnumHasAnyFlags(QueuedCapture.Flags, EPocketCaptureFlags::Diffuse) && ((MaxSceneCaptures <= 0) || (NumSceneCaptures < MaxSceneCaptures)))
+		{
+			Capture->CaptureDiffuse();
+			EnumRemoveFlags(QueuedCapture.Flags, EPocketCaptureFlags::Diffuse);
+			NumSceneCaptures++;
+		}
+
+		if (EnumHasAnyFlags(QueuedCapture.Flags, EPocketCaptureFlags::AlphaMask) && ((MaxSceneCaptures <= 0) || (NumSceneCaptures < MaxSceneCaptures)))
+		{
+			Capture->CaptureAlphaMask();
+			EnumRemoveFlags(QueuedCapture.Flags, EPocketCaptureFlags::AlphaMask);
+			NumSceneCaptures++;
+		}
+
+		if (QueuedCapture.Flags != EPocketCaptureFlags::None)
+		{
+			// Out of budget, the rest waits for the next frame
+			break;
+		}
+
+		NumCompletedEntries++;
+	}
+
+	// Completed entries are always at the front of the queue
+	QueuedCaptures.RemoveAt(0, NumCompletedEntries, EAllowShrinking::No);
+
+	return NumSceneCaptures;
+}
+
 bool UPocketCaptureSubsystem::Tick(float DeltaTime)
 {
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_URealTimeThumbnailSubsystem_Tick);
 
+	// Render the queued captures first, so the primitives they stream are kept streaming below
+	if (QueuedCaptures.Num() > 0)
+	{
+		ProcessQueuedCaptures(PocketCaptureCVars::MaxSceneCapturesPerFrame);
+	}
+
 	for (TWeakObjectPtr<UPrimitiveComponent> PrimitiveComponent : StreamedLastFrameButNotNext)
 	{
 		if (PrimitiveComponent.IsValid())
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "PocketCaptureSubsystem.h"
+#include "PocketTestCapture.h"
+
+namespace PocketCaptureTests
+{
+	// A world that lives for the scope of a test, so its pocket capture subsystem can be used without loading a map
+	struct FScopedTestWorld
+	{
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/ false);
+		}
+
+		~FScopedTestWorld()
+		{
+			World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+		}
+
+		UWorld* World = nullptr;
+	};
+}
+
+// Acquires, releases and reacquires render targets through the pocket capture subsystem and checks that released
+// targets are reused when their size and format match, that the pool is capped, and that destroying a capture returns
+// its targets to the pool (runs with -NullRHI)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPocketCaptureRenderTargetPoolTest, "PocketWorlds.Capture.RenderTargetPool", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FPocketCaptureRenderTargetPoolTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* MaxPooledCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("PocketWorlds.MaxPooledRenderTargets"));
+	if (!TestNotNull(TEXT("Max pooled render targets cvar"), MaxPooledCVar))
+	{
+		return false;
+	}
+
+	PocketCaptureTests::FScopedTestWorld TestWorld;
+	UPocketCaptureSubsystem* Subsystem = TestWorld.World->GetSubsystem<UPocketCaptureSubsystem>();
+	if (!TestNotNull(TEXT("Pocket capture subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	const int32 PreviousMaxPooled = MaxPooledCVar->GetInt();
+	MaxPooledCVar->Set(2, ECVF_SetByCode);
+
+	UTextureRenderTarget2D* First = Subsystem->AcquireRenderTarget(64, 64, RTF_RGBA8);
+	UTextureRenderTarget2D* Second = Subsystem->AcquireRenderTarget(64, 64, RTF_RGBA8);
+	TestNotNull(TEXT("First render target"), First);
+	TestTrue(TEXT("Render targets in use are not shared"), First != Second);
+	TestEqual(TEXT("Pooled render targets while in use"), Subsystem->GetNumPooledRenderTargets(), 0);
+
+	// Released targets are reused for the same size and format only
+	Subsystem->ReleaseRenderTarget(First);
+	TestEqual(TEXT("Pooled render targets after a release"), Subsystem->GetNumPooledRenderTargets(), 1);
+
+	UTextureRenderTarget2D* OtherFormat = Subsystem->AcquireRenderTarget(64, 64, RTF_R8);
+	TestTrue(TEXT("Different format not reused"), OtherFormat != First);
+	UTextureRenderTarget2D* OtherSize = Subsystem->AcquireRenderTarget(128, 64, RTF_RGBA8);
+	TestTrue(TEXT("Different size not reused"), OtherSize != First);
+	TestEqual(TEXT("Pooled render targets after mismatched acquires"), Subsystem->GetNumPooledRenderTargets(), 1);
+
+	UTextureRenderTarget2D* Reused = Subsystem->AcquireRenderTarget(64, 64, RTF_RGBA8);
+	TestEqual(TEXT("Matching render target reused"), Reused, First);
+	TestNotNull(TEXT("Reused render target has a resource"), Reused->GetResource());
+	TestEqual(TEXT("Pooled render targets after reuse"), Subsystem->GetNumPooledRenderTargets(), 0);
+
+	// A resource released by its previous user is recreated
+	Reused->ReleaseResource();
+	Subsystem->ReleaseRenderTarget(Reused);
+	UTextureRenderTarget2D* Recreated = Subsystem->AcquireRenderTarget(64, 64, RTF_RGBA8);
+	TestEqual(TEXT("Render target with a released resource reused"), Recreated, Reused);
+	TestNotNull(TEXT("Released resource recreated"), Recreated->GetResource());
+
+	// The pool is capped
+	Subsystem->ReleaseRenderTarget(Recreated);
+	Subsystem->ReleaseRenderTarget(Second);
+	Subsystem->ReleaseRenderTarget(OtherFormat);
+	Subsystem->ReleaseRenderTarget(OtherSize);
+	TestEqual(TEXT("Pooled render targets at the cap"), Subsystem->GetNumPooledRenderTargets(), 2);
+
+	// Destroying a capture returns its render targets, and a new capture picks them up
+	UPocketTestCapture* Capture = CastChecked<UPocketTestCapture>(Subsystem->CreateThumbnailRenderer(UPocketTestCapture::StaticClass()));
+	MaxPooledCVar->Set(8, ECVF_SetByCode);
+	Capture->SetRenderTargetSize(32, 32);
+	UTextureRenderTarget2D* CaptureDiffuseRT = Capture->GetOrCreateDiffuseRenderTarget();
+	UTextureRenderTarget2D* CaptureAlphaMaskRT = Capture->GetOrCreateAlphaMaskRenderTarget();
+	const int32 NumPooledBeforeDestroy = Subsystem->GetNumPooledRenderTargets();
+
+	Subsystem->DestroyThumbnailRenderer(Capture);
+	TestEqual(TEXT("Pooled render targets after destroying a capture"), Subsystem->GetNumPooledRenderTargets(), NumPooledBeforeDestroy + 2);
+
+	UPocketTestCapture* NextCapture = CastChecked<UPocketTestCapture>(Subsystem->CreateThumbnailRenderer(UPocketTestCapture::StaticClass()));
+	NextCapture->SetRenderTargetSize(32, 32);
+	TestEqual(TEXT("Next capture reuses the diffuse render target"), NextCapture->GetOrCreateDiffuseRenderTarget(), CaptureDiffuseRT);
+	TestEqual(TEXT("Next capture reuses the alpha mask render target"), NextCapture->GetOrCreateAlphaMaskRenderTarget(), CaptureAlphaMaskRT);
+	Subsystem->DestroyThumbnailRenderer(NextCapture);
+
+	MaxPooledCVar->Set(PreviousMaxPooled, ECVF_SetByCode);
+
+	return true;
+}
+
+// Queues diffuse and alpha mask captures for several pocket captures and checks that each call to
+// ProcessQueuedCaptures renders at most its budget, in request order, merging repeated requests and skipping
+// captures that were already rendered or destroyed (runs with -NullRHI)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPocketCaptureQueueBudgetTest, "PocketWorlds.Capture.QueueBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FPocketCaptureQueueBudgetTest::RunTest(const FString& Parameters)
+{
+	const int32 NumCaptures = 5;
+	const int32 Budget = 3;
+
+	PocketCaptureTests::FScopedTestWorld TestWorld;
+	UPocketCaptureSubsystem* Subsystem = TestWorld.World->GetSubsystem<UPocketCaptureSubsystem>();
+	if (!TestNotNull(TEXT("Pocket capture subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	TArray<UPocketTestCapture*> Captures;
+	for (int32 CaptureIndex = 0; CaptureIndex < NumCaptures; ++CaptureIndex)
+	{
+		UPocketTestCapture* Capture = CastChecked<UPocketTestCapture>(Subsystem->CreateThumbnailRenderer(UPocketTestCapture::StaticClass()));
+		Capture->SetRenderTargetSize(16, 16);
+		Capture->RequestCaptureDiffuse();
+		Capture->RequestCaptureAlphaMask();
+		Capture->RequestCaptureDiffuse();
+		Captures.Add(Capture);
+	}
+	TestEqual(TEXT("Repeated requests merged"), Subsystem->GetNumQueuedCaptures(), NumCaptures);
+
+	// 10 scene captures with a budget of 3: 3, 3, 3 then 1
+	TestEqual(TEXT("First frame scene captures"), Subsystem->ProcessQueuedCapturesForTesting(Budget), Budget);
+	TestTrue(TEXT("First capture fully rendered"), Captures[0]->HasDiffuseRenderTarget() && Captures[0]->HasAlphaMaskRenderTarget());
+	TestTrue(TEXT("Second capture diffuse rendered"), Captures[1]->HasDiffuseRenderTarget());
+	TestFalse(TEXT("Second capture alpha mask waits"), Captures[1]->HasAlphaMaskRenderTarget());
+	TestFalse(TEXT("Third capture waits"), Captures[2]->HasDiffuseRenderTarget());
+	TestEqual(TEXT("Queued after the first frame"), Subsystem->GetNumQueuedCaptures(), NumCaptures - 1);
+
+	TestEqual(TEXT("Second frame scene captures"), Subsystem->ProcessQueuedCapturesForTesting(Budget), Budget);
+	TestTrue(TEXT("Second capture alpha mask rendered"), Captures[1]->HasAlphaMaskRenderTarget());
+	TestTrue(TEXT("Third capture fully rendered"), Captures[2]->HasDiffuseRenderTarget() && Captures[2]->HasAlphaMaskRenderTarget());
+	TestEqual(TEXT("Queued after the second frame"), Subsystem->GetNumQueuedCaptures(), 2);
+
+	// Rendering immediately drops the queued request, destroying a capture drops all of its requests
+	Captures[3]->CaptureDiffuse();
+	Subsystem->DestroyThumbnailRenderer(Captures[4]);
+	TestEqual(TEXT("Third frame scene captures"), Subsystem->ProcessQueuedCapturesForTesting(Budget), 1);
+	TestTrue(TEXT("Fourth capture alpha mask rendered"), Captures[3]->HasAlphaMaskRenderTarget());
+	TestEqual(TEXT("Queue empty"), Subsystem->GetNumQueuedCaptures(), 0);
+	TestEqual(TEXT("Nothing left to render"), Subsystem->ProcessQueuedCapturesForTesting(Budget), 0);
+
+	// No budget renders everything at once
+	for (int32 CaptureIndex = 0; CaptureIndex < NumCaptures - 1; ++CaptureIndex)
+	{
+		Captures[CaptureIndex]->RequestCaptureDiffuse();
+		Captures[CaptureIndex]->RequestCaptureAlphaMask();
+	}
+	TestEqual(TEXT("Unlimited budget scene captures"), Subsystem->ProcessQueuedCapturesForTesting(0), (NumCaptures - 1) * 2);
+	TestEqual(TEXT("Queue empty with an unlimited budget"), Subsystem->GetNumQueuedCaptures(), 0);
+
+	// Resizing drops the contents of the render targets, so they are captured again
+	Captures[0]->SetRenderTargetSize(32, 32);
+	TestEqual(TEXT("Resized capture queued"), Subsystem->GetNumQueuedCaptures(), 1);
+	TestEqual(TEXT("Resized capture scene captures"), Subsystem->ProcessQueuedCapturesForTesting(Budget), 2);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Build.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PocketCapture.h"
+
+#include "PocketTestCapture.generated.h"
+
+/**
+ * Concrete pocket capture used by automation tests, without any capture target or materials
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class UPocketTestCapture : public UPocketCapture
+{
+	GENERATED_BODY()
+
+public:
+	bool HasDiffuseRenderTarget() const { return DiffuseRT != nullptr; }
+	bool HasAlphaMaskRenderTarget() const { return AlphaMaskRT != nullptr; }
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -41,9 +41,11 @@ public:
 	UFUNCTION(BlueprintCallable)
 	UTextureRenderTarget2D* GetOrCreateEffectsRenderTarget();
 
+	// Sets the actor whose camera is used for the captures, and queues a diffuse capture of it
 	UFUNCTION(BlueprintCallable)
 	void SetCaptureTarget(AActor* InCaptureTarget);
 
+	// Sets the actors rendered into the alpha mask, and queues an alpha mask capture of them
 	UFUNCTION(BlueprintCallable)
 	void SetAlphaMaskedActors(const TArray<AActor*>& InCaptureTarget);
 
@@ -56,12 +58,25 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void CaptureEffects();
 
+	// Queues a diffuse capture with the subsystem, which renders queued captures within a per-frame budget
+	UFUNCTION(BlueprintCallable)
+	void RequestCaptureDiffuse();
+
+	// Queues an alpha mask capture with the subsystem, which renders queued captures within a per-frame budget
+	UFUNCTION(BlueprintCallable)
+	void RequestCaptureAlphaMask();
+
 	UFUNCTION(BlueprintCallable)
 	virtual void ReleaseResources();
 
 	UFUNCTION(BlueprintCallable)
 	virtual void ReclaimResources();
 
+	// Returns the render targets to the subsystem pool so other captures can reuse them. Only call this once nothing
+	// displays them anymore (e.g. after clearing the brushes that use them), they are recreated on the next capture
+	UFUNCTION(BlueprintCallable)
+	void ReleaseRenderTargets();
+
 	UFUNCTION(BlueprintCallable)
 	int32 GetRendererIndex() const;
 	
@@ -73,7 +88,7 @@ protected:
 
 protected:
 	TArray<UPrimitiveComponent*> GatherPrimitivesForCapture(const TArray<AActor*>& InCaptureActors) const;
-	
+
 	UPocketCaptureSubsystem* GetThumbnailSystem() const;
 
 protected:
@@ -9,12 +9,23 @@
 
 template <typename T> class TSubclassOf;
 
+enum ETextureRenderTargetFormat : int;
+
 class FSubsystemCollectionBase;
 class UObject;
 class UPocketCapture;
 class UPrimitiveComponent;
+class UTextureRenderTarget2D;
 struct FFrame;
 
+enum class EPocketCaptureFlags : uint8
+{
+	None = 0,
+	Diffuse = 1 << 0,
+	AlphaMask = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EPocketCaptureFlags);
+
 UCLASS(BlueprintType)
 class POCKETWORLDS_API UPocketCaptureSubsystem : public UWorldSubsystem
 {
@@ -31,19 +42,62 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DeterminesOutputType = "PocketCaptureClass"))
 	UPocketCapture* CreateThumbnailRenderer(TSubclassOf<UPocketCapture> PocketCaptureClass);
 
+	// Destroys a capture made with CreateThumbnailRenderer and returns its render targets to the pool, so whoever
+	// displays them (e.g. the owning widget, from its Destruct) must have stopped doing so
 	UFUNCTION(BlueprintCallable)
 	void DestroyThumbnailRenderer(UPocketCapture* ThumbnailRenderer);
 
 	void StreamThisFrame(TArray<UPrimitiveComponent*>& PrimitiveComponents);
 
+	// Returns a render target of the given size and format, reusing one released by another capture if possible
+	UTextureRenderTarget2D* AcquireRenderTarget(int32 Width, int32 Height, ETextureRenderTargetFormat Format);
+
+	// Returns a render target to the pool, it must not be used or displayed by anyone anymore
+	void ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget);
+
+	int32 GetNumPooledRenderTargets() const { return PooledRenderTargets.Num(); }
+
+	// Queues captures to be rendered during the next ticks, within the per-frame capture budget
+	// Requesting the same capture multiple times before it is rendered only renders it once
+	void QueueCapture(UPocketCapture* Capture, EPocketCaptureFlags Flags);
+
+	// Removes any queued captures for the capture
+	void CancelQueuedCaptures(UPocketCapture* Capture);
+
+	// Removes the given queued captures for the capture, e.g. because it was just rendered immediately
+	void CancelQueuedCaptures(UPocketCapture* Capture, EPocketCaptureFlags Flags);
+
+	int32 GetNumQueuedCaptures() const { return QueuedCaptures.Num(); }
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets tests render queued captures with a given budget without ticking the core ticker
+	int32 ProcessQueuedCapturesForTesting(int32 MaxSceneCaptures) { return ProcessQueuedCaptures(MaxSceneCaptures); }
+#endif
+
 protected:
 	bool Tick(float DeltaTime);
 
+	// Renders queued captures until the per-frame budget is used up, returns the number of scene captures rendered
+	int32 ProcessQueuedCaptures(int32 MaxSceneCaptures);
+
 	TArray<TWeakObjectPtr<UPrimitiveComponent>> StreamNextFrame;
 	TArray<TWeakObjectPtr<UPrimitiveComponent>> StreamedLastFrameButNotNext;
 
 private:
 	TArray<TWeakObjectPtr<UPocketCapture>> ThumbnailRenderers;
 
+	// Render targets explicitly released by captures, available for reuse
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTextureRenderTarget2D>> PooledRenderTargets;
+
+	struct FQueuedCapture
+	{
+		TWeakObjectPtr<UPocketCapture> Capture;
+		EPocketCaptureFlags Flags = EPocketCaptureFlags::None;
+	};
+
+	// Captures waiting to be rendered, in request order
+	TArray<FQueuedCapture> QueuedCaptures;
+
 	FTSTicker::FDelegateHandle TickHandle;
 };
@@ -6,6 +6,7 @@
 #include "AbilitySystem/LyraGameplayEffectContext.h"
 #include "AbilitySystem/LyraAbilitySourceInterface.h"
 #include "Engine/World.h"
+#include "LyraGameplayTags.h"
 #include "Teams/LyraTeamSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraDamageExecution)
@@ -96,35 +97,45 @@ void ULyraDamageExecution::Execute_Implementation(const FGameplayEffectCustomExe
 		}
 	}
 
-	// Determine distance
-	double Distance = WORLD_MAX;
-
-	if (TypedContext->HasOrigin())
-	{
-		Distance = FVector::Dist(TypedContext->GetOrigin(), ImpactLocation);
-	}
-	else if (EffectCauser)
+	// Damage batched by ULyraGameplayAbility_RangedWeapon::ApplyBatchedDamageToTargets comes with the
+	// attenuation of all of its hits already resolved and summed up, so only the per-target work is left
+	float PhysicalMaterialAttenuation = 1.0f;
+	float DistanceAttenuation = 1.0f;
+	const float BatchedAttenuation = Spec.GetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_DamageAttenuation, /*WarnIfNotFound=*/ false, /*DefaultIfNotFound=*/ -1.0f);
+	if (BatchedAttenuation >= 0.0f)
 	{
-		Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
+		DistanceAttenuation = BatchedAttenuation;
 	}
 	else
 	{
-		ensureMsgf(false, TEXT("Damage Calculation cannot deduce a source location for damage coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(Spec.Def));
-	}
+		// Determine distance
+		double Distance = WORLD_MAX;
 
-	// Apply ability source modifiers
-	float PhysicalMaterialAttenuation = 1.0f;
-	float DistanceAttenuation = 1.0f;
-	if (const ILyraAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
-	{
-		if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+		if (TypedContext->HasOrigin())
+		{
+			Distance = FVector::Dist(TypedContext->GetOrigin(), ImpactLocation);
+		}
+		else if (EffectCauser)
+		{
+			Distance = FVector::Dist(EffectCauser->GetActorLocation(), ImpactLocation);
+		}
+		else
 		{
-			PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+			ensureMsgf(false, TEXT("Damage Calculation cannot deduce a source location for damage coming from %s; Falling back to WORLD_MAX dist!"), *GetPathNameSafe(Spec.Def));
 		}
 
-		DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
+		// Apply ability source modifiers
+		if (const ILyraAbilitySourceInterface* AbilitySource = TypedContext->GetAbilitySource())
+		{
+			if (const UPhysicalMaterial* PhysMat = TypedContext->GetPhysicalMaterial())
+			{
+				PhysicalMaterialAttenuation = AbilitySource->GetPhysicalMaterialAttenuation(PhysMat, SourceTags, TargetTags);
+			}
+
+			DistanceAttenuation = AbilitySource->GetDistanceAttenuation(Distance, SourceTags, TargetTags);
+		}
+		DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
 	}
-	DistanceAttenuation = FMath::Max(DistanceAttenuation, 0.0f);
 
 	// Clamping is done when damage is converted to -health
 	const float DamageDone = FMath::Max(BaseDamage * DistanceAttenuation * PhysicalMaterialAttenuation * DamageInteractionAllowedMultiplier, 0.0f);
@@ -4,9 +4,12 @@
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
+#include "AbilitySystemGlobals.h"
 #include "Animation/LyraAnimInstance.h"
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "LyraGameplayTags.h"
 #include "LyraGlobalAbilitySystem.h"
 #include "LyraLogChannels.h"
 #include "System/LyraAssetManager.h"
@@ -16,6 +19,23 @@
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_AbilityInputBlocked, "Gameplay.AbilityInputBlocked");
 
+namespace LyraAbilitySystemCVars
+{
+	static bool bBatchAbilityRPCs = true;
+	static FAutoConsoleVariableRef CVarBatchAbilityRPCs(
+		TEXT("Lyra.AbilitySystem.BatchAbilityRPCs"),
+		bBatchAbilityRPCs,
+		TEXT("If true, input activated abilities batch their activate, target data and end RPCs to the server into a single RPC when possible"),
+		ECVF_Default);
+
+	static bool bIndexInputTags = true;
+	static FAutoConsoleVariableRef CVarIndexInputTags(
+		TEXT("Lyra.AbilitySystem.IndexInputTags"),
+		bIndexInputTags,
+		TEXT("If true, abilities for an input tag are found through a per-tag index instead of scanning every activatable ability"),
+		ECVF_Default);
+}
+
 ULyraAbilitySystemComponent::ULyraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -191,36 +211,133 @@ void ULyraAbilitySystemComponent::AbilitySpecInputReleased(FGameplayAbilitySpec&
 	}
 }
 
-void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
 {
-	if (InputTag.IsValid())
+	Super::OnGiveAbility(AbilitySpec);
+
+	AddToInputTagIndex(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	RemoveFromInputTagIndex(AbilitySpec.Handle);
+
+	InputPressedSpecHandles.Remove(AbilitySpec.Handle);
+	InputReleasedSpecHandles.Remove(AbilitySpec.Handle);
+	InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void ULyraAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Added and removed specs went through OnGiveAbility and OnRemoveAbility, but a spec's ability may have resolved
+	// or its dynamic ability tags changed since then
+	for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		RefreshInputTagIndex(AbilitySpec);
+	}
+}
+
+void ULyraAbilitySystemComponent::AddToInputTagIndex(const FGameplayAbilitySpec& AbilitySpec)
+{
+	if (AbilitySpec.Ability)
+	{
+		for (const FGameplayTag& Tag : AbilitySpec.DynamicAbilityTags)
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
+			InputTagToSpecHandles.FindOrAdd(Tag).AddUnique(AbilitySpec.Handle);
+		}
+
+		InputTagIndexedSpecs.Add(AbilitySpec.Handle, AbilitySpec.DynamicAbilityTags);
+	}
+}
+
+void ULyraAbilitySystemComponent::RemoveFromInputTagIndex(const FGameplayAbilitySpecHandle& Handle)
+{
+	FGameplayTagContainer IndexedTags;
+	if (InputTagIndexedSpecs.RemoveAndCopyValue(Handle, /*out*/ IndexedTags))
+	{
+		for (const FGameplayTag& Tag : IndexedTags)
+		{
+			if (TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagToSpecHandles.Find(Tag))
 			{
-				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+				SpecHandles->RemoveSingle(Handle);
 			}
 		}
 	}
 }
 
-void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
+void ULyraAbilitySystemComponent::RefreshInputTagIndex(const FGameplayAbilitySpec& AbilitySpec)
 {
-	if (InputTag.IsValid())
+	const FGameplayTagContainer* IndexedTags = InputTagIndexedSpecs.Find(AbilitySpec.Handle);
+	const bool bIsIndexed = (IndexedTags != nullptr);
+	const bool bShouldBeIndexed = (AbilitySpec.Ability != nullptr);
+
+	if ((bIsIndexed != bShouldBeIndexed) || (bIsIndexed && (*IndexedTags != AbilitySpec.DynamicAbilityTags)))
+	{
+		RemoveFromInputTagIndex(AbilitySpec.Handle);
+		AddToInputTagIndex(AbilitySpec);
+	}
+}
+
+void ULyraAbilitySystemComponent::GatherSpecHandlesWithInputTag(const FGameplayTag& InputTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>>& OutSpecHandles)
+{
+	if (LyraAbilitySystemCVars::bIndexInputTags)
+	{
+		if (const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagToSpecHandles.Find(InputTag))
+		{
+			OutSpecHandles.Append(*SpecHandles);
+		}
+	}
+	else
 	{
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
 		{
 			if (AbilitySpec.Ability && (AbilitySpec.DynamicAbilityTags.HasTagExact(InputTag)))
 			{
-				InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+				OutSpecHandles.Add(AbilitySpec.Handle);
 			}
 		}
 	}
 }
 
+bool ULyraAbilitySystemComponent::ShouldDoServerAbilityRPCBatch() const
+{
+	return LyraAbilitySystemCVars::bBatchAbilityRPCs;
+}
+
+void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
+{
+	if (InputTag.IsValid())
+	{
+		TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> SpecHandles;
+		GatherSpecHandlesWithInputTag(InputTag, /*out*/ SpecHandles);
+
+		for (const FGameplayAbilitySpecHandle& SpecHandle : SpecHandles)
+		{
+			InputPressedSpecHandles.AddUnique(SpecHandle);
+			InputHeldSpecHandles.AddUnique(SpecHandle);
+		}
+	}
+}
+
+void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& InputTag)
+{
+	if (InputTag.IsValid())
+	{
+		TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> SpecHandles;
+		GatherSpecHandlesWithInputTag(InputTag, /*out*/ SpecHandles);
+
+		for (const FGameplayAbilitySpecHandle& SpecHandle : SpecHandles)
+		{
+			InputReleasedSpecHandles.AddUnique(SpecHandle);
+			InputHeldSpecHandles.Remove(SpecHandle);
+		}
+	}
+}
+
 void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGamePaused)
 {
 	if (HasMatchingGameplayTag(TAG_Gameplay_AbilityInputBlocked))
@@ -229,10 +346,8 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 		return;
 	}
 
-	static TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
-	AbilitiesToActivate.Reset();
-
-	//@TODO: See if we can use FScopedServerAbilityRPCBatcher ScopedRPCBatcher in some of these loops
+	// Inline storage keeps this allocation free for any reasonable number of simultaneous activations
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<16>> AbilitiesToActivate;
 
 	//
 	// Process all abilities that activate when the input is held.
@@ -286,8 +401,12 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	// We do it all at once so that held inputs don't activate the ability
 	// and then also send a input event to the ability because of the press.
 	//
+	// Each activation is wrapped in a batcher so that abilities which activate, send target data and end in the same
+	// frame (e.g., instant fire weapons) do it with a single server RPC (see ShouldDoServerAbilityRPCBatch).
+	//
 	for (const FGameplayAbilitySpecHandle& AbilitySpecHandle : AbilitiesToActivate)
 	{
+		FScopedServerAbilityRPCBatcher ScopedRPCBatcher(this, AbilitySpecHandle);
 		TryActivateAbility(AbilitySpecHandle);
 	}
 
@@ -534,3 +653,82 @@ void ULyraAbilitySystemComponent::GetAbilityTargetData(const FGameplayAbilitySpe
 	}
 }
 
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static void BenchmarkAbilityInputTags(const TArray<FString>& Args, UWorld* World)
+{
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	ULyraAbilitySystemComponent* ASC = Cast<ULyraAbilitySystemComponent>(UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(PC ? PC->GetPawn() : nullptr));
+	if ((ASC == nullptr) || !ASC->IsOwnerActorAuthoritative())
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Lyra.AbilitySystem.BenchmarkInputTags requires a standalone or listen server game with a possessed pawn that has an ability system"));
+		return;
+	}
+
+	const int32 NumAbilities = FMath::Max((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 200, 1);
+	const int32 NumIterations = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 10000;
+
+	const FGameplayTag InputTags[] =
+	{
+		LyraGameplayTags::InputTag_Move,
+		LyraGameplayTags::InputTag_Look_Mouse,
+		LyraGameplayTags::InputTag_Look_Stick,
+		LyraGameplayTags::InputTag_Crouch,
+		LyraGameplayTags::InputTag_AutoRun,
+	};
+
+	// Inert abilities (not Lyra abilities, so input never activates them) to pad the activatable ability list
+	TArray<FGameplayAbilitySpecHandle> GrantedHandles;
+	for (int32 Index = 0; Index < NumAbilities; ++Index)
+	{
+		FGameplayAbilitySpec AbilitySpec(UGameplayAbility::StaticClass(), 1);
+		AbilitySpec.DynamicAbilityTags.AddTag(InputTags[Index % UE_ARRAY_COUNT(InputTags)]);
+		GrantedHandles.Add(ASC->GiveAbility(AbilitySpec));
+	}
+
+	IConsoleVariable* IndexInputTagsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.AbilitySystem.IndexInputTags"));
+	const bool bOriginalIndexInputTags = LyraAbilitySystemCVars::bIndexInputTags;
+
+	UE_LOG(LogLyraAbilitySystem, Log, TEXT("Pressing and releasing input tags %d times with %d activatable abilities, activating one between each press"), NumIterations, ASC->GetActivatableAbilities().Num());
+
+	for (const bool bIndexInputTags : { false, true })
+	{
+		IndexInputTagsCVar->Set(bIndexInputTags);
+
+		uint64 LookupCycles = 0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			// Activating and ending an ability marks its spec dirty, like it does in game between two inputs
+			const FGameplayAbilitySpecHandle& ActivatedHandle = GrantedHandles[Iteration % GrantedHandles.Num()];
+			ASC->TryActivateAbility(ActivatedHandle);
+			ASC->CancelAbilityHandle(ActivatedHandle);
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			const FGameplayTag& InputTag = InputTags[Iteration % UE_ARRAY_COUNT(InputTags)];
+			ASC->AbilityInputTagPressed(InputTag);
+			ASC->AbilityInputTagReleased(InputTag);
+			ASC->ClearAbilityInput();
+			LookupCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+		const double ElapsedTime = FPlatformTime::ToSeconds64(LookupCycles);
+
+		UE_LOG(LogLyraAbilitySystem, Log, TEXT("  %s: %.3f ms total, %.3f us per press and release"),
+			bIndexInputTags ? TEXT("input tag index") : TEXT("linear scan"), ElapsedTime * 1000.0, (ElapsedTime * 1000000.0) / FMath::Max(NumIterations, 1));
+	}
+
+	IndexInputTagsCVar->Set(bOriginalIndexInputTags);
+
+	for (const FGameplayAbilitySpecHandle& Handle : GrantedHandles)
+	{
+		ASC->ClearAbility(Handle);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkAbilityInputTags(
+	TEXT("Lyra.AbilitySystem.BenchmarkInputTags"),
+	TEXT("Grants [NumAbilities=200] inert abilities to the local pawn and times [Iterations=10000] input tag presses and releases, with abilities activated in between, with and without the input tag index"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkAbilityInputTags));
+
+#endif // !UE_BUILD_SHIPPING
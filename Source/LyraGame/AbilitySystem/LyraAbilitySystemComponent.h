@@ -45,6 +45,9 @@ public:
 	void AbilityInputTagPressed(const FGameplayTag& InputTag);
 	void AbilityInputTagReleased(const FGameplayTag& InputTag);
 
+	// Updates the input tag index for a granted ability, call after changing its dynamic ability tags
+	void RefreshInputTagIndex(const FGameplayAbilitySpec& AbilitySpec);
+
 	void ProcessAbilityInput(float DeltaTime, bool bGamePaused);
 	void ClearAbilityInput();
 
@@ -75,6 +78,19 @@ protected:
 	virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
+
+	// Appends the handles of granted abilities with the input tag
+	void GatherSpecHandlesWithInputTag(const FGameplayTag& InputTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>>& OutSpecHandles);
+
+	// Adds or removes a granted ability from the input tag index
+	void AddToInputTagIndex(const FGameplayAbilitySpec& AbilitySpec);
+	void RemoveFromInputTagIndex(const FGameplayAbilitySpecHandle& Handle);
+
+	virtual bool ShouldDoServerAbilityRPCBatch() const override;
+
 	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability) override;
 	virtual void NotifyAbilityFailed(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason) override;
 	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability, bool bWasCancelled) override;
@@ -101,6 +117,13 @@ protected:
 	// Handles to abilities that have their input held.
 	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
 
+	// Handles to granted abilities keyed by each of their dynamic ability tags (which is where input tags live).
+	// Updated as abilities are given or removed, and for changed specs when the ability list replicates.
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>> InputTagToSpecHandles;
+
+	// The dynamic ability tags each granted ability was indexed with, to find out which specs changed
+	TMap<FGameplayAbilitySpecHandle, FGameplayTagContainer> InputTagIndexedSpecs;
+
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
 };
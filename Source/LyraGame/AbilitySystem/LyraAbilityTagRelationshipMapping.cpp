@@ -2,15 +2,179 @@
 
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
 
-
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityTagRelationshipMapping)
 
+#if !UE_BUILD_SHIPPING
+namespace LyraAbilityTagRelationshipCVars
+{
+	static bool bValidateCompiledRelationships = false;
+	static FAutoConsoleVariableRef CVarValidateCompiledRelationships(
+		TEXT("Lyra.AbilitySystem.ValidateTagRelationships"),
+		bValidateCompiledRelationships,
+		TEXT("If true, every tag relationship query is also evaluated by iterating over all relationships and the results are compared"),
+		ECVF_Default);
+}
+#endif
+
+void ULyraAbilityTagRelationshipMapping::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileRelationships();
+}
+
+#if WITH_EDITOR
+void ULyraAbilityTagRelationshipMapping::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileRelationships();
+}
+#endif
+
+void ULyraAbilityTagRelationshipMapping::CompileRelationships() const
+{
+	CompiledRelationships.Reset();
+
+	for (const FLyraAbilityTagRelationship& Relationship : AbilityTagRelationships)
+	{
+		if (!Relationship.AbilityTag.IsValid())
+		{
+			continue;
+		}
+
+		FLyraCompiledAbilityTagRelationship& Compiled = CompiledRelationships.FindOrAdd(Relationship.AbilityTag);
+		Compiled.AbilityTagsToBlock.AppendTags(Relationship.AbilityTagsToBlock);
+		Compiled.AbilityTagsToCancel.AppendTags(Relationship.AbilityTagsToCancel);
+		Compiled.ActivationRequiredTags.AppendTags(Relationship.ActivationRequiredTags);
+		Compiled.ActivationBlockedTags.AppendTags(Relationship.ActivationBlockedTags);
+	}
+
+	bRelationshipsCompiled = true;
+}
+
+template <typename FuncType>
+void ULyraAbilityTagRelationshipMapping::ForEachMatchingRelationship(const FGameplayTagContainer& AbilityTags, FuncType&& Func) const
+{
+	if (!bRelationshipsCompiled)
+	{
+		CompileRelationships();
+	}
+
+	if (CompiledRelationships.IsEmpty())
+	{
+		return;
+	}
+
+	// A relationship applies if the ability has its tag or any child of it (FGameplayTagContainer::HasTag semantics),
+	// so look up each ability tag and all of its parents
+	for (const FGameplayTag& AbilityTag : AbilityTags)
+	{
+		for (FGameplayTag Tag = AbilityTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			if (const FLyraCompiledAbilityTagRelationship* Compiled = CompiledRelationships.Find(Tag))
+			{
+				Func(*Compiled);
+			}
+		}
+	}
+}
+
 void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+#if !UE_BUILD_SHIPPING
+	const FGameplayTagContainer InitialTagsToBlock = (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships && OutTagsToBlock) ? *OutTagsToBlock : FGameplayTagContainer();
+	const FGameplayTagContainer InitialTagsToCancel = (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships && OutTagsToCancel) ? *OutTagsToCancel : FGameplayTagContainer();
+#endif
+
+	ForEachMatchingRelationship(AbilityTags, [OutTagsToBlock, OutTagsToCancel](const FLyraCompiledAbilityTagRelationship& Compiled)
+	{
+		if (OutTagsToBlock)
+		{
+			OutTagsToBlock->AppendTags(Compiled.AbilityTagsToBlock);
+		}
+		if (OutTagsToCancel)
+		{
+			OutTagsToCancel->AppendTags(Compiled.AbilityTagsToCancel);
+		}
+	});
+
+#if !UE_BUILD_SHIPPING
+	if (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships)
+	{
+		FGameplayTagContainer ExpectedTagsToBlock = InitialTagsToBlock;
+		FGameplayTagContainer ExpectedTagsToCancel = InitialTagsToCancel;
+		GetAbilityTagsToBlockAndCancel_Linear(AbilityTags, &ExpectedTagsToBlock, &ExpectedTagsToCancel);
+
+		ensureMsgf(!OutTagsToBlock || (*OutTagsToBlock == ExpectedTagsToBlock), TEXT("%s: compiled tags to block for [%s] are [%s], expected [%s]"),
+			*GetPathName(), *AbilityTags.ToStringSimple(), *OutTagsToBlock->ToStringSimple(), *ExpectedTagsToBlock.ToStringSimple());
+		ensureMsgf(!OutTagsToCancel || (*OutTagsToCancel == ExpectedTagsToCancel), TEXT("%s: compiled tags to cancel for [%s] are [%s], expected [%s]"),
+			*GetPathName(), *AbilityTags.ToStringSimple(), *OutTagsToCancel->ToStringSimple(), *ExpectedTagsToCancel.ToStringSimple());
+	}
+#endif
+}
+
+void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const
+{
+#if !UE_BUILD_SHIPPING
+	const FGameplayTagContainer InitialActivationRequired = (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships && OutActivationRequired) ? *OutActivationRequired : FGameplayTagContainer();
+	const FGameplayTagContainer InitialActivationBlocked = (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships && OutActivationBlocked) ? *OutActivationBlocked : FGameplayTagContainer();
+#endif
+
+	ForEachMatchingRelationship(AbilityTags, [OutActivationRequired, OutActivationBlocked](const FLyraCompiledAbilityTagRelationship& Compiled)
+	{
+		if (OutActivationRequired)
+		{
+			OutActivationRequired->AppendTags(Compiled.ActivationRequiredTags);
+		}
+		if (OutActivationBlocked)
+		{
+			OutActivationBlocked->AppendTags(Compiled.ActivationBlockedTags);
+		}
+	});
+
+#if !UE_BUILD_SHIPPING
+	if (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships)
+	{
+		FGameplayTagContainer ExpectedActivationRequired = InitialActivationRequired;
+		FGameplayTagContainer ExpectedActivationBlocked = InitialActivationBlocked;
+		GetRequiredAndBlockedActivationTags_Linear(AbilityTags, &ExpectedActivationRequired, &ExpectedActivationBlocked);
+
+		ensureMsgf(!OutActivationRequired || (*OutActivationRequired == ExpectedActivationRequired), TEXT("%s: compiled activation required tags for [%s] are [%s], expected [%s]"),
+			*GetPathName(), *AbilityTags.ToStringSimple(), *OutActivationRequired->ToStringSimple(), *ExpectedActivationRequired.ToStringSimple());
+		ensureMsgf(!OutActivationBlocked || (*OutActivationBlocked == ExpectedActivationBlocked), TEXT("%s: compiled activation blocked tags for [%s] are [%s], expected [%s]"),
+			*GetPathName(), *AbilityTags.ToStringSimple(), *OutActivationBlocked->ToStringSimple(), *ExpectedActivationBlocked.ToStringSimple());
+	}
+#endif
+}
+
+bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
+{
+	if (!bRelationshipsCompiled)
+	{
+		CompileRelationships();
+	}
+
+	// The action tag has to match exactly, and the merged cancel container has any of the tags iff one of the relationships does
+	const FLyraCompiledAbilityTagRelationship* Compiled = CompiledRelationships.Find(ActionTag);
+	const bool bIsCancelled = (Compiled != nullptr) && Compiled->AbilityTagsToCancel.HasAny(AbilityTags);
+
+#if !UE_BUILD_SHIPPING
+	if (LyraAbilityTagRelationshipCVars::bValidateCompiledRelationships)
+	{
+		ensureMsgf(bIsCancelled == IsAbilityCancelledByTag_Linear(AbilityTags, ActionTag), TEXT("%s: compiled cancellation of [%s] by %s does not match"),
+			*GetPathName(), *AbilityTags.ToStringSimple(), *ActionTag.ToString());
+	}
+#endif
+
+	return bIsCancelled;
+}
+
+#if !UE_BUILD_SHIPPING
+void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel_Linear(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const
+{
+	for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
 		if (AbilityTags.HasTag(Tags.AbilityTag))
 		{
 			if (OutTagsToBlock)
@@ -25,12 +189,10 @@ void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FG
 	}
 }
 
-void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const
+void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags_Linear(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+	for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
 		if (AbilityTags.HasTag(Tags.AbilityTag))
 		{
 			if (OutActivationRequired)
@@ -45,13 +207,10 @@ void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(con
 	}
 }
 
-bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
+bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag_Linear(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+	for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
-
 		if (Tags.AbilityTag == ActionTag && Tags.AbilityTagsToCancel.HasAny(AbilityTags))
 		{
 			return true;
@@ -60,4 +219,12 @@ bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplay
 
 	return false;
 }
+#endif
 
+#if WITH_DEV_AUTOMATION_TESTS
+void ULyraAbilityTagRelationshipMapping::SetAbilityTagRelationshipsForTesting(const TArray<FLyraAbilityTagRelationship>& InAbilityTagRelationships)
+{
+	AbilityTagRelationships = InAbilityTagRelationships;
+	CompileRelationships();
+}
+#endif
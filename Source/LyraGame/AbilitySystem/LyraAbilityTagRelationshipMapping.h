@@ -37,6 +37,16 @@ struct FLyraAbilityTagRelationship
 };
 
 
+/** All relationships that share the same ability tag, merged together */
+struct FLyraCompiledAbilityTagRelationship
+{
+	FGameplayTagContainer AbilityTagsToBlock;
+	FGameplayTagContainer AbilityTagsToCancel;
+	FGameplayTagContainer ActivationRequiredTags;
+	FGameplayTagContainer ActivationBlockedTags;
+};
+
+
 /** Mapping of how ability tags block or cancel other abilities */
 UCLASS()
 class ULyraAbilityTagRelationshipMapping : public UDataAsset
@@ -49,6 +59,13 @@ private:
 	TArray<FLyraAbilityTagRelationship> AbilityTagRelationships;
 
 public:
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
 	/** Given a set of ability tags, parse the tag relationship and fill out tags to block and cancel */
 	void GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const;
 
@@ -57,4 +74,30 @@ public:
 
 	/** Returns true if the specified ability tags are canceled by the passed in action tag */
 	bool IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const;
+
+#if !UE_BUILD_SHIPPING
+	// Reference implementations iterating over every relationship, used to validate the compiled tables
+	void GetAbilityTagsToBlockAndCancel_Linear(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const;
+	void GetRequiredAndBlockedActivationTags_Linear(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const;
+	bool IsAbilityCancelledByTag_Linear(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const;
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Replaces the relationships of a mapping built in code, for automation tests
+	void SetAbilityTagRelationshipsForTesting(const TArray<FLyraAbilityTagRelationship>& InAbilityTagRelationships);
+#endif
+
+private:
+	/** Rebuilds CompiledRelationships from AbilityTagRelationships */
+	void CompileRelationships() const;
+
+	/** Calls Func for the compiled relationship of every tag in AbilityTags and their parents */
+	template <typename FuncType>
+	void ForEachMatchingRelationship(const FGameplayTagContainer& AbilityTags, FuncType&& Func) const;
+
+private:
+	/** Relationships merged per ability tag, so queries are O(tags on the ability) instead of O(relationships) */
+	mutable TMap<FGameplayTag, FLyraCompiledAbilityTagRelationship> CompiledRelationships;
+
+	mutable bool bRelationshipsCompiled = false;
 };
@@ -8,6 +8,14 @@
 #include "GameplayTagsManager.h"
 #include "UObject/UObjectThreadContext.h"
 #include "Async/Async.h"
+#include "AbilitySystem/LyraGameplayCueManifest.h"
+#include "GameModes/LyraExperienceDefinition.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueManager)
 
@@ -34,6 +42,33 @@ namespace LyraGameplayCueManagerCvars
 		TEXT("Shows all assets that were loaded via LyraGameplayCueManager and are currently in memory."),
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
+#if !UE_BUILD_SHIPPING
+	static FAutoConsoleCommand CVarDumpGameplayCueUsage(
+		TEXT("Lyra.DumpGameplayCueUsage"),
+		TEXT("Shows the gameplay cues triggered since the current experience started loading, whether they were loaded in time (hit) or not (miss), and how long missed cues took to load."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCueUsage));
+
+	static bool bRecordUsage = false;
+	static FAutoConsoleVariableRef CVarRecordUsage(
+		TEXT("Lyra.GameplayCues.RecordUsage"),
+		bRecordUsage,
+		TEXT("Should the gameplay cue manager record which cues the current experience triggers (used by Lyra.DumpGameplayCueUsage and Lyra.GameplayCues.WriteManifest)"),
+		ECVF_Default);
+#endif // !UE_BUILD_SHIPPING
+
+#if WITH_EDITOR
+	static FAutoConsoleCommand CVarWriteManifest(
+		TEXT("Lyra.GameplayCues.WriteManifest"),
+		TEXT("Adds the gameplay cues recorded for the current experience to its cue manifest (creating one next to the experience if needed). The manifest still needs to be saved."),
+		FConsoleCommandDelegate::CreateLambda([]()
+			{
+				if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+				{
+					GCM->WriteRecordedCueManifest();
+				}
+			}));
+#endif
+
 	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
 }
 
@@ -123,6 +158,247 @@ bool ULyraGameplayCueManager::ShouldAsyncLoadMissingGameplayCues() const
 	return true;
 }
 
+void ULyraGameplayCueManager::HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options)
+{
+#if !UE_BUILD_SHIPPING
+	// Only count the events that start a cue, so a cue being added and removed is not recorded twice
+	const bool bStartsCue = (EventType == EGameplayCueEvent::OnActive) || (EventType == EGameplayCueEvent::Executed);
+	if (bStartsCue && LyraGameplayCueManagerCvars::bRecordUsage && ShouldDelayLoadGameplayCues())
+	{
+		RecordCueUsage(GameplayCueTag);
+	}
+#endif
+
+	Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+}
+
+#if !UE_BUILD_SHIPPING
+void ULyraGameplayCueManager::RecordCueUsage(const FGameplayTag& Tag)
+{
+	UGameplayCueSet* CueSet = RuntimeGameplayCueObjectLibrary.CueSet;
+	const int32* DataIdx = CueSet ? CueSet->GameplayCueDataMap.Find(Tag) : nullptr;
+	if (!DataIdx || !CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+	{
+		// No notify for this exact tag, so there is nothing to preload for it
+		return;
+	}
+
+	if (!RecordedCueTags.HasTagExact(Tag))
+	{
+		UE_LOG(LogLyra, Verbose, TEXT("Gameplay cue %s first triggered in experience %s"), *Tag.ToString(), *GetPathNameSafe(RecordingExperience.Get()));
+		RecordedCueTags.AddTag(Tag);
+	}
+
+	const FGameplayCueNotifyData& CueData = CueSet->GameplayCueData[*DataIdx];
+	const bool bIsLoaded = (CueData.LoadedGameplayCueClass != nullptr) || (CueData.GameplayCueNotifyObj.ResolveObject() != nullptr);
+
+	FCueUsageStats& Stats = CueUsageStats.FindOrAdd(Tag);
+	if (bIsLoaded)
+	{
+		Stats.NumHits++;
+	}
+	else
+	{
+		Stats.NumMisses++;
+
+		// The base manager starts the actual load, this request shares it and only tracks when it completes
+		if (!PendingMissedCueLoadStartTimes.Contains(Tag))
+		{
+			PendingMissedCueLoadStartTimes.Add(Tag, FPlatformTime::Seconds());
+			StreamableManager.RequestAsyncLoad(CueData.GameplayCueNotifyObj, FStreamableDelegate::CreateUObject(this, &ThisClass::OnMissedCueLoaded, Tag), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("GameplayCueManager"));
+		}
+	}
+}
+
+void ULyraGameplayCueManager::OnMissedCueLoaded(FGameplayTag Tag)
+{
+	double StartTime;
+	if (PendingMissedCueLoadStartTimes.RemoveAndCopyValue(Tag, /*out*/ StartTime))
+	{
+		if (FCueUsageStats* Stats = CueUsageStats.Find(Tag))
+		{
+			const double Latency = FPlatformTime::Seconds() - StartTime;
+			Stats->TotalMissLatency += Latency;
+			Stats->MaxMissLatency = FMath::Max(Stats->MaxMissLatency, Latency);
+			Stats->NumMissLoadsCompleted++;
+		}
+	}
+}
+#endif // !UE_BUILD_SHIPPING
+
+void ULyraGameplayCueManager::OnExperienceLoadStarted(const ULyraExperienceDefinition* Experience, UObject* LoadOwner)
+{
+	check(Experience);
+	check(LoadOwner);
+
+#if !UE_BUILD_SHIPPING
+	RecordingExperience = Experience;
+	RecordedCueTags.Reset();
+	CueUsageStats.Reset();
+	PendingMissedCueLoadStartTimes.Reset();
+#endif
+
+	if (Experience->GameplayCueManifest != nullptr)
+	{
+		// Owned by whoever loads the experience rather than the experience asset itself, which is never unloaded
+		PreloadCueManifest(Experience->GameplayCueManifest, LoadOwner);
+	}
+}
+
+void ULyraGameplayCueManager::OnExperienceUnloaded(UObject* LoadOwner)
+{
+	ReleasePreloadedCues(LoadOwner);
+}
+
+void ULyraGameplayCueManager::PreloadCueManifest(const ULyraGameplayCueManifest* Manifest, UObject* OwningObject)
+{
+	check(Manifest);
+	check(OwningObject);
+
+	if (!ShouldDelayLoadGameplayCues() || !ShouldPreloadReferencedCues())
+	{
+		// Cues are either all loaded upfront or not needed at all
+		return;
+	}
+
+	UGameplayCueSet* CueSet = RuntimeGameplayCueObjectLibrary.CueSet;
+	if (!CueSet)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("ULyraGameplayCueManager::PreloadCueManifest called for %s but RuntimeGameplayCueObjectLibrary.CueSet was null. Skipping preload."), *GetPathNameSafe(Manifest));
+		return;
+	}
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const FGameplayTag& Tag : Manifest->CueTags)
+	{
+		const int32* DataIdx = CueSet->GameplayCueDataMap.Find(Tag);
+		if (DataIdx && CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+		{
+			const FGameplayCueNotifyData& CueData = CueSet->GameplayCueData[*DataIdx];
+			if (UClass* LoadedGameplayCueClass = FindObject<UClass>(nullptr, *CueData.GameplayCueNotifyObj.ToString()))
+			{
+				RegisterPreloadedCue(LoadedGameplayCueClass, OwningObject);
+			}
+			else
+			{
+				PathsToLoad.Add(CueData.GameplayCueNotifyObj);
+			}
+		}
+	}
+
+	if (PathsToLoad.Num() > 0)
+	{
+		UE_LOG(LogLyra, Log, TEXT("Preloading %d gameplay cues from manifest %s"), PathsToLoad.Num(), *GetPathNameSafe(Manifest));
+
+		// One request for the whole manifest, loaded at high priority since it competes with the rest of the experience load
+		TWeakObjectPtr<UObject> WeakOwner = OwningObject;
+		TArray<FSoftObjectPath> RequestedPaths = PathsToLoad;
+		TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(MoveTemp(RequestedPaths), FStreamableDelegate::CreateUObject(this, &ThisClass::OnPreloadCueManifestComplete, MoveTemp(PathsToLoad), WeakOwner), FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("GameplayCueManifest"));
+
+		// A new manifest for the same owner replaces the load of the previous one
+		TSharedPtr<FStreamableHandle> PreviousHandle;
+		if (PendingManifestLoads.RemoveAndCopyValue(FObjectKey(OwningObject), /*out*/ PreviousHandle) && PreviousHandle.IsValid() && (PreviousHandle != Handle))
+		{
+			PreviousHandle->CancelHandle();
+		}
+
+		if (Handle.IsValid() && Handle->IsLoadingInProgress())
+		{
+			PendingManifestLoads.Add(FObjectKey(OwningObject), Handle);
+		}
+	}
+}
+
+void ULyraGameplayCueManager::ReleasePreloadedCues(UObject* OwningObject)
+{
+	const FObjectKey OwnerKey(OwningObject);
+
+	TSharedPtr<FStreamableHandle> PendingHandle;
+	if (PendingManifestLoads.RemoveAndCopyValue(OwnerKey, /*out*/ PendingHandle) && PendingHandle.IsValid())
+	{
+		PendingHandle->CancelHandle();
+	}
+
+	int32 NumReleasedCues = 0;
+	for (auto CueIt = PreloadedCues.CreateIterator(); CueIt; ++CueIt)
+	{
+		TSet<FObjectKey>* ReferencerSet = PreloadedCueReferencers.Find(*CueIt);
+		if ((ReferencerSet != nullptr) && (ReferencerSet->Remove(OwnerKey) > 0) && (ReferencerSet->Num() == 0))
+		{
+			// Let the notify be garbage collected, it will be loaded again on demand if it triggers later on
+			if (RuntimeGameplayCueObjectLibrary.CueSet)
+			{
+				RuntimeGameplayCueObjectLibrary.CueSet->RemoveLoadedClass(*CueIt);
+			}
+
+			PreloadedCueReferencers.Remove(*CueIt);
+			CueIt.RemoveCurrent();
+			++NumReleasedCues;
+		}
+	}
+
+	UE_CLOG(NumReleasedCues > 0, LogLyra, Log, TEXT("Released %d gameplay cues preloaded for %s"), NumReleasedCues, *GetPathNameSafe(OwningObject));
+}
+
+void ULyraGameplayCueManager::OnPreloadCueManifestComplete(TArray<FSoftObjectPath> Paths, TWeakObjectPtr<UObject> OwningObject)
+{
+	// Forget about the loads that are done, including those of owners that were destroyed in the meantime
+	for (auto LoadIt = PendingManifestLoads.CreateIterator(); LoadIt; ++LoadIt)
+	{
+		if (!LoadIt->Value.IsValid() || !LoadIt->Value->IsLoadingInProgress())
+		{
+			LoadIt.RemoveCurrent();
+		}
+	}
+
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		OnPreloadCueComplete(Path, OwningObject, /*bAlwaysLoadedCue=*/ false);
+	}
+}
+
+#if WITH_EDITOR
+void ULyraGameplayCueManager::WriteRecordedCueManifest()
+{
+	const ULyraExperienceDefinition* Experience = RecordingExperience.Get();
+	if (Experience == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("WriteRecordedCueManifest failed. No experience is running."));
+		return;
+	}
+
+	if (RecordedCueTags.IsEmpty())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("WriteRecordedCueManifest skipped. No gameplay cues were recorded for %s (is Lyra.GameplayCues.RecordUsage enabled?)."), *Experience->GetPrimaryAssetId().ToString());
+		return;
+	}
+
+	ULyraGameplayCueManifest* Manifest = const_cast<ULyraGameplayCueManifest*>(Experience->GameplayCueManifest.Get());
+	if (Manifest == nullptr)
+	{
+		const FString AssetName = Experience->GetPrimaryAssetId().PrimaryAssetName.ToString() + TEXT("_CueManifest");
+		const FString PackageName = FPackageName::GetLongPackagePath(Experience->GetOutermost()->GetName()) / AssetName;
+
+		UPackage* Package = CreatePackage(*PackageName);
+		Manifest = FindObject<ULyraGameplayCueManifest>(Package, *AssetName);
+		if (Manifest == nullptr)
+		{
+			Manifest = NewObject<ULyraGameplayCueManifest>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+			FAssetRegistryModule::AssetCreated(Manifest);
+		}
+
+		UE_LOG(LogLyra, Log, TEXT("Created gameplay cue manifest %s, assign it to the GameplayCueManifest of %s to preload it."), *Manifest->GetPathName(), *Experience->GetPrimaryAssetId().ToString());
+	}
+
+	const int32 NumTagsBefore = Manifest->CueTags.Num();
+	Manifest->Modify();
+	Manifest->CueTags.AppendTags(RecordedCueTags);
+	Manifest->MarkPackageDirty();
+
+	UE_LOG(LogLyra, Log, TEXT("Added %d new gameplay cues to manifest %s (%d in total), save it to keep the changes."), Manifest->CueTags.Num() - NumTagsBefore, *Manifest->GetPathName(), Manifest->CueTags.Num());
+}
+#endif // WITH_EDITOR
+
 void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 {
 	ULyraGameplayCueManager* GCM = Cast<ULyraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
@@ -177,6 +453,47 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
 }
 
+#if !UE_BUILD_SHIPPING
+void ULyraGameplayCueManager::DumpGameplayCueUsage(const TArray<FString>& Args)
+{
+	ULyraGameplayCueManager* GCM = Cast<ULyraGameplayCueManager>(UAbilitySystemGlobals::Get().GetGameplayCueManager());
+	if (!GCM)
+	{
+		UE_LOG(LogLyra, Error, TEXT("DumpGameplayCueUsage failed. No ULyraGameplayCueManager found."));
+		return;
+	}
+
+	const ULyraExperienceDefinition* Experience = GCM->RecordingExperience.Get();
+	const ULyraGameplayCueManifest* Manifest = Experience ? Experience->GameplayCueManifest.Get() : nullptr;
+
+	UE_LOG(LogLyra, Log, TEXT("=========== Dumping Gameplay Cue usage for %s ==========="), Experience ? *Experience->GetPrimaryAssetId().ToString() : TEXT("(no experience)"));
+
+	int32 TotalHits = 0;
+	int32 TotalMisses = 0;
+	int32 NumCuesMissingFromManifest = 0;
+	for (const TPair<FGameplayTag, FCueUsageStats>& Pair : GCM->CueUsageStats)
+	{
+		const FCueUsageStats& Stats = Pair.Value;
+		const bool bInManifest = Manifest && Manifest->CueTags.HasTagExact(Pair.Key);
+		const double AverageMissLatency = (Stats.NumMissLoadsCompleted > 0) ? (Stats.TotalMissLatency / Stats.NumMissLoadsCompleted) : 0.0;
+
+		UE_LOG(LogLyra, Log, TEXT("  %s: %d hits, %d misses (avg %.1f ms, max %.1f ms to load)%s"),
+			*Pair.Key.ToString(), Stats.NumHits, Stats.NumMisses, AverageMissLatency * 1000.0, Stats.MaxMissLatency * 1000.0,
+			bInManifest ? TEXT("") : TEXT(" [not in manifest]"));
+
+		TotalHits += Stats.NumHits;
+		TotalMisses += Stats.NumMisses;
+		NumCuesMissingFromManifest += bInManifest ? 0 : 1;
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("=========== Gameplay Cue usage summary ==========="));
+	UE_LOG(LogLyra, Log, TEXT("  ... %d distinct cues triggered"), GCM->CueUsageStats.Num());
+	UE_LOG(LogLyra, Log, TEXT("  ... %d hits, %d misses"), TotalHits, TotalMisses);
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cues still loading"), GCM->PendingMissedCueLoadStartTimes.Num());
+	UE_LOG(LogLyra, Log, TEXT("  ... %d triggered cues not in the manifest %s"), NumCuesMissingFromManifest, *GetPathNameSafe(Manifest));
+}
+#endif // !UE_BUILD_SHIPPING
+
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
 {
 	FScopeLock ScopeLock(&LoadedGameplayTagsToProcessCS);
@@ -251,20 +568,9 @@ void ULyraGameplayCueManager::ProcessLoadedTags()
 
 void ULyraGameplayCueManager::ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject)
 {
-	switch (LyraGameplayCueManagerCvars::LoadMode)
+	if (!ShouldPreloadReferencedCues())
 	{
-	case ELyraEditorLoadMode::LoadUpfront:
 		return;
-	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
-#if WITH_EDITOR
-		if (GIsEditor)
-		{
-			return;
-		}
-#endif
-		break;
-	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced:
-		break;
 	}
 
 	check(RuntimeGameplayCueObjectLibrary.CueSet);
@@ -357,15 +663,33 @@ void ULyraGameplayCueManager::UpdateDelayLoadDelegateListeners()
 	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 
+	if (!ShouldPreloadReferencedCues())
+	{
+		return;
+	}
+
+	UGameplayTagsManager::Get().OnGameplayTagLoadedDelegate.AddUObject(this, &ThisClass::OnGameplayTagLoaded);
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+}
+
+bool ULyraGameplayCueManager::ShouldDelayLoadGameplayCues() const
+{
+	const bool bClientDelayLoadGameplayCues = true;
+	return !IsRunningDedicatedServer() && bClientDelayLoadGameplayCues;
+}
+
+bool ULyraGameplayCueManager::ShouldPreloadReferencedCues() const
+{
 	switch (LyraGameplayCueManagerCvars::LoadMode)
 	{
 	case ELyraEditorLoadMode::LoadUpfront:
-		return;
+		return false;
 	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
 #if WITH_EDITOR
 		if (GIsEditor)
 		{
-			return;
+			return false;
 		}
 #endif
 		break;
@@ -373,15 +697,7 @@ void ULyraGameplayCueManager::UpdateDelayLoadDelegateListeners()
 		break;
 	}
 
-	UGameplayTagsManager::Get().OnGameplayTagLoadedDelegate.AddUObject(this, &ThisClass::OnGameplayTagLoaded);
-	FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
-	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
-}
-
-bool ULyraGameplayCueManager::ShouldDelayLoadGameplayCues() const
-{
-	const bool bClientDelayLoadGameplayCues = true;
-	return !IsRunningDedicatedServer() && bClientDelayLoadGameplayCues;
+	return true;
 }
 
 const FPrimaryAssetType UFortAssetManager_GameplayCueRefsType = TEXT("GameplayCueRefs");
@@ -8,6 +8,8 @@
 
 class FString;
 class UClass;
+class ULyraExperienceDefinition;
+class ULyraGameplayCueManifest;
 class UObject;
 class UWorld;
 struct FObjectKey;
@@ -32,9 +34,30 @@ public:
 	virtual bool ShouldAsyncLoadRuntimeObjectLibraries() const override;
 	virtual bool ShouldSyncLoadMissingGameplayCues() const override;
 	virtual bool ShouldAsyncLoadMissingGameplayCues() const override;
+	virtual void HandleGameplayCue(AActor* TargetActor, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters, EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default) override;
 	//~End of UGameplayCueManager interface
 
 	static void DumpGameplayCues(const TArray<FString>& Args);
+#if !UE_BUILD_SHIPPING
+	static void DumpGameplayCueUsage(const TArray<FString>& Args);
+#endif
+
+	// Called when an experience starts loading, bulk preloads its cue manifest on behalf of LoadOwner (and starts recording the cues it triggers)
+	void OnExperienceLoadStarted(const ULyraExperienceDefinition* Experience, UObject* LoadOwner);
+
+	// Called when the experience loaded by LoadOwner is unloaded, releases the cues that were preloaded for it
+	void OnExperienceUnloaded(UObject* LoadOwner);
+
+	// Requests an async load of every cue in the manifest at once, keeping them loaded until ReleasePreloadedCues is called for OwningObject or it is destroyed
+	void PreloadCueManifest(const ULyraGameplayCueManifest* Manifest, UObject* OwningObject);
+
+	// Releases the cues preloaded on behalf of OwningObject, cancelling its manifest load if it is still in flight
+	void ReleasePreloadedCues(UObject* OwningObject);
+
+#if WITH_EDITOR
+	// Adds the cues recorded for the current experience to its manifest, creating a new manifest asset next to the experience if it does not have one
+	void WriteRecordedCueManifest();
+#endif
 
 	// When delay loading cues, this will load the cues that must be always loaded anyway
 	void LoadAlwaysLoadedCues();
@@ -48,10 +71,16 @@ private:
 	void ProcessLoadedTags();
 	void ProcessTagToPreload(const FGameplayTag& Tag, UObject* OwningObject);
 	void OnPreloadCueComplete(FSoftObjectPath Path, TWeakObjectPtr<UObject> OwningObject, bool bAlwaysLoadedCue);
+	void OnPreloadCueManifestComplete(TArray<FSoftObjectPath> Paths, TWeakObjectPtr<UObject> OwningObject);
+#if !UE_BUILD_SHIPPING
+	void RecordCueUsage(const FGameplayTag& Tag);
+	void OnMissedCueLoaded(FGameplayTag Tag);
+#endif
 	void RegisterPreloadedCue(UClass* LoadedGameplayCueClass, UObject* OwningObject);
 	void HandlePostLoadMap(UWorld* NewWorld);
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
+	bool ShouldPreloadReferencedCues() const;
 
 private:
 	struct FLoadedGameplayTagToProcessData
@@ -73,7 +102,36 @@ private:
 	UPROPERTY(transient)
 	TSet<TObjectPtr<UClass>> AlwaysLoadedCues;
 
+	// Manifest loads still in flight, per owning object
+	TMap<FObjectKey, TSharedPtr<FStreamableHandle>> PendingManifestLoads;
+
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
+
+#if !UE_BUILD_SHIPPING
+	struct FCueUsageStats
+	{
+		// Number of times the cue was triggered with its notify already loaded
+		int32 NumHits = 0;
+
+		// Number of times the cue was triggered before its notify was loaded (and so did not play)
+		int32 NumMisses = 0;
+
+		// Time between a miss and the notify finishing loading
+		double TotalMissLatency = 0.0;
+		double MaxMissLatency = 0.0;
+		int32 NumMissLoadsCompleted = 0;
+	};
+
+	// Experience the recorded cues belong to
+	TWeakObjectPtr<const ULyraExperienceDefinition> RecordingExperience;
+
+	// Cues triggered since the current experience started loading, and whether they were loaded in time
+	FGameplayTagContainer RecordedCueTags;
+	TMap<FGameplayTag, FCueUsageStats> CueUsageStats;
+
+	// Time at which cues that missed started loading
+	TMap<FGameplayTag, double> PendingMissedCueLoadStartTimes;
+#endif // !UE_BUILD_SHIPPING
 };
@@ -0,0 +1,10 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraGameplayCueManifest.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueManifest)
+
+ULyraGameplayCueManifest::ULyraGameplayCueManifest(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+
+#include "LyraGameplayCueManifest.generated.h"
+
+class UObject;
+
+/**
+ * ULyraGameplayCueManifest
+ *
+ *	List of gameplay cues an experience is known to trigger, bulk preloaded by the gameplay cue manager while
+ *	the experience loads so the first time each cue plays does not hitch.
+ *
+ *	Usually generated from play sessions with Lyra.GameplayCues.WriteManifest rather than authored by hand.
+ */
+UCLASS(BlueprintType, Const, Meta = (DisplayName = "Lyra Gameplay Cue Manifest", ShortTooltip = "Data asset listing the gameplay cues to preload for an experience."))
+class LYRAGAME_API ULyraGameplayCueManifest : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	ULyraGameplayCueManifest(const FObjectInitializer& ObjectInitializer);
+
+public:
+
+	// Gameplay cues to preload
+	UPROPERTY(EditDefaultsOnly, Category = "Lyra|GameplayCues", meta = (Categories = "GameplayCue"))
+	FGameplayTagContainer CueTags;
+};
@@ -3,9 +3,21 @@
 #include "LyraGlobalAbilitySystem.h"
 
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGlobalAbilitySystem)
 
+namespace LyraGlobalAbilitySystemCVars
+{
+	static int32 MaxApplicationsPerFrame = 32;
+	static FAutoConsoleVariableRef CVarMaxApplicationsPerFrame(
+		TEXT("Lyra.GlobalAbilitySystem.MaxApplicationsPerFrame"),
+		MaxApplicationsPerFrame,
+		TEXT("Maximum number of ASCs a globally applied ability or effect is applied to per frame, the rest are spread over the following frames (<= 0 means no limit)"),
+		ECVF_Default);
+}
+
 void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC)
 {
 	if (FGameplayAbilitySpecHandle* SpecHandle = Handles.Find(ASC))
@@ -13,8 +25,16 @@ void FGlobalAppliedAbilityList::AddToASC(TSubclassOf<UGameplayAbility> Ability,
 		RemoveFromASC(ASC);
 	}
 
-	UGameplayAbility* AbilityCDO = Ability->GetDefaultObject<UGameplayAbility>();
-	FGameplayAbilitySpec AbilitySpec(AbilityCDO);
+	if (SharedSpec.Ability == nullptr)
+	{
+		SharedSpec = FGameplayAbilitySpec(Ability->GetDefaultObject<UGameplayAbility>());
+	}
+
+	// Every granted spec needs its own handle
+	FGameplayAbilitySpec AbilitySpec = SharedSpec;
+	AbilitySpec.Handle = FGameplayAbilitySpecHandle();
+	AbilitySpec.Handle.GenerateNewHandle();
+
 	const FGameplayAbilitySpecHandle AbilitySpecHandle = ASC->GiveAbility(AbilitySpec);
 	Handles.Add(ASC, AbilitySpecHandle);
 }
@@ -38,6 +58,7 @@ void FGlobalAppliedAbilityList::RemoveFromAll()
 		}
 	}
 	Handles.Empty();
+	PendingASCs.Empty();
 }
 
 
@@ -49,8 +70,13 @@ void FGlobalAppliedEffectList::AddToASC(TSubclassOf<UGameplayEffect> Effect, ULy
 		RemoveFromASC(ASC);
 	}
 
-	const UGameplayEffect* GameplayEffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
-	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(GameplayEffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
+	if (EffectCDO == nullptr)
+	{
+		EffectCDO = Effect->GetDefaultObject<UGameplayEffect>();
+	}
+
+	// Every ASC gets its own spec, attribute captures and calculated magnitudes depend on the ASC it was made for
+	const FActiveGameplayEffectHandle GameplayEffectHandle = ASC->ApplyGameplayEffectToSelf(EffectCDO, /*Level=*/ 1, ASC->MakeEffectContext());
 	Handles.Add(ASC, GameplayEffectHandle);
 }
 
@@ -73,6 +99,7 @@ void FGlobalAppliedEffectList::RemoveFromAll()
 		}
 	}
 	Handles.Empty();
+	PendingASCs.Empty();
 }
 
 ULyraGlobalAbilitySystem::ULyraGlobalAbilitySystem()
@@ -84,10 +111,7 @@ void ULyraGlobalAbilitySystem::ApplyAbilityToAll(TSubclassOf<UGameplayAbility> A
 	if ((Ability.Get() != nullptr) && (!AppliedAbilities.Contains(Ability)))
 	{
 		FGlobalAppliedAbilityList& Entry = AppliedAbilities.Add(Ability);		
-		for (ULyraAbilitySystemComponent* ASC : RegisteredASCs)
-		{
-			Entry.AddToASC(Ability, ASC);
-		}
+		QueueForAllASCs(Entry);
 	}
 }
 
@@ -96,10 +120,7 @@ void ULyraGlobalAbilitySystem::ApplyEffectToAll(TSubclassOf<UGameplayEffect> Eff
 	if ((Effect.Get() != nullptr) && (!AppliedEffects.Contains(Effect)))
 	{
 		FGlobalAppliedEffectList& Entry = AppliedEffects.Add(Effect);
-		for (ULyraAbilitySystemComponent* ASC : RegisteredASCs)
-		{
-			Entry.AddToASC(Effect, ASC);
-		}
+		QueueForAllASCs(Entry);
 	}
 }
 
@@ -145,12 +166,76 @@ void ULyraGlobalAbilitySystem::UnregisterASC(ULyraAbilitySystemComponent* ASC)
 	for (auto& Entry : AppliedAbilities)
 	{
 		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.PendingASCs.RemoveSwap(ASC);
 	}
 	for (auto& Entry : AppliedEffects)
 	{
 		Entry.Value.RemoveFromASC(ASC);
+		Entry.Value.PendingASCs.RemoveSwap(ASC);
 	}
 
 	RegisteredASCs.Remove(ASC);
 }
 
+template <typename ListType>
+void ULyraGlobalAbilitySystem::QueueForAllASCs(ListType& List)
+{
+	List.Handles.Reserve(RegisteredASCs.Num());
+	List.PendingASCs.Reserve(RegisteredASCs.Num());
+	for (ULyraAbilitySystemComponent* ASC : RegisteredASCs)
+	{
+		List.PendingASCs.Add(ASC);
+	}
+
+	// Apply the first chunk right away, the rest will follow over the next frames
+	ProcessPendingApplications();
+}
+
+void ULyraGlobalAbilitySystem::ScheduleProcessPendingApplications()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (!World->GetTimerManager().TimerExists(ProcessPendingTimerHandle))
+		{
+			ProcessPendingTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ThisClass::ProcessPendingApplications);
+		}
+	}
+}
+
+void ULyraGlobalAbilitySystem::ProcessPendingApplications()
+{
+	int32 Budget = (LyraGlobalAbilitySystemCVars::MaxApplicationsPerFrame > 0) ? LyraGlobalAbilitySystemCVars::MaxApplicationsPerFrame : MAX_int32;
+	bool bHasRemainingWork = false;
+
+	auto ProcessList = [&Budget, &bHasRemainingWork](auto& Class, auto& List)
+	{
+		while ((Budget > 0) && (List.PendingASCs.Num() > 0))
+		{
+			ULyraAbilitySystemComponent* ASC = List.PendingASCs.Pop(EAllowShrinking::No).Get();
+
+			// Skip ASCs that went away or already received it (e.g., by registering while the list was pending)
+			if ((ASC != nullptr) && !List.Handles.Contains(ASC))
+			{
+				List.AddToASC(Class, ASC);
+				--Budget;
+			}
+		}
+
+		bHasRemainingWork |= (List.PendingASCs.Num() > 0);
+	};
+
+	for (auto& Entry : AppliedAbilities)
+	{
+		ProcessList(Entry.Key, Entry.Value);
+	}
+	for (auto& Entry : AppliedEffects)
+	{
+		ProcessList(Entry.Key, Entry.Value);
+	}
+
+	if (bHasRemainingWork)
+	{
+		ScheduleProcessPendingApplications();
+	}
+}
+
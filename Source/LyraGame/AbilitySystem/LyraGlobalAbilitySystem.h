@@ -3,6 +3,8 @@
 #pragma once
 
 #include "ActiveGameplayEffectHandle.h"
+#include "Engine/TimerHandle.h"
+#include "GameplayAbilitySpec.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "GameplayAbilitySpecHandle.h"
 #include "Templates/SubclassOf.h"
@@ -25,9 +27,16 @@ struct FGlobalAppliedAbilityList
 	UPROPERTY()
 	TMap<TObjectPtr<ULyraAbilitySystemComponent>, FGameplayAbilitySpecHandle> Handles;
 
+	// ASCs that this ability still has to be given to, processed over several frames
+	TArray<TWeakObjectPtr<ULyraAbilitySystemComponent>> PendingASCs;
+
 	void AddToASC(TSubclassOf<UGameplayAbility> Ability, ULyraAbilitySystemComponent* ASC);
 	void RemoveFromASC(ULyraAbilitySystemComponent* ASC);
 	void RemoveFromAll();
+
+private:
+	// Spec built once and copied (with a new handle) for every ASC
+	FGameplayAbilitySpec SharedSpec;
 };
 
 USTRUCT()
@@ -38,9 +47,16 @@ struct FGlobalAppliedEffectList
 	UPROPERTY()
 	TMap<TObjectPtr<ULyraAbilitySystemComponent>, FActiveGameplayEffectHandle> Handles;
 
+	// ASCs that this effect still has to be applied to, processed over several frames
+	TArray<TWeakObjectPtr<ULyraAbilitySystemComponent>> PendingASCs;
+
 	void AddToASC(TSubclassOf<UGameplayEffect> Effect, ULyraAbilitySystemComponent* ASC);
 	void RemoveFromASC(ULyraAbilitySystemComponent* ASC);
 	void RemoveFromAll();
+
+private:
+	UPROPERTY()
+	TObjectPtr<const UGameplayEffect> EffectCDO = nullptr;
 };
 
 UCLASS()
@@ -69,6 +85,16 @@ public:
 	/** Removes an ASC from the global system, along with any active global effects/abilities. */
 	void UnregisterASC(ULyraAbilitySystemComponent* ASC);
 
+private:
+	/** Queues every registered ASC on the list and starts processing the queue */
+	template <typename ListType>
+	void QueueForAllASCs(ListType& List);
+
+	/** Applies pending abilities/effects, up to the per frame budget, rescheduling itself while work remains */
+	void ProcessPendingApplications();
+
+	void ScheduleProcessPendingApplications();
+
 private:
 	UPROPERTY()
 	TMap<TSubclassOf<UGameplayAbility>, FGlobalAppliedAbilityList> AppliedAbilities;
@@ -78,4 +104,6 @@ private:
 
 	UPROPERTY()
 	TArray<TObjectPtr<ULyraAbilitySystemComponent>> RegisteredASCs;
+
+	FTimerHandle ProcessPendingTimerHandle;
 };
@@ -6,11 +6,14 @@
 #include "Character/LyraCharacterMovementComponent.h"
 
 #if WITH_EDITOR
+#include "Animation/AnimBlueprint.h"
 #include "Misc/DataValidation.h"
 #endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAnimInstance)
 
+#define LOCTEXT_NAMESPACE "LyraAnimInstance"
+
 
 ULyraAnimInstance::ULyraAnimInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -31,6 +34,16 @@ EDataValidationResult ULyraAnimInstance::IsDataValid(FDataValidationContext& Con
 
 	GameplayTagPropertyMap.IsDataValid(this, Context);
 
+	// Everything derived from the movement snapshot is computed in NativeThreadSafeUpdateAnimation, which only leaves the
+	// game thread if the anim blueprint allows it
+	if (const UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(GetClass()->ClassGeneratedBy))
+	{
+		if (!AnimBlueprint->bUseMultiThreadedAnimationUpdate)
+		{
+			Context.AddWarning(FText::Format(LOCTEXT("SingleThreadedAnimationUpdate", "{0} does not use multi-threaded animation update, its whole update runs on the game thread. Enable Use Multi Threaded Animation Update in its Class Settings."), FText::FromString(AnimBlueprint->GetName())));
+		}
+	}
+
 	return ((Context.GetNumErrors() > 0) ? EDataValidationResult::Invalid : EDataValidationResult::Valid);
 }
 #endif // WITH_EDITOR
@@ -52,14 +65,34 @@ void ULyraAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraAnimInstance_NativeUpdateAnimation);
+
 	const ALyraCharacter* Character = Cast<ALyraCharacter>(GetOwningActor());
-	if (!Character)
+	if (Character)
 	{
-		return;
+		ULyraCharacterMovementComponent* CharMoveComp = CastChecked<ULyraCharacterMovementComponent>(Character->GetCharacterMovement());
+		if (ULyraCharacterMovementComponent::IsAnimSnapshotEnabled())
+		{
+			// The movement component built the snapshot at the end of its tick, which runs before ours. Only copy it here,
+			// everything derived from it is computed in NativeThreadSafeUpdateAnimation
+			MovementSnapshot = CharMoveComp->GetAnimSnapshot();
+		}
+		else
+		{
+			const FLyraCharacterGroundInfo& GroundInfo = CharMoveComp->GetGroundInfo();
+			GroundDistance = GroundInfo.GroundDistance;
+		}
 	}
+}
 
-	ULyraCharacterMovementComponent* CharMoveComp = CastChecked<ULyraCharacterMovementComponent>(Character->GetCharacterMovement());
-	const FLyraCharacterGroundInfo& GroundInfo = CharMoveComp->GetGroundInfo();
-	GroundDistance = GroundInfo.GroundDistance;
+void ULyraAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	if (ULyraCharacterMovementComponent::IsAnimSnapshotEnabled())
+	{
+		GroundDistance = MovementSnapshot.GroundDistance;
+	}
 }
 
+#undef LOCTEXT_NAMESPACE
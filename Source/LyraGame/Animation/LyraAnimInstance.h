@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Animation/AnimInstance.h"
+#include "Character/LyraCharacterMovementComponent.h"
 #include "GameplayEffectTypes.h"
 #include "LyraAnimInstance.generated.h"
 
@@ -13,6 +14,10 @@ class UAbilitySystemComponent;
  * ULyraAnimInstance
  *
  *	The base game animation instance class used by this project.
+ *
+ *	The game thread part of the update only copies the movement snapshot, the rest belongs in thread safe functions so it
+ *	runs on worker threads. Anim blueprints deriving from this should enable Use Multi Threaded Animation Update (data
+ *	validation warns when it is off), otherwise the whole update runs on the game thread.
  */
 UCLASS(Config = Game)
 class ULyraAnimInstance : public UAnimInstance
@@ -25,6 +30,11 @@ public:
 
 	virtual void InitializeWithAbilitySystem(UAbilitySystemComponent* ASC);
 
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets tests check what the last update copied from the movement component
+	const FLyraCharacterAnimSnapshot& GetMovementSnapshotForTesting() const { return MovementSnapshot; }
+#endif
+
 protected:
 
 #if WITH_EDITOR
@@ -33,6 +43,7 @@ protected:
 
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 protected:
 
@@ -43,4 +54,8 @@ protected:
 
 	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
 	float GroundDistance = -1.0f;
+
+	// Movement state copied from the movement component at the start of the update, safe to read from thread safe update functions
+	UPROPERTY(BlueprintReadOnly, Category = "Character State Data")
+	FLyraCharacterAnimSnapshot MovementSnapshot;
 };
@@ -98,6 +98,12 @@ public:
 
 	virtual void DrawDebug(UCanvas* Canvas) const;
 
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets tests place the view and control interpolation without a camera component driving the mode
+	FLyraCameraModeView& GetCameraModeViewForTesting() { return View; }
+	void SetResetInterpolationForTesting(bool bResetInterp) { bResetInterpolation = bResetInterp; }
+#endif
+
 protected:
 
 	virtual FVector GetPivotLocation() const;
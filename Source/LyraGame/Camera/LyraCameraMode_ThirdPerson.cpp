@@ -6,10 +6,12 @@
 #include "Camera/LyraPenetrationAvoidanceFeeler.h"
 #include "Curves/CurveVector.h"
 #include "Engine/Canvas.h"
+#include "Engine/World.h"
 #include "GameFramework/CameraBlockingVolume.h"
 #include "LyraCameraAssistInterface.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
 #include "Math/RotationMatrix.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCameraMode_ThirdPerson)
@@ -17,6 +19,27 @@
 namespace LyraCameraMode_ThirdPerson_Statics
 {
 	static const FName NAME_IgnoreCameraCollision = TEXT("IgnoreCameraCollision");
+
+	static bool bAsyncPenetrationFeelers = true;
+	static FAutoConsoleVariableRef CVarAsyncPenetrationFeelers(
+		TEXT("Lyra.Camera.AsyncPenetrationFeelers"),
+		bAsyncPenetrationFeelers,
+		TEXT("If true, the predictive camera penetration feelers are swept asynchronously and their results are used the following frame"),
+		ECVF_Default);
+
+	static float FeelerFastLinearSpeed = 1500.0f;
+	static FAutoConsoleVariableRef CVarFeelerFastLinearSpeed(
+		TEXT("Lyra.Camera.FeelerFastLinearSpeed"),
+		FeelerFastLinearSpeed,
+		TEXT("Camera speed (cm/s) at which the predictive penetration feelers are traced every frame"),
+		ECVF_Default);
+
+	static float FeelerFastAngularSpeed = 360.0f;
+	static FAutoConsoleVariableRef CVarFeelerFastAngularSpeed(
+		TEXT("Lyra.Camera.FeelerFastAngularSpeed"),
+		FeelerFastAngularSpeed,
+		TEXT("Camera rotation speed (deg/s) at which the predictive penetration feelers are traced every frame"),
+		ECVF_Default);
 }
 
 ULyraCameraMode_ThirdPerson::ULyraCameraMode_ThirdPerson()
@@ -150,6 +173,8 @@ void ULyraCameraMode_ThirdPerson::UpdatePreventPenetration(float DeltaTime)
 			SafeLocation += (SafeLocation - ClosestPointOnLineToCapsuleCenter).GetSafeNormal() * PushInDistance;
 		}
 
+		UpdateFeelerIntervalScale(DeltaTime);
+
 		// Then aim line to desired camera position
 		bool const bSingleRayPenetrationCheck = !bDoPredictiveAvoidance;
 		PreventCameraPenetration(*PPActor, SafeLocation, View.Location, DeltaTime, AimLineToDesiredPosBlockedPct, bSingleRayPenetrationCheck);
@@ -170,6 +195,73 @@ void ULyraCameraMode_ThirdPerson::UpdatePreventPenetration(float DeltaTime)
 	}
 }
 
+void ULyraCameraMode_ThirdPerson::UpdateFeelerIntervalScale(float DeltaTime)
+{
+	if (bHasLastFeelerView && !bResetInterpolation && (DeltaTime > UE_SMALL_NUMBER))
+	{
+		const float LinearSpeed = FVector::Dist(View.Location, LastFeelerViewLocation) / DeltaTime;
+		const float AngularSpeed = (View.Rotation - LastFeelerViewRotation).GetNormalized().Euler().GetAbsMax() / DeltaTime;
+
+		const float LinearAlpha = (LyraCameraMode_ThirdPerson_Statics::FeelerFastLinearSpeed > 0.0f) ? (LinearSpeed / LyraCameraMode_ThirdPerson_Statics::FeelerFastLinearSpeed) : 1.0f;
+		const float AngularAlpha = (LyraCameraMode_ThirdPerson_Statics::FeelerFastAngularSpeed > 0.0f) ? (AngularSpeed / LyraCameraMode_ThirdPerson_Statics::FeelerFastAngularSpeed) : 1.0f;
+
+		// A still camera traces the predictive feelers at half their authored rate, one moving at the
+		// fast speeds (or faster) every frame, and one at half those speeds at exactly the authored rate
+		FeelerIntervalScale = FMath::Lerp(2.0f, 0.0f, FMath::Clamp(FMath::Max(LinearAlpha, AngularAlpha), 0.0f, 1.0f));
+	}
+	else
+	{
+		FeelerIntervalScale = 1.0f;
+	}
+
+	LastFeelerViewLocation = View.Location;
+	LastFeelerViewRotation = View.Rotation;
+	bHasLastFeelerView = true;
+}
+
+float ULyraCameraMode_ThirdPerson::ComputeFeelerBlockedPct(const FVector& HitLocation, const FVector& SafeLoc, const FVector& RayTarget, float PushOutDistance)
+{
+	return ((HitLocation - SafeLoc).Size() - PushOutDistance) / (RayTarget - SafeLoc).Size();
+}
+
+float ULyraCameraMode_ThirdPerson::GetFeelerBlockedPct(const FHitResult& Hit, const AActor& ViewTarget, const FVector& SafeLoc, const FVector& RayTarget, FCollisionQueryParams& SphereParams)
+{
+	const AActor* HitActor = Hit.GetActor();
+	if (!Hit.bBlockingHit || (HitActor == nullptr))
+	{
+		return 1.f;
+	}
+
+	if (HitActor->ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+	{
+		SphereParams.AddIgnoredActor(HitActor);
+		return 1.f;
+	}
+
+	// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+	if (HitActor->IsA<ACameraBlockingVolume>())
+	{
+		const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+		const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+		const FVector HitOffset = Hit.Location - ViewTargetLocation;
+		const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+		const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+		if (DotHitDirection > 0.0f)
+		{
+			// Ignore this CameraBlockingVolume on the remaining sweeps.
+			SphereParams.AddIgnoredActor(HitActor);
+			return 1.f;
+		}
+	}
+
+#if ENABLE_DRAW_DEBUG
+	DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+
+	// Recompute blocked pct taking into account pushout distance.
+	return ComputeFeelerBlockedPct(Hit.Location, SafeLoc, RayTarget, CollisionPushOutDistance);
+}
+
 void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly)
 {
 #if ENABLE_DRAW_DEBUG
@@ -201,9 +293,49 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 	FCollisionShape SphereShape = FCollisionShape::MakeSphere(0.f);
 	UWorld* World = GetWorld();
 
+	// The main ray (index 0) is always swept synchronously since it is what keeps the camera out of the world
+	// this frame, the predictive feelers only pull the camera in ahead of time so they can afford a frame of latency
+	const bool bAsyncFeelers = LyraCameraMode_ThirdPerson_Statics::bAsyncPenetrationFeelers;
+	PendingFeelerTraces.SetNum(PenetrationAvoidanceFeelers.Num());
+
 	for (int32 RayIdx = 0; RayIdx < NumRaysToShoot; ++RayIdx)
 	{
 		FLyraPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+		FLyraPendingFeelerTrace& PendingTrace = PendingFeelerTraces[RayIdx];
+		const bool bTraceAsync = bAsyncFeelers && (RayIdx > 0);
+
+		// Consume the sweep submitted last frame. The hit is converted to a blocked percentage of the ray it was
+		// submitted with, which predicts where this frame's ray is blocked as long as the camera moved little
+		// (and the feeler interval drops to every frame when it does not).
+		bool bTracedThisFrame = false;
+		if (PendingTrace.Handle.IsValid())
+		{
+			FTraceDatum TraceData;
+			if (World->QueryTraceData(PendingTrace.Handle, /*out*/ TraceData))
+			{
+				const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+				const float NewBlockPct = Hit ? GetFeelerBlockedPct(*Hit, ViewTarget, PendingTrace.SafeLoc, PendingTrace.RayTarget, SphereParams) : 1.f;
+				if (NewBlockPct < 1.f)
+				{
+					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+
+					// This feeler got a hit, so do another trace right away
+					Feeler.FramesUntilNextTrace = 0;
+				}
+
+#if ENABLE_DRAW_DEBUG
+				if (World->TimeSince(LastDrawDebugTime) < 1.f)
+				{
+					DrawDebugLine(World, PendingTrace.SafeLoc, Hit ? Hit->Location : PendingTrace.RayTarget, FColor::Orange);
+				}
+#endif // ENABLE_DRAW_DEBUG
+
+				bTracedThisFrame = true;
+			}
+
+			PendingTrace.Handle = FTraceHandle();
+		}
+
 		if (Feeler.FramesUntilNextTrace <= 0)
 		{
 			// calc ray target
@@ -219,76 +351,53 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 			SphereShape.Sphere.Radius = Feeler.Extent;
 			ECollisionChannel TraceChannel = ECC_Camera;		//(Feeler.PawnWeight > 0.f) ? ECC_Pawn : ECC_Camera;
 
-			// do multi-line check to make sure the hits we throw out aren't
-			// masking real hits behind (these are important rays).
-
-			// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
-			FHitResult Hit;
-			const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
-#if ENABLE_DRAW_DEBUG
-			if (World->TimeSince(LastDrawDebugTime) < 1.f)
+			if (bTraceAsync)
 			{
-				DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Red);
-				DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Red);
-			}
-#endif // ENABLE_DRAW_DEBUG
-
-			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+				PendingTrace.Handle = World->AsyncSweepByChannel(EAsyncTraceType::Single, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+				PendingTrace.SafeLoc = SafeLoc;
+				PendingTrace.RayTarget = RayTarget;
 
-			const AActor* HitActor = Hit.GetActor();
-
-			if (bHit && HitActor)
+				// Predictive feelers that are not hitting anything trace less often when the camera is slow
+				Feeler.FramesUntilNextTrace = FMath::RoundToInt32(Feeler.TraceInterval * FeelerIntervalScale);
+			}
+			else
 			{
-				bool bIgnoreHit = false;
+				// do multi-line check to make sure the hits we throw out aren't
+				// masking real hits behind (these are important rays).
 
-				if (HitActor->ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+				// MT-> passing camera as actor so that camerablockingvolumes know when it's the camera doing traces
+				FHitResult Hit;
+				const bool bHit = World->SweepSingleByChannel(Hit, SafeLoc, RayTarget, FQuat::Identity, TraceChannel, SphereShape, SphereParams);
+#if ENABLE_DRAW_DEBUG
+				if (World->TimeSince(LastDrawDebugTime) < 1.f)
 				{
-					bIgnoreHit = true;
-					SphereParams.AddIgnoredActor(HitActor);
+					DrawDebugSphere(World, SafeLoc, SphereShape.Sphere.Radius, 8, FColor::Red);
+					DrawDebugSphere(World, bHit ? Hit.Location : RayTarget, SphereShape.Sphere.Radius, 8, FColor::Red);
+					DrawDebugLine(World, SafeLoc, bHit ? Hit.Location : RayTarget, FColor::Red);
 				}
+#endif // ENABLE_DRAW_DEBUG
 
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
-				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
-				}
-				
-				if (!bIgnoreHit)
-				{
-					float const Weight = Cast<APawn>(Hit.GetActor()) ? Feeler.PawnWeight : Feeler.WorldWeight;
-					float NewBlockPct = Hit.Time;
-					NewBlockPct += (1.f - NewBlockPct) * (1.f - Weight);
+				Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
 
-					// Recompute blocked pct taking into account pushout distance.
-					NewBlockPct = ((Hit.Location - SafeLoc).Size() - CollisionPushOutDistance) / (RayTarget - SafeLoc).Size();
+				const float NewBlockPct = bHit ? GetFeelerBlockedPct(Hit, ViewTarget, SafeLoc, RayTarget, SphereParams) : 1.f;
+				if (NewBlockPct < 1.f)
+				{
 					DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
 
 					// This feeler got a hit, so do another trace next frame
 					Feeler.FramesUntilNextTrace = 0;
-
-#if ENABLE_DRAW_DEBUG
-					DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
 				}
+
+				bTracedThisFrame = true;
 			}
+		}
+		else
+		{
+			--Feeler.FramesUntilNextTrace;
+		}
 
+		if (bTracedThisFrame)
+		{
 			if (RayIdx == 0)
 			{
 				// don't interpolate toward this one, snap to it
@@ -300,10 +409,6 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 				SoftBlockedPct = DistBlockedPctThisFrame;
 			}
 		}
-		else
-		{
-			--Feeler.FramesUntilNextTrace;
-		}
 	}
 
 	if (bResetInterpolation)
@@ -6,10 +6,21 @@
 #include "Curves/CurveFloat.h"
 #include "LyraPenetrationAvoidanceFeeler.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 #include "LyraCameraMode_ThirdPerson.generated.h"
 
 class UCurveVector;
 
+/** A predictive feeler sweep submitted asynchronously, consumed the following frame */
+struct FLyraPendingFeelerTrace
+{
+	FTraceHandle Handle;
+
+	// The ray the sweep was submitted with, hits are converted to a blocked percentage of that ray
+	FVector SafeLoc = FVector::ZeroVector;
+	FVector RayTarget = FVector::ZeroVector;
+};
+
 /**
  * ULyraCameraMode_ThirdPerson
  *
@@ -24,6 +35,18 @@ public:
 
 	ULyraCameraMode_ThirdPerson();
 
+	/** Blocked percentage of a feeler ray given the location of its hit, taking the push out distance into account */
+	static float ComputeFeelerBlockedPct(const FVector& HitLocation, const FVector& SafeLoc, const FVector& RayTarget, float PushOutDistance);
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets tests run the penetration avoidance on its own and inspect the async predictive feelers
+	void PreventCameraPenetrationForTesting(const AActor& ViewTarget, const FVector& SafeLoc, FVector& CameraLoc, float DeltaTime) { PreventCameraPenetration(ViewTarget, SafeLoc, CameraLoc, DeltaTime, AimLineToDesiredPosBlockedPct, /*bSingleRayOnly=*/ false); }
+	void UpdateFeelerIntervalScaleForTesting(float DeltaTime) { UpdateFeelerIntervalScale(DeltaTime); }
+	const TArray<FLyraPendingFeelerTrace>& GetPendingFeelerTracesForTesting() const { return PendingFeelerTraces; }
+	float GetFeelerIntervalScaleForTesting() const { return FeelerIntervalScale; }
+	void SetFeelerIntervalScaleForTesting(float Scale) { FeelerIntervalScale = Scale; }
+#endif
+
 protected:
 
 	virtual void UpdateView(float DeltaTime) override;
@@ -32,6 +55,12 @@ protected:
 	void UpdatePreventPenetration(float DeltaTime);
 	void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
 
+	/** Returns the percentage of the feeler ray left unblocked by the hit, or 1 if the hit should be ignored */
+	float GetFeelerBlockedPct(const FHitResult& Hit, const AActor& ViewTarget, const FVector& SafeLoc, const FVector& RayTarget, FCollisionQueryParams& SphereParams);
+
+	/** Updates FeelerIntervalScale from how fast the desired camera location and rotation are changing */
+	void UpdateFeelerIntervalScale(float DeltaTime);
+
 	virtual void DrawDebug(UCanvas* Canvas) const override;
 
 protected:
@@ -101,6 +130,18 @@ public:
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
 
+protected:
+
+	/** Async sweeps of the predictive feelers (index 1+), parallel to PenetrationAvoidanceFeelers */
+	TArray<FLyraPendingFeelerTrace> PendingFeelerTraces;
+
+	/** Multiplier applied to the trace interval of the predictive feelers, lower when the camera moves fast */
+	float FeelerIntervalScale = 1.0f;
+
+	FVector LastFeelerViewLocation = FVector::ZeroVector;
+	FRotator LastFeelerViewRotation = FRotator::ZeroRotator;
+	bool bHasLastFeelerView = false;
+
 protected:
 	
 	void SetTargetCrouchOffset(FVector NewTargetOffset);
@@ -110,5 +151,4 @@ protected:
 	FVector TargetCrouchOffset = FVector::ZeroVector;
 	float CrouchOffsetBlendPct = 1.0f;
 	FVector CurrentCrouchOffset = FVector::ZeroVector;
-	
 };
@@ -8,6 +8,7 @@
 #include "Character/LyraPawnExtensionComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "LyraCharacterMovementComponent.h"
 #include "LyraGameplayTags.h"
 #include "LyraLogChannels.h"
@@ -27,6 +28,23 @@ class UInputComponent;
 static FName NAME_LyraCharacterCollisionProfile_Capsule(TEXT("LyraPawnCapsule"));
 static FName NAME_LyraCharacterCollisionProfile_Mesh(TEXT("LyraPawnMesh"));
 
+namespace LyraCharacterCVars
+{
+	static bool bPackSharedMovement = true;
+	static FAutoConsoleVariableRef CVarPackSharedMovement(
+		TEXT("Lyra.FastShared.PackMovement"),
+		bPackSharedMovement,
+		TEXT("Send FastShared movement updates in the packed format (delta compressed against periodic keyframes) instead of full FRepMovement states"),
+		ECVF_Default);
+
+	static float SharedMovementLowPrecisionDistance = 4000.0f;
+	static FAutoConsoleVariableRef CVarSharedMovementLowPrecisionDistance(
+		TEXT("Lyra.FastShared.LowPrecisionDistance"),
+		SharedMovementLowPrecisionDistance,
+		TEXT("Characters further than this from every other player send packed FastShared updates at low precision (whole cm, 6 bit rotation axes). <= 0 disables low precision"),
+		ECVF_Default);
+}
+
 ALyraCharacter::ALyraCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<ULyraCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
@@ -531,6 +549,14 @@ bool ALyraCharacter::UpdateSharedReplication()
 		FSharedRepMovement SharedMovement;
 		if (SharedMovement.FillForCharacter(this))
 		{
+			const double Time = GetWorld()->GetTimeSeconds();
+			if (LyraCharacterCVars::bPackSharedMovement)
+			{
+				// Significance is only reevaluated on keyframes, since changing the precision forces one anyway
+				const bool bLowPrecision = SharedMovementBaseline.WantsKeyframe(Time) ? IsSharedMovementLowSignificance() : SharedMovementBaseline.IsLowPrecision();
+				SharedMovement.PackAgainst(SharedMovementBaseline, bLowPrecision, Time);
+			}
+
 			// Only call FastSharedReplication if data has changed since the last frame.
 			// Skipping this call will cause replication to reuse the same bunch that we previously
 			// produced, but not send it to clients that already received. (But a new client who has not received
@@ -540,6 +566,11 @@ bool ALyraCharacter::UpdateSharedReplication()
 				LastSharedReplication = SharedMovement;
 				ReplicatedMovementMode = SharedMovement.RepMovementMode;
 
+				if (SharedMovement.bPacked)
+				{
+					SharedMovementBaseline.OnPackedSent(SharedMovement.Packed, SharedMovement.QuantizedState, Time);
+				}
+
 				FastSharedReplication(SharedMovement);
 			}
 			return true;
@@ -550,6 +581,29 @@ bool ALyraCharacter::UpdateSharedReplication()
 	return false;
 }
 
+bool ALyraCharacter::IsSharedMovementLowSignificance() const
+{
+	const float LowPrecisionDistance = LyraCharacterCVars::SharedMovementLowPrecisionDistance;
+	if (LowPrecisionDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	// FastShared updates are shared by every connection, so the closest player decides
+	const FVector Location = GetActorLocation();
+	const double LowPrecisionDistanceSquared = FMath::Square(LowPrecisionDistance);
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PC = Iterator->Get();
+		if (PC && (PC != GetController()) && (FVector::DistSquared(PC->GetFocalLocation(), Location) < LowPrecisionDistanceSquared))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void ALyraCharacter::FastSharedReplication_Implementation(const FSharedRepMovement& SharedRepMovement)
 {
 	if (GetWorld()->IsPlayingReplay())
@@ -560,6 +614,13 @@ void ALyraCharacter::FastSharedReplication_Implementation(const FSharedRepMoveme
 	// Timestamp is checked to reject old moves.
 	if (GetLocalRole() == ROLE_SimulatedProxy)
 	{
+		// Packed updates are resolved against the last keyframe received first, and dropped if it is missing
+		FRepMovement ResolvedMovement = SharedRepMovement.RepMovement;
+		if (SharedRepMovement.bPacked && !SharedRepMovement.Unpack(SharedMovementBaseline, GetWorld()->GetTimeSeconds(), /*out*/ ResolvedMovement))
+		{
+			return;
+		}
+
 		// Timestamp
 		ReplicatedServerLastTransformUpdateTimeStamp = SharedRepMovement.RepTimeStamp;
 
@@ -573,7 +634,7 @@ void ALyraCharacter::FastSharedReplication_Implementation(const FSharedRepMoveme
 
 		// Location, Rotation, Velocity, etc.
 		FRepMovement& MutableRepMovement = GetReplicatedMovement_Mutable();
-		MutableRepMovement = SharedRepMovement.RepMovement;
+		MutableRepMovement = ResolvedMovement;
 
 		// This also sets LastRepMovement
 		OnRep_ReplicatedMovement();
@@ -623,21 +684,56 @@ bool FSharedRepMovement::FillForCharacter(ACharacter* Character)
 	return false;
 }
 
-bool FSharedRepMovement::Equals(const FSharedRepMovement& Other, ACharacter* Character) const
+void FSharedRepMovement::PackAgainst(const FLyraPackedMovementBaseline& Baseline, bool bLowPrecision, double Time)
+{
+	QuantizedState = FLyraPackedMovementState::Quantize(RepMovement.Location, RepMovement.Rotation, RepMovement.LinearVelocity, bLowPrecision);
+	Baseline.Pack(QuantizedState, bLowPrecision, Time, /*out*/ Packed);
+	bPacked = true;
+}
+
+bool FSharedRepMovement::Unpack(FLyraPackedMovementBaseline& Baseline, double Time, FRepMovement& OutRepMovement) const
 {
-	if (RepMovement.Location != Other.RepMovement.Location)
+	FLyraPackedMovementState Resolved;
+	if (!Baseline.Unpack(Packed, Time, /*out*/ Resolved))
 	{
 		return false;
 	}
 
-	if (RepMovement.Rotation != Other.RepMovement.Rotation)
+	Resolved.Dequantize(Packed.bLowPrecision, /*out*/ OutRepMovement.Location, /*out*/ OutRepMovement.Rotation, /*out*/ OutRepMovement.LinearVelocity);
+	return true;
+}
+
+bool FSharedRepMovement::Equals(const FSharedRepMovement& Other, ACharacter* Character) const
+{
+	if (bPacked != Other.bPacked)
 	{
 		return false;
 	}
 
-	if (RepMovement.LinearVelocity != Other.RepMovement.LinearVelocity)
+	if (bPacked)
 	{
-		return false;
+		// Only what survives quantization matters
+		if ((QuantizedState != Other.QuantizedState) || (Packed.bLowPrecision != Other.Packed.bLowPrecision))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		if (RepMovement.Location != Other.RepMovement.Location)
+		{
+			return false;
+		}
+
+		if (RepMovement.Rotation != Other.RepMovement.Rotation)
+		{
+			return false;
+		}
+
+		if (RepMovement.LinearVelocity != Other.RepMovement.LinearVelocity)
+		{
+			return false;
+		}
 	}
 
 	if (RepMovementMode != Other.RepMovementMode)
@@ -661,10 +757,28 @@ bool FSharedRepMovement::Equals(const FSharedRepMovement& Other, ACharacter* Cha
 bool FSharedRepMovement::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
 	bOutSuccess = true;
-	RepMovement.NetSerialize(Ar, Map, bOutSuccess);
-	Ar << RepMovementMode;
-	Ar << bProxyIsJumpForceApplied;
-	Ar << bIsCrouched;
+
+	uint8 bPackedFormat = bPacked;
+	Ar.SerializeBits(&bPackedFormat, 1);
+	bPacked = (bPackedFormat != 0);
+
+	if (bPacked)
+	{
+		Packed.NetSerialize(Ar);
+		Ar << RepMovementMode;
+
+		uint8 Flags = (bProxyIsJumpForceApplied ? 1 : 0) | (bIsCrouched ? 2 : 0);
+		Ar.SerializeBits(&Flags, 2);
+		bProxyIsJumpForceApplied = (Flags & 1) != 0;
+		bIsCrouched = (Flags & 2) != 0;
+	}
+	else
+	{
+		RepMovement.NetSerialize(Ar, Map, bOutSuccess);
+		Ar << RepMovementMode;
+		Ar << bProxyIsJumpForceApplied;
+		Ar << bIsCrouched;
+	}
 
 	// Timestamp, if non-zero.
 	uint8 bHasTimeStamp = (RepTimeStamp != 0.f);
@@ -678,5 +792,6 @@ bool FSharedRepMovement::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool
 		RepTimeStamp = 0.f;
 	}
 
+	bOutSuccess &= !Ar.IsError();
 	return true;
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "AbilitySystemInterface.h"
+#include "Character/LyraSharedMovementPacking.h"
 #include "GameplayCueInterface.h"
 #include "GameplayTagAssetInterface.h"
 #include "ModularCharacter.h"
@@ -57,6 +58,12 @@ struct FSharedRepMovement
 	bool FillForCharacter(ACharacter* Character);
 	bool Equals(const FSharedRepMovement& Other, ACharacter* Character) const;
 
+	// Switches to the packed format, quantizing RepMovement and packing it against the keyframe of the baseline
+	void PackAgainst(const FLyraPackedMovementBaseline& Baseline, bool bLowPrecision, double Time);
+
+	// Resolves a packed update against the last keyframe received, returns false if it has to be dropped
+	bool Unpack(FLyraPackedMovementBaseline& Baseline, double Time, FRepMovement& OutRepMovement) const;
+
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 
 	UPROPERTY(Transient)
@@ -73,6 +80,14 @@ struct FSharedRepMovement
 
 	UPROPERTY(Transient)
 	bool bIsCrouched = false;
+
+	// Whether Packed is sent instead of RepMovement
+	bool bPacked = false;
+
+	FLyraPackedMovement Packed;
+
+	// Full quantized state Packed was made from, only valid on the server
+	FLyraPackedMovementState QuantizedState;
 };
 
 template<>
@@ -144,8 +159,14 @@ public:
 	// Last FSharedRepMovement we sent, to avoid sending repeatedly.
 	FSharedRepMovement LastSharedReplication;
 
+	// Keyframe stream of the packed FastShared format: the last keyframe sent on the server, the last one received on clients
+	FLyraPackedMovementBaseline SharedMovementBaseline;
+
 	virtual bool UpdateSharedReplication();
 
+	// Whether no other player is close enough for this character to need full precision FastShared updates
+	bool IsSharedMovementLowSignificance() const;
+
 protected:
 
 	virtual void OnAbilitySystemInitialized();
@@ -4,9 +4,12 @@
 
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "Character/LyraGroundProbeSubsystem.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCharacterMovementComponent)
 
@@ -16,6 +19,13 @@ namespace LyraCharacter
 {
 	static float GroundTraceDistance = 100000.0f;
 	FAutoConsoleVariableRef CVar_GroundTraceDistance(TEXT("LyraCharacter.GroundTraceDistance"), GroundTraceDistance, TEXT("Distance to trace down when generating ground information."), ECVF_Cheat);
+
+	static bool bUseAnimSnapshot = true;
+	static FAutoConsoleVariableRef CVarUseAnimSnapshot(
+		TEXT("Lyra.Anim.UseMovementSnapshot"),
+		bUseAnimSnapshot,
+		TEXT("If true, movement ticks build a snapshot of the movement state that anim instances copy to derive their state on worker threads, instead of querying the movement component on the game thread"),
+		ECVF_Default);
 };
 
 
@@ -77,8 +87,13 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 		FCollisionResponseParams ResponseParam;
 		InitCollisionParams(QueryParams, ResponseParam);
 
+		// Answered from the batched probe queued last frame when possible, traced synchronously otherwise
 		FHitResult HitResult;
-		GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam);
+		ULyraGroundProbeSubsystem* GroundProbes = ULyraGroundProbeSubsystem::IsEnabled() ? GetWorld()->GetSubsystem<ULyraGroundProbeSubsystem>() : nullptr;
+		if (!GroundProbes || !GroundProbes->RequestGroundHit(this, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam, /*out*/ HitResult))
+		{
+			GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, CollisionChannel, QueryParams, ResponseParam);
+		}
 
 		CachedGroundInfo.GroundHitResult = HitResult;
 		CachedGroundInfo.GroundDistance = LyraCharacter::GroundTraceDistance;
@@ -98,6 +113,43 @@ const FLyraCharacterGroundInfo& ULyraCharacterMovementComponent::GetGroundInfo()
 	return CachedGroundInfo;
 }
 
+void ULyraCharacterMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// The skeletal mesh ticks after the movement component, so this is after the move and before the animation update
+	if (LyraCharacter::bUseAnimSnapshot && ShouldUpdateAnimSnapshot())
+	{
+		UpdateAnimSnapshot();
+	}
+}
+
+bool ULyraCharacterMovementComponent::IsAnimSnapshotEnabled()
+{
+	return LyraCharacter::bUseAnimSnapshot;
+}
+
+bool ULyraCharacterMovementComponent::ShouldUpdateAnimSnapshot() const
+{
+	const USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+	return Mesh && Mesh->GetAnimInstance() && Mesh->ShouldTickPose();
+}
+
+void ULyraCharacterMovementComponent::UpdateAnimSnapshot()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_LyraCharacterMovement_UpdateAnimSnapshot);
+
+	const FLyraCharacterGroundInfo& GroundInfo = GetGroundInfo();
+
+	AnimSnapshot.Velocity = Velocity;
+	AnimSnapshot.Acceleration = GetCurrentAcceleration();
+	AnimSnapshot.GroundDistance = GroundInfo.GroundDistance;
+	AnimSnapshot.MovementMode = MovementMode;
+	AnimSnapshot.bIsMovingOnGround = IsMovingOnGround();
+	AnimSnapshot.bIsCrouching = IsCrouching();
+	AnimSnapshot.LastUpdateFrame = GFrameCounter;
+}
+
 void ULyraCharacterMovementComponent::SetReplicatedAcceleration(const FVector& InAcceleration)
 {
 	bHasReplicatedAcceleration = true;
@@ -37,6 +37,40 @@ struct FLyraCharacterGroundInfo
 };
 
 
+/**
+ * FLyraCharacterAnimSnapshot
+ *
+ *	Movement state the animation update needs, built on the game thread by the movement component at the end of its tick,
+ *	after the move and before the skeletal mesh updates the animation, so that anim instances only copy it and run the
+ *	rest of their update on worker threads. It is not built when the animation is not going to update (e.g., off screen).
+ */
+USTRUCT(BlueprintType)
+struct FLyraCharacterAnimSnapshot
+{
+	GENERATED_BODY()
+
+	uint64 LastUpdateFrame = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector Acceleration = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	float GroundDistance = -1.0f;
+
+	UPROPERTY(BlueprintReadOnly)
+	TEnumAsByte<EMovementMode> MovementMode = MOVE_None;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsMovingOnGround = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsCrouching = false;
+};
+
+
 /**
  * ULyraCharacterMovementComponent
  *
@@ -59,8 +93,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|CharacterMovement")
 	const FLyraCharacterGroundInfo& GetGroundInfo();
 
+	// Returns the animation snapshot built at the end of the last movement tick
+	const FLyraCharacterAnimSnapshot& GetAnimSnapshot() const { return AnimSnapshot; }
+
+	// True if movement ticks build the animation snapshot and anim instances read it (Lyra.Anim.UseMovementSnapshot)
+	static bool IsAnimSnapshotEnabled();
+
 	void SetReplicatedAcceleration(const FVector& InAcceleration);
 
+	//~UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
+
 	//~UMovementComponent interface
 	virtual FRotator GetDeltaRotation(float DeltaTime) const override;
 	virtual float GetMaxSpeed() const override;
@@ -75,6 +119,13 @@ protected:
 	// Cached ground info for the character.  Do not access this directly!  It's only updated when accessed via GetGroundInfo().
 	FLyraCharacterGroundInfo CachedGroundInfo;
 
+	// True if the skeletal mesh is going to update its animation this frame
+	bool ShouldUpdateAnimSnapshot() const;
+	void UpdateAnimSnapshot();
+
+	// Snapshot of the movement state for the animation update, rebuilt at the end of the movement tick
+	FLyraCharacterAnimSnapshot AnimSnapshot;
+
 	UPROPERTY(Transient)
 	bool bHasReplicatedAcceleration = false;
 };
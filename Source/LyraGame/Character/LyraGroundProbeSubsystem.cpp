@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/LyraGroundProbeSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGroundProbeSubsystem)
+
+namespace LyraGroundProbeCVars
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("Lyra.GroundProbe.Enabled"),
+		bEnabled,
+		TEXT("If true, ground probes of characters that are not walking are batched as async traces and answered from the previous frame"),
+		ECVF_Default);
+
+	static float MaxHorizontalOffset = 25.0f;
+	static FAutoConsoleVariableRef CVarMaxHorizontalOffset(
+		TEXT("Lyra.GroundProbe.MaxHorizontalOffset"),
+		MaxHorizontalOffset,
+		TEXT("Horizontal distance a character can move in a frame and still be answered with the probe it queued the previous frame, projected on the ground it hit. Ledges and steps crossed within that distance show up one frame late"),
+		ECVF_Default);
+
+	static float MinSharedNormalZ = 0.98f;
+	static FAutoConsoleVariableRef CVarMinSharedNormalZ(
+		TEXT("Lyra.GroundProbe.MinSharedNormalZ"),
+		MinSharedNormalZ,
+		TEXT("Minimum Z of the ground normal for the previous probe to answer a probe started at a horizontal offset from it"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraGroundProbeSubsystem
+
+ULyraGroundProbeSubsystem::ULyraGroundProbeSubsystem()
+{
+}
+
+bool ULyraGroundProbeSubsystem::IsEnabled()
+{
+	return LyraGroundProbeCVars::bEnabled;
+}
+
+bool ULyraGroundProbeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+TStatId ULyraGroundProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraGroundProbeSubsystem, STATGROUP_Tickables);
+}
+
+bool ULyraGroundProbeSubsystem::CanConvertHit(const FProbe& Probe, const FVector& Start, const FVector& End, ECollisionChannel Channel)
+{
+	if (Probe.Channel != Channel)
+	{
+		return false;
+	}
+
+	// Anywhere else than straight above, the ground only matches if it is flat enough to follow its plane
+	const float HorizontalOffsetSq = FVector2D(Start - Probe.Start).SizeSquared();
+	if (HorizontalOffsetSq > FMath::Square(UE_KINDA_SMALL_NUMBER))
+	{
+		const bool bFlatGround = !Probe.Hit.bBlockingHit || (Probe.Hit.ImpactNormal.Z >= LyraGroundProbeCVars::MinSharedNormalZ);
+		if (!bFlatGround || (HorizontalOffsetSq > FMath::Square(LyraGroundProbeCVars::MaxHorizontalOffset)))
+		{
+			return false;
+		}
+	}
+
+	// Above the start of the previous probe is where the requester just moved through. Below it, only down to what
+	// the previous probe hit, and not further than it reached if it hit nothing
+	return Probe.Hit.bBlockingHit ? (Start.Z >= Probe.Hit.Location.Z) : (End.Z >= Probe.End.Z);
+}
+
+void ULyraGroundProbeSubsystem::ConvertHit(const FProbe& Probe, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	const float TraceLength = Start.Z - End.Z;
+
+	OutHit = Probe.Hit;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+
+	if (Probe.Hit.bBlockingHit)
+	{
+		// Keep the horizontal position of the new trace and find the ground height on the plane of the previous hit,
+		// which is the previous height when both probes started from the same position
+		const FVector& Normal = Probe.Hit.ImpactNormal;
+		const float DeltaX = Start.X - Probe.Start.X;
+		const float DeltaY = Start.Y - Probe.Start.Y;
+		const float GroundDeltaZ = (Normal.Z > UE_KINDA_SMALL_NUMBER) ? -((Normal.X * DeltaX) + (Normal.Y * DeltaY)) / Normal.Z : 0.0f;
+
+		OutHit.Location = FVector(Start.X, Start.Y, Probe.Hit.Location.Z + GroundDeltaZ);
+		OutHit.ImpactPoint = FVector(Start.X, Start.Y, Probe.Hit.ImpactPoint.Z + GroundDeltaZ);
+		OutHit.Distance = Start.Z - OutHit.Location.Z;
+		OutHit.Time = (TraceLength > 0.0f) ? (OutHit.Distance / TraceLength) : 0.0f;
+	}
+	else
+	{
+		OutHit.Location = End;
+		OutHit.Time = 1.0f;
+	}
+}
+
+bool ULyraGroundProbeSubsystem::RequestGroundHit(const UObject* Requester, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& QueryParams, const FCollisionResponseParams& ResponseParams, FHitResult& OutHit)
+{
+	FRequester& RequesterState = Requesters.FindOrAdd(FObjectKey(Requester));
+
+	// Async results are only available the frame after they were issued
+	bool bFound = false;
+	if (RequesterState.Handle.IsValid() && ((RequesterState.IssueFrame + 1) == GFrameCounter))
+	{
+		FTraceDatum TraceData;
+		if (GetWorld()->QueryTraceData(RequesterState.Handle, /*out*/ TraceData))
+		{
+			FProbe& IssuedProbe = RequesterState.IssuedProbe;
+			const FHitResult* Hit = TraceData.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+			IssuedProbe.Hit = Hit ? *Hit : FHitResult(IssuedProbe.Start, IssuedProbe.End);
+
+			if (CanConvertHit(IssuedProbe, Start, End, Channel))
+			{
+				ConvertHit(IssuedProbe, Start, End, /*out*/ OutHit);
+				bFound = true;
+			}
+		}
+	}
+	RequesterState.Handle = FTraceHandle();
+
+	RequesterState.QueuedProbe.Start = Start;
+	RequesterState.QueuedProbe.End = End;
+	RequesterState.QueuedProbe.Channel = Channel;
+	RequesterState.QueryParams = QueryParams;
+	RequesterState.ResponseParams = ResponseParams;
+	RequesterState.bHasQueuedProbe = true;
+	RequesterState.LastRequestFrame = GFrameCounter;
+
+	return bFound;
+}
+
+void ULyraGroundProbeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+
+	// Issue everything queued this frame together, the engine traces them in one batch at the end of the frame
+	for (auto It = Requesters.CreateIterator(); It; ++It)
+	{
+		FRequester& RequesterState = It.Value();
+		if (RequesterState.bHasQueuedProbe)
+		{
+			const FProbe& QueuedProbe = RequesterState.QueuedProbe;
+			RequesterState.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, QueuedProbe.Start, QueuedProbe.End, QueuedProbe.Channel, RequesterState.QueryParams, RequesterState.ResponseParams);
+			RequesterState.IssuedProbe = QueuedProbe;
+			RequesterState.IssueFrame = GFrameCounter;
+			RequesterState.bHasQueuedProbe = false;
+		}
+		else if ((RequesterState.LastRequestFrame + 1) < GFrameCounter)
+		{
+			// Stopped asking (landed, destroyed, ...), it starts over with a synchronous trace if it asks again
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+
+#include "LyraGroundProbeSubsystem.generated.h"
+
+class UObject;
+
+/**
+ * ULyraGroundProbeSubsystem
+ *
+ * Batches the straight down ground probes used by ULyraCharacterMovementComponent::GetGroundInfo for characters
+ * that are not walking.
+ *
+ * Every frame, each requester (the movement component asking) queues its probe, and the subsystem issues all of
+ * them together as async traces, which the engine runs as one batch at the end of the frame. The next frame, the
+ * requester is answered with the result of its own probe from the previous frame, converted to where it is now:
+ * the ground height is projected on the plane of the previous hit, as long as the requester moved horizontally by
+ * no more than Lyra.GroundProbe.MaxHorizontalOffset and, if it moved at all, the ground is flat enough
+ * (Lyra.GroundProbe.MinSharedNormalZ). Rising is always fine, the requester just moved through that space.
+ * The answer can be one frame stale: a ledge or step crossed within that offset shows up one frame late.
+ * Only requesters without a usable result from the previous frame (e.g., on the first frame) trace synchronously.
+ */
+UCLASS()
+class LYRAGAME_API ULyraGroundProbeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraGroundProbeSubsystem();
+
+	// Returns true if ground probes should go through the batched async probes
+	static bool IsEnabled();
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Queues a trace straight down from Start to End for this frame's batch, and returns the result of the probe the
+	// requester queued last frame converted to this trace. Returns false if there is none usable, in which case the
+	// caller should trace synchronously.
+	bool RequestGroundHit(const UObject* Requester, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& QueryParams, const FCollisionResponseParams& ResponseParams, FHitResult& OutHit);
+
+	// Number of requesters with a probe queued or in flight
+	int32 GetNumRequesters() const { return Requesters.Num(); }
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	struct FProbe
+	{
+		FHitResult Hit;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		TEnumAsByte<ECollisionChannel> Channel = ECC_Pawn;
+	};
+
+	struct FRequester
+	{
+		// Probe queued this frame, issued with the rest of the batch when the subsystem ticks
+		FProbe QueuedProbe;
+		FCollisionQueryParams QueryParams;
+		FCollisionResponseParams ResponseParams;
+		bool bHasQueuedProbe = false;
+
+		// Probe issued last frame, its result is read by the next request
+		FProbe IssuedProbe;
+		FTraceHandle Handle;
+		uint64 IssueFrame = 0;
+
+		uint64 LastRequestFrame = 0;
+	};
+
+	// Returns true if the result of Probe can be converted to a trace from Start to End
+	static bool CanConvertHit(const FProbe& Probe, const FVector& Start, const FVector& End, ECollisionChannel Channel);
+
+	// Converts the result of Probe into the hit a trace from Start to End would have produced, following the plane
+	// of the ground it hit if Start is horizontally offset from it
+	static void ConvertHit(const FProbe& Probe, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+	TMap<FObjectKey, FRequester> Requesters;
+};
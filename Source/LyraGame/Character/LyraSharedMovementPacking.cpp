@@ -0,0 +1,505 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Character/LyraSharedMovementPacking.h"
+
+#include "Character/LyraCharacter.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BitWriter.h"
+
+namespace LyraSharedMovementCVars
+{
+	static int32 KeyframeInterval = 8;
+	static FAutoConsoleVariableRef CVarKeyframeInterval(
+		TEXT("Lyra.FastShared.KeyframeInterval"),
+		KeyframeInterval,
+		TEXT("Number of packed FastShared movement updates per keyframe, the updates in between are sent as deltas against the last keyframe (1 sends only keyframes)"),
+		ECVF_Default);
+}
+
+namespace LyraSharedMovementPacking
+{
+	// Largest magnitude of a packed value, so its zigzag encoding always fits in 31 bits
+	static constexpr int64 MaxPackedValue = (1 << 30) - 1;
+
+	// Deltas are dropped on clients when their keyframe is older than this
+	static constexpr double MaxKeyframeAge = 1.0;
+
+	static constexpr uint8 KeyframeIdMask = (1 << FLyraPackedMovement::KeyframeIdBits) - 1;
+
+	static int32 GetLocationScale(bool bLowPrecision)
+	{
+		return bLowPrecision ? 1 : 100;
+	}
+
+	static int32 ClampToPacked(double Value)
+	{
+		return (int32)FMath::Clamp<int64>(FMath::RoundToInt64(Value), -MaxPackedValue, MaxPackedValue);
+	}
+
+	static uint8 QuantizeAxis(double Angle, bool bLowPrecision)
+	{
+		const uint8 Byte = FRotator::CompressAxisToByte(Angle);
+		return bLowPrecision ? (uint8)((Byte + 2) & 0xFC) : Byte;
+	}
+
+	static int64 DivideAndRoundNearest(int64 Dividend, int64 Divisor)
+	{
+		return (Dividend >= 0) ? ((Dividend + Divisor / 2) / Divisor) : ((Dividend - Divisor / 2) / Divisor);
+	}
+
+	// Keyframe location extrapolated by the keyframe velocity, in integer math so both ends agree exactly
+	static int64 PredictLocation(const FLyraPackedMovementState& Keyframe, int32 Axis, int32 ElapsedMs, bool bLowPrecision)
+	{
+		return (int64)Keyframe.Location[Axis] + DivideAndRoundNearest((int64)Keyframe.Velocity[Axis] * GetLocationScale(bLowPrecision) * ElapsedMs, 1000);
+	}
+
+	static bool MakeResidual(const FLyraPackedMovementState& Keyframe, const FLyraPackedMovementState& Absolute, int32 ElapsedMs, bool bLowPrecision, FLyraPackedMovementState& OutResidual)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const int64 LocationResidual = (int64)Absolute.Location[Axis] - PredictLocation(Keyframe, Axis, ElapsedMs, bLowPrecision);
+			const int64 VelocityResidual = (int64)Absolute.Velocity[Axis] - Keyframe.Velocity[Axis];
+			if ((FMath::Abs(LocationResidual) > MaxPackedValue) || (FMath::Abs(VelocityResidual) > MaxPackedValue))
+			{
+				return false;
+			}
+
+			OutResidual.Location[Axis] = (int32)LocationResidual;
+			OutResidual.Velocity[Axis] = (int32)VelocityResidual;
+		}
+
+		// Rotation deltas wrap around like the axes themselves
+		OutResidual.Pitch = (uint8)(Absolute.Pitch - Keyframe.Pitch);
+		OutResidual.Yaw = (uint8)(Absolute.Yaw - Keyframe.Yaw);
+		OutResidual.Roll = (uint8)(Absolute.Roll - Keyframe.Roll);
+		return true;
+	}
+
+	static FLyraPackedMovementState ApplyResidual(const FLyraPackedMovementState& Keyframe, const FLyraPackedMovementState& Residual, int32 ElapsedMs, bool bLowPrecision)
+	{
+		FLyraPackedMovementState Result;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Result.Location[Axis] = (int32)(PredictLocation(Keyframe, Axis, ElapsedMs, bLowPrecision) + Residual.Location[Axis]);
+			Result.Velocity[Axis] = (int32)((int64)Keyframe.Velocity[Axis] + Residual.Velocity[Axis]);
+		}
+
+		Result.Pitch = (uint8)(Keyframe.Pitch + Residual.Pitch);
+		Result.Yaw = (uint8)(Keyframe.Yaw + Residual.Yaw);
+		Result.Roll = (uint8)(Keyframe.Roll + Residual.Roll);
+		return Result;
+	}
+
+	// Sends the number of significant bits of the largest component followed by the zigzag encoded components,
+	// so small vectors (and residuals in particular) only cost a few bits per axis
+	static void SerializePackedVector(FArchive& Ar, FIntVector& Vector)
+	{
+		uint32 ZigZag[3] = { 0, 0, 0 };
+		uint32 NumBits = 0;
+		if (Ar.IsSaving())
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				ZigZag[Axis] = ((uint32)Vector[Axis] << 1) ^ (uint32)(Vector[Axis] >> 31);
+				NumBits = FMath::Max<uint32>(NumBits, (ZigZag[Axis] != 0) ? (FMath::FloorLog2(ZigZag[Axis]) + 1) : 0);
+			}
+		}
+
+		Ar.SerializeInt(NumBits, 32);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Ar.SerializeBits(&ZigZag[Axis], NumBits);
+			Vector[Axis] = (int32)(ZigZag[Axis] >> 1) ^ -(int32)(ZigZag[Axis] & 1);
+		}
+	}
+
+	static void SerializePackedAxis(FArchive& Ar, uint8& Value, bool bLowPrecision)
+	{
+		uint8 bNonZero = (Value != 0);
+		Ar.SerializeBits(&bNonZero, 1);
+		if (bNonZero)
+		{
+			uint8 Bits = bLowPrecision ? (Value >> 2) : Value;
+			Ar.SerializeBits(&Bits, bLowPrecision ? 6 : 8);
+			Value = bLowPrecision ? (uint8)(Bits << 2) : Bits;
+		}
+		else
+		{
+			Value = 0;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPackedMovementState
+
+FLyraPackedMovementState FLyraPackedMovementState::Quantize(const FVector& Location, const FRotator& Rotation, const FVector& Velocity, bool bLowPrecision)
+{
+	using namespace LyraSharedMovementPacking;
+
+	const int32 LocationScale = GetLocationScale(bLowPrecision);
+
+	FLyraPackedMovementState Result;
+	Result.Location = FIntVector(ClampToPacked(Location.X * LocationScale), ClampToPacked(Location.Y * LocationScale), ClampToPacked(Location.Z * LocationScale));
+	Result.Velocity = FIntVector(ClampToPacked(Velocity.X), ClampToPacked(Velocity.Y), ClampToPacked(Velocity.Z));
+	Result.Pitch = QuantizeAxis(Rotation.Pitch, bLowPrecision);
+	Result.Yaw = QuantizeAxis(Rotation.Yaw, bLowPrecision);
+	Result.Roll = QuantizeAxis(Rotation.Roll, bLowPrecision);
+	return Result;
+}
+
+void FLyraPackedMovementState::Dequantize(bool bLowPrecision, FVector& OutLocation, FRotator& OutRotation, FVector& OutVelocity) const
+{
+	const double LocationScale = LyraSharedMovementPacking::GetLocationScale(bLowPrecision);
+
+	OutLocation = FVector(Location.X / LocationScale, Location.Y / LocationScale, Location.Z / LocationScale);
+	OutRotation = FRotator(FRotator::DecompressAxisFromByte(Pitch), FRotator::DecompressAxisFromByte(Yaw), FRotator::DecompressAxisFromByte(Roll));
+	OutVelocity = FVector(Velocity.X, Velocity.Y, Velocity.Z);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPackedMovement
+
+void FLyraPackedMovement::NetSerialize(FArchive& Ar)
+{
+	using namespace LyraSharedMovementPacking;
+
+	uint8 Flags = (bKeyframe ? 1 : 0) | (bLowPrecision ? 2 : 0);
+	Ar.SerializeBits(&Flags, 2);
+	bKeyframe = (Flags & 1) != 0;
+	bLowPrecision = (Flags & 2) != 0;
+
+	KeyframeId &= KeyframeIdMask;
+	Ar.SerializeBits(&KeyframeId, KeyframeIdBits);
+
+	if (bKeyframe)
+	{
+		ElapsedMs = 0;
+	}
+	else
+	{
+		Ar << ElapsedMs;
+	}
+
+	SerializePackedVector(Ar, State.Location);
+	SerializePackedVector(Ar, State.Velocity);
+	SerializePackedAxis(Ar, State.Pitch, bLowPrecision);
+	SerializePackedAxis(Ar, State.Yaw, bLowPrecision);
+	SerializePackedAxis(Ar, State.Roll, bLowPrecision);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraPackedMovementBaseline
+
+bool FLyraPackedMovementBaseline::WantsKeyframe(double Time) const
+{
+	if (!bValid || (NumDeltas + 1 >= LyraSharedMovementCVars::KeyframeInterval))
+	{
+		return true;
+	}
+
+	const double ElapsedMs = (Time - KeyframeTime) * 1000.0;
+	return (ElapsedMs < 0.0) || (FMath::RoundToInt32(ElapsedMs) > MAX_uint8);
+}
+
+void FLyraPackedMovementBaseline::Pack(const FLyraPackedMovementState& Absolute, bool bInLowPrecision, double Time, FLyraPackedMovement& OutPacked) const
+{
+	using namespace LyraSharedMovementPacking;
+
+	OutPacked.bLowPrecision = bInLowPrecision;
+
+	if (!WantsKeyframe(Time) && (bInLowPrecision == bLowPrecision))
+	{
+		const int32 ElapsedMs = FMath::RoundToInt32((Time - KeyframeTime) * 1000.0);
+		if (MakeResidual(Keyframe, Absolute, ElapsedMs, bLowPrecision, /*out*/ OutPacked.State))
+		{
+			OutPacked.bKeyframe = false;
+			OutPacked.KeyframeId = KeyframeId;
+			OutPacked.ElapsedMs = (uint8)ElapsedMs;
+			return;
+		}
+	}
+
+	// Either it is time for a keyframe or the state moved too far from the prediction (e.g., a teleport)
+	OutPacked.bKeyframe = true;
+	OutPacked.KeyframeId = (KeyframeId + 1) & KeyframeIdMask;
+	OutPacked.ElapsedMs = 0;
+	OutPacked.State = Absolute;
+}
+
+void FLyraPackedMovementBaseline::OnPackedSent(const FLyraPackedMovement& Packed, const FLyraPackedMovementState& Absolute, double Time)
+{
+	if (Packed.bKeyframe)
+	{
+		Keyframe = Absolute;
+		KeyframeTime = Time;
+		KeyframeId = Packed.KeyframeId;
+		bLowPrecision = Packed.bLowPrecision;
+		NumDeltas = 0;
+		bValid = true;
+	}
+	else
+	{
+		++NumDeltas;
+	}
+}
+
+bool FLyraPackedMovementBaseline::Unpack(const FLyraPackedMovement& Packed, double Time, FLyraPackedMovementState& OutAbsolute)
+{
+	if (Packed.bKeyframe)
+	{
+		Keyframe = Packed.State;
+		KeyframeTime = Time;
+		KeyframeId = Packed.KeyframeId;
+		bLowPrecision = Packed.bLowPrecision;
+		bValid = true;
+
+		OutAbsolute = Packed.State;
+		return true;
+	}
+
+	// The id wraps around quickly, the age check rules out matching a keyframe from a previous cycle
+	const bool bHasKeyframe = bValid && (KeyframeId == Packed.KeyframeId) && (bLowPrecision == Packed.bLowPrecision) && ((Time - KeyframeTime) <= LyraSharedMovementPacking::MaxKeyframeAge);
+	if (!bHasKeyframe)
+	{
+		return false;
+	}
+
+	OutAbsolute = LyraSharedMovementPacking::ApplyResidual(Keyframe, Packed.State, Packed.ElapsedMs, bLowPrecision);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+namespace LyraSharedMovementPacking
+{
+	static FString GetDefaultTracePath()
+	{
+		return FPaths::ProfilingDir() / TEXT("FastSharedMovementTrace.csv");
+	}
+
+	static int64 GetSerializedBits(FSharedRepMovement& Movement)
+	{
+		FBitWriter Writer(0, /*bAllowResize=*/ true);
+		bool bSuccess = true;
+		Movement.NetSerialize(Writer, nullptr, bSuccess);
+		return Writer.GetNumBits();
+	}
+}
+
+static void RecordSharedMovementTrace(const TArray<FString>& Args, UWorld* World)
+{
+	if (World == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Lyra.FastShared.RecordTrace requires a game world"));
+		return;
+	}
+
+	const double Duration = (Args.Num() > 0) ? FCString::Atod(*Args[0]) : 10.0;
+	const FString FileName = (Args.Num() > 1) ? Args[1] : LyraSharedMovementPacking::GetDefaultTracePath();
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Frame,Time,Pawn,LocationX,LocationY,LocationZ,Pitch,Yaw,Roll,VelocityX,VelocityY,VelocityZ,MovementMode,JumpForce,Crouched"));
+
+	TMap<TWeakObjectPtr<ALyraCharacter>, int32> PawnIndices;
+	TWeakObjectPtr<UWorld> WeakWorld(World);
+	const double StartTime = World->GetTimeSeconds();
+	int32 Frame = 0;
+
+	UE_LOG(LogLyra, Log, TEXT("Recording FastShared movement of every character for %.1f seconds"), Duration);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakWorld, StartTime, Duration, FileName, Lines, PawnIndices, Frame](float) mutable
+	{
+		UWorld* TraceWorld = WeakWorld.Get();
+		if (TraceWorld == nullptr)
+		{
+			UE_LOG(LogLyra, Warning, TEXT("World went away while recording the FastShared movement trace"));
+			return false;
+		}
+
+		const double Time = TraceWorld->GetTimeSeconds() - StartTime;
+		for (TActorIterator<ALyraCharacter> It(TraceWorld); It; ++It)
+		{
+			FSharedRepMovement Movement;
+			if (!Movement.FillForCharacter(*It))
+			{
+				continue;
+			}
+
+			const int32 PawnIndex = PawnIndices.FindOrAdd(*It, PawnIndices.Num());
+			const FRepMovement& RepMovement = Movement.RepMovement;
+			Lines.Add(FString::Printf(TEXT("%d,%.4f,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d"),
+				Frame, Time, PawnIndex,
+				RepMovement.Location.X, RepMovement.Location.Y, RepMovement.Location.Z,
+				RepMovement.Rotation.Pitch, RepMovement.Rotation.Yaw, RepMovement.Rotation.Roll,
+				RepMovement.LinearVelocity.X, RepMovement.LinearVelocity.Y, RepMovement.LinearVelocity.Z,
+				Movement.RepMovementMode, Movement.bProxyIsJumpForceApplied ? 1 : 0, Movement.bIsCrouched ? 1 : 0));
+		}
+		++Frame;
+
+		if (Time < Duration)
+		{
+			return true;
+		}
+
+		FFileHelper::SaveStringArrayToFile(Lines, *FileName);
+		UE_LOG(LogLyra, Log, TEXT("Recorded %d frames of %d characters to %s"), Frame, PawnIndices.Num(), *FileName);
+		return false;
+	}));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRecordSharedMovementTrace(
+	TEXT("Lyra.FastShared.RecordTrace"),
+	TEXT("Records the FastShared movement state of every character each frame for [Seconds=10] to [File=Saved/Profiling/FastSharedMovementTrace.csv]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(RecordSharedMovementTrace));
+
+static void CompareSharedMovementBandwidth(const TArray<FString>& Args, UWorld* World)
+{
+	using namespace LyraSharedMovementPacking;
+
+	const FString FileName = (Args.Num() > 0) ? Args[0] : GetDefaultTracePath();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FileName) || (Lines.Num() < 2))
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Could not load a FastShared movement trace from %s, record one with Lyra.FastShared.RecordTrace"), *FileName);
+		return;
+	}
+
+	struct FTraceSample
+	{
+		int32 Frame = 0;
+		double Time = 0.0;
+		int32 Pawn = 0;
+		FSharedRepMovement Movement;
+	};
+
+	TArray<FTraceSample> Samples;
+	Samples.Reserve(Lines.Num() - 1);
+	TArray<FString> Fields;
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		Lines[LineIndex].ParseIntoArray(Fields, TEXT(","));
+		if (Fields.Num() != 15)
+		{
+			continue;
+		}
+
+		FTraceSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.Frame = FCString::Atoi(*Fields[0]);
+		Sample.Time = FCString::Atod(*Fields[1]);
+		Sample.Pawn = FCString::Atoi(*Fields[2]);
+		Sample.Movement.RepMovement.Location = FVector(FCString::Atod(*Fields[3]), FCString::Atod(*Fields[4]), FCString::Atod(*Fields[5]));
+		Sample.Movement.RepMovement.Rotation = FRotator(FCString::Atod(*Fields[6]), FCString::Atod(*Fields[7]), FCString::Atod(*Fields[8]));
+		Sample.Movement.RepMovement.LinearVelocity = FVector(FCString::Atod(*Fields[9]), FCString::Atod(*Fields[10]), FCString::Atod(*Fields[11]));
+		Sample.Movement.RepMovementMode = (uint8)FCString::Atoi(*Fields[12]);
+		Sample.Movement.bProxyIsJumpForceApplied = FCString::Atoi(*Fields[13]) != 0;
+		Sample.Movement.bIsCrouched = FCString::Atoi(*Fields[14]) != 0;
+	}
+
+	// Treat every other recorded pawn as a viewer, like player pawns are on a server
+	float LowPrecisionDistance = 0.0f;
+	if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.FastShared.LowPrecisionDistance")))
+	{
+		LowPrecisionDistance = CVar->GetFloat();
+	}
+
+	struct FPawnStreams
+	{
+		FSharedRepMovement LastLegacy;
+		FSharedRepMovement LastPacked;
+		FLyraPackedMovementBaseline ServerBaseline;
+		FLyraPackedMovementBaseline ClientBaseline;
+		bool bSentLegacy = false;
+		bool bSentPacked = false;
+	};
+	TMap<int32, FPawnStreams> Streams;
+
+	int64 LegacyBits = 0;
+	int64 PackedBits = 0;
+	int32 NumLegacyUpdates = 0;
+	int32 NumPackedUpdates = 0;
+	int32 NumKeyframes = 0;
+	int32 NumLowPrecision = 0;
+	double MaxLocationError = 0.0;
+
+	for (int32 FrameStart = 0; FrameStart < Samples.Num();)
+	{
+		int32 FrameEnd = FrameStart + 1;
+		while ((FrameEnd < Samples.Num()) && (Samples[FrameEnd].Frame == Samples[FrameStart].Frame))
+		{
+			++FrameEnd;
+		}
+
+		for (int32 SampleIndex = FrameStart; SampleIndex < FrameEnd; ++SampleIndex)
+		{
+			const FTraceSample& Sample = Samples[SampleIndex];
+			FPawnStreams& PawnStreams = Streams.FindOrAdd(Sample.Pawn);
+
+			FSharedRepMovement Legacy = Sample.Movement;
+			if (!PawnStreams.bSentLegacy || !Legacy.Equals(PawnStreams.LastLegacy, nullptr))
+			{
+				LegacyBits += GetSerializedBits(Legacy);
+				++NumLegacyUpdates;
+				PawnStreams.LastLegacy = Legacy;
+				PawnStreams.bSentLegacy = true;
+			}
+
+			bool bLowPrecision = PawnStreams.ServerBaseline.IsLowPrecision();
+			if (PawnStreams.ServerBaseline.WantsKeyframe(Sample.Time))
+			{
+				bLowPrecision = (LowPrecisionDistance > 0.0f);
+				for (int32 OtherIndex = FrameStart; OtherIndex < FrameEnd; ++OtherIndex)
+				{
+					if ((OtherIndex != SampleIndex) && (FVector::DistSquared(Samples[OtherIndex].Movement.RepMovement.Location, Sample.Movement.RepMovement.Location) < FMath::Square(LowPrecisionDistance)))
+					{
+						bLowPrecision = false;
+						break;
+					}
+				}
+			}
+
+			FSharedRepMovement Packed = Sample.Movement;
+			Packed.PackAgainst(PawnStreams.ServerBaseline, bLowPrecision, Sample.Time);
+			if (!PawnStreams.bSentPacked || !Packed.Equals(PawnStreams.LastPacked, nullptr))
+			{
+				PawnStreams.ServerBaseline.OnPackedSent(Packed.Packed, Packed.QuantizedState, Sample.Time);
+				PackedBits += GetSerializedBits(Packed);
+				++NumPackedUpdates;
+				NumKeyframes += Packed.Packed.bKeyframe ? 1 : 0;
+				NumLowPrecision += Packed.Packed.bLowPrecision ? 1 : 0;
+				PawnStreams.LastPacked = Packed;
+				PawnStreams.bSentPacked = true;
+
+				FRepMovement Resolved;
+				if (Packed.Unpack(PawnStreams.ClientBaseline, Sample.Time, /*out*/ Resolved))
+				{
+					MaxLocationError = FMath::Max(MaxLocationError, FVector::Dist(Resolved.Location, Sample.Movement.RepMovement.Location));
+				}
+			}
+		}
+
+		FrameStart = FrameEnd;
+	}
+
+	UE_LOG(LogLyra, Log, TEXT("FastShared bandwidth over %d samples of %d characters from %s:"), Samples.Num(), Streams.Num(), *FileName);
+	UE_LOG(LogLyra, Log, TEXT("  Legacy: %d updates, %lld bytes, %.1f bits/update"), NumLegacyUpdates, (LegacyBits + 7) / 8, (double)LegacyBits / FMath::Max(NumLegacyUpdates, 1));
+	UE_LOG(LogLyra, Log, TEXT("  Packed: %d updates (%d keyframes, %d low precision), %lld bytes, %.1f bits/update, max location error %.3f cm"),
+		NumPackedUpdates, NumKeyframes, NumLowPrecision, (PackedBits + 7) / 8, (double)PackedBits / FMath::Max(NumPackedUpdates, 1), MaxLocationError);
+	UE_LOG(LogLyra, Log, TEXT("  Packed uses %.1f%% of the legacy bandwidth"), (LegacyBits > 0) ? (100.0 * PackedBits / LegacyBits) : 0.0);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdCompareSharedMovementBandwidth(
+	TEXT("Lyra.FastShared.CompareBandwidth"),
+	TEXT("Replays a movement trace recorded with Lyra.FastShared.RecordTrace from [File] and compares the FastShared bandwidth of the legacy and packed formats"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(CompareSharedMovementBandwidth));
+
+#endif // !UE_BUILD_SHIPPING
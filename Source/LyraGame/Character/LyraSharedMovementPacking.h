@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Math/IntVector.h"
+
+class FArchive;
+
+/**
+ * Quantized movement state used by the packed FastShared movement format.
+ *
+ * Location is stored in units of 1/100 cm (or whole cm for low precision), velocity in whole cm/s and
+ * rotation as one byte per axis (the low two bits are always zero for low precision). Everything is
+ * integer so the server and the clients reconstruct exactly the same values.
+ */
+struct FLyraPackedMovementState
+{
+	FIntVector Location = FIntVector::ZeroValue;
+	FIntVector Velocity = FIntVector::ZeroValue;
+	uint8 Pitch = 0;
+	uint8 Yaw = 0;
+	uint8 Roll = 0;
+
+	static FLyraPackedMovementState Quantize(const FVector& Location, const FRotator& Rotation, const FVector& Velocity, bool bLowPrecision);
+	void Dequantize(bool bLowPrecision, FVector& OutLocation, FRotator& OutRotation, FVector& OutVelocity) const;
+
+	bool operator==(const FLyraPackedMovementState& Other) const
+	{
+		return (Location == Other.Location) && (Velocity == Other.Velocity) && (Pitch == Other.Pitch) && (Yaw == Other.Yaw) && (Roll == Other.Roll);
+	}
+
+	bool operator!=(const FLyraPackedMovementState& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/**
+ * Wire payload of the packed format: either a keyframe, or the residual of the state against the
+ * prediction made from the keyframe it references (keyframe location extrapolated by the keyframe
+ * velocity over ElapsedMs, and the keyframe velocity and rotation unchanged).
+ */
+struct FLyraPackedMovement
+{
+	FLyraPackedMovementState State;
+
+	// Time between the referenced keyframe and this update, only sent for deltas
+	uint8 ElapsedMs = 0;
+
+	// Wraps around, only the low KeyframeIdBits bits are sent
+	uint8 KeyframeId = 0;
+
+	bool bKeyframe = true;
+	bool bLowPrecision = false;
+
+	static constexpr int32 KeyframeIdBits = 4;
+
+	void NetSerialize(FArchive& Ar);
+};
+
+/**
+ * One end of the keyframe stream of a character. FastShared updates are serialized once and shared by
+ * every connection, so instead of a baseline per connection the server periodically sends a keyframe
+ * that every following delta references, and each client keeps the last keyframe it received.
+ *
+ * Deltas referencing a keyframe the client does not have (it was lost, or the client only just started
+ * receiving updates) are dropped, regular movement replication and the next keyframe correct it.
+ */
+struct FLyraPackedMovementBaseline
+{
+public:
+	// Server: whether the next update is going to be a keyframe regardless of its contents
+	bool WantsKeyframe(double Time) const;
+
+	// Server: packs the quantized state, as a delta against the current keyframe when possible
+	void Pack(const FLyraPackedMovementState& Absolute, bool bLowPrecision, double Time, FLyraPackedMovement& OutPacked) const;
+
+	// Server: to be called once the packed update has actually been sent
+	void OnPackedSent(const FLyraPackedMovement& Packed, const FLyraPackedMovementState& Absolute, double Time);
+
+	// Client: reconstructs the quantized state, returns false if the referenced keyframe is not available
+	bool Unpack(const FLyraPackedMovement& Packed, double Time, FLyraPackedMovementState& OutAbsolute);
+
+	void Reset() { bValid = false; }
+
+	bool IsLowPrecision() const { return bLowPrecision; }
+
+private:
+	FLyraPackedMovementState Keyframe;
+	double KeyframeTime = 0.0;
+	int32 NumDeltas = 0;
+	uint8 KeyframeId = 0;
+	bool bLowPrecision = false;
+	bool bValid = false;
+};
@@ -0,0 +1,189 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Cosmetics/LyraCharacterPartSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "Cosmetics/LyraPawnComponent_CharacterParts.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCharacterPartSubsystem)
+
+namespace LyraCharacterPartCVars
+{
+	static bool bSliceSpawning = true;
+	static FAutoConsoleVariableRef CVarSliceSpawning(
+		TEXT("Lyra.CharacterParts.SliceSpawning"),
+		bSliceSpawning,
+		TEXT("If true, character parts of pawns that are not locally controlled are spawned over several frames within Lyra.CharacterParts.SpawnBudgetMs"),
+		ECVF_Default);
+
+	static float SpawnBudgetMs = 1.0f;
+	static FAutoConsoleVariableRef CVarSpawnBudgetMs(
+		TEXT("Lyra.CharacterParts.SpawnBudgetMs"),
+		SpawnBudgetMs,
+		TEXT("Game thread time per frame spent spawning queued character parts (at least one part is spawned per frame)"),
+		ECVF_Default);
+
+	static int32 MaxPooledPerClass = 16;
+	static FAutoConsoleVariableRef CVarMaxPooledPerClass(
+		TEXT("Lyra.CharacterParts.MaxPooledPerClass"),
+		MaxPooledPerClass,
+		TEXT("How many released character part actors of each class are kept around for reuse (0 disables pooling)"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraCharacterPartSubsystem
+
+ULyraCharacterPartSubsystem::ULyraCharacterPartSubsystem()
+{
+}
+
+bool ULyraCharacterPartSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+TStatId ULyraCharacterPartSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraCharacterPartSubsystem, STATGROUP_Tickables);
+}
+
+bool ULyraCharacterPartSubsystem::QueuePendingSpawns(ULyraPawnComponent_CharacterParts* Component)
+{
+	if (!LyraCharacterPartCVars::bSliceSpawning)
+	{
+		return false;
+	}
+
+	QueuedComponents.AddUnique(Component);
+	return true;
+}
+
+void ULyraCharacterPartSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (QueuedComponents.Num() == 0)
+	{
+		return;
+	}
+
+	// Components spawn at least one part before checking the time, so the queue always makes progress
+	const double EndTime = FPlatformTime::Seconds() + (LyraCharacterPartCVars::SpawnBudgetMs / 1000.0);
+
+	while (QueuedComponents.Num() > 0)
+	{
+		const TWeakObjectPtr<ULyraPawnComponent_CharacterParts> WeakComponent = QueuedComponents[0];
+		QueuedComponents.RemoveAt(0, 1, EAllowShrinking::No);
+
+		if (ULyraPawnComponent_CharacterParts* Component = WeakComponent.Get())
+		{
+			// The component may have queued itself again while broadcasting its changes, so dequeue it before spawning
+			if (!Component->SpawnPendingCharacterParts(EndTime))
+			{
+				// Out of budget, it keeps its place at the front of the queue
+				QueuedComponents.Remove(WeakComponent);
+				QueuedComponents.Insert(WeakComponent, 0);
+				break;
+			}
+		}
+
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+}
+
+AActor* ULyraCharacterPartSubsystem::AcquirePartActor(TSubclassOf<AActor> PartClass, AActor* Owner, USceneComponent* Parent, FName SocketName)
+{
+	AActor* PartActor = nullptr;
+
+	if (FLyraCharacterPartActorPool* Pool = Pools.Find(PartClass))
+	{
+		while ((PartActor == nullptr) && (Pool->Actors.Num() > 0))
+		{
+			AActor* Candidate = Pool->Actors.Pop(EAllowShrinking::No);
+			if (IsValid(Candidate))
+			{
+				PartActor = Candidate;
+			}
+		}
+	}
+
+	if (PartActor != nullptr)
+	{
+		// Restore what releasing the actor changed to how a freshly spawned one would start
+		const AActor* PartCDO = PartClass->GetDefaultObject<AActor>();
+		PartActor->SetOwner(Owner);
+		PartActor->SetActorEnableCollision(PartCDO->GetActorEnableCollision());
+		PartActor->SetActorHiddenInGame(PartCDO->IsHidden());
+		PartActor->SetActorTickEnabled(PartCDO->PrimaryActorTick.bStartWithTickEnabled);
+		PartActor->ForEachComponent(/*bIncludeFromChildActors=*/ false, [](UActorComponent* Component)
+		{
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		});
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Owner;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		PartActor = GetWorld()->SpawnActor<AActor>(PartClass, Parent->GetSocketTransform(SocketName), SpawnParams);
+	}
+
+	if (PartActor != nullptr)
+	{
+		PartActor->AttachToComponent(Parent, FAttachmentTransformRules::SnapToTargetNotIncludingScale, SocketName);
+	}
+
+	return PartActor;
+}
+
+void ULyraCharacterPartSubsystem::ReleasePartActor(AActor* PartActor)
+{
+	if (!IsValid(PartActor) || PartActor->IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	FLyraCharacterPartActorPool& Pool = Pools.FindOrAdd(PartActor->GetClass());
+	if (GetWorld()->bIsTearingDown || (Pool.Actors.Num() >= LyraCharacterPartCVars::MaxPooledPerClass))
+	{
+		PartActor->Destroy();
+		return;
+	}
+
+	if (USceneComponent* PartRootComponent = PartActor->GetRootComponent())
+	{
+		if (USceneComponent* Parent = PartRootComponent->GetAttachParent())
+		{
+			PartRootComponent->RemoveTickPrerequisiteComponent(Parent);
+		}
+	}
+
+	PartActor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	PartActor->SetActorHiddenInGame(true);
+	PartActor->SetActorEnableCollision(false);
+	PartActor->SetActorTickEnabled(false);
+	PartActor->ForEachComponent(/*bIncludeFromChildActors=*/ false, [](UActorComponent* Component)
+	{
+		Component->SetComponentTickEnabled(false);
+	});
+	PartActor->SetOwner(nullptr);
+
+	Pool.Actors.Add(PartActor);
+}
+
+int32 ULyraCharacterPartSubsystem::GetNumPooledActors() const
+{
+	int32 NumPooledActors = 0;
+	for (const auto& KVP : Pools)
+	{
+		NumPooledActors += KVP.Value.Actors.Num();
+	}
+	return NumPooledActors;
+}
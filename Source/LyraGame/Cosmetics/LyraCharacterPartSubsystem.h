@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+
+#include "LyraCharacterPartSubsystem.generated.h"
+
+class AActor;
+class UObject;
+class USceneComponent;
+class ULyraPawnComponent_CharacterParts;
+
+// Inactive part actors of one class, ready to be reused
+USTRUCT()
+struct FLyraCharacterPartActorPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * ULyraCharacterPartSubsystem
+ *
+ * Spreads the spawning of character part actors over several frames and keeps released part actors around
+ * for reuse, so many characters (re)spawning at once do not spike a single frame.
+ *
+ * Character part components queue themselves when they have parts waiting to be spawned, and the queue is
+ * serviced in order within a per-frame time budget. Part actors are pooled per class when their part is
+ * removed and handed out again, reattached to the new owner, instead of spawning a new actor.
+ */
+UCLASS()
+class LYRAGAME_API ULyraCharacterPartSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraCharacterPartSubsystem();
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Queues the component to have its pending parts spawned in a later frame. Returns false if spawning is not
+	// sliced, in which case the caller should spawn right away.
+	bool QueuePendingSpawns(ULyraPawnComponent_CharacterParts* Component);
+
+	// Returns an actor of the specified class attached to the parent, reusing a pooled one when possible. Pooled actors
+	// get the visibility, collision and tick state of their class defaults back, other state is kept from their last use.
+	AActor* AcquirePartActor(TSubclassOf<AActor> PartClass, AActor* Owner, USceneComponent* Parent, FName SocketName);
+
+	// Detaches, hides and stops ticking the actor and its components so it can be reused, or destroys it if the pool
+	// for its class is full
+	void ReleasePartActor(AActor* PartActor);
+
+	int32 GetNumQueuedComponents() const { return QueuedComponents.Num(); }
+	int32 GetNumPooledActors() const;
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	// Components with parts waiting to be spawned, oldest first
+	TArray<TWeakObjectPtr<ULyraPawnComponent_CharacterParts>> QueuedComponents;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FLyraCharacterPartActorPool> Pools;
+};
@@ -3,7 +3,9 @@
 #include "Cosmetics/LyraPawnComponent_CharacterParts.h"
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Cosmetics/LyraCharacterPartSubsystem.h"
 #include "Cosmetics/LyraCharacterPartTypes.h"
+#include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "GameplayTagAssetInterface.h"
 #include "Net/UnrealNetwork.h"
@@ -19,7 +21,7 @@ class UWorld;
 
 FString FLyraAppliedCharacterPartEntry::GetDebugString() const
 {
-	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedComponent));
+	return FString::Printf(TEXT("(PartClass: %s, Socket: %s, Instance: %s)"), *GetPathNameSafe(Part.PartClass), *Part.SocketName.ToString(), *GetPathNameSafe(SpawnedActor));
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -132,22 +134,31 @@ void FLyraCharacterPartList::ClearAllEntries(bool bBroadcastChangeDelegate)
 	}
 }
 
-FGameplayTagContainer FLyraCharacterPartList::CollectCombinedTags() const
+void FLyraCharacterPartList::AddCombinedTags(const FGameplayTagContainer& Tags)
 {
-	FGameplayTagContainer Result;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		int32& Count = CombinedTagCounts.FindOrAdd(Tag);
+		if (Count++ == 0)
+		{
+			CombinedTags.AddTag(Tag);
+		}
+	}
+}
 
-	for (const FLyraAppliedCharacterPartEntry& Entry : Entries)
+void FLyraCharacterPartList::RemoveCombinedTags(const FGameplayTagContainer& Tags)
+{
+	for (const FGameplayTag& Tag : Tags)
 	{
-		if (Entry.SpawnedComponent != nullptr)
+		if (int32* Count = CombinedTagCounts.Find(Tag))
 		{
-			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(Entry.SpawnedComponent->GetChildActor()))
+			if (--(*Count) <= 0)
 			{
-				TagInterface->GetOwnedGameplayTags(/*inout*/ Result);
+				CombinedTagCounts.Remove(Tag);
+				CombinedTags.RemoveTag(Tag);
 			}
 		}
 	}
-
-	return Result;
 }
 
 bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry& Entry)
@@ -158,42 +169,85 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 	{
 		if (Entry.Part.PartClass != nullptr)
 		{
-			UWorld* World = OwnerComponent->GetWorld();
-
-			if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
+			// Parts of the locally controlled pawn are spawned right away, other pawns wait for their turn
+			const APawn* OwningPawn = OwnerComponent->GetPawn<APawn>();
+			if ((OwningPawn == nullptr) || !OwningPawn->IsLocallyControlled())
 			{
-				const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
+				if (ULyraCharacterPartSubsystem* PartSubsystem = UWorld::GetSubsystem<ULyraCharacterPartSubsystem>(OwnerComponent->GetWorld()))
+				{
+					if (PartSubsystem->QueuePendingSpawns(OwnerComponent))
+					{
+						Entry.bSpawnPending = true;
+						return false;
+					}
+				}
+			}
 
-				UChildActorComponent* PartComponent = NewObject<UChildActorComponent>(OwnerComponent->GetOwner());
+			bCreatedAnyActors = SpawnActorForEntryImmediately(Entry);
+		}
+	}
 
-				PartComponent->SetupAttachment(ComponentToAttachTo, Entry.Part.SocketName);
-				PartComponent->SetChildActorClass(Entry.Part.PartClass);
-				PartComponent->RegisterComponent();
+	return bCreatedAnyActors;
+}
 
-				if (AActor* SpawnedActor = PartComponent->GetChildActor())
-				{
-					switch (Entry.Part.CollisionMode)
-					{
-					case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
-						// Do nothing
-						break;
+bool FLyraCharacterPartList::SpawnActorForEntryImmediately(FLyraAppliedCharacterPartEntry& Entry)
+{
+	bool bCreatedAnyActors = false;
 
-					case ECharacterCustomizationCollisionMode::NoCollision:
-						SpawnedActor->SetActorEnableCollision(false);
-						break;
-					}
+	Entry.bSpawnPending = false;
 
-					// Set up a direct tick dependency to work around the child actor component not providing one
-					if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
-					{
-						SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
-					}
-				}
+	if (USceneComponent* ComponentToAttachTo = OwnerComponent->GetSceneComponentToAttachTo())
+	{
+		UWorld* World = OwnerComponent->GetWorld();
 
-				Entry.SpawnedComponent = PartComponent;
-				bCreatedAnyActors = true;
+		AActor* SpawnedActor = nullptr;
+		if (ULyraCharacterPartSubsystem* PartSubsystem = UWorld::GetSubsystem<ULyraCharacterPartSubsystem>(World))
+		{
+			SpawnedActor = PartSubsystem->AcquirePartActor(Entry.Part.PartClass, OwnerComponent->GetOwner(), ComponentToAttachTo, Entry.Part.SocketName);
+		}
+		else
+		{
+			const FTransform SpawnTransform = ComponentToAttachTo->GetSocketTransform(Entry.Part.SocketName);
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.Owner = OwnerComponent->GetOwner();
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			SpawnedActor = World->SpawnActor<AActor>(Entry.Part.PartClass, SpawnTransform, SpawnParams);
+			if (SpawnedActor != nullptr)
+			{
+				SpawnedActor->AttachToComponent(ComponentToAttachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale, Entry.Part.SocketName);
 			}
 		}
+
+		if (SpawnedActor != nullptr)
+		{
+			switch (Entry.Part.CollisionMode)
+			{
+			case ECharacterCustomizationCollisionMode::UseCollisionFromCharacterPart:
+				// Do nothing
+				break;
+
+			case ECharacterCustomizationCollisionMode::NoCollision:
+				SpawnedActor->SetActorEnableCollision(false);
+				break;
+			}
+
+			// Set up a direct tick dependency so the part is updated after the component it is attached to
+			if (USceneComponent* SpawnedRootComponent = SpawnedActor->GetRootComponent())
+			{
+				SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
+			}
+
+			if (IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(SpawnedActor))
+			{
+				TagInterface->GetOwnedGameplayTags(/*out*/ Entry.SpawnedTags);
+				AddCombinedTags(Entry.SpawnedTags);
+			}
+
+			Entry.SpawnedActor = SpawnedActor;
+			bCreatedAnyActors = true;
+		}
 	}
 
 	return bCreatedAnyActors;
@@ -203,16 +257,56 @@ bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry
 {
 	bool bDestroyedAnyActors = false;
 
-	if (Entry.SpawnedComponent != nullptr)
+	Entry.bSpawnPending = false;
+
+	if (Entry.SpawnedActor != nullptr)
 	{
-		Entry.SpawnedComponent->DestroyComponent();
-		Entry.SpawnedComponent = nullptr;
+		RemoveCombinedTags(Entry.SpawnedTags);
+		Entry.SpawnedTags.Reset();
+
+		if (ULyraCharacterPartSubsystem* PartSubsystem = UWorld::GetSubsystem<ULyraCharacterPartSubsystem>(Entry.SpawnedActor->GetWorld()))
+		{
+			PartSubsystem->ReleasePartActor(Entry.SpawnedActor);
+		}
+		else
+		{
+			Entry.SpawnedActor->Destroy();
+		}
+
+		Entry.SpawnedActor = nullptr;
 		bDestroyedAnyActors = true;
 	}
 
 	return bDestroyedAnyActors;
 }
 
+bool FLyraCharacterPartList::SpawnPendingActors(double EndTime)
+{
+	bool bCreatedAnyActors = false;
+	bool bAttemptedAnySpawn = false;
+
+	for (FLyraAppliedCharacterPartEntry& Entry : Entries)
+	{
+		if (Entry.bSpawnPending)
+		{
+			if (bAttemptedAnySpawn && (FPlatformTime::Seconds() >= EndTime))
+			{
+				break;
+			}
+
+			bCreatedAnyActors |= SpawnActorForEntryImmediately(Entry);
+			bAttemptedAnySpawn = true;
+		}
+	}
+
+	return bCreatedAnyActors;
+}
+
+bool FLyraCharacterPartList::HasPendingActors() const
+{
+	return Entries.ContainsByPredicate([](const FLyraAppliedCharacterPartEntry& Entry) { return Entry.bSpawnPending; });
+}
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraPawnComponent_CharacterParts::ULyraPawnComponent_CharacterParts(const FObjectInitializer& ObjectInitializer)
@@ -272,12 +366,9 @@ TArray<AActor*> ULyraPawnComponent_CharacterParts::GetCharacterPartActors() cons
 
 	for (const FLyraAppliedCharacterPartEntry& Entry : CharacterPartList.Entries)
 	{
-		if (UChildActorComponent* PartComponent = Entry.SpawnedComponent)
+		if (AActor* SpawnedActor = Entry.SpawnedActor)
 		{
-			if (AActor* SpawnedActor = PartComponent->GetChildActor())
-			{
-				Result.Add(SpawnedActor);
-			}
+			Result.Add(SpawnedActor);
 		}
 	}
 
@@ -318,7 +409,7 @@ USceneComponent* ULyraPawnComponent_CharacterParts::GetSceneComponentToAttachTo(
 
 FGameplayTagContainer ULyraPawnComponent_CharacterParts::GetCombinedTags(FGameplayTag RequiredPrefix) const
 {
-	FGameplayTagContainer Result = CharacterPartList.CollectCombinedTags();
+	const FGameplayTagContainer& Result = CharacterPartList.GetCombinedTags();
 	if (RequiredPrefix.IsValid())
 	{
 		return Result.Filter(FGameplayTagContainer(RequiredPrefix));
@@ -354,4 +445,14 @@ void ULyraPawnComponent_CharacterParts::BroadcastChanged()
 	OnCharacterPartsChanged.Broadcast(this);
 }
 
+bool ULyraPawnComponent_CharacterParts::SpawnPendingCharacterParts(double EndTime)
+{
+	if (CharacterPartList.SpawnPendingActors(EndTime))
+	{
+		BroadcastChanged();
+	}
+
+	return !CharacterPartList.HasPendingActors();
+}
+
 
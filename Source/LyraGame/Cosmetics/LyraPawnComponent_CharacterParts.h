@@ -15,7 +15,6 @@ struct FGameplayTag;
 struct FLyraCharacterPartList;
 
 class AActor;
-class UChildActorComponent;
 class UObject;
 class USceneComponent;
 class USkeletalMeshComponent;
@@ -52,7 +51,14 @@ private:
 
 	// The spawned actor instance (client only)
 	UPROPERTY(NotReplicated)
-	TObjectPtr<UChildActorComponent> SpawnedComponent = nullptr;
+	TObjectPtr<AActor> SpawnedActor = nullptr;
+
+	// Tags the spawned actor contributed to the combined tags, captured when it was spawned (or reused from the pool).
+	// Tags the actor gains or loses afterwards are ignored until the part is spawned again.
+	FGameplayTagContainer SpawnedTags;
+
+	// Whether the actor is waiting for its turn to be spawned by the character part subsystem
+	bool bSpawnPending = false;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -84,7 +90,9 @@ public:
 	void RemoveEntry(FLyraCharacterPartHandle Handle);
 	void ClearAllEntries(bool bBroadcastChangeDelegate);
 
-	FGameplayTagContainer CollectCombinedTags() const;
+	// Returns the combined tags of all spawned part actors, kept up to date as parts are spawned and destroyed. The tags
+	// of each part actor are read once when it is spawned, later changes to them are not reflected.
+	const FGameplayTagContainer& GetCombinedTags() const { return CombinedTags; }
 
 	void SetOwnerComponent(ULyraPawnComponent_CharacterParts* InOwnerComponent)
 	{
@@ -95,8 +103,16 @@ private:
 	friend ULyraPawnComponent_CharacterParts;
 
 	bool SpawnActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
+	bool SpawnActorForEntryImmediately(FLyraAppliedCharacterPartEntry& Entry);
 	bool DestroyActorForEntry(FLyraAppliedCharacterPartEntry& Entry);
 
+	// Spawns pending actors until EndTime has passed, returns true if any were spawned
+	bool SpawnPendingActors(double EndTime);
+	bool HasPendingActors() const;
+
+	void AddCombinedTags(const FGameplayTagContainer& Tags);
+	void RemoveCombinedTags(const FGameplayTagContainer& Tags);
+
 private:
 	// Replicated list of equipment entries
 	UPROPERTY()
@@ -108,6 +124,10 @@ private:
 
 	// Upcounter for handles
 	int32 PartHandleCounter = 0;
+
+	// Union of the tags of all spawned part actors, and how many part actors contributed each tag
+	FGameplayTagContainer CombinedTags;
+	TMap<FGameplayTag, int32> CombinedTagCounts;
 };
 
 template<>
@@ -157,11 +177,16 @@ public:
 	USceneComponent* GetSceneComponentToAttachTo() const;
 
 	// Returns the set of combined gameplay tags from attached character parts, optionally filtered to only tags that start with the specified root
+	// The tags of each part are read when it is spawned, tags a part actor changes afterwards are not reflected until the part is spawned again
 	UFUNCTION(BlueprintCallable, BlueprintPure=false, BlueprintCosmetic, Category=Cosmetics)
 	FGameplayTagContainer GetCombinedTags(FGameplayTag RequiredPrefix) const;
 
 	void BroadcastChanged();
 
+	// Spawns the parts that were queued with the character part subsystem until EndTime has passed (at least one
+	// part is spawned), returns true if no parts are left pending
+	bool SpawnPendingCharacterParts(double EndTime);
+
 public:
 	// Delegate that will be called when the list of spawned character parts has changed
 	UPROPERTY(BlueprintAssignable, Category=Cosmetics, BlueprintCallable)
@@ -29,11 +29,7 @@ void FLyraEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndi
 {
  	for (int32 Index : RemovedIndices)
  	{
- 		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
-		if (Entry.Instance != nullptr)
-		{
-			Entry.Instance->OnUnequipped();
-		}
+		UnequipReplicatedEntry(Entries[Index]);
  	}
 }
 
@@ -41,21 +37,88 @@ void FLyraEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices,
 {
 	for (int32 Index : AddedIndices)
 	{
-		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
-		if (Entry.Instance != nullptr)
+		EquipReplicatedEntry(Entries[Index]);
+	}
+}
+
+void FLyraEquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+{
+	// An entry's instance may have changed, most commonly because it was not mapped yet when the entry was added
+	for (int32 Index : ChangedIndices)
+	{
+		FLyraAppliedEquipmentEntry& Entry = Entries[Index];
+		if (Entry.Instance != Entry.ReplicatedInstance)
 		{
-			Entry.Instance->OnEquipped();
+			UnequipReplicatedEntry(Entry);
+			EquipReplicatedEntry(Entry);
 		}
 	}
 }
 
-void FLyraEquipmentList::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
+void FLyraEquipmentList::EquipReplicatedEntry(FLyraAppliedEquipmentEntry& Entry)
+{
+	if (Entry.Instance != nullptr)
+	{
+		Entry.ReplicatedInstance = Entry.Instance;
+
+		AddToTypeIndex(Entry.Instance);
+
+		Entry.Instance->OnEquipped();
+
+		if (ULyraEquipmentManagerComponent* EquipmentManager = Cast<ULyraEquipmentManagerComponent>(OwnerComponent))
+		{
+			EquipmentManager->OnEquipmentChanged.Broadcast(Entry.Instance, /*bEquipped=*/ true);
+		}
+	}
+}
+
+void FLyraEquipmentList::UnequipReplicatedEntry(FLyraAppliedEquipmentEntry& Entry)
 {
-// 	for (int32 Index : ChangedIndices)
-// 	{
-// 		const FGameplayTagStack& Stack = Stacks[Index];
-// 		TagToCountMap[Stack.Tag] = Stack.StackCount;
-// 	}
+	if (ULyraEquipmentInstance* Instance = Entry.ReplicatedInstance)
+	{
+		Instance->OnUnequipped();
+
+		if (ULyraEquipmentManagerComponent* EquipmentManager = Cast<ULyraEquipmentManagerComponent>(OwnerComponent))
+		{
+			EquipmentManager->OnEquipmentChanged.Broadcast(Instance, /*bEquipped=*/ false);
+		}
+
+		RemoveFromTypeIndex(Instance);
+		Entry.ReplicatedInstance = nullptr;
+	}
+}
+
+void FLyraEquipmentList::AddToTypeIndex(ULyraEquipmentInstance* Instance)
+{
+	const UClass* BaseClass = ULyraEquipmentInstance::StaticClass();
+	for (const UClass* Class = Instance->GetClass(); Class != nullptr; Class = Class->GetSuperClass())
+	{
+		TArray<ULyraEquipmentInstance*>& Instances = InstancesByType.FindOrAdd(Class);
+		Instances.AddUnique(Instance);
+
+		if (Class == BaseClass)
+		{
+			break;
+		}
+	}
+}
+
+void FLyraEquipmentList::RemoveFromTypeIndex(ULyraEquipmentInstance* Instance)
+{
+	const UClass* BaseClass = ULyraEquipmentInstance::StaticClass();
+	for (const UClass* Class = Instance->GetClass(); Class != nullptr; Class = Class->GetSuperClass())
+	{
+		// Buckets are kept around when empty, the set of equipped types is small and tends to repeat
+		if (TArray<ULyraEquipmentInstance*>* Instances = InstancesByType.Find(Class))
+		{
+			Instances->RemoveSingle(Instance);
+		}
+
+		if (Class == BaseClass)
+		{
+			break;
+		}
+	}
 }
 
 ULyraAbilitySystemComponent* FLyraEquipmentList::GetAbilitySystemComponent() const
@@ -85,6 +148,7 @@ ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentD
 	NewEntry.EquipmentDefinition = EquipmentDefinition;
 	NewEntry.Instance = NewObject<ULyraEquipmentInstance>(OwnerComponent->GetOwner(), InstanceType);  //@TODO: Using the actor instead of component as the outer due to UE-127172
 	Result = NewEntry.Instance;
+	AddToTypeIndex(Result);
 
 	if (ULyraAbilitySystemComponent* ASC = GetAbilitySystemComponent())
 	{
@@ -119,7 +183,7 @@ void FLyraEquipmentList::RemoveEntry(ULyraEquipmentInstance* Instance)
 			}
 
 			Instance->DestroyEquipmentActors();
-			
+			RemoveFromTypeIndex(Instance);
 
 			EntryIt.RemoveCurrent();
 			MarkArrayDirty();
@@ -159,6 +223,8 @@ ULyraEquipmentInstance* ULyraEquipmentManagerComponent::EquipItem(TSubclassOf<UL
 			{
 				AddReplicatedSubObject(Result);
 			}
+
+			OnEquipmentChanged.Broadcast(Result, /*bEquipped=*/ true);
 		}
 	}
 	return Result;
@@ -174,6 +240,7 @@ void ULyraEquipmentManagerComponent::UnequipItem(ULyraEquipmentInstance* ItemIns
 		}
 
 		ItemInstance->OnUnequipped();
+		OnEquipmentChanged.Broadcast(ItemInstance, /*bEquipped=*/ false);
 		EquipmentList.RemoveEntry(ItemInstance);
 	}
 }
@@ -239,34 +306,45 @@ void ULyraEquipmentManagerComponent::ReadyForReplication()
 
 ULyraEquipmentInstance* ULyraEquipmentManagerComponent::GetFirstInstanceOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType)
 {
-	for (FLyraAppliedEquipmentEntry& Entry : EquipmentList.Entries)
-	{
-		if (ULyraEquipmentInstance* Instance = Entry.Instance)
-		{
-			if (Instance->IsA(InstanceType))
-			{
-				return Instance;
-			}
-		}
-	}
-
-	return nullptr;
+	TConstArrayView<ULyraEquipmentInstance*> Instances = EquipmentList.GetInstancesOfType(InstanceType);
+	return (Instances.Num() > 0) ? Instances[0] : nullptr;
 }
 
 TArray<ULyraEquipmentInstance*> ULyraEquipmentManagerComponent::GetEquipmentInstancesOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType) const
 {
-	TArray<ULyraEquipmentInstance*> Results;
-	for (const FLyraAppliedEquipmentEntry& Entry : EquipmentList.Entries)
-	{
-		if (ULyraEquipmentInstance* Instance = Entry.Instance)
-		{
-			if (Instance->IsA(InstanceType))
-			{
-				Results.Add(Instance);
-			}
-		}
-	}
-	return Results;
+	return TArray<ULyraEquipmentInstance*>(EquipmentList.GetInstancesOfType(InstanceType));
+}
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+int32 ULyraEquipmentManagerComponent::AddReplicatedEntryForTesting()
+{
+	const int32 EntryIndex = EquipmentList.Entries.AddDefaulted();
+
+	TArray<int32, TInlineAllocator<1>> Indices = { EntryIndex };
+	EquipmentList.PostReplicatedAdd(Indices, EquipmentList.Entries.Num());
+	return EntryIndex;
 }
 
+void ULyraEquipmentManagerComponent::ResolveReplicatedEntryForTesting(int32 EntryIndex, ULyraEquipmentInstance* Instance)
+{
+	EquipmentList.Entries[EntryIndex].Instance = Instance;
+	ChangeReplicatedEntryForTesting(EntryIndex);
+}
+
+void ULyraEquipmentManagerComponent::ChangeReplicatedEntryForTesting(int32 EntryIndex)
+{
+	TArray<int32, TInlineAllocator<1>> Indices = { EntryIndex };
+	EquipmentList.PostReplicatedChange(Indices, EquipmentList.Entries.Num());
+}
+
+void ULyraEquipmentManagerComponent::RemoveReplicatedEntryForTesting(int32 EntryIndex)
+{
+	TArray<int32, TInlineAllocator<1>> Indices = { EntryIndex };
+	EquipmentList.PreReplicatedRemove(Indices, EquipmentList.Entries.Num() - 1);
+	EquipmentList.Entries.RemoveAt(EntryIndex);
+}
 
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -19,6 +19,8 @@ struct FLyraEquipmentList;
 struct FNetDeltaSerializeInfo;
 struct FReplicationFlags;
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLyraEquipmentChanged, ULyraEquipmentInstance* /*Instance*/, bool /*bEquipped*/);
+
 /** A single piece of applied equipment */
 USTRUCT(BlueprintType)
 struct FLyraAppliedEquipmentEntry : public FFastArraySerializerItem
@@ -44,6 +46,10 @@ private:
 	// Authority-only list of granted handles
 	UPROPERTY(NotReplicated)
 	FLyraAbilitySet_GrantedHandles GrantedHandles;
+
+	// Client-only, the instance that was last equipped from replication (Instance can resolve after the entry was added)
+	UPROPERTY(NotReplicated)
+	TObjectPtr<ULyraEquipmentInstance> ReplicatedInstance = nullptr;
 };
 
 /** List of applied equipment */
@@ -77,9 +83,24 @@ public:
 	ULyraEquipmentInstance* AddEntry(TSubclassOf<ULyraEquipmentDefinition> EquipmentDefinition);
 	void RemoveEntry(ULyraEquipmentInstance* Instance);
 
+	// Returns all instances that are of the specified type (or a subclass of it), in the order they were added
+	TConstArrayView<ULyraEquipmentInstance*> GetInstancesOfType(const UClass* InstanceType) const
+	{
+		const TArray<ULyraEquipmentInstance*>* Instances = InstancesByType.Find(InstanceType);
+		return Instances ? TConstArrayView<ULyraEquipmentInstance*>(*Instances) : TConstArrayView<ULyraEquipmentInstance*>();
+	}
+
 private:
 	ULyraAbilitySystemComponent* GetAbilitySystemComponent() const;
 
+	// Adds or removes an instance from the bucket of every class in its hierarchy
+	void AddToTypeIndex(ULyraEquipmentInstance* Instance);
+	void RemoveFromTypeIndex(ULyraEquipmentInstance* Instance);
+
+	// Client-side equip and unequip of replicated entries, also used when an entry's instance resolves late
+	void EquipReplicatedEntry(FLyraAppliedEquipmentEntry& Entry);
+	void UnequipReplicatedEntry(FLyraAppliedEquipmentEntry& Entry);
+
 	friend ULyraEquipmentManagerComponent;
 
 private:
@@ -89,6 +110,10 @@ private:
 
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UActorComponent> OwnerComponent;
+
+	// Maps every class in the hierarchy of an equipped instance (up to ULyraEquipmentInstance) to the instances of that type
+	// Instances are kept alive by Entries, this is only an acceleration structure for type queries
+	TMap<const UClass*, TArray<ULyraEquipmentInstance*>> InstancesByType;
 };
 
 template<>
@@ -142,12 +167,34 @@ public:
  	UFUNCTION(BlueprintCallable, BlueprintPure)
 	TArray<ULyraEquipmentInstance*> GetEquipmentInstancesOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType) const;
 
+	/** Appends all equipped instances of a given type to OutInstances, without allocating if it has enough slack (e.g., an inline allocator) */
+	template <typename AllocatorType>
+	void GetEquipmentInstancesOfType(TSubclassOf<ULyraEquipmentInstance> InstanceType, TArray<ULyraEquipmentInstance*, AllocatorType>& OutInstances) const
+	{
+		OutInstances.Append(EquipmentList.GetInstancesOfType(InstanceType));
+	}
+
 	template <typename T>
 	T* GetFirstInstanceOfType()
 	{
 		return (T*)GetFirstInstanceOfType(T::StaticClass());
 	}
 
+	/**
+	 * Broadcast after an instance is equipped and before it is unequipped (on the authority and on clients as
+	 * the equipment list replicates). The instance is still part of the equipment list during the unequip broadcast.
+	 */
+	FOnLyraEquipmentChanged OnEquipmentChanged;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Simulates the client side of equipment replication for automation tests: adds an entry whose instance is not
+	// mapped yet (returning its index), then resolves, changes or removes it as if those updates had been received
+	int32 AddReplicatedEntryForTesting();
+	void ResolveReplicatedEntryForTesting(int32 EntryIndex, ULyraEquipmentInstance* Instance);
+	void ChangeReplicatedEntryForTesting(int32 EntryIndex);
+	void RemoveReplicatedEntryForTesting(int32 EntryIndex);
+#endif
+
 private:
 	UPROPERTY(Replicated)
 	FLyraEquipmentList EquipmentList;
@@ -0,0 +1,332 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraNumberPopComponent_InstancedMeshText.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "TimerManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraNumberPopComponent_InstancedMeshText)
+
+//////////////////////////////////////////////////////////////////////
+// FLyraNumberPopInstanceSlots
+
+int32 FLyraNumberPopInstanceSlots::Acquire(double ReleaseTime, int32 MaxSlots, bool& bOutAddedSlot)
+{
+	bOutAddedSlot = false;
+
+	int32 SlotIndex = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else if ((NumSlots < MaxSlots) || (LiveSlots.Num() == 0))
+	{
+		SlotIndex = NumSlots++;
+		bOutAddedSlot = true;
+	}
+	else
+	{
+		// Out of slots, steal the one closest to expiring
+		SlotIndex = LiveSlots[0].SlotIndex;
+		LiveSlots.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	LiveSlots.Add({ ReleaseTime, SlotIndex });
+	return SlotIndex;
+}
+
+void FLyraNumberPopInstanceSlots::ReleaseExpired(double CurrentTime, TArray<int32>& OutReleasedSlots)
+{
+	int32 NumReleased = 0;
+	for (const FLiveSlot& LiveSlot : LiveSlots)
+	{
+		if (CurrentTime < LiveSlot.ReleaseTime)
+		{
+			// These are in chronological order so none of the other elements will be released
+			break;
+		}
+
+		FreeSlots.Add(LiveSlot.SlotIndex);
+		OutReleasedSlots.Add(LiveSlot.SlotIndex);
+		++NumReleased;
+	}
+
+	LiveSlots.RemoveAt(0, NumReleased, EAllowShrinking::No);
+}
+
+double FLyraNumberPopInstanceSlots::GetNextReleaseTime() const
+{
+	return (LiveSlots.Num() > 0) ? LiveSlots[0].ReleaseTime : -1.0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraNumberPopComponent_InstancedMeshText
+
+ULyraNumberPopComponent_InstancedMeshText::ULyraNumberPopComponent_InstancedMeshText(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	MaxInstancesPerMesh = 512;
+}
+
+void ULyraNumberPopComponent_InstancedMeshText::AddNumberPop(const FLyraNumberPopRequest& NewRequest)
+{
+	// Drop requests for remote players on the floor
+	// (this prevents multiple pops from showing up for the host of a listen server)
+	APlayerController* PC = GetController<APlayerController>();
+	if ((PC != nullptr) && !PC->IsLocalController())
+	{
+		return;
+	}
+
+	UWorld* LocalWorld = GetWorld();
+	if (LocalWorld == nullptr)
+	{
+		return;
+	}
+
+	if (!CreateInstancedDigitsIfNeeded())
+	{
+		Super::AddNumberPop(NewRequest);
+		return;
+	}
+
+	// Parse the base10 number into digits, most significant first
+	TArray<int32, TInlineAllocator<10>> Digits;
+	{
+		int32 LocalNumber = FMath::Max(NewRequest.NumberToDisplay, 0);
+		do
+		{
+			Digits.Insert(LocalNumber % 10, 0);
+			LocalNumber /= 10;
+		}
+		while (LocalNumber > 0);
+	}
+
+	// Determine the position
+	FTransform CameraTransform;
+	FVector NumberLocation(NewRequest.WorldLocation);
+	if (APlayerCameraManager* PlayerCameraManager = PC ? PC->PlayerCameraManager.Get() : nullptr)
+	{
+		CameraTransform = FTransform(PlayerCameraManager->GetCameraRotation(), PlayerCameraManager->GetCameraLocation());
+
+		const float RandomMagnitude = 5.0f; //@TODO: Make this style driven
+		NumberLocation += FMath::RandPointInBox(FBox(FVector(-RandomMagnitude), FVector(RandomMagnitude)));
+	}
+
+	const float DistanceFromCameraToNumber = (CameraTransform.GetLocation() - NumberLocation).Size();
+	const float DistanceSpriteScale = DistanceFromCameraBeforeDoublingSize == 0.f ? 1.f : FMath::Max(DistanceFromCameraToNumber / DistanceFromCameraBeforeDoublingSize, 1.f);
+	const float HitSizeMultiplier = NewRequest.bIsCriticalDamage ? CriticalHitSizeMultiplier : 1.f;
+	const float FontSizeMultiplier = HitSizeMultiplier * DistanceSpriteScale;
+
+	// Lay the digits out along the camera right vector, with ones (and the digit after a one) packed tighter
+	const FVector CameraRight = CameraTransform.GetUnitAxis(EAxis::Y);
+	float TotalWidth = 0.0f;
+	TArray<float, TInlineAllocator<10>> DigitOffsets;
+	for (int32 DigitIndex = 0; DigitIndex < Digits.Num(); ++DigitIndex)
+	{
+		const bool bNextToOne = (Digits[DigitIndex] == 1) || ((DigitIndex > 0) && (Digits[DigitIndex - 1] == 1));
+		const float Spacing = FontXSize * FontSizeMultiplier * (bNextToOne ? SpacingPercentageForOnes : 1.f);
+		DigitOffsets.Add(TotalWidth + Spacing * 0.5f);
+		TotalWidth += Spacing;
+	}
+
+	const double CurrentTime = LocalWorld->GetTimeSeconds();
+	const float AnimationEndTime = LocalWorld->GetRealTimeSeconds() + ComponentLifespan;
+	const FLinearColor Color = DetermineColor(NewRequest);
+	const FQuat Rotation = CameraTransform.GetRotation();
+	const FVector Scale(FontSizeMultiplier);
+
+	UInstancedStaticMeshComponent* ISMComponent = InstancedDigits.Component;
+
+	for (int32 DigitIndex = 0; DigitIndex < Digits.Num(); ++DigitIndex)
+	{
+		const FTransform DigitTransform(Rotation, NumberLocation + CameraRight * (DigitOffsets[DigitIndex] - TotalWidth * 0.5f), Scale);
+
+		bool bAddedSlot = false;
+		const int32 SlotIndex = InstancedDigits.Slots.Acquire(CurrentTime + ComponentLifespan, MaxInstancesPerMesh, /*out*/ bAddedSlot);
+		if (bAddedSlot)
+		{
+			const int32 InstanceIndex = ISMComponent->AddInstance(DigitTransform, /*bWorldSpace=*/ true);
+			check(InstanceIndex == SlotIndex);
+		}
+		else
+		{
+			ISMComponent->UpdateInstanceTransform(SlotIndex, DigitTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ false, /*bTeleport=*/ true);
+		}
+
+		const float CustomData[NumCustomDataFloats] =
+		{
+			(float)Digits[DigitIndex],
+			Color.R, Color.G, Color.B,
+			AnimationEndTime,
+			ComponentLifespan,
+			NewRequest.bIsCriticalDamage ? 1.f : 0.f,
+			FMath::FRand()
+		};
+		ISMComponent->SetCustomData(SlotIndex, CustomData, /*bMarkRenderStateDirty=*/ false);
+	}
+
+	// Push everything added this frame to the render thread in one go
+	FTimerManager& TimerManager = LocalWorld->GetTimerManager();
+	if (!TimerManager.TimerExists(FlushTimerHandle))
+	{
+		FlushTimerHandle = TimerManager.SetTimerForNextTick(this, &ThisClass::FlushInstanceUpdates);
+	}
+
+	// A pending release timer is always due before the digits that were just added expire
+	if (!TimerManager.IsTimerActive(ReleaseTimerHandle))
+	{
+		ScheduleRelease();
+	}
+}
+
+bool ULyraNumberPopComponent_InstancedMeshText::CreateInstancedDigitsIfNeeded()
+{
+	if (InstancedDigits.Component != nullptr)
+	{
+		return true;
+	}
+
+	if ((SingleDigitMesh == nullptr) || (InstancedDigitMaterial == nullptr))
+	{
+		UE_CLOG(!bWarnedMissingInstancingAssets, LogLyra, Warning, TEXT("%s has no single digit mesh or instanced digit material, using pooled meshes instead"), *GetPathNameSafe(this));
+		bWarnedMissingInstancingAssets = true;
+		return false;
+	}
+
+	UInstancedStaticMeshComponent* NewComponent = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+	NewComponent->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	NewComponent->SetStaticMesh(SingleDigitMesh);
+	NewComponent->SetNumCustomDataFloats(NumCustomDataFloats);
+
+	// Used to allow post-processes to opt out of affecting the number pop digits
+	NewComponent->SetRenderCustomDepth(true);
+	NewComponent->SetCustomDepthStencilValue(123);
+
+	// The digits travel a great distance from their original bounds due to
+	// world position offset (WPO) animation in the material, so expand bounds
+	NewComponent->SetBoundsScale(2000.0f);
+
+	for (int32 MatIdx = 0; MatIdx < NewComponent->GetNumMaterials(); ++MatIdx)
+	{
+		NewComponent->SetMaterial(MatIdx, InstancedDigitMaterial);
+	}
+
+	NewComponent->RegisterComponent();
+	InstancedDigits.Component = NewComponent;
+
+	return true;
+}
+
+void ULyraNumberPopComponent_InstancedMeshText::ReleaseExpiredInstances()
+{
+	UWorld* LocalWorld = GetWorld();
+	check(LocalWorld);
+
+	const double CurrentTime = LocalWorld->GetTimeSeconds();
+	const FTransform HiddenTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+
+	TArray<int32> ReleasedSlots;
+	InstancedDigits.Slots.ReleaseExpired(CurrentTime, /*out*/ ReleasedSlots);
+	if ((ReleasedSlots.Num() > 0) && (InstancedDigits.Component != nullptr))
+	{
+		// Collapse the instances rather than removing them, so instance indices stay stable
+		for (const int32 SlotIndex : ReleasedSlots)
+		{
+			InstancedDigits.Component->UpdateInstanceTransform(SlotIndex, HiddenTransform, /*bWorldSpace=*/ true, /*bMarkRenderStateDirty=*/ false, /*bTeleport=*/ true);
+		}
+		InstancedDigits.Component->MarkRenderStateDirty();
+	}
+
+	ScheduleRelease();
+}
+
+void ULyraNumberPopComponent_InstancedMeshText::ScheduleRelease()
+{
+	UWorld* LocalWorld = GetWorld();
+	check(LocalWorld);
+
+	const double NextReleaseTime = InstancedDigits.Slots.GetNextReleaseTime();
+
+	// If we still have live digits animating, set the timer to release the next ones
+	if (NextReleaseTime >= 0.0)
+	{
+		const float TimeUntilNextRelease = FMath::Max((float)(NextReleaseTime - LocalWorld->GetTimeSeconds()), UE_KINDA_SMALL_NUMBER);
+		LocalWorld->GetTimerManager().SetTimer(ReleaseTimerHandle, this, &ThisClass::ReleaseExpiredInstances, TimeUntilNextRelease);
+	}
+}
+
+void ULyraNumberPopComponent_InstancedMeshText::FlushInstanceUpdates()
+{
+	FlushTimerHandle.Invalidate();
+
+	if (InstancedDigits.Component != nullptr)
+	{
+		InstancedDigits.Component->MarkRenderStateDirty();
+	}
+}
+
+void ULyraNumberPopComponent_InstancedMeshText::OnUnregister()
+{
+	if (InstancedDigits.Component != nullptr)
+	{
+		InstancedDigits.Component->DestroyComponent();
+	}
+	InstancedDigits = FLyraNumberPopInstancedMesh();
+
+	if (UWorld* LocalWorld = GetWorld())
+	{
+		LocalWorld->GetTimerManager().ClearTimer(ReleaseTimerHandle);
+		LocalWorld->GetTimerManager().ClearTimer(FlushTimerHandle);
+	}
+
+	Super::OnUnregister();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static void BenchmarkNumberPops(const TArray<FString>& Args, UWorld* World)
+{
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	ULyraNumberPopComponent* NumberPopComponent = PC ? PC->FindComponentByClass<ULyraNumberPopComponent>() : nullptr;
+	if (NumberPopComponent == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Lyra.NumberPops.Benchmark requires a local player controller with a number pop component"));
+		return;
+	}
+
+	const int32 NumPops = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+
+	FLyraNumberPopRequest Request;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 PopIndex = 0; PopIndex < NumPops; ++PopIndex)
+	{
+		Request.WorldLocation = ViewLocation + ViewRotation.Vector() * 500.0f;
+		Request.NumberToDisplay = (PopIndex * 37) % 1000;
+		Request.bIsCriticalDamage = (PopIndex % 5) == 0;
+		NumberPopComponent->AddNumberPop(Request);
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogLyra, Log, TEXT("Added %d number pops with %s in %.3f ms (%.2f us per pop)"),
+		NumPops, *NumberPopComponent->GetClass()->GetName(), ElapsedTime * 1000.0, (ElapsedTime * 1000000.0) / NumPops);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkNumberPops(
+	TEXT("Lyra.NumberPops.Benchmark"),
+	TEXT("Adds [NumPops=1000] number pops in one frame through the local player's number pop component and logs the game thread cost"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkNumberPops));
+
+#endif // !UE_BUILD_SHIPPING
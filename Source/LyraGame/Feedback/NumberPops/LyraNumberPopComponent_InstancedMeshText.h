@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "LyraNumberPopComponent_MeshText.h"
+
+#include "LyraNumberPopComponent_InstancedMeshText.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UObject;
+class UStaticMesh;
+
+/**
+ * Slot bookkeeping for one instanced digit mesh, kept free of any component so it can be exercised on its own.
+ * Slots are handed out from a free list and released in the order they were acquired, which matches the
+ * constant lifespan every pop on a component has.
+ */
+struct FLyraNumberPopInstanceSlots
+{
+public:
+	// Returns a free slot that will be released at ReleaseTime, growing by one slot if none is free and
+	// MaxSlots has not been reached yet, and otherwise reusing the slot that would expire first
+	int32 Acquire(double ReleaseTime, int32 MaxSlots, bool& bOutAddedSlot);
+
+	// Releases every slot whose release time has passed, appending them to OutReleasedSlots
+	void ReleaseExpired(double CurrentTime, TArray<int32>& OutReleasedSlots);
+
+	// Returns the release time of the next live slot, or a negative value if nothing is live
+	double GetNextReleaseTime() const;
+
+	int32 GetNumSlots() const { return NumSlots; }
+	int32 GetNumLiveSlots() const { return LiveSlots.Num(); }
+
+private:
+	struct FLiveSlot
+	{
+		double ReleaseTime;
+		int32 SlotIndex;
+	};
+
+	// Live slots in chronological order
+	TArray<FLiveSlot> LiveSlots;
+
+	TArray<int32> FreeSlots;
+	int32 NumSlots = 0;
+};
+
+USTRUCT()
+struct FLyraNumberPopInstancedMesh
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
+
+	FLyraNumberPopInstanceSlots Slots;
+};
+
+/**
+ * Number pop component that draws every digit as an instance of one instanced static mesh,
+ * instead of a pooled static mesh component with its own dynamic material instances per pop.
+ *
+ * Adding a pop only writes the instance transforms and a few floats of per-instance custom data, and the
+ * render state is updated once per frame no matter how many pops were added.
+ *
+ * The multi-digit card meshes of the styles can't be used here: their material lays the digits out with WPO
+ * from per-digit parameters, so one instance per digit would draw every card at each digit position.
+ * SingleDigitMesh must be a single card, and InstancedDigitMaterial must read the digit and its animation
+ * from the per-instance custom data (see the layout below) instead of material parameters.
+ * Until both are set, pops fall back to the pooled mesh path of the base class.
+ */
+UCLASS(Blueprintable)
+class ULyraNumberPopComponent_InstancedMeshText : public ULyraNumberPopComponent_MeshText
+{
+	GENERATED_BODY()
+
+public:
+
+	ULyraNumberPopComponent_InstancedMeshText(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	//~ULyraNumberPopComponent interface
+	virtual void AddNumberPop(const FLyraNumberPopRequest& NewRequest) override;
+	//~End of ULyraNumberPopComponent interface
+
+	//~UActorComponent interface
+	virtual void OnUnregister() override;
+	//~End of UActorComponent interface
+
+	// Number of per-instance custom data floats written for every digit
+	static constexpr int32 NumCustomDataFloats = 8;
+
+protected:
+	/** Creates the instanced digit mesh component if needed, returns false if the instancing assets are not set */
+	bool CreateInstancedDigitsIfNeeded();
+
+	/** Hides the instances of pops that have exceeded their lifespan and makes them available again */
+	void ReleaseExpiredInstances();
+
+	/** Pushes the instance updates made this frame to the render thread */
+	void FlushInstanceUpdates();
+
+	/** Sets the release timer to fire when the next live digit expires, if any */
+	void ScheduleRelease();
+
+	/** Card mesh drawing a single digit, every digit of every pop is one instance of it */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Instancing")
+	TObjectPtr<UStaticMesh> SingleDigitMesh;
+
+	/** Material that reads the digit parameters from per-instance custom data, applied to every slot of the digit mesh */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Instancing")
+	TObjectPtr<UMaterialInterface> InstancedDigitMaterial;
+
+	/** Maximum number of digit instances, once reached the oldest digits are reused */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Instancing")
+	int32 MaxInstancesPerMesh;
+
+	// Layout of the per-instance custom data:
+	// [0] digit (0-9), [1..3] color RGB, [4] real time at which the animation ends, [5] animation lifespan,
+	// [6] is critical hit (0/1), [7] random value in [0, 1)
+
+	UPROPERTY(Transient)
+	FLyraNumberPopInstancedMesh InstancedDigits;
+
+	FTimerHandle FlushTimerHandle;
+
+	bool bWarnedMissingInstancingAssets = false;
+};
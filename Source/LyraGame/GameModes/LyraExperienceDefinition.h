@@ -8,6 +8,7 @@
 class UGameFeatureAction;
 class ULyraPawnData;
 class ULyraExperienceActionSet;
+class ULyraGameplayCueManifest;
 
 /**
  * Definition of an experience
@@ -49,4 +50,8 @@ public:
 	// List of additional action sets to compose into this experience
 	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
 	TArray<TObjectPtr<ULyraExperienceActionSet>> ActionSets;
+
+	// Gameplay cues to preload on clients while this experience is loading (see Lyra.GameplayCues.WriteManifest)
+	UPROPERTY(EditDefaultsOnly, Category=Gameplay)
+	TObjectPtr<const ULyraGameplayCueManifest> GameplayCueManifest;
 };
@@ -13,6 +13,7 @@
 #include "TimerManager.h"
 #include "Settings/LyraSettingsLocal.h"
 #include "LyraLogChannels.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManagerComponent)
 
@@ -131,6 +132,9 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 
 	LoadState = ELyraExperienceLoadState::Loading;
 
+	// We now want the loading screen up (see ShouldShowLoadingScreen), let the loading screen manager know
+	ILoadingProcessInterface::NotifyLoadingStateChanged(this);
+
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
 
 	TSet<FPrimaryAssetId> BundleAssetList;
@@ -157,6 +161,12 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 	if (bLoadClient)
 	{
 		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+
+		// Start loading the gameplay cues this experience is known to use alongside its other assets
+		if (ULyraGameplayCueManager* GameplayCueManager = ULyraGameplayCueManager::Get())
+		{
+			GameplayCueManager->OnExperienceLoadStarted(CurrentExperience, /*LoadOwner=*/ this);
+		}
 	}
 	if (bLoadServer)
 	{
@@ -381,6 +391,12 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 {
 	Super::EndPlay(EndPlayReason);
 
+	// Release the gameplay cues preloaded for this experience
+	if (ULyraGameplayCueManager* GameplayCueManager = ULyraGameplayCueManager::Get())
+	{
+		GameplayCueManager->OnExperienceUnloaded(this);
+	}
+
 	// deactivate any features this experience loaded
 	//@TODO: This should be handled FILO as well
 	for (const FString& PluginURL : GameFeaturePluginURLs)
@@ -46,6 +46,9 @@ public:
 	/**  */
 	virtual void GatherInteractionOptions(const FInteractionQuery& InteractQuery, FInteractionOptionBuilder& OptionBuilder) = 0;
 
+	/** Returns true if the options do not depend on the query, allowing ULyraInteractableSubsystem to cache them until they are invalidated */
+	virtual bool CanCacheInteractionOptions() const { return false; }
+
 	/**  */
 	virtual void CustomizeInteractionEventData(const FGameplayTag& InteractionEventTag, FGameplayEventData& InOutEventData) { }
 };
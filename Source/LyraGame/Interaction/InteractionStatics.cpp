@@ -4,7 +4,9 @@
 
 #include "Components/PrimitiveComponent.h"
 #include "Engine/OverlapResult.h"
+#include "Engine/World.h"
 #include "IInteractableTarget.h"
+#include "Interaction/LyraInteractableSubsystem.h"
 #include "UObject/ScriptInterface.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(InteractionStatics)
@@ -84,3 +86,16 @@ void UInteractionStatics::AppendInteractableTargetsFromHitResult(const FHitResul
 		OutInteractableTargets.AddUnique(InteractableComponent);
 	}
 }
+
+void UInteractionStatics::GatherInteractionOptions(UWorld* World, const TScriptInterface<IInteractableTarget>& InteractableTarget, const FInteractionQuery& InteractQuery, TArray<FInteractionOption>& OutOptions)
+{
+	if (ULyraInteractableSubsystem* InteractableSubsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(World))
+	{
+		InteractableSubsystem->GatherInteractionOptions(InteractableTarget, InteractQuery, OutOptions);
+	}
+	else
+	{
+		FInteractionOptionBuilder InteractionBuilder(InteractableTarget, OutOptions);
+		InteractableTarget->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+	}
+}
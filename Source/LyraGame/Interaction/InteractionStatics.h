@@ -11,8 +11,11 @@ template <typename InterfaceType> class TScriptInterface;
 class AActor;
 class IInteractableTarget;
 class UObject;
+class UWorld;
 struct FFrame;
 struct FHitResult;
+struct FInteractionOption;
+struct FInteractionQuery;
 struct FOverlapResult;
 
 /**  */
@@ -33,4 +36,7 @@ public:
 
 	static void AppendInteractableTargetsFromOverlapResults(const TArray<FOverlapResult>& OverlapResults, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets);
 	static void AppendInteractableTargetsFromHitResult(const FHitResult& HitResult, TArray<TScriptInterface<IInteractableTarget>>& OutInteractableTargets);
+
+	/** Appends the interaction options of the target, going through the interactable registry of the world so they can be cached */
+	static void GatherInteractionOptions(UWorld* World, const TScriptInterface<IInteractableTarget>& InteractableTarget, const FInteractionQuery& InteractQuery, TArray<FInteractionOption>& OutOptions);
 };
@@ -0,0 +1,349 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Interaction/LyraInteractableSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Interaction/IInteractableTarget.h"
+#include "LyraLogChannels.h"
+#include "UObject/ScriptInterface.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraInteractableSubsystem)
+
+namespace LyraInteractableCVars
+{
+	static bool bUseSpatialIndex = true;
+	static FAutoConsoleVariableRef CVarUseSpatialIndex(
+		TEXT("Lyra.Interaction.UseSpatialIndex"),
+		bUseSpatialIndex,
+		TEXT("If true, nearby interactables are found through the interactable registry instead of physics queries (only registered interactables are found)"),
+		ECVF_Default);
+
+	static float SpatialCellSize = 1000.0f;
+	static FAutoConsoleVariableRef CVarSpatialCellSize(
+		TEXT("Lyra.Interaction.SpatialCellSize"),
+		SpatialCellSize,
+		TEXT("Cell size of the interactable spatial hash, takes effect for worlds created after the change"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraInteractableSpatialHash
+
+FLyraInteractableSpatialHash::FLyraInteractableSpatialHash(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+FIntVector FLyraInteractableSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void FLyraInteractableSpatialHash::Add(int32 Id, const FVector& Location, float Radius)
+{
+	check(!Elements.Contains(Id));
+
+	const FIntVector Cell = GetCell(Location);
+	Elements.Add(Id, { Location, Radius, Cell });
+	Cells.FindOrAdd(Cell).Add(Id);
+	MaxElementRadius = FMath::Max(MaxElementRadius, Radius);
+}
+
+void FLyraInteractableSpatialHash::Remove(int32 Id)
+{
+	FElement Element;
+	if (Elements.RemoveAndCopyValue(Id, /*out*/ Element))
+	{
+		TArray<int32>& CellIds = Cells.FindChecked(Element.Cell);
+		CellIds.RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (CellIds.Num() == 0)
+		{
+			Cells.Remove(Element.Cell);
+		}
+	}
+}
+
+void FLyraInteractableSpatialHash::Update(int32 Id, const FVector& Location, float Radius)
+{
+	FElement* Element = Elements.Find(Id);
+	if (Element == nullptr)
+	{
+		Add(Id, Location, Radius);
+		return;
+	}
+
+	const FIntVector NewCell = GetCell(Location);
+	if (NewCell != Element->Cell)
+	{
+		TArray<int32>& OldCellIds = Cells.FindChecked(Element->Cell);
+		OldCellIds.RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (OldCellIds.Num() == 0)
+		{
+			Cells.Remove(Element->Cell);
+		}
+
+		Cells.FindOrAdd(NewCell).Add(Id);
+		Element->Cell = NewCell;
+	}
+
+	Element->Location = Location;
+	Element->Radius = Radius;
+	MaxElementRadius = FMath::Max(MaxElementRadius, Radius);
+}
+
+void FLyraInteractableSpatialHash::Query(const FVector& Center, float Radius, TArray<int32>& OutIds) const
+{
+	if (Elements.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector Extent(Radius + MaxElementRadius);
+	const FIntVector MinCell = GetCell(Center - Extent);
+	const FIntVector MaxCell = GetCell(Center + Extent);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32>* CellIds = Cells.Find(FIntVector(X, Y, Z));
+				if (CellIds == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 Id : *CellIds)
+				{
+					const FElement& Element = Elements.FindChecked(Id);
+					if (FVector::DistSquared(Center, Element.Location) <= FMath::Square(Radius + Element.Radius))
+					{
+						OutIds.Add(Id);
+					}
+				}
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraInteractableSubsystem
+
+ULyraInteractableSubsystem::ULyraInteractableSubsystem()
+{
+}
+
+bool ULyraInteractableSubsystem::IsSpatialIndexEnabled()
+{
+	return LyraInteractableCVars::bUseSpatialIndex;
+}
+
+void ULyraInteractableSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialHash = FLyraInteractableSpatialHash(LyraInteractableCVars::SpatialCellSize);
+}
+
+bool ULyraInteractableSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void ULyraInteractableSubsystem::RegisterInteractable(TScriptInterface<IInteractableTarget> Target, const FVector& Location, float Radius)
+{
+	UObject* Object = Target.GetObject();
+	if ((Object == nullptr) || EntryIndices.Contains(FObjectKey(Object)))
+	{
+		return;
+	}
+
+	const int32 Index = (FreeEntries.Num() > 0) ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+	FLyraInteractableEntry& Entry = Entries[Index];
+	Entry.Object = Object;
+	Entry.CachedOptions.Reset();
+	Entry.bHasCachedOptions = false;
+
+	EntryIndices.Add(FObjectKey(Object), Index);
+	SpatialHash.Add(Index, Location, Radius);
+}
+
+void ULyraInteractableSubsystem::UnregisterInteractable(TScriptInterface<IInteractableTarget> Target)
+{
+	int32 Index = INDEX_NONE;
+	if (EntryIndices.RemoveAndCopyValue(FObjectKey(Target.GetObject()), /*out*/ Index))
+	{
+		SpatialHash.Remove(Index);
+
+		FLyraInteractableEntry& Entry = Entries[Index];
+		Entry.Object.Reset();
+		Entry.CachedOptions.Reset();
+		Entry.bHasCachedOptions = false;
+		FreeEntries.Add(Index);
+	}
+}
+
+void ULyraInteractableSubsystem::UpdateInteractableLocation(TScriptInterface<IInteractableTarget> Target, const FVector& Location, float Radius)
+{
+	if (const int32* Index = EntryIndices.Find(FObjectKey(Target.GetObject())))
+	{
+		SpatialHash.Update(*Index, Location, Radius);
+	}
+}
+
+void ULyraInteractableSubsystem::InvalidateInteractionOptions(TScriptInterface<IInteractableTarget> Target)
+{
+	if (const int32* Index = EntryIndices.Find(FObjectKey(Target.GetObject())))
+	{
+		FLyraInteractableEntry& Entry = Entries[*Index];
+		Entry.CachedOptions.Reset();
+		Entry.bHasCachedOptions = false;
+	}
+}
+
+void ULyraInteractableSubsystem::QueryInteractables(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutTargets) const
+{
+	TArray<int32, TInlineAllocator<32>> Ids;
+	SpatialHash.Query(Center, Radius, /*out*/ Ids);
+
+	for (const int32 Id : Ids)
+	{
+		TScriptInterface<IInteractableTarget> Target(Entries[Id].Object.Get());
+		if (Target)
+		{
+			OutTargets.AddUnique(Target);
+		}
+	}
+}
+
+bool ULyraInteractableSubsystem::HasInteractablesInRange(const FVector& Center, float Radius) const
+{
+	TArray<int32, TInlineAllocator<32>> Ids;
+	SpatialHash.Query(Center, Radius, /*out*/ Ids);
+	return Ids.Num() > 0;
+}
+
+void ULyraInteractableSubsystem::GatherInteractionOptions(const TScriptInterface<IInteractableTarget>& Target, const FInteractionQuery& Query, TArray<FInteractionOption>& OutOptions)
+{
+	const int32* Index = EntryIndices.Find(FObjectKey(Target.GetObject()));
+	FLyraInteractableEntry* Entry = (Index != nullptr) ? &Entries[*Index] : nullptr;
+
+	if ((Entry != nullptr) && Entry->bHasCachedOptions)
+	{
+		OutOptions.Append(Entry->CachedOptions);
+		return;
+	}
+
+	const int32 FirstNewOption = OutOptions.Num();
+	FInteractionOptionBuilder InteractionBuilder(Target, OutOptions);
+	Target->GatherInteractionOptions(Query, InteractionBuilder);
+
+	if ((Entry != nullptr) && Target->CanCacheInteractionOptions())
+	{
+		Entry->CachedOptions = TArray<FInteractionOption>(OutOptions.GetData() + FirstNewOption, OutOptions.Num() - FirstNewOption);
+		Entry->bHasCachedOptions = true;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static void BenchmarkInteractableSpatialHash(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumInteractables = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000;
+	const int32 NumPlayers = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 32;
+	const int32 NumFrames = (Args.Num() > 2) ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 100;
+	const float ScanRadius = 500.0f;
+	const float InteractableRadius = 50.0f;
+	const FBox MapBounds(FVector(-50000.0f, -50000.0f, 0.0f), FVector(50000.0f, 50000.0f, 2000.0f));
+
+	FRandomStream RandomStream(NumInteractables);
+
+	FLyraInteractableSpatialHash SpatialHash(LyraInteractableCVars::SpatialCellSize);
+	TArray<FVector> Locations;
+	Locations.Reserve(NumInteractables);
+	for (int32 Index = 0; Index < NumInteractables; ++Index)
+	{
+		const FVector Location = RandomStream.RandPointInBox(MapBounds);
+		Locations.Add(Location);
+		SpatialHash.Add(Index, Location, InteractableRadius);
+	}
+
+	TArray<FVector> PlayerLocations;
+	for (int32 Index = 0; Index < NumPlayers; ++Index)
+	{
+		PlayerLocations.Add(RandomStream.RandPointInBox(MapBounds));
+	}
+
+	// Players wander a bit every frame so the queries do not hit the same cells over and over
+	auto MovePlayers = [&PlayerLocations](FRandomStream& Stream)
+	{
+		for (FVector& PlayerLocation : PlayerLocations)
+		{
+			PlayerLocation += FVector(Stream.FRandRange(-60.0f, 60.0f), Stream.FRandRange(-60.0f, 60.0f), 0.0f);
+		}
+	};
+
+	TArray<int32> Found;
+	int32 NumFoundLinear = 0;
+	int32 NumFoundHashed = 0;
+
+	FRandomStream LinearStream(NumPlayers);
+	const TArray<FVector> StartLocations = PlayerLocations;
+	const double LinearStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		MovePlayers(LinearStream);
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			Found.Reset();
+			for (int32 Index = 0; Index < Locations.Num(); ++Index)
+			{
+				if (FVector::DistSquared(PlayerLocation, Locations[Index]) <= FMath::Square(ScanRadius + InteractableRadius))
+				{
+					Found.Add(Index);
+				}
+			}
+			NumFoundLinear += Found.Num();
+		}
+	}
+	const double LinearTime = FPlatformTime::Seconds() - LinearStartTime;
+
+	FRandomStream HashedStream(NumPlayers);
+	PlayerLocations = StartLocations;
+	const double HashedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		MovePlayers(HashedStream);
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			Found.Reset();
+			SpatialHash.Query(PlayerLocation, ScanRadius, /*out*/ Found);
+			NumFoundHashed += Found.Num();
+		}
+	}
+	const double HashedTime = FPlatformTime::Seconds() - HashedStartTime;
+
+	UE_LOG(LogLyra, Log, TEXT("Interactable radius queries for %d players over %d interactables, %d frames: linear %.4f ms/frame (%d found), spatial hash %.4f ms/frame (%d found)"),
+		NumPlayers, NumInteractables, NumFrames,
+		(LinearTime * 1000.0) / NumFrames, NumFoundLinear,
+		(HashedTime * 1000.0) / NumFrames, NumFoundHashed);
+
+	if (ULyraInteractableSubsystem* Subsystem = UWorld::GetSubsystem<ULyraInteractableSubsystem>(World))
+	{
+		UE_LOG(LogLyra, Log, TEXT("%d interactables currently registered in %s"), Subsystem->GetNumInteractables(), *GetNameSafe(World));
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkInteractableSpatialHash(
+	TEXT("Lyra.Interaction.BenchmarkSpatialIndex"),
+	TEXT("Compares radius queries of [NumPlayers=32] players against [NumInteractables=5000] interactables through a linear scan and the spatial hash over [NumFrames=100] frames"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkInteractableSpatialHash));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Interaction/InteractionOption.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraInteractableSubsystem.generated.h"
+
+class IInteractableTarget;
+class UObject;
+struct FInteractionQuery;
+template <typename InterfaceType> class TScriptInterface;
+
+/**
+ * FLyraInteractableSpatialHash
+ *
+ * Uniform grid of spheres keyed by id, answering radius queries by only visiting the cells the query
+ * (grown by the largest registered sphere) touches.
+ */
+struct FLyraInteractableSpatialHash
+{
+public:
+	explicit FLyraInteractableSpatialHash(float InCellSize = 1000.0f);
+
+	void Add(int32 Id, const FVector& Location, float Radius);
+	void Remove(int32 Id);
+	void Update(int32 Id, const FVector& Location, float Radius);
+
+	// Appends the ids of every sphere overlapping the query sphere
+	void Query(const FVector& Center, float Radius, TArray<int32>& OutIds) const;
+
+	int32 Num() const { return Elements.Num(); }
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	struct FElement
+	{
+		FVector Location;
+		float Radius;
+		FIntVector Cell;
+	};
+
+	float CellSize;
+
+	// Largest radius ever added, queries are grown by this much to find spheres centered in neighbouring cells
+	float MaxElementRadius = 0.0f;
+
+	TMap<int32, FElement> Elements;
+	TMap<FIntVector, TArray<int32>> Cells;
+};
+
+USTRUCT()
+struct FLyraInteractableEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Object;
+
+	// Options gathered the last time, only used if the interactable allows caching
+	UPROPERTY()
+	TArray<FInteractionOption> CachedOptions;
+
+	bool bHasCachedOptions = false;
+};
+
+/**
+ * ULyraInteractableSubsystem
+ *
+ * Registry of the interactables in the world. Interactables register themselves with a location and
+ * radius and are kept in a spatial hash, so nearby interactables can be found without a physics overlap.
+ * It also caches the interaction options of interactables whose options do not depend on the query,
+ * until the interactable invalidates them.
+ */
+UCLASS()
+class LYRAGAME_API ULyraInteractableSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraInteractableSubsystem();
+
+	// Returns true if interactables should be discovered through the registry instead of physics queries
+	static bool IsSpatialIndexEnabled();
+
+	void RegisterInteractable(TScriptInterface<IInteractableTarget> Target, const FVector& Location, float Radius);
+	void UnregisterInteractable(TScriptInterface<IInteractableTarget> Target);
+
+	// Moves an already registered interactable
+	void UpdateInteractableLocation(TScriptInterface<IInteractableTarget> Target, const FVector& Location, float Radius);
+
+	// Discards the cached interaction options of the interactable, call whenever its options change
+	void InvalidateInteractionOptions(TScriptInterface<IInteractableTarget> Target);
+
+	// Appends every registered interactable overlapping the sphere
+	void QueryInteractables(const FVector& Center, float Radius, TArray<TScriptInterface<IInteractableTarget>>& OutTargets) const;
+
+	// Returns true if at least one registered interactable overlaps the sphere
+	bool HasInteractablesInRange(const FVector& Center, float Radius) const;
+
+	// Appends the interaction options of the target, from the cache when possible
+	void GatherInteractionOptions(const TScriptInterface<IInteractableTarget>& Target, const FInteractionQuery& Query, TArray<FInteractionOption>& OutOptions);
+
+	int32 GetNumInteractables() const { return EntryIndices.Num(); }
+
+protected:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	//~End of USubsystem interface
+
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	UPROPERTY(Transient)
+	TArray<FLyraInteractableEntry> Entries;
+
+	// Unused slots in Entries
+	TArray<int32> FreeEntries;
+
+	TMap<FObjectKey, int32> EntryIndices;
+
+	FLyraInteractableSpatialHash SpatialHash;
+};
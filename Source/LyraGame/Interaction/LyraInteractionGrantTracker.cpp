@@ -0,0 +1,176 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Interaction/LyraInteractionGrantTracker.h"
+
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+//////////////////////////////////////////////////////////////////////
+// FLyraInteractionGrantTracker
+
+void FLyraInteractionGrantTracker::BeginScan()
+{
+	for (TPair<FObjectKey, FGrant>& Pair : Grants)
+	{
+		Pair.Value.RefCount = 0;
+	}
+}
+
+bool FLyraInteractionGrantTracker::AddReference(const FObjectKey& AbilityKey, double CurrentTime)
+{
+	bool bIsNew = false;
+	FGrant* Grant = Grants.Find(AbilityKey);
+	if (Grant == nullptr)
+	{
+		Grant = &Grants.Add(AbilityKey);
+		bIsNew = true;
+	}
+
+	++Grant->RefCount;
+	Grant->LastReferencedTime = CurrentTime;
+	return bIsNew;
+}
+
+void FLyraInteractionGrantTracker::SetGrantHandle(const FObjectKey& AbilityKey, const FGameplayAbilitySpecHandle& Handle)
+{
+	if (FGrant* Grant = Grants.Find(AbilityKey))
+	{
+		Grant->Handle = Handle;
+	}
+}
+
+void FLyraInteractionGrantTracker::EndScan(double CurrentTime, float GracePeriod, int32 MaxLingeringGrants, TArray<FGameplayAbilitySpecHandle>& OutHandlesToRevoke)
+{
+	TArray<TPair<double, FObjectKey>, TInlineAllocator<16>> LingeringGrants;
+
+	for (auto It = Grants.CreateIterator(); It; ++It)
+	{
+		const FGrant& Grant = It.Value();
+		if (Grant.RefCount > 0)
+		{
+			continue;
+		}
+
+		if ((CurrentTime - Grant.LastReferencedTime) >= GracePeriod)
+		{
+			OutHandlesToRevoke.Add(Grant.Handle);
+			It.RemoveCurrent();
+		}
+		else
+		{
+			LingeringGrants.Emplace(Grant.LastReferencedTime, It.Key());
+		}
+	}
+
+	// Grants still in range are always kept, only the lingering ones count against the budget
+	const int32 NumOverBudget = LingeringGrants.Num() - FMath::Max(MaxLingeringGrants, 0);
+	if (NumOverBudget > 0)
+	{
+		LingeringGrants.Sort([](const TPair<double, FObjectKey>& A, const TPair<double, FObjectKey>& B)
+		{
+			return A.Key < B.Key;
+		});
+
+		for (int32 Index = 0; Index < NumOverBudget; ++Index)
+		{
+			FGrant RemovedGrant;
+			if (Grants.RemoveAndCopyValue(LingeringGrants[Index].Value, /*out*/ RemovedGrant))
+			{
+				OutHandlesToRevoke.Add(RemovedGrant.Handle);
+			}
+		}
+	}
+}
+
+void FLyraInteractionGrantTracker::Reset(TArray<FGameplayAbilitySpecHandle>& OutHandlesToRevoke)
+{
+	for (const TPair<FObjectKey, FGrant>& Pair : Grants)
+	{
+		OutHandlesToRevoke.Add(Pair.Value.Handle);
+	}
+	Grants.Reset();
+}
+
+int32 FLyraInteractionGrantTracker::GetNumReferencedGrants() const
+{
+	int32 NumReferenced = 0;
+	for (const TPair<FObjectKey, FGrant>& Pair : Grants)
+	{
+		if (Pair.Value.RefCount > 0)
+		{
+			++NumReferenced;
+		}
+	}
+	return NumReferenced;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+// Walks a simulated pawn down a line of interactables that each offer their own interaction ability,
+// and reports how many grants are live along the way
+static void SimulateInteractionGrantWalk(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumInteractables = (Args.Num() > 0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+	const int32 NumInRange = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 4;
+	const float GracePeriod = (Args.Num() > 2) ? FCString::Atof(*Args[2]) : 2.0f;
+	const int32 MaxLingeringGrants = (Args.Num() > 3) ? FCString::Atoi(*Args[3]) : 8;
+
+	// One scan every 0.1 s, passing one interactable per scan
+	const double ScanInterval = 0.1;
+
+	// Stand-ins for the ability classes, only their identity matters to the tracker
+	TArray<TStrongObjectPtr<UObject>> AbilityStandIns;
+	AbilityStandIns.Reserve(NumInteractables);
+	for (int32 Index = 0; Index < NumInteractables; ++Index)
+	{
+		AbilityStandIns.Emplace(NewObject<UObject>(GetTransientPackage()));
+	}
+
+	FLyraInteractionGrantTracker Tracker;
+	TArray<FGameplayAbilitySpecHandle> HandlesToRevoke;
+	int32 NumGranted = 0;
+	int32 NumRevoked = 0;
+	int32 PeakLiveGrants = 0;
+
+	const int32 NumScans = NumInteractables + NumInRange;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Scan = 0; Scan < NumScans; ++Scan)
+	{
+		const double CurrentTime = Scan * ScanInterval;
+
+		Tracker.BeginScan();
+		for (int32 Index = FMath::Max(Scan - NumInRange + 1, 0); Index <= FMath::Min(Scan, NumInteractables - 1); ++Index)
+		{
+			const FObjectKey AbilityKey(AbilityStandIns[Index].Get());
+			if (Tracker.AddReference(AbilityKey, CurrentTime))
+			{
+				FGameplayAbilitySpecHandle Handle;
+				Handle.GenerateNewHandle();
+				Tracker.SetGrantHandle(AbilityKey, Handle);
+				++NumGranted;
+			}
+		}
+
+		HandlesToRevoke.Reset();
+		Tracker.EndScan(CurrentTime, GracePeriod, MaxLingeringGrants, /*out*/ HandlesToRevoke);
+		NumRevoked += HandlesToRevoke.Num();
+
+		PeakLiveGrants = FMath::Max(PeakLiveGrants, Tracker.GetNumLiveGrants());
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogLyra, Log, TEXT("Interaction grant walk past %d interactables (%d in range, %.1f s grace, %d lingering max): %d granted, %d revoked, %d live at the end, %d peak, %.3f us per scan"),
+		NumInteractables, NumInRange, GracePeriod, MaxLingeringGrants, NumGranted, NumRevoked, Tracker.GetNumLiveGrants(), PeakLiveGrants,
+		(ElapsedTime * 1000000.0) / NumScans);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSimulateInteractionGrantWalk(
+	TEXT("Lyra.Interaction.SimulateGrantWalk"),
+	TEXT("Walks a simulated pawn past [NumInteractables=1000] interactables with [NumInRange=4] in range at a time, using [GracePeriod=2] and [MaxLingeringGrants=8], and logs the live interaction grant count"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(SimulateInteractionGrantWalk));
+
+#endif // !UE_BUILD_SHIPPING
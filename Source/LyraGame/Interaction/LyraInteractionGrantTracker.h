@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameplayAbilitySpecHandle.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * FLyraInteractionGrantTracker
+ *
+ * Tracks the interaction abilities granted to an avatar because of nearby interactables. Every scan
+ * counts how many in-range interaction options reference each ability; an ability nothing references
+ * anymore is kept for a grace period (so walking back and forth along the edge of the scan range does
+ * not grant and revoke it over and over), after which it is revoked. On top of that, the number of
+ * lingering out-of-range grants is capped, with the least recently used ones revoked first.
+ *
+ * Does not touch the ability system itself, the owner grants and revokes the handles it is told to.
+ */
+struct FLyraInteractionGrantTracker
+{
+public:
+	// Starts a new scan, clearing the reference counts of every grant
+	void BeginScan();
+
+	// Adds a reference from an in-range interaction option, returns true if the ability is not granted yet
+	bool AddReference(const FObjectKey& AbilityKey, double CurrentTime);
+
+	// Records the handle the ability was granted with
+	void SetGrantHandle(const FObjectKey& AbilityKey, const FGameplayAbilitySpecHandle& Handle);
+
+	// Ends the scan, removing grants that are out of range past the grace period or over the lingering
+	// budget and appending their handles to OutHandlesToRevoke
+	void EndScan(double CurrentTime, float GracePeriod, int32 MaxLingeringGrants, TArray<FGameplayAbilitySpecHandle>& OutHandlesToRevoke);
+
+	// Removes every grant, appending their handles to OutHandlesToRevoke
+	void Reset(TArray<FGameplayAbilitySpecHandle>& OutHandlesToRevoke);
+
+	// Number of abilities currently granted
+	int32 GetNumLiveGrants() const { return Grants.Num(); }
+
+	// Number of granted abilities referenced by the last scan
+	int32 GetNumReferencedGrants() const;
+
+private:
+	struct FGrant
+	{
+		FGameplayAbilitySpecHandle Handle;
+		double LastReferencedTime = 0.0;
+		int32 RefCount = 0;
+	};
+
+	TMap<FObjectKey, FGrant> Grants;
+};
@@ -6,15 +6,35 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "GameFramework/Controller.h"
+#include "HAL/IConsoleManager.h"
 #include "Interaction/IInteractableTarget.h"
 #include "Interaction/InteractionOption.h"
 #include "Interaction/InteractionQuery.h"
 #include "Interaction/InteractionStatics.h"
+#include "Interaction/LyraInteractableSubsystem.h"
+#include "LyraLogChannels.h"
 #include "Physics/LyraCollisionChannels.h"
 #include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_GrantNearbyInteraction)
 
+namespace LyraInteractionCVars
+{
+	static float GrantGracePeriod = 5.0f;
+	static FAutoConsoleVariableRef CVarGrantGracePeriod(
+		TEXT("Lyra.Interaction.GrantGracePeriod"),
+		GrantGracePeriod,
+		TEXT("Seconds an interaction ability stays granted after the last interactable offering it leaves the scan range"),
+		ECVF_Default);
+
+	static int32 MaxLingeringGrants = 16;
+	static FAutoConsoleVariableRef CVarMaxLingeringGrants(
+		TEXT("Lyra.Interaction.MaxLingeringGrants"),
+		MaxLingeringGrants,
+		TEXT("Maximum number of out of range interaction abilities kept granted during their grace period, the least recently used are revoked first"),
+		ECVF_Default);
+}
+
 UAbilityTask_GrantNearbyInteraction::UAbilityTask_GrantNearbyInteraction(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -43,6 +63,10 @@ void UAbilityTask_GrantNearbyInteraction::OnDestroy(bool AbilityEnded)
 		World->GetTimerManager().ClearTimer(QueryTimerHandle);
 	}
 
+	TArray<FGameplayAbilitySpecHandle> HandlesToRevoke;
+	InteractionGrants.Reset(/*out*/ HandlesToRevoke);
+	RevokeInteractionAbilities(HandlesToRevoke);
+
 	Super::OnDestroy(AbilityEnded);
 }
 
@@ -53,16 +77,28 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 	
 	if (World && ActorOwner)
 	{
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
+		const double CurrentTime = World->GetTimeSeconds();
+		InteractionGrants.BeginScan();
 
-		TArray<FOverlapResult> OverlapResults;
-		World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(), FQuat::Identity, Lyra_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+		TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
 
-		if (OverlapResults.Num() > 0)
+		ULyraInteractableSubsystem* InteractableSubsystem = World->GetSubsystem<ULyraInteractableSubsystem>();
+		if (InteractableSubsystem && ULyraInteractableSubsystem::IsSpatialIndexEnabled())
+		{
+			InteractableSubsystem->QueryInteractables(ActorOwner->GetActorLocation(), InteractionScanRange, OUT InteractableTargets);
+		}
+		else
 		{
-			TArray<TScriptInterface<IInteractableTarget>> InteractableTargets;
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(UAbilityTask_GrantNearbyInteraction), false);
+
+			TArray<FOverlapResult> OverlapResults;
+			World->OverlapMultiByChannel(OUT OverlapResults, ActorOwner->GetActorLocation(), FQuat::Identity, Lyra_TraceChannel_Interaction, FCollisionShape::MakeSphere(InteractionScanRange), Params);
+
 			UInteractionStatics::AppendInteractableTargetsFromOverlapResults(OverlapResults, OUT InteractableTargets);
-			
+		}
+
+		if (InteractableTargets.Num() > 0)
+		{
 			FInteractionQuery InteractionQuery;
 			InteractionQuery.RequestingAvatar = ActorOwner;
 			InteractionQuery.RequestingController = Cast<AController>(ActorOwner->GetOwner());
@@ -70,8 +106,7 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 			TArray<FInteractionOption> Options;
 			for (TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
 			{
-				FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, Options);
-				InteractiveTarget->GatherInteractionOptions(InteractionQuery, InteractionBuilder);
+				UInteractionStatics::GatherInteractionOptions(World, InteractiveTarget, InteractionQuery, Options);
 			}
 
 			// Check if any of the options need to grant the ability to the user before they can be used.
@@ -81,15 +116,48 @@ void UAbilityTask_GrantNearbyInteraction::QueryInteractables()
 				{
 					// Grant the ability to the GAS, otherwise it won't be able to do whatever the interaction is.
 					FObjectKey ObjectKey(Option.InteractionAbilityToGrant);
-					if (!InteractionAbilityCache.Find(ObjectKey))
+					if (InteractionGrants.AddReference(ObjectKey, CurrentTime))
 					{
 						FGameplayAbilitySpec Spec(Option.InteractionAbilityToGrant, 1, INDEX_NONE, this);
 						FGameplayAbilitySpecHandle Handle = AbilitySystemComponent->GiveAbility(Spec);
-						InteractionAbilityCache.Add(ObjectKey, Handle);
+						InteractionGrants.SetGrantHandle(ObjectKey, Handle);
 					}
 				}
 			}
 		}
+
+		// Revoke the abilities that have been out of range for too long
+		TArray<FGameplayAbilitySpecHandle> HandlesToRevoke;
+		InteractionGrants.EndScan(CurrentTime, LyraInteractionCVars::GrantGracePeriod, LyraInteractionCVars::MaxLingeringGrants, /*out*/ HandlesToRevoke);
+		RevokeInteractionAbilities(HandlesToRevoke);
 	}
 }
 
+void UAbilityTask_GrantNearbyInteraction::RevokeInteractionAbilities(const TArray<FGameplayAbilitySpecHandle>& HandlesToRevoke)
+{
+	if ((HandlesToRevoke.Num() == 0) || !AbilitySystemComponent.IsValid() || !AbilitySystemComponent->IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : HandlesToRevoke)
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		// ClearAbility would cancel an interaction in progress, let those finish and be removed when they end
+		const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromHandle(Handle);
+		if ((Spec != nullptr) && Spec->IsActive())
+		{
+			AbilitySystemComponent->SetRemoveAbilityOnEnd(Handle);
+		}
+		else
+		{
+			AbilitySystemComponent->ClearAbility(Handle);
+		}
+	}
+
+	UE_LOG(LogLyra, Verbose, TEXT("%s revoked %d interaction abilities, %d still granted"), *GetNameSafe(GetAvatarActor()), HandlesToRevoke.Num(), InteractionGrants.GetNumLiveGrants());
+}
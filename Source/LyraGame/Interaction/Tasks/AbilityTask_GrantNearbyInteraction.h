@@ -2,14 +2,13 @@
 #pragma once
 
 #include "Abilities/Tasks/AbilityTask.h"
+#include "Interaction/LyraInteractionGrantTracker.h"
 
 #include "AbilityTask_GrantNearbyInteraction.generated.h"
 
 class UGameplayAbility;
 class UObject;
 struct FFrame;
-struct FGameplayAbilitySpecHandle;
-struct FObjectKey;
 
 UCLASS()
 class UAbilityTask_GrantNearbyInteraction : public UAbilityTask
@@ -22,6 +21,9 @@ class UAbilityTask_GrantNearbyInteraction : public UAbilityTask
 	UFUNCTION(BlueprintCallable, Category="Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
 	static UAbilityTask_GrantNearbyInteraction* GrantAbilitiesForNearbyInteractors(UGameplayAbility* OwningAbility, float InteractionScanRange, float InteractionScanRate);
 
+	/** Number of interaction abilities currently granted by this task */
+	int32 GetNumLiveInteractionGrants() const { return InteractionGrants.GetNumLiveGrants(); }
+
 private:
 
 	virtual void OnDestroy(bool AbilityEnded) override;
@@ -33,5 +35,7 @@ private:
 
 	FTimerHandle QueryTimerHandle;
 
-	TMap<FObjectKey, FGameplayAbilitySpecHandle> InteractionAbilityCache;
+	void RevokeInteractionAbilities(const TArray<FGameplayAbilitySpecHandle>& HandlesToRevoke);
+
+	FLyraInteractionGrantTracker InteractionGrants;
 };
@@ -6,6 +6,7 @@
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include "Interaction/IInteractableTarget.h"
+#include "Interaction/InteractionStatics.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_WaitForInteractableTargets)
 
@@ -111,8 +112,7 @@ void UAbilityTask_WaitForInteractableTargets::UpdateInteractableOptions(const FI
 	for (const TScriptInterface<IInteractableTarget>& InteractiveTarget : InteractableTargets)
 	{
 		TArray<FInteractionOption> TempOptions;
-		FInteractionOptionBuilder InteractionBuilder(InteractiveTarget, TempOptions);
-		InteractiveTarget->GatherInteractionOptions(InteractQuery, InteractionBuilder);
+		UInteractionStatics::GatherInteractionOptions(GetWorld(), InteractiveTarget, InteractQuery, TempOptions);
 
 		for (FInteractionOption& Option : TempOptions)
 		{
@@ -2,6 +2,7 @@
 
 #include "AbilityTask_WaitForInteractableTargets_SingleLineTrace.h"
 #include "Interaction/InteractionStatics.h"
+#include "Interaction/LyraInteractableSubsystem.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -54,6 +55,17 @@ void UAbilityTask_WaitForInteractableTargets_SingleLineTrace::PerformTrace()
 
 	UWorld* World = GetWorld();
 
+	// Nothing registered in range means there is nothing the trace could find, so skip it
+	const ULyraInteractableSubsystem* InteractableSubsystem = World->GetSubsystem<ULyraInteractableSubsystem>();
+	if (InteractableSubsystem && ULyraInteractableSubsystem::IsSpatialIndexEnabled())
+	{
+		if (!InteractableSubsystem->HasInteractablesInRange(StartLocation.GetTargetingTransform().GetLocation(), InteractionScanRange))
+		{
+			UpdateInteractableOptions(InteractionQuery, TArray<TScriptInterface<IInteractableTarget>>());
+			return;
+		}
+	}
+
 	TArray<AActor*> ActorsToIgnore;
 	ActorsToIgnore.Add(AvatarActor);
 
@@ -0,0 +1,177 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Performance/LyraAdaptiveQualityController.h"
+
+//////////////////////////////////////////////////////////////////////
+// FLyraAdaptiveQualityController
+
+void FLyraAdaptiveQualityController::Reset(const Scalability::FQualityLevels& InBaselineLevels)
+{
+	BaselineLevels = InBaselineLevels;
+	CurrentLevels = InBaselineLevels;
+	StepsTaken.Reset();
+
+	SmoothedFrameTime = 0.0f;
+	SmoothedGameThreadTime = 0.0f;
+	SmoothedRenderThreadTime = 0.0f;
+	SmoothedGPUTime = 0.0f;
+	bHasSmoothedSample = false;
+
+	TimeOverBudget = 0.0f;
+	TimeUnderBudget = 0.0f;
+	CooldownRemaining = Tuning.Cooldown;
+
+	bInitialized = true;
+}
+
+bool FLyraAdaptiveQualityController::AddSample(const FLyraAdaptiveQualitySample& Sample)
+{
+	if (!bInitialized || (Sample.FrameTime <= 0.0f) || (Sample.FrameTime > Tuning.HitchThreshold))
+	{
+		return false;
+	}
+
+	// With a frame rate limit the total frame time includes idle time, so judge the frame by its slowest
+	// thread when per-thread timings are available
+	const float BoundTime = FMath::Max3(Sample.GameThreadTime, Sample.RenderThreadTime, Sample.GPUTime);
+	const float MeasuredTime = (BoundTime > 0.0f) ? FMath::Min(BoundTime, Sample.FrameTime) : Sample.FrameTime;
+
+	if (bHasSmoothedSample)
+	{
+		const float Alpha = (Tuning.SmoothingTime > 0.0f) ? (1.0f - FMath::Exp(-Sample.FrameTime / Tuning.SmoothingTime)) : 1.0f;
+		SmoothedFrameTime = FMath::Lerp(SmoothedFrameTime, MeasuredTime, Alpha);
+		SmoothedGameThreadTime = FMath::Lerp(SmoothedGameThreadTime, Sample.GameThreadTime, Alpha);
+		SmoothedRenderThreadTime = FMath::Lerp(SmoothedRenderThreadTime, Sample.RenderThreadTime, Alpha);
+		SmoothedGPUTime = FMath::Lerp(SmoothedGPUTime, Sample.GPUTime, Alpha);
+	}
+	else
+	{
+		SmoothedFrameTime = MeasuredTime;
+		SmoothedGameThreadTime = Sample.GameThreadTime;
+		SmoothedRenderThreadTime = Sample.RenderThreadTime;
+		SmoothedGPUTime = Sample.GPUTime;
+		bHasSmoothedSample = true;
+	}
+
+	// Track how long we have been continuously over or under budget, anything in between the two
+	// thresholds resets both so the controller does not oscillate around the target
+	if (SmoothedFrameTime > Tuning.TargetFrameTime * (1.0f + Tuning.DownscaleMargin))
+	{
+		TimeOverBudget += Sample.FrameTime;
+		TimeUnderBudget = 0.0f;
+	}
+	else if (SmoothedFrameTime < Tuning.TargetFrameTime * (1.0f - Tuning.UpscaleMargin))
+	{
+		TimeUnderBudget += Sample.FrameTime;
+		TimeOverBudget = 0.0f;
+	}
+	else
+	{
+		TimeOverBudget = 0.0f;
+		TimeUnderBudget = 0.0f;
+	}
+
+	if (CooldownRemaining > 0.0f)
+	{
+		CooldownRemaining -= Sample.FrameTime;
+		return false;
+	}
+
+	if (TimeOverBudget >= Tuning.DownscaleDelay)
+	{
+		const bool bGPUBound = SmoothedGPUTime >= FMath::Max(SmoothedGameThreadTime, SmoothedRenderThreadTime);
+		if (StepDown(bGPUBound))
+		{
+			OnLevelsChanged();
+			return true;
+		}
+	}
+	else if (TimeUnderBudget >= Tuning.UpscaleDelay)
+	{
+		if (StepUp())
+		{
+			OnLevelsChanged();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32& FLyraAdaptiveQualityController::GetGroupLevel(Scalability::FQualityLevels& Levels, EGroup Group)
+{
+	switch (Group)
+	{
+	case EGroup::ViewDistance:
+		return Levels.ViewDistanceQuality;
+	case EGroup::AntiAliasing:
+		return Levels.AntiAliasingQuality;
+	case EGroup::Shadow:
+		return Levels.ShadowQuality;
+	case EGroup::GlobalIllumination:
+		return Levels.GlobalIlluminationQuality;
+	case EGroup::Reflection:
+		return Levels.ReflectionQuality;
+	case EGroup::PostProcess:
+		return Levels.PostProcessQuality;
+	case EGroup::Effects:
+		return Levels.EffectsQuality;
+	case EGroup::Foliage:
+		return Levels.FoliageQuality;
+	case EGroup::Shading:
+		break;
+	}
+
+	return Levels.ShadingQuality;
+}
+
+bool FLyraAdaptiveQualityController::StepDown(bool bGPUBound)
+{
+	// Groups that mostly cost GPU time vs. groups that mostly cost game/render thread time, in order of preference
+	static const EGroup GPUGroups[] = { EGroup::Shadow, EGroup::GlobalIllumination, EGroup::Reflection, EGroup::PostProcess, EGroup::Effects, EGroup::AntiAliasing, EGroup::Foliage, EGroup::Shading };
+	static const EGroup CPUGroups[] = { EGroup::ViewDistance, EGroup::Foliage, EGroup::Shadow, EGroup::Effects };
+
+	const TArrayView<const EGroup> Candidates = bGPUBound ? TArrayView<const EGroup>(GPUGroups) : TArrayView<const EGroup>(CPUGroups);
+
+	// Lower whichever candidate is currently the highest, so the degradation is spread over the groups
+	int32 BestLevel = 0;
+	const EGroup* BestGroup = nullptr;
+	for (const EGroup& Group : Candidates)
+	{
+		const int32 Level = GetGroupLevel(CurrentLevels, Group);
+		if (Level > BestLevel)
+		{
+			BestLevel = Level;
+			BestGroup = &Group;
+		}
+	}
+
+	if (BestGroup == nullptr)
+	{
+		return false;
+	}
+
+	--GetGroupLevel(CurrentLevels, *BestGroup);
+	StepsTaken.Add(*BestGroup);
+	return true;
+}
+
+bool FLyraAdaptiveQualityController::StepUp()
+{
+	if (StepsTaken.Num() == 0)
+	{
+		return false;
+	}
+
+	const EGroup Group = StepsTaken.Pop(EAllowShrinking::No);
+	int32& Level = GetGroupLevel(CurrentLevels, Group);
+	Level = FMath::Min(Level + 1, GetGroupLevel(BaselineLevels, Group));
+	return true;
+}
+
+void FLyraAdaptiveQualityController::OnLevelsChanged()
+{
+	TimeOverBudget = 0.0f;
+	TimeUnderBudget = 0.0f;
+	CooldownRemaining = Tuning.Cooldown;
+}
@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Scalability.h"
+
+//////////////////////////////////////////////////////////////////////
+
+// Tuning for the adaptive quality controller, all times are in seconds
+struct FLyraAdaptiveQualityTuning
+{
+	// Frame time the controller tries to stay under
+	float TargetFrameTime = 1.0f / 60.0f;
+
+	// Time constant of the exponential moving average applied to the frame time samples
+	float SmoothingTime = 1.0f;
+
+	// The smoothed frame time has to exceed the target by this fraction to count as over budget
+	float DownscaleMargin = 0.1f;
+
+	// The smoothed frame time has to be under the target by this fraction to count as having headroom
+	float UpscaleMargin = 0.25f;
+
+	// How long the frame time has to stay over budget before a group is stepped down
+	float DownscaleDelay = 2.0f;
+
+	// How long the frame time has to stay under budget before a group is stepped back up
+	float UpscaleDelay = 10.0f;
+
+	// Minimum time between two consecutive changes, so each change can settle before it is judged
+	float Cooldown = 3.0f;
+
+	// Samples longer than this are treated as hitches (loads, streaming) and ignored
+	float HitchThreshold = 0.25f;
+};
+
+// A single frame worth of timings fed to the controller
+struct FLyraAdaptiveQualitySample
+{
+	float FrameTime = 0.0f;
+	float GameThreadTime = 0.0f;
+	float RenderThreadTime = 0.0f;
+	float GPUTime = 0.0f;
+};
+
+/**
+ * FLyraAdaptiveQualityController
+ *
+ * Closed loop controller that steps individual scalability groups down when the frame time
+ * stays over budget and restores them when there is sustained headroom. The group to lower is
+ * picked based on whether the GPU or the CPU threads are the bottleneck, and groups are restored
+ * in the reverse order they were lowered so the controller never goes above the baseline.
+ *
+ * The controller does not touch any global state, callers are responsible for applying the
+ * levels whenever AddSample returns true.
+ */
+class FLyraAdaptiveQualityController
+{
+public:
+	// Starts over from the specified levels, forgetting any steps taken so far
+	void Reset(const Scalability::FQualityLevels& InBaselineLevels);
+
+	void SetTuning(const FLyraAdaptiveQualityTuning& InTuning) { Tuning = InTuning; }
+	const FLyraAdaptiveQualityTuning& GetTuning() const { return Tuning; }
+
+	// Feeds one frame to the controller, returns true if the quality levels changed
+	bool AddSample(const FLyraAdaptiveQualitySample& Sample);
+
+	bool IsInitialized() const { return bInitialized; }
+
+	// Levels the controller started from (the user or benchmark chosen levels)
+	const Scalability::FQualityLevels& GetBaselineLevels() const { return BaselineLevels; }
+
+	// Levels the controller currently wants applied
+	const Scalability::FQualityLevels& GetQualityLevels() const { return CurrentLevels; }
+
+	// Number of single level steps currently taken below the baseline
+	int32 GetNumStepsDown() const { return StepsTaken.Num(); }
+
+	float GetSmoothedFrameTime() const { return SmoothedFrameTime; }
+
+private:
+	enum class EGroup : uint8
+	{
+		ViewDistance,
+		AntiAliasing,
+		Shadow,
+		GlobalIllumination,
+		Reflection,
+		PostProcess,
+		Effects,
+		Foliage,
+		Shading,
+	};
+
+	static int32& GetGroupLevel(Scalability::FQualityLevels& Levels, EGroup Group);
+
+	bool StepDown(bool bGPUBound);
+	bool StepUp();
+
+	void OnLevelsChanged();
+
+private:
+	FLyraAdaptiveQualityTuning Tuning;
+
+	Scalability::FQualityLevels BaselineLevels;
+	Scalability::FQualityLevels CurrentLevels;
+
+	// Groups that were stepped down, most recent last
+	TArray<EGroup, TInlineAllocator<16>> StepsTaken;
+
+	float SmoothedFrameTime = 0.0f;
+	float SmoothedGameThreadTime = 0.0f;
+	float SmoothedRenderThreadTime = 0.0f;
+	float SmoothedGPUTime = 0.0f;
+
+	float TimeOverBudget = 0.0f;
+	float TimeUnderBudget = 0.0f;
+	float CooldownRemaining = 0.0f;
+
+	bool bInitialized = false;
+	bool bHasSmoothedSample = false;
+};
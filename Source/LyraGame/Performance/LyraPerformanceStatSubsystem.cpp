@@ -8,12 +8,60 @@
 #include "Engine/World.h"
 #include "GameFramework/PlayerState.h"
 #include "GameModes/LyraGameState.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
 #include "Performance/LyraPerformanceStatTypes.h"
+#include "Settings/LyraSettingsLocal.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPerformanceStatSubsystem)
 
 class FSubsystemCollectionBase;
 
+namespace LyraAdaptiveQualityCVars
+{
+	static float TargetFPS = 60.0f;
+	static FAutoConsoleVariableRef CVarTargetFPS(
+		TEXT("Lyra.AdaptiveQuality.TargetFPS"),
+		TargetFPS,
+		TEXT("Frame rate the adaptive quality controller aims for when no frame rate limit is active"),
+		ECVF_Default);
+
+	static float DownscaleMargin = 0.1f;
+	static FAutoConsoleVariableRef CVarDownscaleMargin(
+		TEXT("Lyra.AdaptiveQuality.DownscaleMargin"),
+		DownscaleMargin,
+		TEXT("Fraction over the target frame time that counts as over budget"),
+		ECVF_Default);
+
+	static float UpscaleMargin = 0.25f;
+	static FAutoConsoleVariableRef CVarUpscaleMargin(
+		TEXT("Lyra.AdaptiveQuality.UpscaleMargin"),
+		UpscaleMargin,
+		TEXT("Fraction under the target frame time that counts as having headroom to raise quality"),
+		ECVF_Default);
+
+	static float DownscaleDelay = 2.0f;
+	static FAutoConsoleVariableRef CVarDownscaleDelay(
+		TEXT("Lyra.AdaptiveQuality.DownscaleDelay"),
+		DownscaleDelay,
+		TEXT("Seconds the frame time has to stay over budget before a scalability group is lowered"),
+		ECVF_Default);
+
+	static float UpscaleDelay = 10.0f;
+	static FAutoConsoleVariableRef CVarUpscaleDelay(
+		TEXT("Lyra.AdaptiveQuality.UpscaleDelay"),
+		UpscaleDelay,
+		TEXT("Seconds the frame time has to stay under budget before a lowered scalability group is raised again"),
+		ECVF_Default);
+
+	static float Cooldown = 3.0f;
+	static FAutoConsoleVariableRef CVarCooldown(
+		TEXT("Lyra.AdaptiveQuality.Cooldown"),
+		Cooldown,
+		TEXT("Minimum number of seconds between two scalability changes"),
+		ECVF_Default);
+}
+
 //////////////////////////////////////////////////////////////////////
 // FLyraPerformanceStatCache
 
@@ -24,6 +72,8 @@ void FLyraPerformanceStatCache::StartCharting()
 void FLyraPerformanceStatCache::ProcessFrame(const FFrameData& FrameData)
 {
 	CachedData = FrameData;
+	MySubsystem->UpdateAdaptiveQuality(FrameData);
+
 	CachedServerFPS = 0.0f;
 	CachedPingMS = 0.0f;
 	CachedPacketLossIncomingPercent = 0.0f;
@@ -119,6 +169,8 @@ void ULyraPerformanceStatSubsystem::Initialize(FSubsystemCollectionBase& Collect
 
 void ULyraPerformanceStatSubsystem::Deinitialize()
 {
+	StopAdaptiveQuality();
+
 	GEngine->RemovePerformanceDataConsumer(Tracker);
 	Tracker.Reset();
 }
@@ -128,3 +180,71 @@ double ULyraPerformanceStatSubsystem::GetCachedStat(ELyraDisplayablePerformanceS
 	return Tracker->GetCachedStat(Stat);
 }
 
+
+void ULyraPerformanceStatSubsystem::UpdateAdaptiveQuality(const IPerformanceDataConsumer::FFrameData& FrameData)
+{
+	ULyraSettingsLocal* Settings = ULyraSettingsLocal::Get();
+	if ((Settings == nullptr) || !Settings->IsAdaptiveQualityEnabled() || GIsEditor || IsRunningDedicatedServer())
+	{
+		StopAdaptiveQuality();
+		return;
+	}
+
+	FLyraAdaptiveQualityTuning Tuning;
+	const float FrameRateLimit = Settings->GetEffectiveFrameRateLimit();
+	const float TargetFPS = (FrameRateLimit > 0.0f) ? FrameRateLimit : LyraAdaptiveQualityCVars::TargetFPS;
+	Tuning.TargetFrameTime = 1.0f / FMath::Max(TargetFPS, 1.0f);
+	Tuning.DownscaleMargin = LyraAdaptiveQualityCVars::DownscaleMargin;
+	Tuning.UpscaleMargin = LyraAdaptiveQualityCVars::UpscaleMargin;
+	Tuning.DownscaleDelay = LyraAdaptiveQualityCVars::DownscaleDelay;
+	Tuning.UpscaleDelay = LyraAdaptiveQualityCVars::UpscaleDelay;
+	Tuning.Cooldown = LyraAdaptiveQualityCVars::Cooldown;
+	AdaptiveQualityController.SetTuning(Tuning);
+
+	if (!AdaptiveQualityController.IsInitialized())
+	{
+		AdaptiveQualityController.Reset(Scalability::GetQualityLevels());
+		return;
+	}
+
+	FLyraAdaptiveQualitySample Sample;
+	Sample.FrameTime = FrameData.TrueDeltaSeconds;
+	Sample.GameThreadTime = FrameData.GameThreadTimeSeconds;
+	Sample.RenderThreadTime = FrameData.RenderThreadTimeSeconds;
+	Sample.GPUTime = FrameData.GPUTimeSeconds;
+
+	const Scalability::FQualityLevels PreviousLevels = AdaptiveQualityController.GetQualityLevels();
+	if (AdaptiveQualityController.AddSample(Sample))
+	{
+		// If something else changed the scalability levels since our last change (the user applying
+		// settings, a front end performance mode, ...) start over from those rather than overriding them
+		if (Scalability::GetQualityLevels() != PreviousLevels)
+		{
+			AdaptiveQualityController.Reset(Scalability::GetQualityLevels());
+			return;
+		}
+
+		Scalability::SetQualityLevels(AdaptiveQualityController.GetQualityLevels());
+
+		UE_LOG(LogLyra, Log, TEXT("Adaptive quality changed scalability (%d steps below baseline, smoothed frame time %.2f ms, target %.2f ms)"),
+			AdaptiveQualityController.GetNumStepsDown(),
+			AdaptiveQualityController.GetSmoothedFrameTime() * 1000.0f,
+			Tuning.TargetFrameTime * 1000.0f);
+	}
+}
+
+void ULyraPerformanceStatSubsystem::StopAdaptiveQuality()
+{
+	if (!AdaptiveQualityController.IsInitialized())
+	{
+		return;
+	}
+
+	// Only undo our own changes, anything applied on top of them since then wins
+	if ((AdaptiveQualityController.GetNumStepsDown() > 0) && (Scalability::GetQualityLevels() == AdaptiveQualityController.GetQualityLevels()))
+	{
+		Scalability::SetQualityLevels(AdaptiveQualityController.GetBaselineLevels());
+	}
+
+	AdaptiveQualityController = FLyraAdaptiveQualityController();
+}
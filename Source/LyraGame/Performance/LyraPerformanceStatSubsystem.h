@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ChartCreation.h"
+#include "Performance/LyraAdaptiveQualityController.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
 #include "LyraPerformanceStatSubsystem.generated.h"
@@ -64,6 +65,17 @@ public:
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	// Feeds the frame to the adaptive quality controller and applies any scalability change it makes
+	void UpdateAdaptiveQuality(const IPerformanceDataConsumer::FFrameData& FrameData);
+
+	const FLyraAdaptiveQualityController& GetAdaptiveQualityController() const { return AdaptiveQualityController; }
+
+protected:
+	// Puts the scalability levels back to where the controller started from and stops adapting
+	void StopAdaptiveQuality();
+
 protected:
 	TSharedPtr<FLyraPerformanceStatCache> Tracker;
+
+	FLyraAdaptiveQualityController AdaptiveQualityController;
 };
@@ -11,6 +11,7 @@
 #include "Components/GameFrameworkComponentManager.h"
 #include "Engine/World.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
+#include "HAL/IConsoleManager.h"
 #include "GameModes/LyraExperienceManagerComponent.h"
 //@TODO: Would like to isolate this a bit better to get the pawn data in here without this having to know about other stuff
 #include "GameModes/LyraGameMode.h"
@@ -27,6 +28,64 @@ class FLifetimeProperty;
 
 const FName ALyraPlayerState::NAME_LyraAbilityReady("LyraAbilitiesReady");
 
+namespace LyraPlayerStateCVars
+{
+	static bool bThrottleViewRotation = true;
+	static FAutoConsoleVariableRef CVarThrottleViewRotation(
+		TEXT("Lyra.ViewRotation.Throttle"),
+		bThrottleViewRotation,
+		TEXT("Only replicate view rotation changes larger than Lyra.ViewRotation.ChangeThreshold, or once they have settled"),
+		ECVF_Default);
+
+	static float ViewRotationChangeThreshold = 0.5f;
+	static FAutoConsoleVariableRef CVarViewRotationChangeThreshold(
+		TEXT("Lyra.ViewRotation.ChangeThreshold"),
+		ViewRotationChangeThreshold,
+		TEXT("Smallest view rotation change (in degrees, on either axis) that is replicated right away"),
+		ECVF_Default);
+
+	static float ViewRotationSettleTime = 0.2f;
+	static FAutoConsoleVariableRef CVarViewRotationSettleTime(
+		TEXT("Lyra.ViewRotation.SettleTime"),
+		ViewRotationSettleTime,
+		TEXT("How long a view rotation change below the threshold is held back before it is replicated anyway"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraReplicatedViewRotation
+
+FLyraReplicatedViewRotation::FLyraReplicatedViewRotation(const FRotator& Rotation)
+	: Pitch(FRotator::CompressAxisToShort(Rotation.Pitch))
+	, Yaw(FRotator::CompressAxisToShort(Rotation.Yaw))
+{
+}
+
+FRotator FLyraReplicatedViewRotation::ToRotator() const
+{
+	return FRotator(FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(Pitch)), FRotator::NormalizeAxis(FRotator::DecompressAxisFromShort(Yaw)), 0.0f);
+}
+
+float FLyraReplicatedViewRotation::GetMaxAxisDelta(const FLyraReplicatedViewRotation& Other) const
+{
+	// Differences wrap around like the axes themselves
+	const int16 PitchDelta = (int16)(uint16)(Pitch - Other.Pitch);
+	const int16 YawDelta = (int16)(uint16)(Yaw - Other.Yaw);
+	return FMath::Max(FMath::Abs((int32)PitchDelta), FMath::Abs((int32)YawDelta)) * (360.0f / 65536.0f);
+}
+
+bool FLyraReplicatedViewRotation::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Pitch;
+	Ar << Yaw;
+
+	bOutSuccess = true;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+// ALyraPlayerState
+
 ALyraPlayerState::ALyraPlayerState(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, MyPlayerConnectionType(ELyraPlayerConnectionType::Player)
@@ -141,17 +200,38 @@ void ALyraPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Out
 
 FRotator ALyraPlayerState::GetReplicatedViewRotation() const
 {
-	// Could replace this with custom replication
-	return ReplicatedViewRotation;
+	return ReplicatedViewRotation.ToRotator();
 }
 
 void ALyraPlayerState::SetReplicatedViewRotation(const FRotator& NewRotation)
 {
-	if (NewRotation != ReplicatedViewRotation)
+	const FLyraReplicatedViewRotation NewViewRotation(NewRotation);
+	if (NewViewRotation == ReplicatedViewRotation)
+	{
+		PendingViewRotation = NewViewRotation;
+		return;
+	}
+
+	// Small changes are held back for up to the settle time, so slow turns still replicate (at a lower rate) and the
+	// rotation the player ends up at always gets sent
+	if (LyraPlayerStateCVars::bThrottleViewRotation && (NewViewRotation.GetMaxAxisDelta(ReplicatedViewRotation) < LyraPlayerStateCVars::ViewRotationChangeThreshold))
 	{
-		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReplicatedViewRotation, this);
-		ReplicatedViewRotation = NewRotation;
+		const double CurrentTime = GetWorld()->GetTimeSeconds();
+		if (PendingViewRotation == ReplicatedViewRotation)
+		{
+			PendingViewRotationTime = CurrentTime;
+		}
+		PendingViewRotation = NewViewRotation;
+
+		if ((CurrentTime - PendingViewRotationTime) < LyraPlayerStateCVars::ViewRotationSettleTime)
+		{
+			return;
+		}
 	}
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ReplicatedViewRotation, this);
+	ReplicatedViewRotation = NewViewRotation;
+	PendingViewRotation = NewViewRotation;
 }
 
 ALyraPlayerController* ALyraPlayerState::GetLyraPlayerController() const
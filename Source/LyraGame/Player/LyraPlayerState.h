@@ -40,6 +40,44 @@ enum class ELyraPlayerConnectionType : uint8
 	InactivePlayer
 };
 
+/**
+ * FLyraReplicatedViewRotation: View rotation quantized to 16 bits per axis. View roll is never replicated.
+ */
+USTRUCT()
+struct FLyraReplicatedViewRotation
+{
+	GENERATED_BODY()
+
+	FLyraReplicatedViewRotation() = default;
+	explicit FLyraReplicatedViewRotation(const FRotator& Rotation);
+
+	FRotator ToRotator() const;
+
+	// Largest change of either axis between the two rotations, in degrees
+	float GetMaxAxisDelta(const FLyraReplicatedViewRotation& Other) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FLyraReplicatedViewRotation& Other) const { return (Pitch == Other.Pitch) && (Yaw == Other.Yaw); }
+	bool operator!=(const FLyraReplicatedViewRotation& Other) const { return !(*this == Other); }
+
+	UPROPERTY()
+	uint16 Pitch = 0;
+
+	UPROPERTY()
+	uint16 Yaw = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FLyraReplicatedViewRotation> : public TStructOpsTypeTraitsBase2<FLyraReplicatedViewRotation>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 /**
  * ALyraPlayerState
  *
@@ -129,7 +167,8 @@ public:
 	// Gets the replicated view rotation of this player, used for spectating
 	FRotator GetReplicatedViewRotation() const;
 
-	// Sets the replicated view rotation, only valid on the server
+	// Sets the replicated view rotation, only valid on the server. Changes smaller than Lyra.ViewRotation.ChangeThreshold
+	// are held back for up to Lyra.ViewRotation.SettleTime, so small adjustments do not dirty the player state every tick
 	void SetReplicatedViewRotation(const FRotator& NewRotation);
 
 private:
@@ -173,7 +212,11 @@ private:
 	FGameplayTagStackContainer StatTags;
 
 	UPROPERTY(Replicated)
-	FRotator ReplicatedViewRotation;
+	FLyraReplicatedViewRotation ReplicatedViewRotation;
+
+	// Last view rotation passed to SetReplicatedViewRotation that was not replicated yet, and when it started differing
+	FLyraReplicatedViewRotation PendingViewRotation;
+	double PendingViewRotationTime = 0.0;
 
 private:
 	UFUNCTION()
@@ -4,6 +4,7 @@
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "Engine/DemoNetDriver.h"
+#include "HAL/IConsoleManager.h"
 #include "Internationalization/Text.h"
 #include "Misc/DateTime.h"
 #include "CommonUISettings.h"
@@ -20,6 +21,13 @@ ULyraReplaySubsystem::ULyraReplaySubsystem()
 {
 }
 
+void ULyraReplaySubsystem::Deinitialize()
+{
+	RestoreCheckpointInterval();
+
+	Super::Deinitialize();
+}
+
 bool ULyraReplaySubsystem::DoesPlatformSupportReplays()
 {
 	if (ICommonUIModule::GetSettings().GetPlatformTraits().HasTag(GetPlatformSupportTraitTag()))
@@ -48,6 +56,7 @@ void ULyraReplaySubsystem::RecordClientReplay(APlayerController* PlayerControlle
 	if (ensure(DoesPlatformSupportReplays() && PlayerController))
 	{
 		FText FriendlyNameText = FText::Format(NSLOCTEXT("Lyra", "LyraReplayName_Format", "Client Replay {0}"), FText::AsDateTime(FDateTime::UtcNow(), EDateTimeStyle::Short, EDateTimeStyle::Short));
+		ApplyClientReplayCheckpointInterval();
 		GetGameInstance()->StartRecordingReplay(FString(), FriendlyNameText.ToString());
 
 		if (ULyraLocalPlayer* LyraLocalPlayer = Cast<ULyraLocalPlayer>(PlayerController->GetLocalPlayer()))
@@ -59,6 +68,54 @@ void ULyraReplaySubsystem::RecordClientReplay(APlayerController* PlayerControlle
 	}
 }
 
+void ULyraReplaySubsystem::ApplyClientReplayCheckpointInterval()
+{
+	if (ClientReplayCheckpointIntervalSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	if (IConsoleVariable* CheckpointIntervalCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds")))
+	{
+		if (SavedCheckpointIntervalSeconds < 0.0f)
+		{
+			SavedCheckpointIntervalSeconds = CheckpointIntervalCVar->GetFloat();
+		}
+		CheckpointIntervalCVar->Set(ClientReplayCheckpointIntervalSeconds, ECVF_SetByCode);
+
+		if (!RecordingCompleteHandle.IsValid())
+		{
+			RecordingCompleteHandle = FNetworkReplayDelegates::OnReplayRecordingComplete.AddUObject(this, &ThisClass::HandleReplayRecordingComplete);
+		}
+	}
+}
+
+void ULyraReplaySubsystem::RestoreCheckpointInterval()
+{
+	if (RecordingCompleteHandle.IsValid())
+	{
+		FNetworkReplayDelegates::OnReplayRecordingComplete.Remove(RecordingCompleteHandle);
+		RecordingCompleteHandle.Reset();
+	}
+
+	if (SavedCheckpointIntervalSeconds >= 0.0f)
+	{
+		if (IConsoleVariable* CheckpointIntervalCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds")))
+		{
+			CheckpointIntervalCVar->Set(SavedCheckpointIntervalSeconds, ECVF_SetByCode);
+		}
+		SavedCheckpointIntervalSeconds = -1.0f;
+	}
+}
+
+void ULyraReplaySubsystem::HandleReplayRecordingComplete(UWorld* World)
+{
+	if ((World != nullptr) && (World->GetGameInstance() == GetGameInstance()))
+	{
+		RestoreCheckpointInterval();
+	}
+}
+
 void ULyraReplaySubsystem::CleanupLocalReplays(ULocalPlayer* LocalPlayer, int32 NumReplaysToKeep)
 {
 	// TODO this was only tested with the generic file streamer and may not fully work with the save game streamer
@@ -162,8 +219,58 @@ void ULyraReplaySubsystem::SeekInActiveReplay(float TimeInSeconds)
 {
 	if (UDemoNetDriver* DemoDriver = GetDemoDriver())
 	{
-		DemoDriver->GotoTimeInSeconds(TimeInSeconds);
+		if (IsSeekInProgress())
+		{
+			// Scrubbing issues a seek every frame, restarting the checkpoint load each time would never let one finish
+			PendingSeekTime = FMath::Max(TimeInSeconds, 0.0f);
+			return;
+		}
+
+		SeekStartTime = FPlatformTime::Seconds();
+		if (!StartSeek(DemoDriver, TimeInSeconds))
+		{
+			OnSeekComplete.Broadcast(false, FPlatformTime::Seconds() - SeekStartTime);
+		}
+	}
+}
+
+bool ULyraReplaySubsystem::IsSeekInProgress() const
+{
+	// The seek is abandoned if the driver it was issued on went away
+	return SeekingDemoDriver.IsValid() && (SeekingDemoDriver.Get() == GetDemoDriver());
+}
+
+bool ULyraReplaySubsystem::StartSeek(UDemoNetDriver* DemoDriver, float TimeInSeconds)
+{
+	PendingSeekTime = -1.0f;
+	SeekingDemoDriver = DemoDriver;
+
+	// The completion delegate is never called when the driver refuses the seek, so nothing would clear the seek state
+	if (!DemoDriver->GotoTimeInSeconds(TimeInSeconds, FOnGotoTimeDelegate::CreateUObject(this, &ThisClass::HandleSeekComplete)))
+	{
+		SeekingDemoDriver.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void ULyraReplaySubsystem::HandleSeekComplete(bool bWasSuccessful)
+{
+	UDemoNetDriver* DemoDriver = SeekingDemoDriver.Get();
+	SeekingDemoDriver.Reset();
+
+	if ((PendingSeekTime >= 0.0f) && (DemoDriver != nullptr) && (DemoDriver == GetDemoDriver()))
+	{
+		if (StartSeek(DemoDriver, PendingSeekTime))
+		{
+			return;
+		}
+		bWasSuccessful = false;
 	}
+
+	PendingSeekTime = -1.0f;
+	OnSeekComplete.Broadcast(bWasSuccessful, FPlatformTime::Seconds() - SeekStartTime);
 }
 
 float ULyraReplaySubsystem::GetReplayLengthInSeconds() const
@@ -195,3 +302,79 @@ UDemoNetDriver* ULyraReplaySubsystem::GetDemoDriver() const
 
 
 
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+// Seeks through the active replay at a few fixed fractions of its length, one after the other, and logs how long each took
+struct FLyraReplaySeekBenchmark : public TSharedFromThis<FLyraReplaySeekBenchmark>
+{
+	TWeakObjectPtr<ULyraReplaySubsystem> Subsystem;
+	TArray<float> SeekTimes;
+	int32 NextSeekIndex = 0;
+	FDelegateHandle SeekCompleteHandle;
+
+	// The benchmark in progress, kept alive until its last seek completes (the delegate only holds a weak reference)
+	static TSharedPtr<FLyraReplaySeekBenchmark> Active;
+
+	void SeekNext()
+	{
+		ULyraReplaySubsystem* ReplaySubsystem = Subsystem.Get();
+		if ((ReplaySubsystem == nullptr) || !SeekTimes.IsValidIndex(NextSeekIndex))
+		{
+			if (ReplaySubsystem != nullptr)
+			{
+				ReplaySubsystem->OnSeekComplete.Remove(SeekCompleteHandle);
+			}
+			Active.Reset();
+			return;
+		}
+
+		ReplaySubsystem->SeekInActiveReplay(SeekTimes[NextSeekIndex]);
+	}
+
+	void HandleSeekComplete(bool bWasSuccessful, double SeekDurationSeconds)
+	{
+		UE_LOG(LogLyra, Log, TEXT("Replay seek to %.1fs %s in %.1f ms"), SeekTimes[NextSeekIndex], bWasSuccessful ? TEXT("finished") : TEXT("failed"), SeekDurationSeconds * 1000.0);
+		++NextSeekIndex;
+		SeekNext();
+	}
+};
+
+TSharedPtr<FLyraReplaySeekBenchmark> FLyraReplaySeekBenchmark::Active;
+
+static void BenchmarkReplaySeeks(const TArray<FString>& Args, UWorld* World)
+{
+	// A benchmark whose game instance went away mid-seek never completes
+	if (FLyraReplaySeekBenchmark::Active.IsValid() && !FLyraReplaySeekBenchmark::Active->Subsystem.IsValid())
+	{
+		FLyraReplaySeekBenchmark::Active.Reset();
+	}
+
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	ULyraReplaySubsystem* ReplaySubsystem = GameInstance ? GameInstance->GetSubsystem<ULyraReplaySubsystem>() : nullptr;
+	const float ReplayLength = ReplaySubsystem ? ReplaySubsystem->GetReplayLengthInSeconds() : 0.0f;
+	if ((ReplayLength <= 0.0f) || ReplaySubsystem->IsSeekInProgress() || FLyraReplaySeekBenchmark::Active.IsValid())
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Lyra.Replay.BenchmarkSeek requires a replay to be playing, and no other benchmark to be running (see also the Lyra.Replays.RecordAndSeek automation test)"));
+		return;
+	}
+
+	TSharedRef<FLyraReplaySeekBenchmark> Benchmark = MakeShared<FLyraReplaySeekBenchmark>();
+	Benchmark->Subsystem = ReplaySubsystem;
+	for (const float Fraction : { 0.9f, 0.1f, 0.5f, 0.75f, 0.25f, 0.95f })
+	{
+		Benchmark->SeekTimes.Add(ReplayLength * Fraction);
+	}
+	Benchmark->SeekCompleteHandle = ReplaySubsystem->OnSeekComplete.AddSP(Benchmark, &FLyraReplaySeekBenchmark::HandleSeekComplete);
+	FLyraReplaySeekBenchmark::Active = Benchmark;
+	Benchmark->SeekNext();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkReplaySeeks(
+	TEXT("Lyra.Replay.BenchmarkSeek"),
+	TEXT("Seeks to several offsets in the currently playing replay and logs the latency of each seek"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkReplaySeeks));
+
+#endif // !UE_BUILD_SHIPPING
@@ -55,7 +55,7 @@ public:
 };
 
 /** Subsystem to handle recording/loading replays */
-UCLASS()
+UCLASS(Config=Engine)
 class LYRAGAME_API ULyraReplaySubsystem : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
@@ -63,6 +63,10 @@ class LYRAGAME_API ULyraReplaySubsystem : public UGameInstanceSubsystem
 public:
 	ULyraReplaySubsystem();
 
+	//~USubsystem interface
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 	/** Returns true if this platform supports replays at all */
 	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
 	static bool DoesPlatformSupportReplays();
@@ -82,10 +86,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Replays)
 	void CleanupLocalReplays(ULocalPlayer* LocalPlayer, int32 NumReplaysToKeep);
 
-	/** Move forward or back in currently playing replay */
+	/**
+	 * Move forward or back in currently playing replay.
+	 * While a seek is still loading, only the most recent request is kept and issued once it finishes.
+	 */
 	UFUNCTION(BlueprintCallable, Category=Replays)
 	void SeekInActiveReplay(float TimeInSeconds);
 
+	/** Returns true if a seek is still loading its checkpoint or fast forwarding */
+	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
+	bool IsSeekInProgress() const;
+
+	/** Broadcast when a seek finishes and no other seek is pending, with the real time in seconds it took */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnReplaySeekComplete, bool /*bWasSuccessful*/, double /*SeekDurationSeconds*/);
+	FOnReplaySeekComplete OnSeekComplete;
+
 	/** Gets length of current replay */
 	UFUNCTION(BlueprintCallable, Category = Replays, BlueprintPure = false)
 	float GetReplayLengthInSeconds() const;
@@ -95,6 +110,22 @@ public:
 	float GetReplayCurrentTime() const;
 
 private:
+	/**
+	 * Checkpoint interval used while recording client replays, shorter intervals make seeks fast forward less.
+	 * Applied to demo.CheckpointUploadDelayInSeconds for the duration of the recording only, <= 0 keeps the engine value
+	 */
+	UPROPERTY(Config)
+	float ClientReplayCheckpointIntervalSeconds = 0.0f;
+
+	// Value of demo.CheckpointUploadDelayInSeconds before the client replay recording overrode it, negative if not overridden
+	float SavedCheckpointIntervalSeconds = -1.0f;
+
+	FDelegateHandle RecordingCompleteHandle;
+
+	void ApplyClientReplayCheckpointInterval();
+	void RestoreCheckpointInterval();
+	void HandleReplayRecordingComplete(UWorld* World);
+
 	TSharedPtr<INetworkReplayStreamer> CurrentReplayStreamer;
 
 	UPROPERTY()
@@ -104,6 +135,19 @@ private:
 
 	UDemoNetDriver* GetDemoDriver() const;
 
+	// Returns false if the demo driver rejected the seek, in which case the seek state is cleared
+	bool StartSeek(UDemoNetDriver* DemoDriver, float TimeInSeconds);
+	void HandleSeekComplete(bool bWasSuccessful);
+
+	// Demo driver the in-flight seek was issued on, used to detect the replay going away mid-seek
+	TWeakObjectPtr<UDemoNetDriver> SeekingDemoDriver;
+
+	// Latest seek requested while another one was in flight, negative if there is none
+	float PendingSeekTime = -1.0f;
+
+	// Real time at which the first of the current run of coalesced seeks was requested
+	double SeekStartTime = 0.0;
+
 	void OnEnumerateStreamsCompleteForDelete(const FEnumerateStreamsResult& Result);
 	void OnDeleteReplay(const FDeleteFinishedStreamResult& DeleteResult);
 };
@@ -2,7 +2,10 @@
 
 #include "LyraGameSettingRegistry.h"
 
+#include "Engine/World.h"
 #include "GameSettingCollection.h"
+#include "GameSettingFilterState.h"
+#include "HAL/IConsoleManager.h"
 #include "LyraSettingsLocal.h"
 #include "LyraSettingsShared.h"
 #include "Player/LyraLocalPlayer.h"
@@ -86,5 +89,63 @@ void ULyraGameSettingRegistry::SaveChanges()
 	}
 }
 
+//--------------------------------------
+
+#if !UE_BUILD_SHIPPING
+
+static void BenchmarkSettingsFilter(const TArray<FString>& Args, UWorld* World)
+{
+	ULyraLocalPlayer* LocalPlayer = World ? Cast<ULyraLocalPlayer>(World->GetFirstLocalPlayerFromController()) : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		UE_LOG(LogLyraGameSettingRegistry, Warning, TEXT("Lyra.Settings.BenchmarkFilter requires a local player"));
+		return;
+	}
+
+	ULyraGameSettingRegistry* Registry = ULyraGameSettingRegistry::Get(LocalPlayer);
+	const int32 NumIterations = FMath::Max((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1000, 1);
+
+	// An empty root list filters every top level page, like refreshing the whole settings screen
+	auto RunFilter = [Registry](bool bInvalidate) -> int32
+	{
+		if (bInvalidate)
+		{
+			Registry->InvalidateFilterCaches();
+		}
+
+		FGameSettingFilterState FilterState;
+		TArray<UGameSetting*> Settings;
+		Registry->GetSettingsForFilter(FilterState, /*out*/ Settings);
+		return Settings.Num();
+	};
+
+	int32 NumFiltered = 0;
+	const double UncachedStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		NumFiltered = RunFilter(true);
+	}
+	const double UncachedTime = FPlatformTime::Seconds() - UncachedStartTime;
+
+	const double CachedStartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		RunFilter(false);
+	}
+	const double CachedTime = FPlatformTime::Seconds() - CachedStartTime;
+
+	UE_LOG(LogLyraGameSettingRegistry, Log, TEXT("Filtering the full registry (%d visible settings) over %d iterations: uncached %.4f ms, cached %.4f ms"),
+		NumFiltered, NumIterations,
+		(UncachedTime * 1000.0) / NumIterations,
+		(CachedTime * 1000.0) / NumIterations);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkSettingsFilter(
+	TEXT("Lyra.Settings.BenchmarkFilter"),
+	TEXT("Compares the cost of refreshing every settings page with and without the filter cache over [Iterations=1000] iterations"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkSettingsFilter));
+
+#endif // !UE_BUILD_SHIPPING
+
 #undef LOCTEXT_NAMESPACE
 
@@ -605,6 +605,21 @@ UGameSettingCollection* ULyraGameSettingRegistry::InitializeVideoSettings(ULyraL
 				}
 			}));
 
+			AdvancedGraphics->AddSetting(Setting);
+		}
+		//----------------------------------------------------------------------------------
+		{
+			UGameSettingValueDiscreteDynamic_Bool* Setting = NewObject<UGameSettingValueDiscreteDynamic_Bool>();
+			Setting->SetDevName(TEXT("AdaptiveQuality"));
+			Setting->SetDisplayName(LOCTEXT("AdaptiveQuality_Name", "Adaptive Quality"));
+			Setting->SetDescriptionRichText(LOCTEXT("AdaptiveQuality_Description", "Temporarily lowers individual graphics quality options when the frame rate stays below the target, and restores them once there is enough headroom again."));
+
+			Setting->SetDynamicGetter(GET_LOCAL_SETTINGS_FUNCTION_PATH(IsAdaptiveQualityEnabled));
+			Setting->SetDynamicSetter(GET_LOCAL_SETTINGS_FUNCTION_PATH(SetAdaptiveQualityEnabled));
+			Setting->SetDefaultValue(false);
+
+			Setting->AddEditCondition(MakeShared<FGameSettingEditCondition_FramePacingMode>(ELyraFramePacingMode::DesktopStyle));
+
 			AdvancedGraphics->AddSetting(Setting);
 		}
 	}
@@ -26,6 +26,8 @@
 #include "Audio/LyraAudioSettings.h"
 #include "Audio/LyraAudioMixEffectsSubsystem.h"
 #include "EnhancedActionKeyMapping.h"
+#include "RHIGlobals.h"
+#include "LyraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraSettingsLocal)
 
@@ -121,6 +123,44 @@ FLyraScalabilitySnapshot::FLyraScalabilitySnapshot()
 
 //////////////////////////////////////////////////////////////////////
 
+FLyraHardwareBenchmarkResult::FLyraHardwareBenchmarkResult(const Scalability::FQualityLevels& InLevels)
+	: CPUBenchmarkResult(InLevels.CPUBenchmarkResults)
+	, GPUBenchmarkResult(InLevels.GPUBenchmarkResults)
+	, ResolutionQuality(InLevels.ResolutionQuality)
+	, ViewDistanceQuality(InLevels.ViewDistanceQuality)
+	, AntiAliasingQuality(InLevels.AntiAliasingQuality)
+	, ShadowQuality(InLevels.ShadowQuality)
+	, GlobalIlluminationQuality(InLevels.GlobalIlluminationQuality)
+	, ReflectionQuality(InLevels.ReflectionQuality)
+	, PostProcessQuality(InLevels.PostProcessQuality)
+	, TextureQuality(InLevels.TextureQuality)
+	, EffectsQuality(InLevels.EffectsQuality)
+	, FoliageQuality(InLevels.FoliageQuality)
+	, ShadingQuality(InLevels.ShadingQuality)
+{
+}
+
+Scalability::FQualityLevels FLyraHardwareBenchmarkResult::ToQualityLevels() const
+{
+	Scalability::FQualityLevels Levels;
+	Levels.CPUBenchmarkResults = CPUBenchmarkResult;
+	Levels.GPUBenchmarkResults = GPUBenchmarkResult;
+	Levels.ResolutionQuality = ResolutionQuality;
+	Levels.ViewDistanceQuality = ViewDistanceQuality;
+	Levels.AntiAliasingQuality = AntiAliasingQuality;
+	Levels.ShadowQuality = ShadowQuality;
+	Levels.GlobalIlluminationQuality = GlobalIlluminationQuality;
+	Levels.ReflectionQuality = ReflectionQuality;
+	Levels.PostProcessQuality = PostProcessQuality;
+	Levels.TextureQuality = TextureQuality;
+	Levels.EffectsQuality = EffectsQuality;
+	Levels.FoliageQuality = FoliageQuality;
+	Levels.ShadingQuality = ShadingQuality;
+	return Levels;
+}
+
+//////////////////////////////////////////////////////////////////////
+
 template<typename T>
 struct TMobileQualityWrapper
 {
@@ -910,16 +950,39 @@ bool ULyraSettingsLocal::ShouldRunAutoBenchmarkAtStartup() const
 
 	if (LastCPUBenchmarkResult != -1)
 	{
-		// Already run and loaded
-		return false;
+		// Already run and loaded, unless the hardware changed since (results from before the hardware
+		// started being tracked are assumed to still match)
+		return !LastBenchmarkHardwareKey.IsEmpty() && (LastBenchmarkHardwareKey != GetHardwareBenchmarkKey());
 	}
 
 	return true;
 }
 
-void ULyraSettingsLocal::RunAutoBenchmark(bool bSaveImmediately)
+FString ULyraSettingsLocal::GetHardwareBenchmarkKey()
+{
+	return FString::Printf(TEXT("%s|%s"), *FPlatformMisc::GetCPUBrand().TrimStartAndEnd(), *GRHIAdapterName.TrimStartAndEnd());
+}
+
+void ULyraSettingsLocal::RunAutoBenchmark(bool bSaveImmediately, bool bForceRerun)
 {
-	RunHardwareBenchmark();
+	const FString HardwareKey = GetHardwareBenchmarkKey();
+
+	const FLyraHardwareBenchmarkResult* CachedResult = bForceRerun ? nullptr : HardwareBenchmarkResults.Find(HardwareKey);
+	if (CachedResult != nullptr)
+	{
+		UE_LOG(LogLyra, Log, TEXT("Using cached hardware benchmark result for %s (CPU %.1f, GPU %.1f)"), *HardwareKey, CachedResult->CPUBenchmarkResult, CachedResult->GPUBenchmarkResult);
+
+		ScalabilityQuality = CachedResult->ToQualityLevels();
+		LastCPUBenchmarkResult = CachedResult->CPUBenchmarkResult;
+		LastGPUBenchmarkResult = CachedResult->GPUBenchmarkResult;
+	}
+	else
+	{
+		RunHardwareBenchmark();
+		HardwareBenchmarkResults.Add(HardwareKey, FLyraHardwareBenchmarkResult(ScalabilityQuality));
+	}
+
+	LastBenchmarkHardwareKey = HardwareKey;
 	
 	// Always apply, optionally save
 	ApplyScalabilitySettings();
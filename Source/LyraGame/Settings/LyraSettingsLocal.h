@@ -31,6 +31,58 @@ struct FLyraScalabilitySnapshot
 	bool bHasOverrides = false;
 };
 
+// Result of the hardware benchmark, cached per CPU/GPU combination so it does not have to be run again
+USTRUCT()
+struct FLyraHardwareBenchmarkResult
+{
+	GENERATED_BODY()
+
+	FLyraHardwareBenchmarkResult() {}
+	FLyraHardwareBenchmarkResult(const Scalability::FQualityLevels& InLevels);
+
+	// Returns the cached result as quality levels
+	Scalability::FQualityLevels ToQualityLevels() const;
+
+	UPROPERTY()
+	float CPUBenchmarkResult = -1.0f;
+
+	UPROPERTY()
+	float GPUBenchmarkResult = -1.0f;
+
+	UPROPERTY()
+	float ResolutionQuality = 100.0f;
+
+	UPROPERTY()
+	int32 ViewDistanceQuality = 3;
+
+	UPROPERTY()
+	int32 AntiAliasingQuality = 3;
+
+	UPROPERTY()
+	int32 ShadowQuality = 3;
+
+	UPROPERTY()
+	int32 GlobalIlluminationQuality = 3;
+
+	UPROPERTY()
+	int32 ReflectionQuality = 3;
+
+	UPROPERTY()
+	int32 PostProcessQuality = 3;
+
+	UPROPERTY()
+	int32 TextureQuality = 3;
+
+	UPROPERTY()
+	int32 EffectsQuality = 3;
+
+	UPROPERTY()
+	int32 FoliageQuality = 3;
+
+	UPROPERTY()
+	int32 ShadingQuality = 3;
+};
+
 /**
  * ULyraSettingsLocal
  */
@@ -274,13 +326,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = Settings)
 	bool ShouldRunAutoBenchmarkAtStartup() const;
 
-	/** Run the auto benchmark, optionally saving right away */
+	/**
+	 * Run the auto benchmark, optionally saving right away.
+	 * A result cached for the current hardware is reused unless bForceRerun is set.
+	 */
 	UFUNCTION(BlueprintCallable, Category = Settings)
-	void RunAutoBenchmark(bool bSaveImmediately);
+	void RunAutoBenchmark(bool bSaveImmediately, bool bForceRerun = false);
 
 	/** Apply just the quality scalability settings */
 	void ApplyScalabilitySettings();
 
+	/** Returns the key identifying the CPU/GPU combination benchmark results are cached for */
+	static FString GetHardwareBenchmarkKey();
+
+	/** Returns true if scalability groups are lowered/raised at runtime to hold the target frame rate */
+	UFUNCTION()
+	bool IsAdaptiveQualityEnabled() const { return bEnableAdaptiveQuality; }
+	UFUNCTION()
+	void SetAdaptiveQualityEnabled(bool bEnabled) { bEnableAdaptiveQuality = bEnabled; }
+
+private:
+	/** Benchmark results for every CPU/GPU combination this user has run the benchmark on */
+	UPROPERTY(Config)
+	TMap<FString, FLyraHardwareBenchmarkResult> HardwareBenchmarkResults;
+
+	/** Hardware the last applied benchmark result belongs to */
+	UPROPERTY(Config)
+	FString LastBenchmarkHardwareKey;
+
+	UPROPERTY(Config)
+	bool bEnableAdaptiveQuality = false;
+
+public:
+
 	UFUNCTION()
 	float GetOverallVolume() const;
 	UFUNCTION()
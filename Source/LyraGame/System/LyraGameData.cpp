@@ -2,11 +2,13 @@
 
 #include "LyraGameData.h"
 #include "LyraAssetManager.h"
+#include "GameplayEffect.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameData)
 
 ULyraGameData::ULyraGameData()
 {
+	WeaponDamageGameplayEffect = TSoftClassPtr<UGameplayEffect>(FSoftObjectPath(TEXT("/Game/GameplayEffects/Damage/GE_Damage_Basic_Instant.GE_Damage_Basic_Instant_C")));
 }
 
 const ULyraGameData& ULyraGameData::ULyraGameData::Get()
@@ -32,6 +32,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Default Gameplay Effects", meta = (DisplayName = "Damage Gameplay Effect (SetByCaller)"))
 	TSoftClassPtr<UGameplayEffect> DamageGameplayEffect_SetByCaller;
 
+	// Gameplay effect used by ranged weapons to apply the damage of their hits.  Uses the damage execution (base damage, distance and material attenuation).
+	UPROPERTY(EditDefaultsOnly, Category = "Default Gameplay Effects", meta = (DisplayName = "Weapon Damage Gameplay Effect"))
+	TSoftClassPtr<UGameplayEffect> WeaponDamageGameplayEffect;
+
 	// Gameplay effect used to apply healing.  Uses SetByCaller for the healing magnitude.
 	UPROPERTY(EditDefaultsOnly, Category = "Default Gameplay Effects", meta = (DisplayName = "Heal Gameplay Effect (SetByCaller)"))
 	TSoftClassPtr<UGameplayEffect> HealGameplayEffect_SetByCaller;
@@ -39,6 +39,8 @@
 *		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
 *		owning connection only) via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		Player states of players that are far from every viewer of a connection only replicate to it on some of their turns (see Lyra.RepGraph.DistantPlayerStateCycles),
+*		while the player state of the player a connection is spectating replicates to it every frame. This is mostly about ReplicatedViewRotation, which changes constantly.
 *		
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -84,6 +86,7 @@
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/Pawn.h"
 #include "Engine/LevelScriptActor.h"
+#include "Containers/Ticker.h"
 #include "Engine/NetConnection.h"
 #include "UObject/UObjectIterator.h"
 
@@ -132,6 +135,14 @@ namespace Lyra::RepGraph
 	int32 EnableFastSharedPath = 1;
 	static FAutoConsoleVariableRef CVarLyraRepEnableFastSharedPath(TEXT("Lyra.RepGraph.EnableFastSharedPath"), EnableFastSharedPath, TEXT(""), ECVF_Default);
 
+	// Player states whose pawn is further than this from every viewer of a connection are distant to that connection.
+	float DistantPlayerStateDistance = 10000.f;
+	static FAutoConsoleVariableRef CVarLyraRepDistantPlayerStateDistance(TEXT("Lyra.RepGraph.DistantPlayerStateDistance"), DistantPlayerStateDistance, TEXT("Distance beyond which a player is distant to a connection, and replicates its player state (and view rotation) to it less often"), ECVF_Default);
+
+	// How many turns of the player state frequency limiter a distant player state waits between replications to a connection. 1 = no throttling.
+	int32 DistantPlayerStateCycles = 2;
+	static FAutoConsoleVariableRef CVarLyraRepDistantPlayerStateCycles(TEXT("Lyra.RepGraph.DistantPlayerStateCycles"), DistantPlayerStateCycles, TEXT("How many turns of the player state frequency limiter distant player states wait between replications to a connection (1 = no throttling)"), ECVF_Default);
+
 	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
 	{
 		// Only create for GameNetDriver
@@ -763,6 +774,19 @@ void ULyraReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsFor
 				}
 			}
 
+			// Spectators get the player state (and so the view rotation) of the player they are watching every frame
+			if (const APawn* ViewTargetPawn = Cast<APawn>(CurViewer.ViewTarget))
+			{
+				APlayerState* ViewTargetPS = ViewTargetPawn->GetPlayerState();
+				if (ViewTargetPS && (ViewTargetPS != PC->PlayerState))
+				{
+					FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(ViewTargetPS);
+					ConnectionActorInfo.ReplicationPeriodFrame = 1;
+
+					ReplicationActorList.ConditionalAdd(ViewTargetPS);
+				}
+			}
+
 			FCachedAlwaysRelevantActorInfo& LastData = PastRelevantActorMap.FindOrAdd(CurViewer.Connection);
 
 			if (ALyraCharacter* Pawn = Cast<ALyraCharacter>(PC->GetPawn()))
@@ -914,6 +938,7 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplicatio
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
 	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
+	UpdateReplicationPeriods(Params, ReplicationActorLists[ListIdx]);
 	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
 
 	if (ForceNetUpdateReplicationActorList.Num() > 0)
@@ -922,6 +947,44 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForC
 	}	
 }
 
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::UpdateReplicationPeriods(const FConnectionGatherActorListParameters& Params, const FActorRepListRefView& List) const
+{
+	// Each list comes around once every ReplicationActorLists.Num() frames, so a period of that many frames times the cycle count
+	// makes distant player states skip all but one of their turns
+	const int32 DistantCycles = FMath::Max(Lyra::RepGraph::DistantPlayerStateCycles, 1);
+	const uint16 DistantPeriodFrame = (uint16)FMath::Min(ReplicationActorLists.Num() * DistantCycles, (int32)MAX_uint16);
+	const FVector::FReal DistantDistanceSquared = FMath::Square(Lyra::RepGraph::DistantPlayerStateDistance);
+
+	for (FActorRepListType Actor : List)
+	{
+		APlayerState* PS = CastChecked<APlayerState>(Actor);
+		const APawn* Pawn = PS->GetPawn();
+
+		// The connection's own player state and the one it spectates are handled by ULyraReplicationGraphNode_AlwaysRelevant_ForConnection
+		bool bHandledElsewhere = false;
+		bool bIsDistant = (DistantCycles > 1) && (Pawn != nullptr);
+		for (const FNetViewer& Viewer : Params.Viewers)
+		{
+			if ((Viewer.InViewer == PS->GetOwner()) || (Pawn && (Viewer.ViewTarget == Pawn)))
+			{
+				bHandledElsewhere = true;
+				break;
+			}
+
+			if (bIsDistant && (FVector::DistSquared(Viewer.ViewLocation, Pawn->GetActorLocation()) < DistantDistanceSquared))
+			{
+				bIsDistant = false;
+			}
+		}
+
+		if (!bHandledElsewhere)
+		{
+			FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Actor);
+			ConnectionActorInfo.ReplicationPeriodFrame = bIsDistant ? DistantPeriodFrame : 1;
+		}
+	}
+}
+
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
 {
 	DebugInfo.Log(NodeName);
@@ -972,6 +1035,83 @@ FAutoConsoleCommandWithWorldAndArgs LyraPrintRepNodePoliciesCmd(TEXT("Lyra.RepGr
 
 // ------------------------------------------------------------------------------
 
+#if !UE_BUILD_SHIPPING
+
+static void MeasureViewRotationBandwidth(const TArray<FString>& Args, UWorld* World)
+{
+	UNetDriver* ServerNetDriver = World ? World->GetNetDriver() : nullptr;
+	if ((ServerNetDriver == nullptr) || !ServerNetDriver->IsServer())
+	{
+		UE_LOG(LogLyraRepGraph, Warning, TEXT("Lyra.RepGraph.MeasureViewRotationBandwidth has to run on a server with connected clients"));
+		return;
+	}
+
+	IConsoleVariable* ThrottleCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.ViewRotation.Throttle"));
+	IConsoleVariable* CyclesCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.RepGraph.DistantPlayerStateCycles"));
+	check(ThrottleCVar && CyclesCVar);
+
+	const double PhaseDuration = (Args.Num() > 0) ? FCString::Atod(*Args[0]) : 15.0;
+	const bool bOriginalThrottle = ThrottleCVar->GetBool();
+	const int32 OriginalCycles = CyclesCVar->GetInt();
+
+	// First phase replicates view rotation the way it used to (every change, same rate to every connection)
+	ThrottleCVar->Set(false);
+	CyclesCVar->Set(1);
+
+	UE_LOG(LogLyraRepGraph, Display, TEXT("Measuring outgoing bandwidth to %d connections for %.1f seconds without and then with view rotation throttling"), ServerNetDriver->ClientConnections.Num(), PhaseDuration);
+
+	TWeakObjectPtr<UNetDriver> WeakNetDriver(ServerNetDriver);
+	int32 Phase = 0;
+	double PhaseStartTime = FPlatformTime::Seconds();
+	uint64 PhaseStartBytes = (uint64)ServerNetDriver->OutTotalBytes;
+	double UnthrottledBytesPerSecond = 0.0;
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float) mutable
+	{
+		UNetDriver* NetDriver = WeakNetDriver.Get();
+		const double CurrentTime = FPlatformTime::Seconds();
+		if ((NetDriver != nullptr) && ((CurrentTime - PhaseStartTime) < PhaseDuration))
+		{
+			return true;
+		}
+
+		if (NetDriver != nullptr)
+		{
+			const double BytesPerSecond = (double)((uint64)NetDriver->OutTotalBytes - PhaseStartBytes) / (CurrentTime - PhaseStartTime);
+			if (Phase == 0)
+			{
+				UnthrottledBytesPerSecond = BytesPerSecond;
+
+				ThrottleCVar->Set(true);
+				CyclesCVar->Set(FMath::Max(OriginalCycles, 2));
+
+				Phase = 1;
+				PhaseStartTime = CurrentTime;
+				PhaseStartBytes = (uint64)NetDriver->OutTotalBytes;
+				return true;
+			}
+
+			const int32 NumConnections = FMath::Max(NetDriver->ClientConnections.Num(), 1);
+			UE_LOG(LogLyraRepGraph, Display, TEXT("View rotation throttling: %.1f KB/s (%.2f KB/s per connection) unthrottled, %.1f KB/s (%.2f KB/s per connection) throttled, %.1f%% saved"),
+				UnthrottledBytesPerSecond / 1024.0, UnthrottledBytesPerSecond / 1024.0 / NumConnections,
+				BytesPerSecond / 1024.0, BytesPerSecond / 1024.0 / NumConnections,
+				(UnthrottledBytesPerSecond > 0.0) ? (100.0 * (1.0 - BytesPerSecond / UnthrottledBytesPerSecond)) : 0.0);
+		}
+
+		ThrottleCVar->Set(bOriginalThrottle);
+		CyclesCVar->Set(OriginalCycles);
+		return false;
+	}));
+}
+
+FAutoConsoleCommandWithWorldAndArgs MeasureViewRotationBandwidthCmd(TEXT("Lyra.RepGraph.MeasureViewRotationBandwidth"),
+	TEXT("Compares the server's outgoing bandwidth over [Seconds=15] without and with view rotation throttling. Meant for a headless server with several connected (e.g. -nullrhi) clients"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(MeasureViewRotationBandwidth));
+
+#endif // !UE_BUILD_SHIPPING
+
+// ------------------------------------------------------------------------------
+
 FAutoConsoleCommandWithWorldAndArgs ChangeFrequencyBucketsCmd(TEXT("Lyra.RepGraph.FrequencyBuckets"), TEXT("Resets frequency bucket count."), FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray< FString >& Args, UWorld* World) 
 {
 	int32 Buckets = 1;
@@ -117,6 +117,9 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 	int32 TargetActorsPerFrame = 2;
 
 private:
+
+	/** Sets how often the connection receives each player state of the list, based on how relevant that player is to it */
+	void UpdateReplicationPeriods(const FConnectionGatherActorListParameters& Params, const FActorRepListRefView& List) const;
 	
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
+#include "GameplayTagsManager.h"
+#include "Math/RandomStream.h"
+
+namespace LyraAbilityTagRelationshipTests
+{
+	static FGameplayTag PickTag(FRandomStream& Random, const TArray<FGameplayTag>& TagPool)
+	{
+		FGameplayTag Tag = TagPool[Random.RandHelper(TagPool.Num())];
+
+		// Favor parent tags now and then, so parent/child matching is exercised
+		while (Tag.IsValid() && Random.FRand() < 0.25f)
+		{
+			const FGameplayTag Parent = Tag.RequestDirectParent();
+			if (!Parent.IsValid())
+			{
+				break;
+			}
+			Tag = Parent;
+		}
+
+		return Tag;
+	}
+
+	static FGameplayTagContainer PickTags(FRandomStream& Random, const TArray<FGameplayTag>& TagPool, int32 MaxTags)
+	{
+		FGameplayTagContainer Result;
+		const int32 NumTags = Random.RandRange(0, MaxTags);
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Result.AddTag(PickTag(Random, TagPool));
+		}
+		return Result;
+	}
+}
+
+// Builds random relationship mappings from the registered gameplay tags and checks that the compiled lookup tables
+// answer every query exactly like the reference implementations that iterate over all relationships
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraAbilityTagRelationshipRandomizedTest, "Lyra.AbilitySystem.TagRelationshipMapping.RandomizedEquivalence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraAbilityTagRelationshipRandomizedTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraAbilityTagRelationshipTests;
+
+	FGameplayTagContainer AllTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, /*OnlyIncludeDictionaryTags=*/ false);
+
+	TArray<FGameplayTag> TagPool;
+	AllTags.GetGameplayTagArray(TagPool);
+	if (TagPool.Num() == 0)
+	{
+		AddWarning(TEXT("No gameplay tags are registered, nothing to test"));
+		return true;
+	}
+
+	const int32 NumMappings = 200;
+	const int32 NumQueriesPerMapping = 50;
+
+	for (int32 MappingIndex = 0; MappingIndex < NumMappings; ++MappingIndex)
+	{
+		const int32 Seed = 0x1A7A + MappingIndex;
+		FRandomStream Random(Seed);
+
+		TArray<FLyraAbilityTagRelationship> Relationships;
+		const int32 NumRelationships = Random.RandRange(0, 24);
+		for (int32 Index = 0; Index < NumRelationships; ++Index)
+		{
+			FLyraAbilityTagRelationship& Relationship = Relationships.AddDefaulted_GetRef();
+
+			// Reuse earlier ability tags regularly, those relationships have to be merged
+			const bool bReuseTag = (Index > 0) && (Random.FRand() < 0.3f);
+			Relationship.AbilityTag = bReuseTag ? Relationships[Random.RandHelper(Index)].AbilityTag : PickTag(Random, TagPool);
+			Relationship.AbilityTagsToBlock = PickTags(Random, TagPool, 3);
+			Relationship.AbilityTagsToCancel = PickTags(Random, TagPool, 3);
+			Relationship.ActivationRequiredTags = PickTags(Random, TagPool, 2);
+			Relationship.ActivationBlockedTags = PickTags(Random, TagPool, 2);
+		}
+
+		ULyraAbilityTagRelationshipMapping* Mapping = NewObject<ULyraAbilityTagRelationshipMapping>();
+		Mapping->SetAbilityTagRelationshipsForTesting(Relationships);
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueriesPerMapping; ++QueryIndex)
+		{
+			// Query with tags that have relationships half of the time, and with anything otherwise
+			FGameplayTagContainer AbilityTags = PickTags(Random, TagPool, 4);
+			if ((NumRelationships > 0) && (Random.FRand() < 0.5f))
+			{
+				AbilityTags.AddTag(Relationships[Random.RandHelper(NumRelationships)].AbilityTag);
+			}
+
+			// Out containers may already have tags in them
+			const FGameplayTagContainer InitialTags = PickTags(Random, TagPool, 2);
+
+			FGameplayTagContainer TagsToBlock = InitialTags;
+			FGameplayTagContainer TagsToCancel = InitialTags;
+			FGameplayTagContainer ExpectedTagsToBlock = InitialTags;
+			FGameplayTagContainer ExpectedTagsToCancel = InitialTags;
+			Mapping->GetAbilityTagsToBlockAndCancel(AbilityTags, &TagsToBlock, &TagsToCancel);
+			Mapping->GetAbilityTagsToBlockAndCancel_Linear(AbilityTags, &ExpectedTagsToBlock, &ExpectedTagsToCancel);
+
+			FGameplayTagContainer ActivationRequired = InitialTags;
+			FGameplayTagContainer ActivationBlocked = InitialTags;
+			FGameplayTagContainer ExpectedActivationRequired = InitialTags;
+			FGameplayTagContainer ExpectedActivationBlocked = InitialTags;
+			Mapping->GetRequiredAndBlockedActivationTags(AbilityTags, &ActivationRequired, &ActivationBlocked);
+			Mapping->GetRequiredAndBlockedActivationTags_Linear(AbilityTags, &ExpectedActivationRequired, &ExpectedActivationBlocked);
+
+			const FGameplayTag ActionTag = PickTag(Random, TagPool);
+			const bool bIsCancelled = Mapping->IsAbilityCancelledByTag(AbilityTags, ActionTag);
+			const bool bExpectedIsCancelled = Mapping->IsAbilityCancelledByTag_Linear(AbilityTags, ActionTag);
+
+			const FString Context = FString::Printf(TEXT("seed %d, query %d, ability tags [%s]"), Seed, QueryIndex, *AbilityTags.ToStringSimple());
+			TestTrue(FString::Printf(TEXT("Tags to block (%s)"), *Context), TagsToBlock == ExpectedTagsToBlock);
+			TestTrue(FString::Printf(TEXT("Tags to cancel (%s)"), *Context), TagsToCancel == ExpectedTagsToCancel);
+			TestTrue(FString::Printf(TEXT("Activation required tags (%s)"), *Context), ActivationRequired == ExpectedActivationRequired);
+			TestTrue(FString::Printf(TEXT("Activation blocked tags (%s)"), *Context), ActivationBlocked == ExpectedActivationBlocked);
+			TestEqual(FString::Printf(TEXT("Cancelled by %s (%s)"), *ActionTag.ToString(), *Context), bIsCancelled, bExpectedIsCancelled);
+
+			if (HasAnyErrors())
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Performance/LyraAdaptiveQualityController.h"
+
+namespace LyraAdaptiveQualityTests
+{
+	static FLyraAdaptiveQualitySample MakeSample(float GameThreadMs, float RenderThreadMs, float GPUMs)
+	{
+		FLyraAdaptiveQualitySample Sample;
+		Sample.GameThreadTime = GameThreadMs / 1000.0f;
+		Sample.RenderThreadTime = RenderThreadMs / 1000.0f;
+		Sample.GPUTime = GPUMs / 1000.0f;
+		Sample.FrameTime = FMath::Max3(Sample.GameThreadTime, Sample.RenderThreadTime, Sample.GPUTime);
+		return Sample;
+	}
+
+	// Feeds the same frame to the controller for the given duration, returns the times (relative to the start of the
+	// trace) at which the levels changed
+	static TArray<float> RunTrace(FLyraAdaptiveQualityController& Controller, const FLyraAdaptiveQualitySample& Sample, float Duration)
+	{
+		TArray<float> ChangeTimes;
+		for (float Time = 0.0f; Time < Duration; Time += Sample.FrameTime)
+		{
+			if (Controller.AddSample(Sample))
+			{
+				ChangeTimes.Add(Time);
+			}
+		}
+		return ChangeTimes;
+	}
+
+	static bool AreAllGroupsAtMost(const Scalability::FQualityLevels& Levels, const Scalability::FQualityLevels& Limit)
+	{
+		return (Levels.ViewDistanceQuality <= Limit.ViewDistanceQuality)
+			&& (Levels.AntiAliasingQuality <= Limit.AntiAliasingQuality)
+			&& (Levels.ShadowQuality <= Limit.ShadowQuality)
+			&& (Levels.GlobalIlluminationQuality <= Limit.GlobalIlluminationQuality)
+			&& (Levels.ReflectionQuality <= Limit.ReflectionQuality)
+			&& (Levels.PostProcessQuality <= Limit.PostProcessQuality)
+			&& (Levels.EffectsQuality <= Limit.EffectsQuality)
+			&& (Levels.FoliageQuality <= Limit.FoliageQuality)
+			&& (Levels.ShadingQuality <= Limit.ShadingQuality);
+	}
+}
+
+// Drives the adaptive quality controller with synthetic frame time traces (on target, GPU bound, CPU bound, hitches,
+// recovery) and checks when and which scalability groups it steps down and back up
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraAdaptiveQualityTraceTest, "Lyra.Performance.AdaptiveQuality.SyntheticTraces", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraAdaptiveQualityTraceTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraAdaptiveQualityTests;
+
+	FLyraAdaptiveQualityTuning Tuning;
+	Tuning.TargetFrameTime = 1.0f / 60.0f;
+	Tuning.SmoothingTime = 0.5f;
+	Tuning.DownscaleDelay = 2.0f;
+	Tuning.UpscaleDelay = 10.0f;
+	Tuning.Cooldown = 3.0f;
+
+	Scalability::FQualityLevels Baseline;
+	Baseline.SetFromSingleQualityLevel(3);
+
+	FLyraAdaptiveQualityController Controller;
+	Controller.SetTuning(Tuning);
+	Controller.Reset(Baseline);
+
+	// On target, and within the dead band around it: nothing changes
+	TestEqual(TEXT("Changes while on target"), RunTrace(Controller, MakeSample(12.0f, 12.0f, 16.0f), 30.0f).Num(), 0);
+	TestEqual(TEXT("Changes just over the target"), RunTrace(Controller, MakeSample(12.0f, 12.0f, 17.5f), 30.0f).Num(), 0);
+
+	// Hitches (loads, streaming) are ignored no matter how long they last
+	TestEqual(TEXT("Changes during hitches"), RunTrace(Controller, MakeSample(400.0f, 20.0f, 20.0f), 30.0f).Num(), 0);
+	TestEqual(TEXT("Steps down after hitches"), Controller.GetNumStepsDown(), 0);
+
+	// GPU bound at 40 fps: GPU heavy groups go down first, one step per cooldown at most
+	{
+		const TArray<float> ChangeTimes = RunTrace(Controller, MakeSample(10.0f, 10.0f, 25.0f), 12.0f);
+		if (TestTrue(TEXT("Stepped down while GPU bound"), ChangeTimes.Num() > 0))
+		{
+			TestTrue(TEXT("First step waits for the downscale delay"), ChangeTimes[0] >= Tuning.DownscaleDelay);
+			for (int32 ChangeIndex = 1; ChangeIndex < ChangeTimes.Num(); ++ChangeIndex)
+			{
+				TestTrue(TEXT("Steps are separated by the cooldown"), (ChangeTimes[ChangeIndex] - ChangeTimes[ChangeIndex - 1]) >= Tuning.Cooldown);
+			}
+		}
+
+		const Scalability::FQualityLevels& Levels = Controller.GetQualityLevels();
+		TestEqual(TEXT("Shadows lowered first when GPU bound"), Levels.ShadowQuality, Baseline.ShadowQuality - 1);
+		TestEqual(TEXT("View distance untouched when GPU bound"), Levels.ViewDistanceQuality, Baseline.ViewDistanceQuality);
+		TestEqual(TEXT("Steps down match the changes"), Controller.GetNumStepsDown(), ChangeTimes.Num());
+	}
+
+	// Sustained GPU overload bottoms out without going below the lowest level
+	RunTrace(Controller, MakeSample(10.0f, 10.0f, 60.0f), 600.0f);
+	{
+		Scalability::FQualityLevels Lowest = Controller.GetQualityLevels();
+		TestEqual(TEXT("Shadows at the lowest level"), Lowest.ShadowQuality, 0);
+		TestEqual(TEXT("View distance still untouched"), Lowest.ViewDistanceQuality, Baseline.ViewDistanceQuality);
+		TestEqual(TEXT("No more changes once everything is lowered"), RunTrace(Controller, MakeSample(10.0f, 10.0f, 60.0f), 30.0f).Num(), 0);
+	}
+
+	// Headroom restores the groups, never above the baseline
+	{
+		const int32 NumStepsDown = Controller.GetNumStepsDown();
+		const TArray<float> ChangeTimes = RunTrace(Controller, MakeSample(6.0f, 6.0f, 8.0f), (Tuning.UpscaleDelay + Tuning.Cooldown) * (NumStepsDown + 2));
+		TestEqual(TEXT("Every step taken back"), ChangeTimes.Num(), NumStepsDown);
+		if (ChangeTimes.Num() > 0)
+		{
+			TestTrue(TEXT("First step up waits for the upscale delay"), ChangeTimes[0] >= Tuning.UpscaleDelay);
+		}
+		TestTrue(TEXT("Back to the baseline"), Controller.GetQualityLevels() == Baseline);
+		TestTrue(TEXT("Never above the baseline"), AreAllGroupsAtMost(Controller.GetQualityLevels(), Baseline));
+		TestEqual(TEXT("No steps down left"), Controller.GetNumStepsDown(), 0);
+	}
+
+	// Game thread bound: view distance goes down first, and a single spike frame does not trigger anything
+	{
+		Controller.Reset(Baseline);
+		TestEqual(TEXT("Changes after a spike"), RunTrace(Controller, MakeSample(50.0f, 10.0f, 10.0f), 0.05f).Num() + RunTrace(Controller, MakeSample(10.0f, 10.0f, 10.0f), 10.0f).Num(), 0);
+
+		RunTrace(Controller, MakeSample(25.0f, 10.0f, 10.0f), 6.0f);
+		TestEqual(TEXT("View distance lowered first when CPU bound"), Controller.GetQualityLevels().ViewDistanceQuality, Baseline.ViewDistanceQuality - 1);
+		TestEqual(TEXT("Shadows untouched by the first CPU step"), Controller.GetQualityLevels().ShadowQuality, Baseline.ShadowQuality);
+	}
+
+	// Alternating between over and under the target never builds up enough time to change anything
+	{
+		Controller.Reset(Baseline);
+		int32 NumChanges = 0;
+		for (int32 Cycle = 0; Cycle < 30; ++Cycle)
+		{
+			NumChanges += RunTrace(Controller, MakeSample(10.0f, 10.0f, 25.0f), 1.0f).Num();
+			NumChanges += RunTrace(Controller, MakeSample(10.0f, 10.0f, 8.0f), 1.0f).Num();
+		}
+		TestEqual(TEXT("Changes while oscillating around the target"), NumChanges, 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
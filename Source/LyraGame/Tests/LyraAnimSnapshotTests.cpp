@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Animation/LyraAnimInstance.h"
+#include "Character/LyraCharacter.h"
+#include "Character/LyraCharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/LyraTestWorld.h"
+
+// Spawns airborne Lyra characters with an animated mesh over a floor, checks that the movement tick builds the
+// animation snapshot of the frame before the animation update copies it (and skips it for animation that does not
+// update), and reports the game thread cost of the movement and animation update with and without the snapshot
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraAnimSnapshotTest, "Lyra.Animation.MovementSnapshot", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraAnimSnapshotTest::RunTest(const FString& Parameters)
+{
+	const int32 NumCharacters = 100;
+	const int32 NumFrames = 120;
+	const float DeltaTime = 1.0f / 60.0f;
+	const float SpawnHeight = 500.0f;
+
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	USkeletalMesh* SkeletalCube = LoadObject<USkeletalMesh>(nullptr, TEXT("/Engine/EngineMeshes/SkeletalCube.SkeletalCube"));
+	IConsoleVariable* UseSnapshotCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.Anim.UseMovementSnapshot"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), CubeMesh) || !TestNotNull(TEXT("Engine skeletal cube"), SkeletalCube) || !TestNotNull(TEXT("Movement snapshot cvar"), UseSnapshotCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+
+	// A floor with its top at Z=50
+	AStaticMeshActor* Floor = TestWorld.SpawnActor<AStaticMeshActor>(FTransform(FRotator::ZeroRotator, FVector::ZeroVector, FVector(100.0f, 100.0f, 1.0f)));
+	Floor->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	Floor->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+
+	// Hovering in place so the ground distance has to be traced every frame, and animating although nothing is rendered
+	TArray<ALyraCharacter*> Characters;
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumCharacters));
+	for (int32 Index = 0; Index < NumCharacters; ++Index)
+	{
+		const FVector Location((Index % GridSize) * 200.0f, (Index / GridSize) * 200.0f, SpawnHeight);
+		ALyraCharacter* Character = TestWorld.SpawnActor<ALyraCharacter>(FTransform(Location));
+
+		USkeletalMeshComponent* Mesh = Character->GetMesh();
+		Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+		Mesh->SetSkeletalMeshAsset(SkeletalCube);
+		Mesh->SetAnimInstanceClass(ULyraAnimInstance::StaticClass());
+
+		UCharacterMovementComponent* CharMoveComp = Character->GetCharacterMovement();
+		CharMoveComp->bRunPhysicsWithNoController = true;
+		CharMoveComp->GravityScale = 0.0f;
+		CharMoveComp->SetMovementMode(MOVE_Falling);
+
+		Characters.Add(Character);
+	}
+
+	// The test ticks the world outside of the engine loop, advance the frame counter so per frame caches refresh
+	auto TickFrame = [&]()
+	{
+		++GFrameCounter;
+		TestWorld.Tick(DeltaTime);
+	};
+
+	const bool bPreviousUseSnapshot = UseSnapshotCVar->GetBool();
+	UseSnapshotCVar->Set(true, ECVF_SetByCode);
+
+	// Built by this frame's movement tick, and copied as is by the animation update that follows it
+	TickFrame();
+	const float ExpectedGroundDistance = SpawnHeight - 50.0f - Characters[0]->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
+	for (ALyraCharacter* Character : Characters)
+	{
+		ULyraCharacterMovementComponent* CharMoveComp = CastChecked<ULyraCharacterMovementComponent>(Character->GetCharacterMovement());
+		const FLyraCharacterAnimSnapshot& Snapshot = CharMoveComp->GetAnimSnapshot();
+
+		const ULyraAnimInstance* AnimInstance = Cast<ULyraAnimInstance>(Character->GetMesh()->GetAnimInstance());
+		if (!TestNotNull(TEXT("Lyra anim instance"), AnimInstance))
+		{
+			break;
+		}
+
+		const FLyraCharacterAnimSnapshot& CopiedSnapshot = AnimInstance->GetMovementSnapshotForTesting();
+		if (!TestEqual(TEXT("Snapshot built by this frame's movement tick"), Snapshot.LastUpdateFrame, GFrameCounter) ||
+			!TestEqual(TEXT("Snapshot copied by this frame's animation update"), CopiedSnapshot.LastUpdateFrame, GFrameCounter) ||
+			!TestEqual(TEXT("Snapshot ground distance"), Snapshot.GroundDistance, ExpectedGroundDistance, 1.0f) ||
+			!TestEqual(TEXT("Copied ground distance"), CopiedSnapshot.GroundDistance, Snapshot.GroundDistance) ||
+			!TestEqual(TEXT("Snapshot movement mode"), (int32)Snapshot.MovementMode.GetValue(), (int32)MOVE_Falling))
+		{
+			break;
+		}
+	}
+
+	// Not built for a mesh whose animation does not update, nothing renders in the test world
+	{
+		ALyraCharacter* HiddenCharacter = Characters.Last();
+		HiddenCharacter->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		const uint64 PreviousUpdateFrame = CastChecked<ULyraCharacterMovementComponent>(HiddenCharacter->GetCharacterMovement())->GetAnimSnapshot().LastUpdateFrame;
+
+		TickFrame();
+		TestEqual(TEXT("Snapshot of animation that does not update"), CastChecked<ULyraCharacterMovementComponent>(HiddenCharacter->GetCharacterMovement())->GetAnimSnapshot().LastUpdateFrame, PreviousUpdateFrame);
+
+		HiddenCharacter->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	}
+
+	// Game thread time of the movement ticks and animation updates, which are all the world has to tick
+	auto MeasureFrames = [&](bool bUseSnapshot)
+	{
+		UseSnapshotCVar->Set(bUseSnapshot, ECVF_SetByCode);
+
+		// Warm up so both runs start from the same state
+		for (int32 Frame = 0; Frame < 5; ++Frame)
+		{
+			TickFrame();
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TickFrame();
+		}
+		return FPlatformTime::Seconds() - StartTime;
+	};
+
+	const double LegacyTime = MeasureFrames(false);
+	const double SnapshotTime = MeasureFrames(true);
+	UseSnapshotCVar->Set(bPreviousUseSnapshot, ECVF_SetByCode);
+
+	AddInfo(FString::Printf(TEXT("Movement tick + animation update for %d airborne characters over %d frames: legacy %.4f ms/frame, movement snapshot %.4f ms/frame"),
+		Characters.Num(), NumFrames, (LegacyTime * 1000.0) / NumFrames, (SnapshotTime * 1000.0) / NumFrames));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
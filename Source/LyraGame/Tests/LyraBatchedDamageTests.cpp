@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/LyraGameplayAbilityTargetData_SingleTargetHit.h"
+#include "AbilitySystem/LyraGameplayEffectContext.h"
+#include "HAL/PlatformTime.h"
+#include "Physics/PhysicalMaterialWithTags.h"
+#include "Tests/LyraTestAbilitySystem.h"
+#include "Tests/LyraTestGameplayEffects.h"
+#include "Weapons/LyraGameplayAbility_RangedWeapon.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
+
+namespace LyraBatchedDamageTests
+{
+	struct FTestHit
+	{
+		int32 TargetIndex;
+		float Distance;
+		bool bWeakSpot;
+	};
+
+	static FHitResult MakeHit(AActor* HitActor, const FTestHit& TestHit, UPhysicalMaterial* WeakSpotMaterial)
+	{
+		const FVector ImpactPoint = HitActor->GetActorLocation();
+
+		FHitResult Hit(HitActor, nullptr, ImpactPoint, FVector::UpVector);
+		Hit.TraceStart = ImpactPoint - FVector(TestHit.Distance, 0.0f, 0.0f);
+		Hit.TraceEnd = ImpactPoint;
+		Hit.bBlockingHit = true;
+		if (TestHit.bWeakSpot)
+		{
+			Hit.PhysMaterial = WeakSpotMaterial;
+		}
+		return Hit;
+	}
+
+	static float GetDamageTaken(const ULyraAbilitySystemComponent* ASC)
+	{
+		return ASC->GetNumericAttribute(ULyraHealthSet::GetMaxHealthAttribute()) - ASC->GetNumericAttribute(ULyraHealthSet::GetHealthAttribute());
+	}
+}
+
+// Fires the same cartridge at two identical sets of targets, once applying the damage effect per hit and once through
+// the batched path of the ranged weapon ability, and checks that every target lost the same amount of health
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraBatchedDamageTest, "Lyra.Weapons.RangedWeapon.BatchedDamageMatchesPerHit", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraBatchedDamageTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraBatchedDamageTests;
+
+	FLyraScopedTestWorld TestWorld;
+
+	// High enough that no hit gets clamped by the health range
+	const float TargetMaxHealth = 100000.0f;
+	const float BaseDamage = 20.0f;
+
+	ULyraAbilitySystemComponent* SourceASC = LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld);
+	SourceASC->SetNumericAttributeBase(ULyraCombatSet::GetBaseDamageAttribute(), BaseDamage);
+
+	ULyraRangedWeaponInstance* WeaponInstance = NewObject<ULyraRangedWeaponInstance>(SourceASC->GetOwner());
+	FRichCurve* FalloffCurve = WeaponInstance->GetDistanceDamageFalloffForTesting().GetRichCurve();
+	FalloffCurve->AddKey(0.0f, 1.0f);
+	FalloffCurve->AddKey(1000.0f, 0.5f);
+	FalloffCurve->AddKey(2000.0f, 0.2f);
+
+	UPhysicalMaterialWithTags* WeakSpotMaterial = NewObject<UPhysicalMaterialWithTags>();
+	const FGameplayTag WeakSpotTag = FGameplayTag::RequestGameplayTag(TEXT("Gameplay.Zone.WeakSpot"), /*ErrorIfNotFound=*/ false);
+	if (WeakSpotTag.IsValid())
+	{
+		WeakSpotMaterial->Tags.AddTag(WeakSpotTag);
+		WeaponInstance->GetMaterialDamageMultiplierForTesting().Add(WeakSpotTag, 2.0f);
+	}
+
+	// Several hits on the first target (like pellets of a shotgun cartridge), a single one on the second target,
+	// and one on an actor without an ability system component that must be ignored
+	const FTestHit TestHits[] =
+	{
+		{ 0, 100.0f, false },
+		{ 0, 600.0f, false },
+		{ 0, 600.0f, true },
+		{ 1, 1500.0f, false },
+		{ 2, 300.0f, false },
+	};
+	const int32 NumTargets = 3;
+
+	TArray<ULyraAbilitySystemComponent*> PerHitTargets;
+	TArray<ULyraAbilitySystemComponent*> BatchedTargets;
+	TArray<AActor*> PerHitActors;
+	TArray<AActor*> BatchedActors;
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+	{
+		const FVector PerHitLocation(0.0f, 500.0f * TargetIndex, 0.0f);
+		const FVector BatchedLocation(0.0f, 500.0f * TargetIndex, 1000.0f);
+
+		if (TargetIndex == NumTargets - 1)
+		{
+			PerHitTargets.Add(nullptr);
+			BatchedTargets.Add(nullptr);
+			PerHitActors.Add(TestWorld.SpawnActor<AActor>(FTransform(PerHitLocation)));
+			BatchedActors.Add(TestWorld.SpawnActor<AActor>(FTransform(BatchedLocation)));
+			continue;
+		}
+
+		PerHitTargets.Add(LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, PerHitLocation, TargetMaxHealth));
+		BatchedTargets.Add(LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, BatchedLocation, TargetMaxHealth));
+		PerHitActors.Add(PerHitTargets.Last()->GetOwner());
+		BatchedActors.Add(BatchedTargets.Last()->GetOwner());
+	}
+
+	FGameplayEffectContextHandle BaseContext = SourceASC->MakeEffectContext();
+	FLyraGameplayEffectContext* LyraContext = FLyraGameplayEffectContext::ExtractEffectContext(BaseContext);
+	if (!TestNotNull(TEXT("Lyra gameplay effect context"), LyraContext))
+	{
+		return false;
+	}
+	LyraContext->SetAbilitySource(WeaponInstance, 1.0f);
+
+	const TSubclassOf<UGameplayEffect> DamageEffectClass = ULyraTestGameplayEffect_Damage::StaticClass();
+
+	// Reference: one effect per hit, distance and material attenuation resolved by the damage execution
+	for (const FTestHit& TestHit : TestHits)
+	{
+		FGameplayEffectContextHandle HitContext = BaseContext.Duplicate();
+		HitContext.AddHitResult(MakeHit(PerHitActors[TestHit.TargetIndex], TestHit, WeakSpotMaterial), /*bReset=*/ true);
+
+		const FGameplayEffectSpecHandle HitSpec = SourceASC->MakeOutgoingSpec(DamageEffectClass, 1.0f, HitContext);
+		if (UAbilitySystemComponent* TargetASC = PerHitTargets[TestHit.TargetIndex])
+		{
+			SourceASC->ApplyGameplayEffectSpecToTarget(*HitSpec.Data.Get(), TargetASC);
+		}
+	}
+
+	// Batched: one effect per target for the whole cartridge
+	FGameplayAbilityTargetDataHandle TargetData;
+	for (const FTestHit& TestHit : TestHits)
+	{
+		FLyraGameplayAbilityTargetData_SingleTargetHit* NewTargetData = new FLyraGameplayAbilityTargetData_SingleTargetHit();
+		NewTargetData->HitResult = MakeHit(BatchedActors[TestHit.TargetIndex], TestHit, WeakSpotMaterial);
+		TargetData.Add(NewTargetData);
+	}
+
+	const FGameplayEffectSpecHandle BaseSpec = SourceASC->MakeOutgoingSpec(DamageEffectClass, 1.0f, BaseContext);
+	ULyraGameplayAbility_RangedWeapon::ApplyBatchedDamageSpecToTargets(SourceASC, *BaseSpec.Data.Get(), TargetData, WeaponInstance);
+
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets - 1; ++TargetIndex)
+	{
+		const float PerHitDamage = GetDamageTaken(PerHitTargets[TargetIndex]);
+		const float BatchedDamage = GetDamageTaken(BatchedTargets[TargetIndex]);
+
+		TestTrue(FString::Printf(TEXT("Target %d took damage"), TargetIndex), PerHitDamage > 0.0f);
+		TestEqual(FString::Printf(TEXT("Batched damage on target %d"), TargetIndex), BatchedDamage, PerHitDamage, KINDA_SMALL_NUMBER * TargetMaxHealth);
+	}
+
+	// The falloff curve above gives 0.95 at 100cm and 0.7 at 600cm
+	const float WeakSpotMultiplier = WeakSpotTag.IsValid() ? 2.0f : 1.0f;
+	TestEqual(TEXT("Batched damage on the first target"), GetDamageTaken(BatchedTargets[0]), BaseDamage * (0.95f + 0.7f + 0.7f * WeakSpotMultiplier), 0.01f);
+
+	return true;
+}
+
+// Fires many shotgun-like cartridges at a group of targets, once applying the damage effect per hit and once through
+// the batched path, checks that both deal the same total damage and reports the game thread cost of each
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraBatchedDamageThroughputTest, "Lyra.Weapons.RangedWeapon.BatchedDamageThroughput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraBatchedDamageThroughputTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraBatchedDamageTests;
+
+	const int32 NumTargets = 8;
+	const int32 NumCartridges = 500;
+	const int32 PelletsPerCartridge = 10;
+	const float TargetMaxHealth = 1.0e9f;
+
+	FLyraScopedTestWorld TestWorld;
+
+	ULyraAbilitySystemComponent* SourceASC = LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld);
+	SourceASC->SetNumericAttributeBase(ULyraCombatSet::GetBaseDamageAttribute(), 10.0f);
+
+	ULyraRangedWeaponInstance* WeaponInstance = NewObject<ULyraRangedWeaponInstance>(SourceASC->GetOwner());
+	FRichCurve* FalloffCurve = WeaponInstance->GetDistanceDamageFalloffForTesting().GetRichCurve();
+	FalloffCurve->AddKey(0.0f, 1.0f);
+	FalloffCurve->AddKey(2000.0f, 0.25f);
+
+	TArray<ULyraAbilitySystemComponent*> PerHitTargets;
+	TArray<ULyraAbilitySystemComponent*> BatchedTargets;
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+	{
+		PerHitTargets.Add(LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, FVector(0.0f, 300.0f * TargetIndex, 0.0f), TargetMaxHealth));
+		BatchedTargets.Add(LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, FVector(0.0f, 300.0f * TargetIndex, 1000.0f), TargetMaxHealth));
+	}
+
+	// Every cartridge spreads its pellets over two or three neighboring targets, at varying distances
+	TArray<FTestHit> CartridgeHits;
+	CartridgeHits.Reserve(NumCartridges * PelletsPerCartridge);
+	FRandomStream RandomStream(1234);
+	for (int32 CartridgeIndex = 0; CartridgeIndex < NumCartridges; ++CartridgeIndex)
+	{
+		const int32 FirstTarget = CartridgeIndex % NumTargets;
+		for (int32 PelletIndex = 0; PelletIndex < PelletsPerCartridge; ++PelletIndex)
+		{
+			const int32 TargetIndex = (FirstTarget + RandomStream.RandRange(0, 2)) % NumTargets;
+			CartridgeHits.Add({ TargetIndex, RandomStream.FRandRange(100.0f, 2000.0f), false });
+		}
+	}
+
+	FGameplayEffectContextHandle BaseContext = SourceASC->MakeEffectContext();
+	FLyraGameplayEffectContext* LyraContext = FLyraGameplayEffectContext::ExtractEffectContext(BaseContext);
+	if (!TestNotNull(TEXT("Lyra gameplay effect context"), LyraContext))
+	{
+		return false;
+	}
+	LyraContext->SetAbilitySource(WeaponInstance, 1.0f);
+
+	const TSubclassOf<UGameplayEffect> DamageEffectClass = ULyraTestGameplayEffect_Damage::StaticClass();
+
+	// Per hit: one spec (and source capture) and one application per pellet
+	const double PerHitStartTime = FPlatformTime::Seconds();
+	for (const FTestHit& TestHit : CartridgeHits)
+	{
+		ULyraAbilitySystemComponent* TargetASC = PerHitTargets[TestHit.TargetIndex];
+
+		FGameplayEffectContextHandle HitContext = BaseContext.Duplicate();
+		HitContext.AddHitResult(MakeHit(TargetASC->GetOwner(), TestHit, nullptr), /*bReset=*/ true);
+
+		const FGameplayEffectSpecHandle HitSpec = SourceASC->MakeOutgoingSpec(DamageEffectClass, 1.0f, HitContext);
+		SourceASC->ApplyGameplayEffectSpecToTarget(*HitSpec.Data.Get(), TargetASC);
+	}
+	const double PerHitTime = FPlatformTime::Seconds() - PerHitStartTime;
+
+	// Batched: one spec per cartridge and one application per target it hit, target data built like the ability does
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	for (int32 CartridgeIndex = 0; CartridgeIndex < NumCartridges; ++CartridgeIndex)
+	{
+		FGameplayAbilityTargetDataHandle TargetData;
+		for (int32 PelletIndex = 0; PelletIndex < PelletsPerCartridge; ++PelletIndex)
+		{
+			const FTestHit& TestHit = CartridgeHits[CartridgeIndex * PelletsPerCartridge + PelletIndex];
+
+			FLyraGameplayAbilityTargetData_SingleTargetHit* NewTargetData = new FLyraGameplayAbilityTargetData_SingleTargetHit();
+			NewTargetData->HitResult = MakeHit(BatchedTargets[TestHit.TargetIndex]->GetOwner(), TestHit, nullptr);
+			TargetData.Add(NewTargetData);
+		}
+
+		const FGameplayEffectSpecHandle BaseSpec = SourceASC->MakeOutgoingSpec(DamageEffectClass, 1.0f, BaseContext);
+		ULyraGameplayAbility_RangedWeapon::ApplyBatchedDamageSpecToTargets(SourceASC, *BaseSpec.Data.Get(), TargetData, WeaponInstance);
+	}
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+	{
+		const float PerHitDamage = GetDamageTaken(PerHitTargets[TargetIndex]);
+		TestEqual(FString::Printf(TEXT("Batched damage on target %d"), TargetIndex), GetDamageTaken(BatchedTargets[TargetIndex]), PerHitDamage, FMath::Max(PerHitDamage * 1.0e-4f, 0.01f));
+	}
+
+	const int32 NumHits = CartridgeHits.Num();
+	AddInfo(FString::Printf(TEXT("Damage for %d cartridges of %d pellets on %d targets: per hit %.3f ms (%.2f us/hit), batched %.3f ms (%.2f us/hit)"),
+		NumCartridges, PelletsPerCartridge, NumTargets,
+		PerHitTime * 1000.0, (PerHitTime * 1.0e6) / NumHits,
+		BatchedTime * 1000.0, (BatchedTime * 1.0e6) / NumHits));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Tests/LyraTestCameraMode.h"
+#include "Tests/LyraTestWorld.h"
+
+namespace LyraCameraFeelerTests
+{
+	// Restores a console variable changed by the test
+	struct FScopedCVarOverride
+	{
+		FScopedCVarOverride(const TCHAR* Name, const TCHAR* Value)
+			: CVar(IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			if (CVar)
+			{
+				PreviousValue = CVar->GetString();
+				CVar->Set(Value, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedCVarOverride()
+		{
+			if (CVar)
+			{
+				CVar->Set(*PreviousValue, ECVF_SetByCode);
+			}
+		}
+
+		IConsoleVariable* CVar = nullptr;
+		FString PreviousValue;
+	};
+}
+
+// Runs the penetration avoidance of a third person camera mode against a wall behind the view target, and checks that
+// the predictive feelers swept asynchronously are consumed on the next frame with the same push out as the synchronous
+// path, and that their trace interval scales with the camera speed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraCameraAsyncFeelersTest, "Lyra.Camera.ThirdPerson.AsyncPenetrationFeelers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraCameraAsyncFeelersTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraCameraFeelerTests;
+
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), CubeMesh))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+
+	// A wall across the camera ray, its front face 200cm behind the safe location
+	AStaticMeshActor* Wall = TestWorld.SpawnActor<AStaticMeshActor>(FTransform(FRotator::ZeroRotator, FVector(-250.0f, 0.0f, 0.0f), FVector(1.0f, 4.0f, 4.0f)));
+	Wall->SetMobility(EComponentMobility::Movable);
+	Wall->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	Wall->GetStaticMeshComponent()->SetCollisionResponseToChannel(ECC_Camera, ECR_Block);
+
+	AActor* ViewTarget = TestWorld.SpawnActor<AActor>();
+	const FVector SafeLoc = FVector::ZeroVector;
+	const FVector DesiredCameraLoc(-400.0f, 0.0f, 0.0f);
+	const float DeltaTime = 1.0f / 60.0f;
+	const float PushOutDistance = 10.0f;
+	const float ExpectedBlockedPct = (200.0f - PushOutDistance) / 400.0f;
+	const int32 PredictiveTraceInterval = 3;
+
+	auto MakeCameraMode = [&]()
+	{
+		ULyraTestCameraMode_ThirdPerson* CameraMode = NewObject<ULyraTestCameraMode_ThirdPerson>(ViewTarget);
+		CameraMode->CollisionPushOutDistance = PushOutDistance;
+		CameraMode->AimLineToDesiredPosBlockedPct = 1.0f;
+
+		// The main feeler looks to the side and never hits, so only the predictive feelers can pull the camera in
+		CameraMode->PenetrationAvoidanceFeelers.Reset();
+		CameraMode->PenetrationAvoidanceFeelers.Add(FLyraPenetrationAvoidanceFeeler(FRotator(0.0f, 90.0f, 0.0f), 1.0f, 1.0f, 0.0f, 0));
+		CameraMode->PenetrationAvoidanceFeelers.Add(FLyraPenetrationAvoidanceFeeler(FRotator(0.0f, 0.0f, 0.0f), 1.0f, 1.0f, 0.0f, PredictiveTraceInterval));
+		CameraMode->PenetrationAvoidanceFeelers.Add(FLyraPenetrationAvoidanceFeeler(FRotator(0.0f, 180.0f, 0.0f), 1.0f, 1.0f, 0.0f, PredictiveTraceInterval));
+		return CameraMode;
+	};
+
+	auto RunFrame = [&](ULyraTestCameraMode_ThirdPerson* CameraMode)
+	{
+		FVector CameraLoc = DesiredCameraLoc;
+		CameraMode->SetResetInterpolationForTesting(true);
+		CameraMode->PreventCameraPenetrationForTesting(*ViewTarget, SafeLoc, CameraLoc, DeltaTime);
+		return CameraLoc;
+	};
+
+	// Reference: everything swept synchronously
+	{
+		FScopedCVarOverride AsyncOverride(TEXT("Lyra.Camera.AsyncPenetrationFeelers"), TEXT("0"));
+
+		ULyraTestCameraMode_ThirdPerson* CameraMode = MakeCameraMode();
+		const FVector CameraLoc = RunFrame(CameraMode);
+		TestEqual(TEXT("Synchronous blocked percentage"), CameraMode->AimLineToDesiredPosBlockedPct, ExpectedBlockedPct, 1.e-3f);
+		TestEqual(TEXT("Synchronous camera location"), CameraLoc.X, -200.0f + PushOutDistance, 0.5f);
+	}
+
+	// Async: the predictive sweeps are submitted on the first frame and consumed on the next one
+	{
+		FScopedCVarOverride AsyncOverride(TEXT("Lyra.Camera.AsyncPenetrationFeelers"), TEXT("1"));
+
+		ULyraTestCameraMode_ThirdPerson* CameraMode = MakeCameraMode();
+
+		// A still camera traces the predictive feelers at half their authored rate
+		CameraMode->SetFeelerIntervalScaleForTesting(2.0f);
+
+		FVector CameraLoc = RunFrame(CameraMode);
+		TestEqual(TEXT("Nothing blocks before the async results arrive"), CameraMode->AimLineToDesiredPosBlockedPct, 1.0f);
+		TestEqual(TEXT("Camera not pulled in before the async results arrive"), CameraLoc, DesiredCameraLoc);
+		TestTrue(TEXT("Predictive sweep submitted"), CameraMode->GetPendingFeelerTracesForTesting()[1].Handle.IsValid());
+		TestFalse(TEXT("Main feeler never swept asynchronously"), CameraMode->GetPendingFeelerTracesForTesting()[0].Handle.IsValid());
+
+		TestWorld.Tick(DeltaTime);
+
+		CameraLoc = RunFrame(CameraMode);
+		TestEqual(TEXT("Async blocked percentage matches the synchronous one"), CameraMode->AimLineToDesiredPosBlockedPct, ExpectedBlockedPct, 1.e-3f);
+		TestEqual(TEXT("Async camera location matches the synchronous one"), CameraLoc.X, -200.0f + PushOutDistance, 0.5f);
+
+		// The feeler that hit is swept again right away, the one that missed waits for its scaled interval
+		TestTrue(TEXT("Hitting feeler swept again"), CameraMode->GetPendingFeelerTracesForTesting()[1].Handle.IsValid());
+		TestFalse(TEXT("Missing feeler waiting for its interval"), CameraMode->GetPendingFeelerTracesForTesting()[2].Handle.IsValid());
+		TestEqual(TEXT("Frames until the next sweep of the missing feeler"), CameraMode->PenetrationAvoidanceFeelers[2].FramesUntilNextTrace, (PredictiveTraceInterval * 2) - 1);
+	}
+
+	// Interval scaling from the camera speed
+	{
+		FScopedCVarOverride LinearOverride(TEXT("Lyra.Camera.FeelerFastLinearSpeed"), TEXT("1000"));
+		FScopedCVarOverride AngularOverride(TEXT("Lyra.Camera.FeelerFastAngularSpeed"), TEXT("360"));
+
+		ULyraTestCameraMode_ThirdPerson* CameraMode = MakeCameraMode();
+		FLyraCameraModeView& View = CameraMode->GetCameraModeViewForTesting();
+		CameraMode->SetResetInterpolationForTesting(false);
+		View.Location = DesiredCameraLoc;
+		View.Rotation = FRotator::ZeroRotator;
+
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Authored rate without a previous view"), CameraMode->GetFeelerIntervalScaleForTesting(), 1.0f);
+
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Half rate for a still camera"), CameraMode->GetFeelerIntervalScaleForTesting(), 2.0f);
+
+		View.Location += FVector(0.0f, 500.0f * DeltaTime, 0.0f);
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Authored rate at half the fast linear speed"), CameraMode->GetFeelerIntervalScaleForTesting(), 1.0f, 1.e-3f);
+
+		View.Location += FVector(0.0f, 2000.0f * DeltaTime, 0.0f);
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Every frame above the fast linear speed"), CameraMode->GetFeelerIntervalScaleForTesting(), 0.0f);
+
+		View.Rotation.Yaw += 360.0f * DeltaTime;
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Every frame at the fast angular speed"), CameraMode->GetFeelerIntervalScaleForTesting(), 0.0f, 1.e-3f);
+
+		CameraMode->SetResetInterpolationForTesting(true);
+		CameraMode->UpdateFeelerIntervalScaleForTesting(DeltaTime);
+		TestEqual(TEXT("Authored rate when interpolation is reset"), CameraMode->GetFeelerIntervalScaleForTesting(), 1.0f);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Animation/SkeletalMeshActor.h"
+#include "Cosmetics/LyraCharacterPartSubsystem.h"
+#include "Cosmetics/LyraPawnComponent_CharacterParts.h"
+#include "Engine/StaticMeshActor.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/LyraTestWorld.h"
+
+// Spawns a wave of 40 characters with their character parts in a single frame, three times: without slicing or
+// pooling, sliced with a cold pool, and sliced again with the pool filled by despawning the previous wave. Checks that
+// unsliced parts spawn right away, that sliced parts are queued and all spawned once the queue drains, and that the
+// warm wave reuses every pooled actor, then reports the worst frame of each wave
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraCharacterPartMassRespawnTest, "Lyra.Cosmetics.CharacterParts.MassRespawn", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraCharacterPartMassRespawnTest::RunTest(const FString& Parameters)
+{
+	const int32 NumCharacters = 40;
+	const int32 MaxFramesToDrain = 600;
+	const int32 NumSettleFrames = 10;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	IConsoleVariable* SliceSpawningCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.CharacterParts.SliceSpawning"));
+	IConsoleVariable* MaxPooledCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.CharacterParts.MaxPooledPerClass"));
+	if (!TestNotNull(TEXT("Slice spawning cvar"), SliceSpawningCVar) || !TestNotNull(TEXT("Max pooled cvar"), MaxPooledCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+
+	ULyraCharacterPartSubsystem* Subsystem = TestWorld.GetWorld()->GetSubsystem<ULyraCharacterPartSubsystem>();
+	if (!TestNotNull(TEXT("Character part subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Native stand-ins for the body and cosmetic part blueprints
+	TArray<FLyraCharacterPart> Parts;
+	for (UClass* PartClass : { ASkeletalMeshActor::StaticClass(), AStaticMeshActor::StaticClass(), AStaticMeshActor::StaticClass() })
+	{
+		FLyraCharacterPart& Part = Parts.AddDefaulted_GetRef();
+		Part.PartClass = PartClass;
+	}
+	const int32 NumPartActors = NumCharacters * Parts.Num();
+
+	struct FPhase
+	{
+		const TCHAR* Name;
+		bool bSliceSpawning;
+		bool bPooling;
+	};
+	static const FPhase Phases[] =
+	{
+		{ TEXT("unsliced, no pooling"), false, false },
+		{ TEXT("sliced, cold pool"), true, true },
+		{ TEXT("sliced, warm pool (respawn)"), true, true },
+	};
+
+	const bool bPreviousSliceSpawning = SliceSpawningCVar->GetBool();
+	const int32 PreviousMaxPooled = MaxPooledCVar->GetInt();
+
+	// Only parts whose actor has been spawned are reported by the component
+	auto CountPartActors = [](const TArray<ULyraPawnComponent_CharacterParts*>& PartsComponents)
+	{
+		int32 NumActors = 0;
+		for (const ULyraPawnComponent_CharacterParts* PartsComponent : PartsComponents)
+		{
+			NumActors += PartsComponent->GetCharacterPartActors().Num();
+		}
+		return NumActors;
+	};
+
+	for (const FPhase& Phase : Phases)
+	{
+		SliceSpawningCVar->Set(Phase.bSliceSpawning, ECVF_SetByCode);
+		MaxPooledCVar->Set(Phase.bPooling ? NumPartActors : 0, ECVF_SetByCode);
+
+		const int32 NumPooledBefore = Subsystem->GetNumPooledActors();
+
+		// Everyone in one frame, like a wave of players respawning
+		const double SpawnStartTime = FPlatformTime::Seconds();
+		TArray<ACharacter*> Characters;
+		TArray<ULyraPawnComponent_CharacterParts*> PartsComponents;
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumCharacters));
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			ACharacter* Character = TestWorld.SpawnActor<ACharacter>(FTransform(FVector((Index % GridSize) * 200.0f, (Index / GridSize) * 200.0f, 0.0f)));
+			ULyraPawnComponent_CharacterParts* PartsComponent = NewObject<ULyraPawnComponent_CharacterParts>(Character);
+			PartsComponent->RegisterComponent();
+			for (const FLyraCharacterPart& Part : Parts)
+			{
+				PartsComponent->AddCharacterPart(Part);
+			}
+
+			Characters.Add(Character);
+			PartsComponents.Add(PartsComponent);
+		}
+		const double SpawnTime = FPlatformTime::Seconds() - SpawnStartTime;
+
+		if (Phase.bSliceSpawning)
+		{
+			TestEqual(FString::Printf(TEXT("Part actors spawned right away (%s)"), Phase.Name), CountPartActors(PartsComponents), 0);
+			TestEqual(FString::Printf(TEXT("Characters queued (%s)"), Phase.Name), Subsystem->GetNumQueuedComponents(), NumCharacters);
+		}
+		else
+		{
+			TestEqual(FString::Printf(TEXT("Part actors spawned right away (%s)"), Phase.Name), CountPartActors(PartsComponents), NumPartActors);
+		}
+
+		// The frame of the wave includes spawning the characters, the following ones drain the queue
+		double WorstFrameTime = 0.0;
+		double TotalFrameTime = 0.0;
+		int32 NumFrames = 0;
+		int32 NumFramesToDrain = 0;
+		for (int32 Frame = 0; (Frame < MaxFramesToDrain) && ((Subsystem->GetNumQueuedComponents() > 0) || (Frame < NumSettleFrames)); ++Frame)
+		{
+			const double FrameStartTime = FPlatformTime::Seconds();
+			TestWorld.Tick(DeltaTime);
+			const double FrameTime = (FPlatformTime::Seconds() - FrameStartTime) + ((Frame == 0) ? SpawnTime : 0.0);
+
+			WorstFrameTime = FMath::Max(WorstFrameTime, FrameTime);
+			TotalFrameTime += FrameTime;
+			++NumFrames;
+			if ((NumFramesToDrain == 0) && (Subsystem->GetNumQueuedComponents() == 0))
+			{
+				NumFramesToDrain = NumFrames;
+			}
+		}
+
+		TestEqual(FString::Printf(TEXT("Characters still queued (%s)"), Phase.Name), Subsystem->GetNumQueuedComponents(), 0);
+		TestEqual(FString::Printf(TEXT("Part actors spawned (%s)"), Phase.Name), CountPartActors(PartsComponents), NumPartActors);
+		if (Phase.bPooling)
+		{
+			TestEqual(FString::Printf(TEXT("Pooled actors left after spawning (%s)"), Phase.Name), Subsystem->GetNumPooledActors(), FMath::Max(NumPooledBefore - NumPartActors, 0));
+		}
+
+		AddInfo(FString::Printf(TEXT("Respawning %d characters with %d parts each, %s: worst frame %.2f ms, average %.2f ms over %d frames, queue drained in %d frames, %d part actors pooled before"),
+			NumCharacters, Parts.Num(), Phase.Name, WorstFrameTime * 1000.0, (TotalFrameTime * 1000.0) / FMath::Max(NumFrames, 1), NumFrames, NumFramesToDrain, NumPooledBefore));
+
+		// Despawning releases the part actors, which fills the pool for the next wave
+		for (ACharacter* Character : Characters)
+		{
+			Character->Destroy();
+		}
+		TestEqual(FString::Printf(TEXT("Pooled actors after despawning (%s)"), Phase.Name), Subsystem->GetNumPooledActors(), Phase.bPooling ? NumPartActors : 0);
+		TestWorld.Tick(DeltaTime);
+	}
+
+	SliceSpawningCVar->Set(bPreviousSliceSpawning, ECVF_SetByCode);
+	MaxPooledCVar->Set(PreviousMaxPooled, ECVF_SetByCode);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
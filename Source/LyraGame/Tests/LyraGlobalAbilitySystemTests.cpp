@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/LyraGlobalAbilitySystem.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/LyraTestAbilitySystem.h"
+#include "Tests/LyraTestGameplayEffects.h"
+
+namespace LyraGlobalAbilitySystemTests
+{
+	// Returns the number of ASCs the effect is currently active on
+	static int32 CountASCsWithEffect(const TArray<ULyraAbilitySystemComponent*>& ASCs, TSubclassOf<UGameplayEffect> EffectClass)
+	{
+		int32 Count = 0;
+		for (const ULyraAbilitySystemComponent* ASC : ASCs)
+		{
+			if (ASC->GetGameplayEffectCount(EffectClass, /*OptionalInstigatorFilterComponent=*/ nullptr) > 0)
+			{
+				++Count;
+			}
+		}
+		return Count;
+	}
+}
+
+// Applies an effect whose magnitude is captured from its source to more ASCs than the per frame budget through the
+// global ability system, checks that the application spans several frames, and that each ASC got the value of its
+// own attributes rather than those of the first ASC
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGlobalEffectCaptureTest, "Lyra.AbilitySystem.GlobalAbilitySystem.EffectCapturesPerASC", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraGlobalEffectCaptureTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraGlobalAbilitySystemTests;
+
+	IConsoleVariable* MaxApplicationsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GlobalAbilitySystem.MaxApplicationsPerFrame"));
+	if (!TestNotNull(TEXT("Max applications per frame cvar"), MaxApplicationsCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+
+	ULyraGlobalAbilitySystem* GlobalAbilitySystem = UWorld::GetSubsystem<ULyraGlobalAbilitySystem>(TestWorld.GetWorld());
+	if (!TestNotNull(TEXT("Global ability system"), GlobalAbilitySystem))
+	{
+		return false;
+	}
+
+	const int32 PreviousBudget = MaxApplicationsCVar->GetInt();
+	const int32 Budget = 8;
+	MaxApplicationsCVar->Set(Budget, ECVF_SetByCode);
+
+	// More ASCs than the per frame budget, each with a different max health
+	const int32 NumASCs = (Budget * 2) + (Budget / 2) + 1;
+	const int32 ExpectedNumFrames = FMath::DivideAndRoundUp(NumASCs, Budget);
+
+	TArray<ULyraAbilitySystemComponent*> ASCs;
+	for (int32 Index = 0; Index < NumASCs; ++Index)
+	{
+		ULyraAbilitySystemComponent* ASC = LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, FVector::ZeroVector, 50.0f + (Index * 10.0f));
+		GlobalAbilitySystem->RegisterASC(ASC);
+		ASCs.Add(ASC);
+	}
+
+	// Effects applied to everyone at once spread over several frames, one budget's worth at a time
+	const TSubclassOf<UGameplayEffect> EffectClass = ULyraTestGameplayEffect_CaptureSourceMaxHealth::StaticClass();
+	GlobalAbilitySystem->ApplyEffectToAll(EffectClass);
+	TestEqual(TEXT("ASCs with the effect right after applying it"), CountASCsWithEffect(ASCs, EffectClass), Budget);
+
+	// An ASC registering while the application is in progress gets it right away
+	ULyraAbilitySystemComponent* LateASC = LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, FVector::ZeroVector, 175.0f);
+	GlobalAbilitySystem->RegisterASC(LateASC);
+	ASCs.Add(LateASC);
+	TestEqual(TEXT("ASCs with the effect after one registered"), CountASCsWithEffect(ASCs, EffectClass), Budget + 1);
+
+	for (int32 Frame = 1; Frame < ExpectedNumFrames; ++Frame)
+	{
+		TestWorld.Tick();
+		TestEqual(FString::Printf(TEXT("ASCs with the effect after %d frames"), Frame), CountASCsWithEffect(ASCs, EffectClass), FMath::Min((Budget * (Frame + 1)) + 1, ASCs.Num()));
+	}
+	TestEqual(TEXT("ASCs with the effect once the application finished"), CountASCsWithEffect(ASCs, EffectClass), ASCs.Num());
+
+	for (int32 Index = 0; Index < ASCs.Num(); ++Index)
+	{
+		const float MaxHealth = ASCs[Index]->GetNumericAttribute(ULyraHealthSet::GetMaxHealthAttribute());
+		const float BaseHeal = ASCs[Index]->GetNumericAttribute(ULyraCombatSet::GetBaseHealAttribute());
+		TestEqual(FString::Printf(TEXT("BaseHeal captured from ASC %d"), Index), BaseHeal, MaxHealth);
+	}
+
+	GlobalAbilitySystem->RemoveEffectFromAll(EffectClass);
+	for (ULyraAbilitySystemComponent* ASC : ASCs)
+	{
+		TestEqual(TEXT("BaseHeal after removing the global effect"), ASC->GetNumericAttribute(ULyraCombatSet::GetBaseHealAttribute()), ASC->GetNumericAttributeBase(ULyraCombatSet::GetBaseHealAttribute()));
+		GlobalAbilitySystem->UnregisterASC(ASC);
+	}
+
+	MaxApplicationsCVar->Set(PreviousBudget, ECVF_SetByCode);
+
+	return true;
+}
+
+// Registers hundreds of ASCs and reports the worst frame cost of applying a global effect to all of them, without
+// and with time slicing
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGlobalEffectManyASCsTest, "Lyra.AbilitySystem.GlobalAbilitySystem.ApplyToManyASCs", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraGlobalEffectManyASCsTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraGlobalAbilitySystemTests;
+
+	const int32 NumASCs = 500;
+	const int32 MaxFrames = 100;
+
+	IConsoleVariable* MaxApplicationsCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GlobalAbilitySystem.MaxApplicationsPerFrame"));
+	if (!TestNotNull(TEXT("Max applications per frame cvar"), MaxApplicationsCVar))
+	{
+		return false;
+	}
+	const int32 PreviousBudget = MaxApplicationsCVar->GetInt();
+
+	FLyraScopedTestWorld TestWorld;
+
+	ULyraGlobalAbilitySystem* GlobalAbilitySystem = UWorld::GetSubsystem<ULyraGlobalAbilitySystem>(TestWorld.GetWorld());
+	if (!TestNotNull(TEXT("Global ability system"), GlobalAbilitySystem))
+	{
+		return false;
+	}
+
+	TArray<ULyraAbilitySystemComponent*> ASCs;
+	for (int32 Index = 0; Index < NumASCs; ++Index)
+	{
+		ULyraAbilitySystemComponent* ASC = LyraTestAbilitySystem::SpawnActorWithAbilitySystem(TestWorld, FVector::ZeroVector, 100.0f + Index);
+		GlobalAbilitySystem->RegisterASC(ASC);
+		ASCs.Add(ASC);
+	}
+
+	const TSubclassOf<UGameplayEffect> EffectClass = ULyraTestGameplayEffect_CaptureSourceMaxHealth::StaticClass();
+
+	for (const int32 Budget : { 0, 32 })
+	{
+		MaxApplicationsCVar->Set(Budget, ECVF_SetByCode);
+
+		double WorstFrameTime = 0.0;
+		int32 NumFrames = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		GlobalAbilitySystem->ApplyEffectToAll(EffectClass);
+		WorstFrameTime = FPlatformTime::Seconds() - StartTime;
+
+		while ((CountASCsWithEffect(ASCs, EffectClass) < NumASCs) && (NumFrames < MaxFrames))
+		{
+			StartTime = FPlatformTime::Seconds();
+			TestWorld.Tick();
+			WorstFrameTime = FMath::Max(WorstFrameTime, FPlatformTime::Seconds() - StartTime);
+			++NumFrames;
+		}
+
+		TestEqual(FString::Printf(TEXT("ASCs with the effect (budget %d)"), Budget), CountASCsWithEffect(ASCs, EffectClass), NumASCs);
+		if (Budget > 0)
+		{
+			TestEqual(TEXT("Frames spent applying with time slicing"), NumFrames + 1, FMath::DivideAndRoundUp(NumASCs, Budget));
+		}
+		else
+		{
+			TestEqual(TEXT("Frames spent applying without time slicing"), NumFrames, 0);
+		}
+
+		AddInfo(FString::Printf(TEXT("Global effect on %d ASCs with %s: worst frame %.3f ms over %d frames"),
+			NumASCs, (Budget > 0) ? *FString::Printf(TEXT("a budget of %d per frame"), Budget) : TEXT("no budget"), WorstFrameTime * 1000.0, NumFrames + 1));
+
+		GlobalAbilitySystem->RemoveEffectFromAll(EffectClass);
+	}
+
+	MaxApplicationsCVar->Set(PreviousBudget, ECVF_SetByCode);
+
+	for (ULyraAbilitySystemComponent* ASC : ASCs)
+	{
+		GlobalAbilitySystem->UnregisterASC(ASC);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,271 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/LyraCharacter.h"
+#include "Character/LyraCharacterMovementComponent.h"
+#include "Character/LyraGroundProbeSubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/LyraTestWorld.h"
+
+namespace LyraGroundProbeTests
+{
+	// 100cm cubes
+	static AStaticMeshActor* SpawnBlock(FLyraScopedTestWorld& TestWorld, UStaticMesh* CubeMesh, const FTransform& Transform)
+	{
+		AStaticMeshActor* Block = TestWorld.SpawnActor<AStaticMeshActor>(Transform);
+		Block->SetMobility(EComponentMobility::Movable);
+		Block->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+		Block->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		return Block;
+	}
+
+	// Ticks one frame, running Probes where a movement or animation tick would ask for its ground: after the async traces
+	// of the previous frame completed and before the ones of this frame are issued. The tests tick the world outside of
+	// the engine loop, so this also advances the frame counter
+	static void TickFrame(FLyraScopedTestWorld& TestWorld, TFunctionRef<void()> Probes)
+	{
+		++GFrameCounter;
+		const FDelegateHandle PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddLambda([&TestWorld, &Probes](UWorld* World, ELevelTick TickType, float DeltaTime)
+		{
+			if (World == TestWorld.GetWorld())
+			{
+				Probes();
+			}
+		});
+		TestWorld.Tick();
+		FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	}
+
+	static void TickFrame(FLyraScopedTestWorld& TestWorld)
+	{
+		TickFrame(TestWorld, []() {});
+	}
+}
+
+// Walks a requester over a ledge and a slope one probe per frame, and checks that each probe is answered with the
+// requester's probe from the previous frame only when it still applies: same column, nearby flat ground or rising, but
+// not past the offset, on a slope, below the previous hit, or after a frame without a probe. A ledge crossed within the
+// offset shows up one frame late
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGroundProbeLedgeTest, "Lyra.Character.GroundProbes.PreviousFrameResult", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraGroundProbeLedgeTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraGroundProbeTests;
+
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), CubeMesh))
+	{
+		return false;
+	}
+
+	IConsoleVariable* MaxOffsetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GroundProbe.MaxHorizontalOffset"));
+	if (!TestNotNull(TEXT("Max horizontal offset cvar"), MaxOffsetCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	ULyraGroundProbeSubsystem* GroundProbes = World->GetSubsystem<ULyraGroundProbeSubsystem>();
+	if (!TestNotNull(TEXT("Ground probe subsystem"), GroundProbes))
+	{
+		return false;
+	}
+
+	const float PreviousMaxOffset = MaxOffsetCVar->GetFloat();
+	MaxOffsetCVar->Set(10.0f, ECVF_SetByCode);
+
+	// A ledge at X=25: 100cm high before it, 0 after it
+	SpawnBlock(TestWorld, CubeMesh, FTransform(FVector(-25.0f, 25.0f, 50.0f)));
+	SpawnBlock(TestWorld, CubeMesh, FTransform(FVector(75.0f, 25.0f, -50.0f)));
+
+	// Further away, a slope steeper than what is followed at an offset
+	SpawnBlock(TestWorld, CubeMesh, FTransform(FRotator(20.0f, 0.0f, 0.0f), FVector(500.0f, 25.0f, 0.0f)));
+
+	AActor* Requester = TestWorld.SpawnActor<AActor>();
+	const ECollisionChannel Channel = ECC_WorldStatic;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LyraGroundProbeTest), false);
+	const FCollisionResponseParams ResponseParams;
+	const FVector ProbeDown(0.0f, 0.0f, -1000.0f);
+
+	// Ticks a frame that queues this probe, and returns whether the probe of the previous frame answered it
+	auto Probe = [&](const FVector& Start, FHitResult& OutHit, ECollisionChannel ProbeChannel = ECC_WorldStatic)
+	{
+		bool bAnswered = false;
+		TickFrame(TestWorld, [&]()
+		{
+			bAnswered = GroundProbes->RequestGroundHit(Requester, Start, Start + ProbeDown, ProbeChannel, QueryParams, ResponseParams, /*out*/ OutHit);
+		});
+		return bAnswered;
+	};
+
+	FHitResult Hit;
+
+	// Nothing from a previous frame to answer the first probe
+	TestFalse(TEXT("First probe answered"), Probe(FVector(10.0f, 25.0f, 300.0f), /*out*/ Hit));
+
+	// Same column, lower down: answered exactly
+	TestTrue(TEXT("Same column answered"), Probe(FVector(10.0f, 25.0f, 250.0f), /*out*/ Hit));
+	TestEqual(TEXT("Same column ground height"), Hit.ImpactPoint.Z, 100.0, 0.5);
+	TestEqual(TEXT("Same column ground distance"), Hit.Distance, 150.0f, 0.5f);
+
+	// Nearby flat ground follows the requester
+	TestTrue(TEXT("Nearby flat ground answered"), Probe(FVector(18.0f, 25.0f, 250.0f), /*out*/ Hit));
+	TestEqual(TEXT("Nearby flat ground height"), Hit.ImpactPoint.Z, 100.0, 0.5);
+	TestEqual(TEXT("Nearby flat ground X"), Hit.ImpactPoint.X, 18.0);
+
+	// Crossing the ledge within the offset reports the ground before it for one frame, and the ground past it the next
+	TestTrue(TEXT("Probe just past the ledge answered"), Probe(FVector(28.0f, 25.0f, 250.0f), /*out*/ Hit));
+	TestEqual(TEXT("Ground height one frame after crossing the ledge"), Hit.ImpactPoint.Z, 100.0, 0.5);
+	TestTrue(TEXT("Probe further past the ledge answered"), Probe(FVector(30.0f, 25.0f, 250.0f), /*out*/ Hit));
+	TestEqual(TEXT("Ground height two frames after crossing the ledge"), Hit.ImpactPoint.Z, 0.0, 0.5);
+
+	// Never further than the offset
+	TestFalse(TEXT("Probe beyond the offset answered"), Probe(FVector(45.0f, 25.0f, 250.0f), /*out*/ Hit));
+
+	// Rising is fine, the requester just moved through that space
+	TestTrue(TEXT("Rising probe answered"), Probe(FVector(45.0f, 25.0f, 400.0f), /*out*/ Hit));
+	TestEqual(TEXT("Rising probe ground distance"), Hit.Distance, 400.0f, 0.5f);
+
+	// But not below what the previous probe hit
+	TestFalse(TEXT("Probe below the previous hit answered"), Probe(FVector(45.0f, 25.0f, -10.0f), /*out*/ Hit));
+
+	// Not slopes at an offset, only from the same column
+	Probe(FVector(510.0f, 25.0f, 300.0f), /*out*/ Hit);
+	TestFalse(TEXT("Nearby slope answered"), Probe(FVector(515.0f, 25.0f, 300.0f), /*out*/ Hit));
+	TestTrue(TEXT("Same column on the slope answered"), Probe(FVector(515.0f, 25.0f, 250.0f), /*out*/ Hit));
+	{
+		FHitResult TracedHit;
+		const FVector Start(515.0f, 25.0f, 250.0f);
+		World->LineTraceSingleByChannel(/*out*/ TracedHit, Start, Start + ProbeDown, Channel, QueryParams, ResponseParams);
+		TestEqual(TEXT("Same column on the slope ground height"), Hit.ImpactPoint.Z, TracedHit.ImpactPoint.Z, 0.01);
+	}
+
+	// Nothing answers after a frame without a probe, or on another channel
+	TickFrame(TestWorld);
+	TestFalse(TEXT("Probe after a frame without one answered"), Probe(FVector(515.0f, 25.0f, 250.0f), /*out*/ Hit));
+	TestFalse(TEXT("Probe on another channel answered"), Probe(FVector(515.0f, 25.0f, 250.0f), /*out*/ Hit, ECC_Visibility));
+
+	MaxOffsetCVar->Set(PreviousMaxOffset, ECVF_SetByCode);
+
+	return true;
+}
+
+// Moves airborne Lyra characters over flat ground at lateral speeds from standing still to faster than the offset the
+// previous frame's probe is followed for, checks that the ground distance is right every frame with the batched
+// probes as well as with synchronous traces, and reports the game thread cost of the ground probes for both
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGroundProbeLateralMovementTest, "Lyra.Character.GroundProbes.LateralMovement", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraGroundProbeLateralMovementTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraGroundProbeTests;
+
+	const int32 NumCharactersPerSpeed = 20;
+	const int32 NumFrames = 120;
+	const float SpawnHeight = 500.0f;
+	const float LateralSpeeds[] = { 0.0f, 300.0f, 600.0f, 1200.0f, 2400.0f };
+
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	IConsoleVariable* EnabledCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GroundProbe.Enabled"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), CubeMesh) || !TestNotNull(TEXT("Ground probes cvar"), EnabledCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+	ULyraGroundProbeSubsystem* GroundProbes = TestWorld.GetWorld()->GetSubsystem<ULyraGroundProbeSubsystem>();
+	if (!TestNotNull(TEXT("Ground probe subsystem"), GroundProbes))
+	{
+		return false;
+	}
+
+	// A 200m floor with its top at Z=50
+	SpawnBlock(TestWorld, CubeMesh, FTransform(FRotator::ZeroRotator, FVector::ZeroVector, FVector(200.0f, 200.0f, 1.0f)));
+
+	TArray<ULyraCharacterMovementComponent*> MovementComponents;
+	TArray<FVector> StartLocations;
+	for (int32 SpeedIndex = 0; SpeedIndex < UE_ARRAY_COUNT(LateralSpeeds); ++SpeedIndex)
+	{
+		for (int32 Index = 0; Index < NumCharactersPerSpeed; ++Index)
+		{
+			const FVector Location(-5000.0f, (SpeedIndex * NumCharactersPerSpeed + Index) * 100.0f - 5000.0f, SpawnHeight);
+			ALyraCharacter* Character = TestWorld.SpawnActor<ALyraCharacter>(FTransform(Location));
+
+			// Hovering, diagonally so the probes move on both axes
+			ULyraCharacterMovementComponent* CharMoveComp = CastChecked<ULyraCharacterMovementComponent>(Character->GetCharacterMovement());
+			CharMoveComp->bRunPhysicsWithNoController = true;
+			CharMoveComp->GravityScale = 0.0f;
+			CharMoveComp->SetMovementMode(MOVE_Falling);
+			CharMoveComp->Velocity = FVector(1.0f, 0.25f, 0.0f).GetSafeNormal() * LateralSpeeds[SpeedIndex];
+
+			MovementComponents.Add(CharMoveComp);
+			StartLocations.Add(Location);
+		}
+	}
+
+	const float CapsuleHalfHeight = MovementComponents[0]->GetCharacterOwner()->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
+	const float ExpectedGroundDistance = SpawnHeight - 50.0f - CapsuleHalfHeight;
+
+	// Asks every character for its ground info once per frame, like their animation would, and returns the time spent
+	auto RunFrames = [&](bool bUseGroundProbes)
+	{
+		EnabledCVar->Set(bUseGroundProbes, ECVF_SetByCode);
+
+		for (int32 Index = 0; Index < MovementComponents.Num(); ++Index)
+		{
+			MovementComponents[Index]->GetCharacterOwner()->SetActorLocation(StartLocations[Index]);
+		}
+
+		double GroundInfoTime = 0.0;
+		bool bErrorReported = false;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TickFrame(TestWorld, [&]()
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				for (ULyraCharacterMovementComponent* CharMoveComp : MovementComponents)
+				{
+					CharMoveComp->GetGroundInfo();
+				}
+				GroundInfoTime += FPlatformTime::Seconds() - StartTime;
+			});
+
+			// Cached for the frame
+			for (ULyraCharacterMovementComponent* CharMoveComp : MovementComponents)
+			{
+				const float GroundDistance = CharMoveComp->GetGroundInfo().GroundDistance;
+				if (!bErrorReported && !FMath::IsNearlyEqual(GroundDistance, ExpectedGroundDistance, 1.0f))
+				{
+					AddError(FString::Printf(TEXT("Ground distance %.1f instead of %.1f at %.0f cm/s on frame %d (%s)"), GroundDistance, ExpectedGroundDistance,
+						CharMoveComp->Velocity.Size2D(), Frame, bUseGroundProbes ? TEXT("batched probes") : TEXT("synchronous traces")));
+					bErrorReported = true;
+				}
+			}
+		}
+		return GroundInfoTime;
+	};
+
+	const bool bPreviousEnabled = EnabledCVar->GetBool();
+	const double SyncTime = RunFrames(false);
+	const double BatchedTime = RunFrames(true);
+	TestEqual(TEXT("Requesters with a batched probe"), GroundProbes->GetNumRequesters(), MovementComponents.Num());
+	EnabledCVar->Set(bPreviousEnabled, ECVF_SetByCode);
+
+	AddInfo(FString::Printf(TEXT("Ground probes for %d airborne characters at lateral speeds up to %.0f cm/s over %d frames: synchronous %.4f ms/frame, batched %.4f ms/frame"),
+		MovementComponents.Num(), LateralSpeeds[UE_ARRAY_COUNT(LateralSpeeds) - 1], NumFrames, (SyncTime * 1000.0) / NumFrames, (BatchedTime * 1000.0) / NumFrames));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/Abilities/LyraGameplayAbility.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "GameFramework/Character.h"
+#include "Interaction/LyraInteractionGrantTracker.h"
+#include "Tests/LyraTestWorld.h"
+
+// Walks a character past a line of interactables that each offer their own interaction ability, granting and revoking
+// them on its ability system the way the nearby interaction task does, and checks that pacing along the edge of the
+// scan range does not grant the same ability over and over, that the lingering grants stay within budget while walking,
+// and that everything is revoked once the character is out of range for longer than the grace period
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraInteractionGrantWalkTest, "Lyra.Interaction.GrantTracker.WalkPastInteractables", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraInteractionGrantWalkTest::RunTest(const FString& Parameters)
+{
+	const int32 NumInteractables = 50;
+	const float InteractableSpacing = 200.0f;
+	const float InteractableOffset = 100.0f;
+	const float ScanRange = 300.0f;
+	const float GracePeriod = 2.0f;
+	const int32 MaxLingeringGrants = 4;
+	const float WalkSpeed = 600.0f;
+	const float DeltaTime = 1.0f / 60.0f;
+	const int32 FramesPerScan = 6;
+
+	// At most this many interactables are in range at once, given the spacing and offset above
+	const int32 MaxInRange = 3;
+
+	// Distance along the line at which an interactable enters the scan range
+	const float EdgeDistance = FMath::Sqrt(FMath::Square(ScanRange) - FMath::Square(InteractableOffset));
+
+	FLyraScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	ACharacter* Character = TestWorld.SpawnActor<ACharacter>(FTransform(FVector(-EdgeDistance - 200.0f, 0.0f, 0.0f)));
+	ULyraAbilitySystemComponent* ASC = NewObject<ULyraAbilitySystemComponent>(Character);
+	ASC->RegisterComponent();
+	ASC->InitAbilityActorInfo(Character, Character);
+
+	// Each interactable stands in for the ability class it offers, only its identity matters to the tracker
+	TArray<AActor*> Interactables;
+	for (int32 Index = 0; Index < NumInteractables; ++Index)
+	{
+		AActor* Interactable = TestWorld.SpawnActor<AActor>();
+		USceneComponent* RootComponent = NewObject<USceneComponent>(Interactable);
+		Interactable->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+		Interactable->SetActorLocation(FVector(Index * InteractableSpacing, InteractableOffset, 0.0f));
+		Interactables.Add(Interactable);
+	}
+
+	FLyraInteractionGrantTracker Tracker;
+	TArray<FGameplayAbilitySpecHandle> HandlesToRevoke;
+	int32 NumGranted = 0;
+	int32 NumRevoked = 0;
+	int32 PeakLiveGrants = 0;
+	int32 PeakLingeringGrants = 0;
+	bool bMismatchReported = false;
+
+	// One scan of the nearby interaction task, at the current location of the character
+	auto Scan = [&]()
+	{
+		const double CurrentTime = World->GetTimeSeconds();
+		const FVector ScanCenter = Character->GetActorLocation();
+
+		Tracker.BeginScan();
+		for (AActor* Interactable : Interactables)
+		{
+			if (FVector::Dist(Interactable->GetActorLocation(), ScanCenter) > ScanRange)
+			{
+				continue;
+			}
+
+			const FObjectKey AbilityKey(Interactable);
+			if (Tracker.AddReference(AbilityKey, CurrentTime))
+			{
+				FGameplayAbilitySpec Spec(ULyraGameplayAbility::StaticClass(), 1, INDEX_NONE, Interactable);
+				Tracker.SetGrantHandle(AbilityKey, ASC->GiveAbility(Spec));
+				++NumGranted;
+			}
+		}
+
+		HandlesToRevoke.Reset();
+		Tracker.EndScan(CurrentTime, GracePeriod, MaxLingeringGrants, /*out*/ HandlesToRevoke);
+		for (const FGameplayAbilitySpecHandle& Handle : HandlesToRevoke)
+		{
+			ASC->ClearAbility(Handle);
+		}
+		NumRevoked += HandlesToRevoke.Num();
+
+		PeakLiveGrants = FMath::Max(PeakLiveGrants, Tracker.GetNumLiveGrants());
+		PeakLingeringGrants = FMath::Max(PeakLingeringGrants, Tracker.GetNumLiveGrants() - Tracker.GetNumReferencedGrants());
+
+		if (!bMismatchReported && (ASC->GetActivatableAbilities().Num() != Tracker.GetNumLiveGrants()))
+		{
+			AddError(FString::Printf(TEXT("%d abilities granted on the ability system, but %d tracked"), ASC->GetActivatableAbilities().Num(), Tracker.GetNumLiveGrants()));
+			bMismatchReported = true;
+		}
+	};
+
+	// Ticks the world, scanning at the rate of the task, and moves the character by Velocity every frame
+	int32 FrameCount = 0;
+	auto Advance = [&](float Duration, const FVector& Velocity)
+	{
+		const int32 NumFrames = FMath::CeilToInt(Duration / DeltaTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Character->SetActorLocation(Character->GetActorLocation() + Velocity * DeltaTime);
+			TestWorld.Tick(DeltaTime);
+			if ((++FrameCount % FramesPerScan) == 0)
+			{
+				Scan();
+			}
+		}
+	};
+
+	// Pacing in and out of the range of the first interactable is granted once and never revoked
+	const float PaceDistance = 40.0f;
+	Character->SetActorLocation(FVector(-EdgeDistance - PaceDistance, 0.0f, 0.0f));
+	for (int32 Pace = 0; Pace < 10; ++Pace)
+	{
+		const float Direction = ((Pace % 2) == 0) ? 1.0f : -1.0f;
+		Advance(0.5f, FVector(Direction * PaceDistance * 4.0f, 0.0f, 0.0f));
+	}
+	TestEqual(TEXT("Grants while pacing along the edge of the scan range"), NumGranted, 1);
+	TestEqual(TEXT("Revokes while pacing along the edge of the scan range"), NumRevoked, 0);
+
+	// Walking down the line grants every interaction once, and keeps the ones left behind within budget
+	const float WalkDistance = (NumInteractables - 1) * InteractableSpacing + 2.0f * (EdgeDistance + PaceDistance);
+	Advance(WalkDistance / WalkSpeed, FVector(WalkSpeed, 0.0f, 0.0f));
+	TestEqual(TEXT("Grants after walking past every interactable"), NumGranted, NumInteractables);
+	TestTrue(TEXT("Peak live grants within the in range and lingering budgets"), PeakLiveGrants <= MaxInRange + MaxLingeringGrants);
+	TestEqual(TEXT("Peak lingering grants"), PeakLingeringGrants, MaxLingeringGrants);
+
+	// Standing out of range for longer than the grace period revokes everything
+	Advance(GracePeriod + 0.5f, FVector::ZeroVector);
+	TestEqual(TEXT("Live grants after the grace period"), Tracker.GetNumLiveGrants(), 0);
+	TestEqual(TEXT("Revokes after the grace period"), NumRevoked, NumGranted);
+	TestEqual(TEXT("Abilities left on the ability system"), ASC->GetActivatableAbilities().Num(), 0);
+
+	AddInfo(FString::Printf(TEXT("Interaction grants walking past %d interactables (%.1f s grace, %d lingering max): %d granted, %d peak live"),
+		NumInteractables, GracePeriod, MaxLingeringGrants, NumGranted, PeakLiveGrants));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "LoadingScreenManager.h"
+#include "Misc/CommandLine.h"
+#include "Tests/LyraTestLoadingProcessor.h"
+#include "Tests/LyraTestWorld.h"
+
+// Checks that the loading screen manager does not poll loading processors while the loading screen is hidden, and
+// that it shows and hides the loading screen on the next tick after a processor notifies it that its answer changed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraLoadingScreenNotifyTest, "Lyra.LoadingScreen.ShowAndHideOnNotify", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraLoadingScreenNotifyTest::RunTest(const FString& Parameters)
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("NoLoadingScreen")))
+	{
+		AddWarning(TEXT("The loading screen is disabled from the command line, nothing to test"));
+		return true;
+	}
+
+	IConsoleVariable* AlwaysShowCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("CommonLoadingScreen.AlwaysShow"));
+	if (AlwaysShowCVar && AlwaysShowCVar->GetBool())
+	{
+		AddWarning(TEXT("CommonLoadingScreen.AlwaysShow is set, nothing to test"));
+		return true;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	ULoadingScreenManager* LoadingScreenManager = TestWorld.GetGameInstance()->GetSubsystem<ULoadingScreenManager>();
+	if (!TestNotNull(TEXT("Loading screen manager"), LoadingScreenManager))
+	{
+		return false;
+	}
+
+	// Hide as soon as nothing needs the loading screen anymore
+	IConsoleVariable* HoldCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("CommonLoadingScreen.HoldLoadingScreenAdditionalSecs"));
+	const float PreviousHoldSecs = HoldCVar ? HoldCVar->GetFloat() : 0.0f;
+	if (HoldCVar)
+	{
+		HoldCVar->Set(0.0f, ECVF_SetByCode);
+	}
+
+	// Everything else the loading screen waits for: a game state and a local player with a controller
+	AGameStateBase* GameState = TestWorld.SpawnActor<AGameStateBase>();
+	World->SetGameState(GameState);
+
+	ULocalPlayer* LocalPlayer = NewObject<ULocalPlayer>(GEngine);
+	LocalPlayer->PlayerController = TestWorld.SpawnActor<APlayerController>();
+	TestWorld.GetGameInstance()->AddTestLocalPlayer(LocalPlayer);
+
+	ULyraTestLoadingProcessor* Processor = NewObject<ULyraTestLoadingProcessor>(GameState);
+	LoadingScreenManager->RegisterLoadingProcessor(Processor);
+
+	const float DeltaTime = 1.0f / 60.0f;
+	LoadingScreenManager->Tick(DeltaTime);
+	TestFalse(TEXT("Loading screen hidden once everything is ready"), LoadingScreenManager->GetLoadingScreenDisplayStatus());
+	TestTrue(TEXT("Processor asked after registering"), Processor->NumQueries > 0);
+
+	// Dormant: the processor changing its mind goes unnoticed until it notifies the manager
+	const int32 NumQueriesWhileHidden = Processor->NumQueries;
+	Processor->bWantsLoadingScreen = true;
+	for (int32 Frame = 0; Frame < 5; ++Frame)
+	{
+		LoadingScreenManager->Tick(DeltaTime);
+	}
+	TestEqual(TEXT("Processor not polled while the loading screen is hidden"), Processor->NumQueries, NumQueriesWhileHidden);
+	TestFalse(TEXT("Loading screen still hidden without a notification"), LoadingScreenManager->GetLoadingScreenDisplayStatus());
+
+	ILoadingProcessInterface::NotifyLoadingStateChanged(Processor);
+	LoadingScreenManager->Tick(DeltaTime);
+	TestTrue(TEXT("Loading screen shown on the tick after the notification"), LoadingScreenManager->GetLoadingScreenDisplayStatus());
+
+	Processor->bWantsLoadingScreen = false;
+	ILoadingProcessInterface::NotifyLoadingStateChanged(Processor);
+	LoadingScreenManager->Tick(DeltaTime);
+	TestFalse(TEXT("Loading screen hidden on the tick after the notification"), LoadingScreenManager->GetLoadingScreenDisplayStatus());
+
+	// And dormant again
+	const int32 NumQueriesAfterHiding = Processor->NumQueries;
+	for (int32 Frame = 0; Frame < 5; ++Frame)
+	{
+		LoadingScreenManager->Tick(DeltaTime);
+	}
+	TestEqual(TEXT("Processor not polled after the loading screen was hidden"), Processor->NumQueries, NumQueriesAfterHiding);
+
+	LoadingScreenManager->UnregisterLoadingProcessor(Processor);
+	TestWorld.GetGameInstance()->RemoveTestLocalPlayer(LocalPlayer);
+
+	if (HoldCVar)
+	{
+		HoldCVar->Set(PreviousHoldSecs, ECVF_SetByCode);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
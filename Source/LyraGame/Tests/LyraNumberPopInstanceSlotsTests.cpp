@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Feedback/NumberPops/LyraNumberPopComponent_InstancedMeshText.h"
+
+// Acquires and releases number pop digit slots and checks that they grow up to the limit, are reused once released,
+// and that the digit closest to expiring is recycled when every slot is live
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraNumberPopInstanceSlotsTest, "Lyra.NumberPops.InstanceSlots", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraNumberPopInstanceSlotsTest::RunTest(const FString& Parameters)
+{
+	const int32 MaxSlots = 3;
+
+	FLyraNumberPopInstanceSlots Slots;
+	TestEqual(TEXT("Next release time with nothing live"), Slots.GetNextReleaseTime(), -1.0);
+
+	// Grows one slot at a time up to the limit
+	for (int32 ExpectedSlot = 0; ExpectedSlot < MaxSlots; ++ExpectedSlot)
+	{
+		bool bAddedSlot = false;
+		const int32 Slot = Slots.Acquire(1.0 + ExpectedSlot, MaxSlots, /*out*/ bAddedSlot);
+		TestEqual(TEXT("Slots are added in order"), Slot, ExpectedSlot);
+		TestTrue(TEXT("Slot added while under the limit"), bAddedSlot);
+	}
+	TestEqual(TEXT("Number of slots at the limit"), Slots.GetNumSlots(), MaxSlots);
+	TestEqual(TEXT("Number of live slots at the limit"), Slots.GetNumLiveSlots(), MaxSlots);
+	TestEqual(TEXT("Next release time is the oldest digit"), Slots.GetNextReleaseTime(), 1.0);
+
+	// Full, the slot that would expire first is recycled
+	{
+		bool bAddedSlot = true;
+		const int32 Slot = Slots.Acquire(10.0, MaxSlots, /*out*/ bAddedSlot);
+		TestEqual(TEXT("Oldest slot recycled when full"), Slot, 0);
+		TestFalse(TEXT("No slot added when full"), bAddedSlot);
+		TestEqual(TEXT("Number of slots when full"), Slots.GetNumSlots(), MaxSlots);
+		TestEqual(TEXT("Number of live slots when full"), Slots.GetNumLiveSlots(), MaxSlots);
+		TestEqual(TEXT("Next release time after recycling"), Slots.GetNextReleaseTime(), 2.0);
+	}
+
+	// Nothing has expired yet
+	TArray<int32> ReleasedSlots;
+	Slots.ReleaseExpired(1.5, /*out*/ ReleasedSlots);
+	TestEqual(TEXT("Nothing released before the first release time"), ReleasedSlots.Num(), 0);
+
+	// Release times are inclusive, and only the expired slots are released
+	Slots.ReleaseExpired(3.0, /*out*/ ReleasedSlots);
+	TestEqual(TEXT("Number of released slots"), ReleasedSlots.Num(), 2);
+	if (ReleasedSlots.Num() == 2)
+	{
+		TestEqual(TEXT("First released slot"), ReleasedSlots[0], 1);
+		TestEqual(TEXT("Second released slot"), ReleasedSlots[1], 2);
+	}
+	TestEqual(TEXT("Live slots after releasing"), Slots.GetNumLiveSlots(), 1);
+	TestEqual(TEXT("Next release time after releasing"), Slots.GetNextReleaseTime(), 10.0);
+
+	// Released slots are reused before growing, even with room under the limit
+	{
+		bool bAddedSlot = true;
+		const int32 Slot = Slots.Acquire(11.0, MaxSlots + 1, /*out*/ bAddedSlot);
+		TestTrue(TEXT("Released slot reused"), (Slot == 1) || (Slot == 2));
+		TestFalse(TEXT("No slot added while some are free"), bAddedSlot);
+		TestEqual(TEXT("Number of slots after reusing"), Slots.GetNumSlots(), MaxSlots);
+	}
+
+	// Releasing everything
+	ReleasedSlots.Reset();
+	Slots.ReleaseExpired(100.0, /*out*/ ReleasedSlots);
+	TestEqual(TEXT("Remaining live slots released"), ReleasedSlots.Num(), 2);
+	TestEqual(TEXT("No live slots left"), Slots.GetNumLiveSlots(), 0);
+	TestEqual(TEXT("Next release time with nothing live"), Slots.GetNextReleaseTime(), -1.0);
+
+	// Without any live slot to recycle, a slot is always handed out even with no room
+	{
+		FLyraNumberPopInstanceSlots EmptySlots;
+		bool bAddedSlot = false;
+		const int32 Slot = EmptySlots.Acquire(1.0, /*MaxSlots=*/ 0, /*out*/ bAddedSlot);
+		TestEqual(TEXT("Slot handed out with a limit of zero"), Slot, 0);
+		TestTrue(TEXT("Slot added with a limit of zero"), bAddedSlot);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
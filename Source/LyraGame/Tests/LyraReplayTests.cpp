@@ -0,0 +1,292 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SceneComponent.h"
+#include "Engine/DemoNetDriver.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Replays/LyraReplaySubsystem.h"
+#include "Tests/AutomationCommon.h"
+
+namespace LyraReplayTests
+{
+	// Length of the synthetic replay, with a checkpoint every CheckpointInterval seconds
+	static const float RecordDuration = 12.0f;
+	static const float CheckpointInterval = 2.0f;
+	static const int32 NumMovingActors = 32;
+
+	// Gives up on a step that did not complete in this much real time
+	static const double StepTimeout = 60.0;
+
+	// Replays are recorded in memory so the test does not depend on (or leave anything in) the replay folder
+	static const TCHAR* ReplayName = TEXT("LyraReplayTest");
+	static const TCHAR* StreamerOverride = TEXT("ReplayStreamerOverride=InMemoryNetworkReplayStreaming");
+
+	struct FSeekResult
+	{
+		float TargetTime = 0.0f;
+		float ReachedTime = 0.0f;
+		double Duration = 0.0;
+		bool bWasSuccessful = false;
+	};
+
+	struct FState
+	{
+		TArray<TWeakObjectPtr<AActor>> MovingActors;
+		float RecordStartTime = 0.0f;
+		float PreviousCheckpointInterval = -1.0f;
+
+		double StepStartTime = 0.0;
+		bool bFailed = false;
+
+		TArray<float> SeekTargets;
+		TArray<FSeekResult> SeekResults;
+		bool bSeekInFlight = false;
+		FDelegateHandle SeekCompleteHandle;
+	};
+
+	static UWorld* FindGameWorld()
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			if ((WorldContext.WorldType == EWorldType::Game) && (WorldContext.World() != nullptr))
+			{
+				return WorldContext.World();
+			}
+		}
+		return nullptr;
+	}
+
+	static ULyraReplaySubsystem* FindReplaySubsystem()
+	{
+		UWorld* World = FindGameWorld();
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+		return GameInstance ? GameInstance->GetSubsystem<ULyraReplaySubsystem>() : nullptr;
+	}
+}
+
+// Records a short synthetic replay headlessly (actors moving around an empty map, with frequent checkpoints, into the
+// in-memory replay streamer), plays it back and seeks through it with the replay subsystem, checking that every seek
+// lands on its target and reporting the latency of each (the reproducible version of Lyra.Replay.BenchmarkSeek).
+// Needs a game world, run it with -game -NullRHI
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraReplayRecordAndSeekTest, "Lyra.Replays.RecordAndSeek", EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraReplayRecordAndSeekTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraReplayTests;
+
+	IConsoleVariable* CheckpointIntervalCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds"));
+	if (!TestNotNull(TEXT("Checkpoint interval cvar"), CheckpointIntervalCVar))
+	{
+		return false;
+	}
+
+	TSharedRef<FState> State = MakeShared<FState>();
+	for (const float Fraction : { 0.9f, 0.1f, 0.5f, 0.75f, 0.25f, 0.95f })
+	{
+		State->SeekTargets.Add(RecordDuration * Fraction);
+	}
+
+	// A map without any content, the replay only contains what the test spawns
+	AutomationOpenMap(TEXT("/Engine/Maps/Entry"));
+
+	// Start recording with frequent checkpoints
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, CheckpointIntervalCVar]()
+	{
+		UWorld* World = FindGameWorld();
+		if ((World == nullptr) || (World->GetGameInstance() == nullptr))
+		{
+			AddError(TEXT("No game world to record, run the test with -game"));
+			State->bFailed = true;
+			return true;
+		}
+
+		for (int32 ActorIndex = 0; ActorIndex < NumMovingActors; ++ActorIndex)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+			USceneComponent* RootComponent = NewObject<USceneComponent>(Actor);
+			RootComponent->SetMobility(EComponentMobility::Movable);
+			Actor->SetRootComponent(RootComponent);
+			RootComponent->RegisterComponent();
+
+			Actor->bAlwaysRelevant = true;
+			Actor->SetReplicates(true);
+			Actor->SetReplicateMovement(true);
+			State->MovingActors.Add(Actor);
+		}
+
+		State->PreviousCheckpointInterval = CheckpointIntervalCVar->GetFloat();
+		CheckpointIntervalCVar->Set(CheckpointInterval, ECVF_SetByCode);
+
+		World->GetGameInstance()->StartRecordingReplay(ReplayName, ReplayName, { StreamerOverride });
+		if (World->GetDemoNetDriver() == nullptr)
+		{
+			AddError(TEXT("Failed to start recording the replay"));
+			State->bFailed = true;
+			return true;
+		}
+
+		State->RecordStartTime = World->GetTimeSeconds();
+		return true;
+	}));
+
+	// Move the actors around every frame until the replay is long enough, then stop recording and play it back
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State, CheckpointIntervalCVar]()
+	{
+		UWorld* World = FindGameWorld();
+		if (State->bFailed || (World == nullptr))
+		{
+			return true;
+		}
+
+		const float RecordedTime = World->GetTimeSeconds() - State->RecordStartTime;
+		if (RecordedTime < RecordDuration)
+		{
+			for (int32 ActorIndex = 0; ActorIndex < State->MovingActors.Num(); ++ActorIndex)
+			{
+				if (AActor* Actor = State->MovingActors[ActorIndex].Get())
+				{
+					const float Angle = RecordedTime + (ActorIndex * UE_TWO_PI / NumMovingActors);
+					Actor->SetActorLocation(FVector(FMath::Cos(Angle) * 1000.0f, FMath::Sin(Angle) * 1000.0f, ActorIndex * 10.0f));
+				}
+			}
+			return false;
+		}
+
+		UGameInstance* GameInstance = World->GetGameInstance();
+		GameInstance->StopRecordingReplay();
+		CheckpointIntervalCVar->Set(State->PreviousCheckpointInterval, ECVF_SetByCode);
+
+		State->StepStartTime = FPlatformTime::Seconds();
+		if (!GameInstance->PlayReplay(ReplayName, nullptr, { StreamerOverride }))
+		{
+			AddError(TEXT("Failed to play the recorded replay"));
+			State->bFailed = true;
+		}
+		return true;
+	}));
+
+	// Wait for the playback to start (which loads the recorded map)
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		if (State->bFailed)
+		{
+			return true;
+		}
+
+		UWorld* World = FindGameWorld();
+		UDemoNetDriver* DemoDriver = World ? World->GetDemoNetDriver() : nullptr;
+		if ((DemoDriver != nullptr) && DemoDriver->IsPlaying() && (DemoDriver->GetDemoTotalTime() > 0.0f) && !DemoDriver->IsFastForwarding())
+		{
+			TestTrue(TEXT("Replay length covers the recording"), DemoDriver->GetDemoTotalTime() >= RecordDuration * 0.9f);
+			return true;
+		}
+
+		if ((FPlatformTime::Seconds() - State->StepStartTime) > StepTimeout)
+		{
+			AddError(TEXT("Timed out waiting for the replay to play"));
+			State->bFailed = true;
+			return true;
+		}
+		return false;
+	}));
+
+	// Seek to every target one after the other, waiting for each to complete
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		ULyraReplaySubsystem* ReplaySubsystem = FindReplaySubsystem();
+		if (State->bFailed || (ReplaySubsystem == nullptr))
+		{
+			if (!State->bFailed)
+			{
+				AddError(TEXT("No replay subsystem"));
+				State->bFailed = true;
+			}
+			return true;
+		}
+
+		if (!State->SeekCompleteHandle.IsValid())
+		{
+			State->SeekCompleteHandle = ReplaySubsystem->OnSeekComplete.AddLambda([State, ReplaySubsystem](bool bWasSuccessful, double SeekDurationSeconds)
+			{
+				FSeekResult& Result = State->SeekResults.Last();
+				Result.bWasSuccessful = bWasSuccessful;
+				Result.Duration = SeekDurationSeconds;
+				Result.ReachedTime = ReplaySubsystem->GetReplayCurrentTime();
+				State->bSeekInFlight = false;
+			});
+		}
+
+		if (State->bSeekInFlight)
+		{
+			if ((FPlatformTime::Seconds() - State->StepStartTime) > StepTimeout)
+			{
+				AddError(FString::Printf(TEXT("Timed out seeking to %.1fs"), State->SeekResults.Last().TargetTime));
+				State->bFailed = true;
+				ReplaySubsystem->OnSeekComplete.Remove(State->SeekCompleteHandle);
+				return true;
+			}
+			return false;
+		}
+
+		if (State->SeekResults.Num() == State->SeekTargets.Num())
+		{
+			ReplaySubsystem->OnSeekComplete.Remove(State->SeekCompleteHandle);
+			return true;
+		}
+
+		FSeekResult& Result = State->SeekResults.AddDefaulted_GetRef();
+		Result.TargetTime = State->SeekTargets[State->SeekResults.Num() - 1];
+		State->bSeekInFlight = true;
+		State->StepStartTime = FPlatformTime::Seconds();
+		ReplaySubsystem->SeekInActiveReplay(Result.TargetTime);
+		return false;
+	}));
+
+	// Check and report the seeks, then stop the playback
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, State]()
+	{
+		if (!State->bFailed)
+		{
+			TestEqual(TEXT("Seeks completed"), State->SeekResults.Num(), State->SeekTargets.Num());
+
+			double TotalDuration = 0.0;
+			double WorstDuration = 0.0;
+			for (const FSeekResult& Result : State->SeekResults)
+			{
+				TestTrue(FString::Printf(TEXT("Seek to %.1fs succeeded"), Result.TargetTime), Result.bWasSuccessful);
+				TestEqual(FString::Printf(TEXT("Time reached seeking to %.1fs"), Result.TargetTime), Result.ReachedTime, Result.TargetTime, 0.5f);
+
+				AddInfo(FString::Printf(TEXT("Replay seek to %.1fs: %.1f ms"), Result.TargetTime, Result.Duration * 1000.0));
+				TotalDuration += Result.Duration;
+				WorstDuration = FMath::Max(WorstDuration, Result.Duration);
+			}
+
+			if (State->SeekResults.Num() > 0)
+			{
+				AddInfo(FString::Printf(TEXT("Replay seeks with a checkpoint every %.1fs: average %.1f ms, worst %.1f ms"),
+					CheckpointInterval, (TotalDuration * 1000.0) / State->SeekResults.Num(), WorstDuration * 1000.0));
+			}
+		}
+
+		UWorld* World = FindGameWorld();
+		if (UDemoNetDriver* DemoDriver = World ? World->GetDemoNetDriver() : nullptr)
+		{
+			DemoDriver->StopDemo();
+		}
+		return true;
+	}));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
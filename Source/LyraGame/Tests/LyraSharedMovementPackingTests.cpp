@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/LyraCharacter.h"
+#include "Character/LyraSharedMovementPacking.h"
+#include "Math/RandomStream.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+namespace LyraSharedMovementPackingTests
+{
+	static bool IsSamePackedUpdate(const FSharedRepMovement& A, const FSharedRepMovement& B)
+	{
+		return (A.bPacked == B.bPacked)
+			&& (A.Packed.State == B.Packed.State)
+			&& (A.Packed.ElapsedMs == B.Packed.ElapsedMs)
+			&& (A.Packed.KeyframeId == B.Packed.KeyframeId)
+			&& (A.Packed.bKeyframe == B.Packed.bKeyframe)
+			&& (A.Packed.bLowPrecision == B.Packed.bLowPrecision)
+			&& (A.RepMovementMode == B.RepMovementMode)
+			&& (A.bProxyIsJumpForceApplied == B.bProxyIsJumpForceApplied)
+			&& (A.bIsCrouched == B.bIsCrouched)
+			&& (A.RepTimeStamp == B.RepTimeStamp);
+	}
+}
+
+// Round trips 20000 random packed FastShared movement updates (velocity changes, teleports and precision switches so
+// every path of the format is hit) through the wire format with 10% packet loss, and checks that every bit written is
+// read back, that the clients reconstruct the quantized server state bit for bit from the keyframes they received, and
+// that what they apply quantizes back to exactly what the server packed
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraSharedMovementPackingRoundTripTest, "Lyra.Character.FastSharedMovement.PackingRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraSharedMovementPackingRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraSharedMovementPackingTests;
+
+	const int32 NumUpdates = 20000;
+	const float PacketLoss = 0.1f;
+
+	FRandomStream Random(0x4C797261);
+	FLyraPackedMovementBaseline ServerBaseline;
+	FLyraPackedMovementBaseline ClientBaseline;
+
+	FVector Location(0.0, 0.0, 100.0);
+	FVector Velocity = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	double Time = 0.0;
+
+	int32 NumKeyframes = 0;
+	int32 NumLowPrecision = 0;
+	int32 NumDelivered = 0;
+	int32 NumResolved = 0;
+	int32 NumSerializeMismatches = 0;
+	int32 NumStateMismatches = 0;
+	int32 NumRequantizeMismatches = 0;
+
+	for (int32 Update = 0; Update < NumUpdates; ++Update)
+	{
+		const double DeltaTime = Random.FRandRange(1.0f / 60.0f, 0.1f);
+		Time += DeltaTime;
+		if (Random.FRand() < 0.05f)
+		{
+			Velocity = Random.VRand() * Random.FRandRange(0.0f, 1200.0f);
+		}
+		if (Random.FRand() < 0.002f)
+		{
+			Location = Random.VRand() * Random.FRandRange(0.0f, 2000000.0f);
+		}
+		Location += (Velocity * DeltaTime) + (Random.VRand() * Random.FRandRange(0.0f, 2.0f));
+		Rotation.Yaw = FRotator::NormalizeAxis(Rotation.Yaw + Random.FRandRange(-20.0f, 20.0f));
+		Rotation.Pitch = (Random.FRand() < 0.1f) ? Random.FRandRange(-90.0f, 90.0f) : 0.0f;
+
+		const bool bLowPrecision = ServerBaseline.WantsKeyframe(Time) ? (Random.FRand() < 0.3f) : ServerBaseline.IsLowPrecision();
+
+		FSharedRepMovement Sent;
+		Sent.RepMovement.Location = Location;
+		Sent.RepMovement.Rotation = Rotation;
+		Sent.RepMovement.LinearVelocity = Velocity;
+		Sent.RepMovementMode = (uint8)Random.RandRange(0, 5);
+		Sent.bProxyIsJumpForceApplied = Random.FRand() < 0.1f;
+		Sent.bIsCrouched = Random.FRand() < 0.2f;
+		Sent.RepTimeStamp = (Random.FRand() < 0.5f) ? (float)Time : 0.0f;
+		Sent.PackAgainst(ServerBaseline, bLowPrecision, Time);
+		ServerBaseline.OnPackedSent(Sent.Packed, Sent.QuantizedState, Time);
+		NumKeyframes += Sent.Packed.bKeyframe ? 1 : 0;
+		NumLowPrecision += Sent.Packed.bLowPrecision ? 1 : 0;
+
+		// Round trip through the wire format, every bit written has to be read back
+		FBitWriter Writer(0, /*bAllowResize=*/ true);
+		bool bWriteSuccess = true;
+		Sent.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FSharedRepMovement Received;
+		bool bReadSuccess = true;
+		Received.NetSerialize(Reader, nullptr, bReadSuccess);
+
+		if (!bWriteSuccess || !bReadSuccess || Reader.IsError() || (Reader.GetBitsLeft() != 0) || !IsSamePackedUpdate(Sent, Received))
+		{
+			if (NumSerializeMismatches++ == 0)
+			{
+				AddError(FString::Printf(TEXT("Update %d (%s) did not round trip through the wire format: %lld bits written, %lld left unread"),
+					Update, Sent.Packed.bKeyframe ? TEXT("keyframe") : TEXT("delta"), Writer.GetNumBits(), Reader.GetBitsLeft()));
+			}
+		}
+
+		if (Random.FRand() < PacketLoss)
+		{
+			continue;
+		}
+		++NumDelivered;
+
+		FLyraPackedMovementState Resolved;
+		if (ClientBaseline.Unpack(Received.Packed, Time, /*out*/ Resolved))
+		{
+			++NumResolved;
+			if ((Resolved != Sent.QuantizedState) && (NumStateMismatches++ == 0))
+			{
+				AddError(FString::Printf(TEXT("Update %d (%s) resolved to a different state than the server packed"), Update, Sent.Packed.bKeyframe ? TEXT("keyframe") : TEXT("delta")));
+			}
+
+			// What the client applies has to quantize back to exactly what the server packed
+			FVector ResolvedLocation;
+			FRotator ResolvedRotation;
+			FVector ResolvedVelocity;
+			Resolved.Dequantize(Received.Packed.bLowPrecision, /*out*/ ResolvedLocation, /*out*/ ResolvedRotation, /*out*/ ResolvedVelocity);
+			if ((FLyraPackedMovementState::Quantize(ResolvedLocation, ResolvedRotation, ResolvedVelocity, Received.Packed.bLowPrecision) != Sent.QuantizedState) && (NumRequantizeMismatches++ == 0))
+			{
+				AddError(FString::Printf(TEXT("Update %d (%s) does not quantize back to what the server packed"), Update, Sent.Packed.bKeyframe ? TEXT("keyframe") : TEXT("delta")));
+			}
+		}
+	}
+
+	TestEqual(TEXT("Serialization mismatches"), NumSerializeMismatches, 0);
+	TestEqual(TEXT("State mismatches"), NumStateMismatches, 0);
+	TestEqual(TEXT("Requantization mismatches"), NumRequantizeMismatches, 0);
+
+	// Both formats and both precisions were covered, and most deltas found their keyframe
+	TestTrue(TEXT("Keyframes sent"), NumKeyframes > 0);
+	TestTrue(TEXT("Deltas sent"), NumKeyframes < NumUpdates);
+	TestTrue(TEXT("Low precision updates sent"), (NumLowPrecision > 0) && (NumLowPrecision < NumUpdates));
+	TestTrue(TEXT("Delivered updates resolved"), NumResolved > NumDelivered / 2);
+
+	AddInfo(FString::Printf(TEXT("FastShared packing round trip: %d updates (%d keyframes, %d low precision), %d delivered, %d resolved"),
+		NumUpdates, NumKeyframes, NumLowPrecision, NumDelivered, NumResolved));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/Attributes/LyraCombatSet.h"
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "Tests/LyraTestWorld.h"
+
+namespace LyraTestAbilitySystem
+{
+	// Spawns an actor that owns and avatars a Lyra ASC with a health set and a combat set
+	inline ULyraAbilitySystemComponent* SpawnActorWithAbilitySystem(FLyraScopedTestWorld& TestWorld, const FVector& Location = FVector::ZeroVector, float MaxHealth = 100.0f)
+	{
+		AActor* Actor = TestWorld.SpawnActor<AActor>(FTransform(Location));
+
+		// Actors without a root component cannot be placed, and damage falloff needs a location
+		USceneComponent* RootComponent = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+		Actor->SetActorLocation(Location);
+
+		ULyraAbilitySystemComponent* ASC = NewObject<ULyraAbilitySystemComponent>(Actor);
+		ASC->RegisterComponent();
+		ASC->InitAbilityActorInfo(Actor, Actor);
+
+		ASC->AddSpawnedAttribute(NewObject<ULyraHealthSet>(Actor));
+		ASC->AddSpawnedAttribute(NewObject<ULyraCombatSet>(Actor));
+		ASC->SetNumericAttributeBase(ULyraHealthSet::GetMaxHealthAttribute(), MaxHealth);
+		ASC->SetNumericAttributeBase(ULyraHealthSet::GetHealthAttribute(), MaxHealth);
+
+		return ASC;
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
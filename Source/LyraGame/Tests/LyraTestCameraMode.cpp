@@ -0,0 +1,9 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestCameraMode.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestCameraMode)
+
+#endif // WITH_DEV_AUTOMATION_TESTS
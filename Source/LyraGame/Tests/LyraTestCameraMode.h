@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Build.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Camera/LyraCameraMode_ThirdPerson.h"
+
+#include "LyraTestCameraMode.generated.h"
+
+/**
+ * Concrete third person camera mode used by automation tests, the regular one is abstract and only set up in data
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class ULyraTestCameraMode_ThirdPerson : public ULyraCameraMode_ThirdPerson
+{
+	GENERATED_BODY()
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
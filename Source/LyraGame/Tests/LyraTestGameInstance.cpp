@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestGameInstance.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/LocalPlayer.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestGameInstance)
+
+ULyraTestGameInstance::ULyraTestGameInstance(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void ULyraTestGameInstance::SetTestWorldContext(FWorldContext* InWorldContext)
+{
+	WorldContext = InWorldContext;
+}
+
+void ULyraTestGameInstance::AddTestLocalPlayer(ULocalPlayer* LocalPlayer)
+{
+	LocalPlayers.AddUnique(LocalPlayer);
+	OnLocalPlayerAddedEvent.Broadcast(LocalPlayer);
+}
+
+void ULyraTestGameInstance::RemoveTestLocalPlayer(ULocalPlayer* LocalPlayer)
+{
+	if (LocalPlayers.Remove(LocalPlayer) > 0)
+	{
+		OnLocalPlayerRemovedEvent.Broadcast(LocalPlayer);
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
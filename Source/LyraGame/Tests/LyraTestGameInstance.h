@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Build.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/GameInstance.h"
+
+#include "LyraTestGameInstance.generated.h"
+
+class ULocalPlayer;
+class UObject;
+struct FWorldContext;
+
+/**
+ * Game instance used by automation test worlds, which are set up without a game viewport or a map load
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class ULyraTestGameInstance : public UGameInstance
+{
+	GENERATED_BODY()
+
+public:
+	ULyraTestGameInstance(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Binds the game instance to a world context created outside of the usual initialization paths
+	void SetTestWorldContext(FWorldContext* InWorldContext);
+
+	// Adds or removes a local player directly, without going through the (missing) game viewport
+	void AddTestLocalPlayer(ULocalPlayer* LocalPlayer);
+	void RemoveTestLocalPlayer(ULocalPlayer* LocalPlayer);
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Tests/LyraTestGameplayEffects.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/Attributes/LyraCombatSet.h"
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/Executions/LyraDamageExecution.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraTestGameplayEffects)
+
+ULyraTestGameplayEffect_CaptureSourceMaxHealth::ULyraTestGameplayEffect_CaptureSourceMaxHealth(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+	FAttributeBasedFloat SourceMaxHealth;
+	SourceMaxHealth.Coefficient = 1.0f;
+	SourceMaxHealth.BackingAttribute = FGameplayEffectAttributeCaptureDefinition(ULyraHealthSet::GetMaxHealthAttribute(), EGameplayEffectAttributeCaptureSource::Source, /*bSnapshot=*/ true);
+
+	FGameplayModifierInfo& Modifier = Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = ULyraCombatSet::GetBaseHealAttribute();
+	Modifier.ModifierOp = EGameplayModOp::Override;
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(SourceMaxHealth);
+}
+
+ULyraTestGameplayEffect_Damage::ULyraTestGameplayEffect_Damage(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayEffectExecutionDefinition& Execution = Executions.AddDefaulted_GetRef();
+	Execution.CalculationClass = ULyraDamageExecution::StaticClass();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Build.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameplayEffect.h"
+
+#include "LyraTestGameplayEffects.generated.h"
+
+class UObject;
+
+/**
+ * Infinite effect used by automation tests: overrides BaseHeal with the MaxHealth of the effect's source, so the
+ * result depends on the attributes captured from the ASC the spec was made for.
+ */
+UCLASS(HideDropdown, NotBlueprintable)
+class ULyraTestGameplayEffect_CaptureSourceMaxHealth : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	ULyraTestGameplayEffect_CaptureSourceMaxHealth(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+/**
+ * Instant effect used by automation tests: deals damage through ULyraDamageExecution, like the weapon damage effects.
+ */
+UCLASS(HideDropdown, NotBlueprintable)
+class ULyraTestGameplayEffect_Damage : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	ULyraTestGameplayEffect_Damage(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Build.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "LoadingProcessInterface.h"
+#include "UObject/Object.h"
+
+#include "LyraTestLoadingProcessor.generated.h"
+
+/**
+ * Loading processor used by automation tests, wants a loading screen while bWantsLoadingScreen is set and counts how
+ * many times it was asked
+ */
+UCLASS(HideDropdown, NotBlueprintable, Transient)
+class ULyraTestLoadingProcessor : public UObject, public ILoadingProcessInterface
+{
+	GENERATED_BODY()
+
+public:
+	//~ILoadingProcessInterface interface
+	virtual bool ShouldShowLoadingScreen(FString& OutReason) const override
+	{
+		++NumQueries;
+		if (bWantsLoadingScreen)
+		{
+			OutReason = TEXT("Test loading processor");
+			return true;
+		}
+		return false;
+	}
+	//~End of ILoadingProcessInterface
+
+	bool bWantsLoadingScreen = false;
+	mutable int32 NumQueries = 0;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Tests/LyraTestGameInstance.h"
+
+/**
+ * A game world that lives for the scope of an automation test, so tests can spawn actors, register
+ * components and run traces without loading a map. The world has a game instance, so game instance
+ * subsystems (e.g., the gameplay message router) are available.
+ */
+struct FLyraScopedTestWorld
+{
+public:
+	FLyraScopedTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/ false);
+		GameInstance = NewObject<ULyraTestGameInstance>(GEngine);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.OwningGameInstance = GameInstance;
+		WorldContext.SetCurrentWorld(World);
+		GameInstance->SetTestWorldContext(&WorldContext);
+
+		World->SetGameInstance(GameInstance);
+		GameInstance->Init();
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FLyraScopedTestWorld()
+	{
+		GameInstance->Shutdown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(/*bInformEngineOfWorld=*/ false);
+	}
+
+	// Advances the world by one frame, which also completes async traces requested during the previous frame
+	void Tick(float DeltaTime = 1.0f / 60.0f)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+
+	template <typename ActorType>
+	ActorType* SpawnActor(const FTransform& Transform = FTransform::Identity, UClass* Class = ActorType::StaticClass())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return World->SpawnActor<ActorType>(Class, Transform, SpawnParams);
+	}
+
+	UWorld* GetWorld() const { return World; }
+	ULyraTestGameInstance* GetGameInstance() const { return GameInstance; }
+
+private:
+	UWorld* World = nullptr;
+	ULyraTestGameInstance* GameInstance = nullptr;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
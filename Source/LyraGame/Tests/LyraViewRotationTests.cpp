@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameModes/LyraGameState.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Player/LyraPlayerState.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Tests/LyraTestWorld.h"
+
+// Quantizes random view rotations and checks that they come back within half a step of 16 bit precision per axis,
+// normalized and without roll, that they serialize to 32 bits and read back identically, and that the largest axis
+// change between two rotations wraps around like the axes do
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraViewRotationQuantizeTest, "Lyra.Player.ViewRotation.Quantize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraViewRotationQuantizeTest::RunTest(const FString& Parameters)
+{
+	const int32 NumRotations = 10000;
+	const float StepSize = 360.0f / 65536.0f;
+	const float Tolerance = (StepSize * 0.5f) + UE_KINDA_SMALL_NUMBER;
+
+	FRandomStream Random(0x4C797261);
+	float WorstError = 0.0f;
+	bool bErrorReported = false;
+	for (int32 Index = 0; (Index < NumRotations) && !bErrorReported; ++Index)
+	{
+		const FRotator Rotation(Random.FRandRange(-90.0f, 90.0f), Random.FRandRange(-540.0f, 540.0f), Random.FRandRange(-180.0f, 180.0f));
+		const FLyraReplicatedViewRotation Quantized(Rotation);
+		const FRotator Restored = Quantized.ToRotator();
+
+		const float PitchError = FMath::Abs(FRotator::NormalizeAxis(Restored.Pitch - Rotation.Pitch));
+		const float YawError = FMath::Abs(FRotator::NormalizeAxis(Restored.Yaw - Rotation.Yaw));
+		WorstError = FMath::Max3(WorstError, PitchError, YawError);
+
+		FBitWriter Writer(0, /*bAllowResize=*/ true);
+		FLyraReplicatedViewRotation Written = Quantized;
+		bool bWriteSuccess = false;
+		Written.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		FLyraReplicatedViewRotation Read;
+		bool bReadSuccess = false;
+		Read.NetSerialize(Reader, nullptr, bReadSuccess);
+
+		if ((PitchError > Tolerance) || (YawError > Tolerance))
+		{
+			AddError(FString::Printf(TEXT("%s restored as %s"), *Rotation.ToString(), *Restored.ToString()));
+			bErrorReported = true;
+		}
+		else if ((Restored.Roll != 0.0f) || (Restored.Pitch <= -180.0f) || (Restored.Pitch > 180.0f) || (Restored.Yaw <= -180.0f) || (Restored.Yaw > 180.0f))
+		{
+			AddError(FString::Printf(TEXT("%s restored as %s, which is not normalized without roll"), *Rotation.ToString(), *Restored.ToString()));
+			bErrorReported = true;
+		}
+		else if (!bWriteSuccess || !bReadSuccess || (Writer.GetNumBits() != 32) || (Reader.GetBitsLeft() != 0) || (Read != Quantized))
+		{
+			AddError(FString::Printf(TEXT("%s did not round trip through the wire format (%lld bits)"), *Rotation.ToString(), Writer.GetNumBits()));
+			bErrorReported = true;
+		}
+	}
+
+	// Quantizing is stable
+	const FLyraReplicatedViewRotation Quantized(FRotator(12.34f, -56.78f, 0.0f));
+	TestTrue(TEXT("Quantized again"), FLyraReplicatedViewRotation(Quantized.ToRotator()) == Quantized);
+
+	// Either axis, the shortest way around
+	TestEqual(TEXT("Yaw change"), FLyraReplicatedViewRotation(FRotator(0.0f, 10.0f, 0.0f)).GetMaxAxisDelta(FLyraReplicatedViewRotation(FRotator(0.0f, 12.0f, 0.0f))), 2.0f, StepSize);
+	TestEqual(TEXT("Pitch change"), FLyraReplicatedViewRotation(FRotator(-5.0f, 0.0f, 0.0f)).GetMaxAxisDelta(FLyraReplicatedViewRotation(FRotator(5.0f, 1.0f, 0.0f))), 10.0f, StepSize);
+	TestEqual(TEXT("Yaw change across 180"), FLyraReplicatedViewRotation(FRotator(0.0f, 179.9f, 0.0f)).GetMaxAxisDelta(FLyraReplicatedViewRotation(FRotator(0.0f, -179.9f, 0.0f))), 0.2f, StepSize);
+	TestEqual(TEXT("Roll change"), FLyraReplicatedViewRotation(FRotator(0.0f, 0.0f, 0.0f)).GetMaxAxisDelta(FLyraReplicatedViewRotation(FRotator(0.0f, 0.0f, 45.0f))), 0.0f);
+
+	AddInfo(FString::Printf(TEXT("View rotation quantization of %d rotations: worst error %.5f degrees"), NumRotations, WorstError));
+
+	return true;
+}
+
+// Feeds view rotations to a player state frame by frame and checks that changes above the threshold replicate right
+// away, that smaller ones are held back until they have differed for the settle time, that a slow turn replicates at
+// the settle rate and still ends on the rotation the player stopped at, and that everything replicates unthrottled
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraViewRotationThrottleTest, "Lyra.Player.ViewRotation.ThresholdAndSettle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraViewRotationThrottleTest::RunTest(const FString& Parameters)
+{
+	const float DeltaTime = 1.0f / 60.0f;
+	const float ChangeThreshold = 0.5f;
+	const float SettleTime = 0.2f;
+	const float StepSize = 360.0f / 65536.0f;
+
+	IConsoleVariable* ThrottleCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.ViewRotation.Throttle"));
+	IConsoleVariable* ThresholdCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.ViewRotation.ChangeThreshold"));
+	IConsoleVariable* SettleTimeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.ViewRotation.SettleTime"));
+	if (!TestNotNull(TEXT("Throttle cvar"), ThrottleCVar) || !TestNotNull(TEXT("Change threshold cvar"), ThresholdCVar) || !TestNotNull(TEXT("Settle time cvar"), SettleTimeCVar))
+	{
+		return false;
+	}
+
+	FLyraScopedTestWorld TestWorld;
+
+	// Player states register with the experience of the game state
+	ALyraGameState* GameState = TestWorld.SpawnActor<ALyraGameState>();
+	TestWorld.GetWorld()->SetGameState(GameState);
+	ALyraPlayerState* PlayerState = TestWorld.SpawnActor<ALyraPlayerState>();
+
+	const bool bPreviousThrottle = ThrottleCVar->GetBool();
+	const float PreviousThreshold = ThresholdCVar->GetFloat();
+	const float PreviousSettleTime = SettleTimeCVar->GetFloat();
+	ThrottleCVar->Set(true, ECVF_SetByCode);
+	ThresholdCVar->Set(ChangeThreshold, ECVF_SetByCode);
+	SettleTimeCVar->Set(SettleTime, ECVF_SetByCode);
+
+	auto GetReplicatedYaw = [PlayerState]()
+	{
+		return (float)PlayerState->GetReplicatedViewRotation().Yaw;
+	};
+
+	// Advances the world by Duration, setting Yaw every frame, and returns how many times the replicated rotation changed
+	auto HoldYaw = [&](float Duration, TFunctionRef<float(int32)> GetYaw)
+	{
+		int32 NumChanges = 0;
+		const int32 NumFrames = FMath::CeilToInt(Duration / DeltaTime);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TestWorld.Tick(DeltaTime);
+			const FRotator PreviousRotation = PlayerState->GetReplicatedViewRotation();
+			PlayerState->SetReplicatedViewRotation(FRotator(0.0f, GetYaw(Frame), 0.0f));
+			NumChanges += (PlayerState->GetReplicatedViewRotation() != PreviousRotation) ? 1 : 0;
+		}
+		return NumChanges;
+	};
+
+	// Above the threshold, right away
+	PlayerState->SetReplicatedViewRotation(FRotator(0.0f, 10.0f, 0.0f));
+	TestEqual(TEXT("Yaw after a change above the threshold"), GetReplicatedYaw(), 10.0f, StepSize);
+
+	// Below it, held back until it has differed for the settle time
+	PlayerState->SetReplicatedViewRotation(FRotator(0.0f, 10.2f, 0.0f));
+	TestEqual(TEXT("Yaw right after a change below the threshold"), GetReplicatedYaw(), 10.0f, StepSize);
+	HoldYaw(SettleTime * 0.5f, [](int32) { return 10.3f; });
+	TestEqual(TEXT("Yaw before the change below the threshold settled"), GetReplicatedYaw(), 10.0f, StepSize);
+	HoldYaw(SettleTime * 0.5f + (2.0f * DeltaTime), [](int32) { return 10.3f; });
+	TestEqual(TEXT("Yaw once the change below the threshold settled"), GetReplicatedYaw(), 10.3f, StepSize);
+
+	// A change above the threshold does not wait for a pending one to settle
+	PlayerState->SetReplicatedViewRotation(FRotator(0.0f, 10.5f, 0.0f));
+	PlayerState->SetReplicatedViewRotation(FRotator(0.0f, 20.0f, 0.0f));
+	TestEqual(TEXT("Yaw after a change above the threshold while one is pending"), GetReplicatedYaw(), 20.0f, StepSize);
+
+	// A slow turn (1.2 degrees/s, under the threshold for longer than the settle time) replicates about once per settle time, and ends exactly where it stopped
+	const float TurnDuration = 2.0f;
+	const float TurnRate = 0.02f;
+	const int32 NumTurnFrames = FMath::CeilToInt(TurnDuration / DeltaTime);
+	const int32 NumThrottledChanges = HoldYaw(TurnDuration, [TurnRate](int32 Frame) { return 20.0f + (Frame + 1) * TurnRate; });
+	const float FinalYaw = 20.0f + NumTurnFrames * TurnRate;
+	const int32 MaxExpectedChanges = FMath::CeilToInt(TurnDuration / SettleTime) + 1;
+	TestTrue(FString::Printf(TEXT("Changes during a slow turn (%d) at most one per settle time"), NumThrottledChanges), NumThrottledChanges <= MaxExpectedChanges);
+	TestTrue(FString::Printf(TEXT("Changes during a slow turn (%d) at least one per two settle times"), NumThrottledChanges), NumThrottledChanges >= MaxExpectedChanges / 2);
+
+	HoldYaw(SettleTime + (2.0f * DeltaTime), [FinalYaw](int32) { return FinalYaw; });
+	TestEqual(TEXT("Yaw once the slow turn stopped"), GetReplicatedYaw(), FinalYaw, StepSize);
+
+	// Unthrottled, every change replicates
+	ThrottleCVar->Set(false, ECVF_SetByCode);
+	const int32 NumUnthrottledChanges = HoldYaw(TurnDuration, [FinalYaw, TurnRate](int32 Frame) { return FinalYaw + (Frame + 1) * TurnRate; });
+	TestEqual(TEXT("Changes during a slow turn unthrottled"), NumUnthrottledChanges, NumTurnFrames);
+
+	ThrottleCVar->Set(bPreviousThrottle, ECVF_SetByCode);
+	ThresholdCVar->Set(PreviousThreshold, ECVF_SetByCode);
+	SettleTimeCVar->Set(PreviousSettleTime, ECVF_SetByCode);
+
+	AddInfo(FString::Printf(TEXT("View rotation changes replicated during a %.1f s turn at %.1f degrees/s: %d throttled, %d unthrottled"),
+		TurnDuration, TurnRate / DeltaTime, NumThrottledChanges, NumUnthrottledChanges));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Weapons/LyraRangedWeaponInstance.h"
+
+namespace LyraWeaponHeatCurveTests
+{
+	static void AddCubicKeys(FRichCurve& Curve, std::initializer_list<TPair<float, float>> Keys)
+	{
+		for (const TPair<float, float>& Key : Keys)
+		{
+			const FKeyHandle Handle = Curve.AddKey(Key.Key, Key.Value);
+			Curve.SetKeyInterpMode(Handle, RCIM_Cubic);
+		}
+	}
+
+	static float GetValueRange(const FRichCurve& Curve)
+	{
+		float MinValue;
+		float MaxValue;
+		Curve.GetValueRange(/*out*/ MinValue, /*out*/ MaxValue);
+		return MaxValue - MinValue;
+	}
+}
+
+// Bakes smooth heat curves like the ones weapons use and checks that the lookup tables stay within a small error of
+// evaluating the curves directly, over the heat range and beyond it
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponHeatCurveBakeTest, "Lyra.Weapons.RangedWeapon.HeatCurveBakeError", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraWeaponHeatCurveBakeTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraWeaponHeatCurveTests;
+
+	FRichCurve HeatToHeatPerShot;
+	AddCubicKeys(HeatToHeatPerShot, { { 0.0f, 1.0f }, { 50.0f, 3.0f }, { 100.0f, 0.5f } });
+
+	FRichCurve HeatToCoolDownPerSecond;
+	AddCubicKeys(HeatToCoolDownPerSecond, { { 0.0f, 2.0f }, { 30.0f, 10.0f }, { 100.0f, 25.0f } });
+
+	FRichCurve HeatToSpread;
+	AddCubicKeys(HeatToSpread, { { 0.0f, 0.5f }, { 40.0f, 2.0f }, { 70.0f, 6.0f }, { 100.0f, 8.0f } });
+
+	const float MinHeat = 0.0f;
+	const float MaxHeat = 100.0f;
+
+	FLyraWeaponHeatCurveTables Tables;
+	Tables.Bake(MinHeat, MaxHeat, HeatToHeatPerShot, HeatToCoolDownPerSecond, HeatToSpread);
+
+	// Linear interpolation between 128 samples, allow 0.5% of the range of values of each curve
+	const float RelativeTolerance = 0.005f;
+	const float HeatPerShotTolerance = RelativeTolerance * GetValueRange(HeatToHeatPerShot);
+	const float CoolDownTolerance = RelativeTolerance * GetValueRange(HeatToCoolDownPerSecond);
+	const float SpreadTolerance = RelativeTolerance * GetValueRange(HeatToSpread);
+
+	float MaxHeatPerShotError = 0.0f;
+	float MaxCoolDownError = 0.0f;
+	float MaxSpreadError = 0.0f;
+
+	// Includes heat outside of the baked range, which clamps like the curves do
+	const int32 NumQueries = 2000;
+	const float QueryMinHeat = MinHeat - 10.0f;
+	const float QueryMaxHeat = MaxHeat + 10.0f;
+	for (int32 QueryIndex = 0; QueryIndex <= NumQueries; ++QueryIndex)
+	{
+		const float Heat = FMath::Lerp(QueryMinHeat, QueryMaxHeat, (float)QueryIndex / (float)NumQueries);
+
+		MaxHeatPerShotError = FMath::Max(MaxHeatPerShotError, FMath::Abs(Tables.EvalHeatPerShot(Heat) - HeatToHeatPerShot.Eval(Heat)));
+		MaxCoolDownError = FMath::Max(MaxCoolDownError, FMath::Abs(Tables.EvalCoolDownPerSecond(Heat) - HeatToCoolDownPerSecond.Eval(Heat)));
+		MaxSpreadError = FMath::Max(MaxSpreadError, FMath::Abs(Tables.EvalSpread(Heat) - HeatToSpread.Eval(Heat)));
+	}
+
+	TestTrue(FString::Printf(TEXT("Heat per shot error %f within %f"), MaxHeatPerShotError, HeatPerShotTolerance), MaxHeatPerShotError <= HeatPerShotTolerance);
+	TestTrue(FString::Printf(TEXT("Cool down error %f within %f"), MaxCoolDownError, CoolDownTolerance), MaxCoolDownError <= CoolDownTolerance);
+	TestTrue(FString::Printf(TEXT("Spread error %f within %f"), MaxSpreadError, SpreadTolerance), MaxSpreadError <= SpreadTolerance);
+
+	// The samples themselves are exact
+	TestEqual(TEXT("Spread at the minimum heat"), Tables.EvalSpread(MinHeat), HeatToSpread.Eval(MinHeat));
+	TestEqual(TEXT("Spread at the maximum heat"), Tables.EvalSpread(MaxHeat), HeatToSpread.Eval(MaxHeat));
+
+	float MinSpread;
+	float MaxSpread;
+	HeatToSpread.GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
+	TestEqual(TEXT("Baked min spread"), Tables.MinSpread, MinSpread);
+	TestEqual(TEXT("Baked max spread"), Tables.MaxSpread, MaxSpread);
+
+	return true;
+}
+
+// Checks that weapon instances drop the tables they were using once the shared cache is reset, which happens when
+// curves are edited or classes are reinstanced
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponHeatCurveCacheTest, "Lyra.Weapons.RangedWeapon.HeatCurveCacheReset", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraWeaponHeatCurveCacheTest::RunTest(const FString& Parameters)
+{
+	ULyraRangedWeaponInstance::ResetHeatCurveTableCacheForTesting();
+
+	ULyraRangedWeaponInstance* WeaponInstance = NewObject<ULyraRangedWeaponInstance>();
+	FRichCurve* SpreadCurve = WeaponInstance->GetHeatToSpreadCurveForTesting().GetRichCurve();
+	SpreadCurve->Reset();
+	SpreadCurve->AddKey(0.0f, 1.0f);
+	SpreadCurve->AddKey(10.0f, 2.0f);
+
+	TestEqual(TEXT("Spread before the edit"), WeaponInstance->GetHeatCurveTablesForTesting().EvalSpread(10.0f), 2.0f);
+
+	SpreadCurve->UpdateOrAddKey(10.0f, 5.0f);
+	TestEqual(TEXT("Spread while the old tables are cached"), WeaponInstance->GetHeatCurveTablesForTesting().EvalSpread(10.0f), 2.0f);
+
+	ULyraRangedWeaponInstance::ResetHeatCurveTableCacheForTesting();
+	TestEqual(TEXT("Spread after resetting the cache"), WeaponInstance->GetHeatCurveTablesForTesting().EvalSpread(10.0f), 5.0f);
+
+	// Don't leave tables baked from these test curves behind for the native class
+	ULyraRangedWeaponInstance::ResetHeatCurveTableCacheForTesting();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
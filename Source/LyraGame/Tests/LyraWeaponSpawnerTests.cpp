@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/StaticMeshComponent.h"
+#include "HAL/PlatformTime.h"
+#include "Tests/LyraTestWorld.h"
+#include "TimerManager.h"
+#include "Weapons/LyraWeaponSpawner.h"
+#include "Weapons/LyraWeaponSpawnerSubsystem.h"
+
+// Spawns 200 weapon spawners with half of them cooling down, checks that the batched update drives the same cooldown
+// progress as their respawn timers without any spawner ticking on its own, and reports the game thread cost of the
+// batched update against the per-actor update it replaced
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponSpawnerBatchedUpdateTest, "Lyra.Weapons.Spawners.BatchedUpdate", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraWeaponSpawnerBatchedUpdateTest::RunTest(const FString& Parameters)
+{
+	const int32 NumSpawners = 200;
+	const int32 NumFrames = 300;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// The spawners are not configured with a weapon definition
+	AddExpectedError(TEXT("does not have a valid weapon definition"), EAutomationExpectedErrorFlags::Contains, NumSpawners);
+
+	FLyraScopedTestWorld TestWorld;
+	UWorld* World = TestWorld.GetWorld();
+
+	ULyraWeaponSpawnerSubsystem* Subsystem = World->GetSubsystem<ULyraWeaponSpawnerSubsystem>();
+	if (!TestNotNull(TEXT("Weapon spawner subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	TArray<ALyraWeaponSpawner*> Spawners;
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumSpawners));
+	for (int32 SpawnIndex = 0; SpawnIndex < NumSpawners; ++SpawnIndex)
+	{
+		const FVector Location((SpawnIndex % GridSize) * 300.0f, (SpawnIndex / GridSize) * 300.0f, 0.0f);
+		if (ALyraWeaponSpawner* Spawner = TestWorld.SpawnActor<ALyraWeaponSpawner>(FTransform(Location)))
+		{
+			if ((SpawnIndex % 2) == 0)
+			{
+				Spawner->StartCoolDown();
+			}
+			Spawners.Add(Spawner);
+		}
+	}
+
+	TestEqual(TEXT("Spawned spawners"), Spawners.Num(), NumSpawners);
+	TestEqual(TEXT("Registered spawners"), Subsystem->GetNumSpawners(), NumSpawners);
+
+	for (ALyraWeaponSpawner* Spawner : Spawners)
+	{
+		if (Spawner->PrimaryActorTick.IsTickFunctionEnabled())
+		{
+			AddError(FString::Printf(TEXT("'%s' ticks on its own"), *GetNameSafe(Spawner)));
+			break;
+		}
+	}
+
+	// One second into the cooldown, the batched progress matches the respawn timers
+	for (int32 Frame = 0; Frame < 60; ++Frame)
+	{
+		TestWorld.Tick(DeltaTime);
+	}
+
+	FTimerManager& TimerManager = World->GetTimerManager();
+	for (int32 SpawnIndex = 0; SpawnIndex < Spawners.Num(); ++SpawnIndex)
+	{
+		ALyraWeaponSpawner* Spawner = Spawners[SpawnIndex];
+		if ((SpawnIndex % 2) == 0)
+		{
+			const float TimerPercentage = 1.0f - TimerManager.GetTimerRemaining(Spawner->CoolDownTimerHandle) / Spawner->GetCoolDownTime();
+			TestTrue(TEXT("Cooldown progressed"), Spawner->GetCoolDownPercentage() > 0.0f);
+			TestEqual(TEXT("Cooldown progress matches the respawn timer"), Spawner->GetCoolDownPercentage(), TimerPercentage, 1.0e-3f);
+		}
+		else
+		{
+			TestEqual(TEXT("No cooldown progress while available"), Spawner->GetCoolDownPercentage(), 0.0f);
+		}
+	}
+
+	// Per-actor update, equivalent to what each spawner used to do in its own Tick
+	const double PerActorStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (ALyraWeaponSpawner* Spawner : Spawners)
+		{
+			if (TimerManager.IsTimerActive(Spawner->CoolDownTimerHandle))
+			{
+				volatile float Percentage = 1.0f - TimerManager.GetTimerRemaining(Spawner->CoolDownTimerHandle) / Spawner->GetCoolDownTime();
+			}
+			Spawner->WeaponMesh->AddRelativeRotation(FRotator(0.0f, DeltaTime * Spawner->WeaponMeshRotationSpeed, 0.0f));
+		}
+	}
+	const double PerActorTime = FPlatformTime::Seconds() - PerActorStartTime;
+
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Subsystem->Tick(DeltaTime);
+	}
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	AddInfo(FString::Printf(TEXT("Weapon spawner update with %d spawners: per-actor %.4f ms/frame, batched %.4f ms/frame"),
+		Spawners.Num(), (PerActorTime * 1000.0) / NumFrames, (BatchedTime * 1000.0) / NumFrames));
+
+	// Removing spawners keeps the packed arrays consistent
+	for (int32 SpawnIndex = 0; SpawnIndex < Spawners.Num(); SpawnIndex += 3)
+	{
+		Spawners[SpawnIndex]->Destroy();
+	}
+	TestEqual(TEXT("Registered spawners after destroying a third"), Subsystem->GetNumSpawners(), NumSpawners - ((NumSpawners + 2) / 3));
+	TestWorld.Tick(DeltaTime);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Equipment/LyraEquipmentManagerComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Tests/LyraTestWorld.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
+#include "Weapons/LyraWeaponStateComponent.h"
+
+// Replicates an equipment entry whose instance is not mapped yet, resolves it later and checks that the weapon
+// state component picks the weapon up (and drops it again when the entry is removed)
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponStateLateResolveTest, "Lyra.Weapons.WeaponState.LateResolvedInstance", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraWeaponStateLateResolveTest::RunTest(const FString& Parameters)
+{
+	FLyraScopedTestWorld TestWorld;
+
+	APawn* Pawn = TestWorld.SpawnActor<APawn>();
+	ULyraEquipmentManagerComponent* EquipmentManager = NewObject<ULyraEquipmentManagerComponent>(Pawn);
+	EquipmentManager->RegisterComponent();
+
+	APlayerController* Controller = TestWorld.SpawnActor<APlayerController>();
+	ULyraWeaponStateComponent* WeaponState = NewObject<ULyraWeaponStateComponent>(Controller);
+	WeaponState->RegisterComponent();
+	WeaponState->BindToPawnForTesting(Pawn);
+
+	// The entry arrives before the instance it references
+	const int32 EntryIndex = EquipmentManager->AddReplicatedEntryForTesting();
+	TestNull(TEXT("Weapon before the instance resolved"), WeaponState->GetActiveRangedWeapon());
+
+	ULyraRangedWeaponInstance* Weapon = NewObject<ULyraRangedWeaponInstance>(Pawn);
+	EquipmentManager->ResolveReplicatedEntryForTesting(EntryIndex, Weapon);
+	TestEqual(TEXT("Equipment manager lookup after the instance resolved"), EquipmentManager->GetFirstInstanceOfType<ULyraRangedWeaponInstance>(), Weapon);
+	TestEqual(TEXT("Weapon after the instance resolved"), WeaponState->GetActiveRangedWeapon(), Weapon);
+	TestTrue(TEXT("Weapon state ticks while armed"), WeaponState->IsComponentTickEnabled());
+
+	// A change that does not touch the instance must not equip it twice
+	EquipmentManager->ChangeReplicatedEntryForTesting(EntryIndex);
+	TestEqual(TEXT("Instances of type after an unrelated change"), EquipmentManager->GetEquipmentInstancesOfType(ULyraRangedWeaponInstance::StaticClass()).Num(), 1);
+
+	EquipmentManager->RemoveReplicatedEntryForTesting(EntryIndex);
+	TestNull(TEXT("Weapon after the entry was removed"), WeaponState->GetActiveRangedWeapon());
+	TestFalse(TEXT("Weapon state ticks while unarmed"), WeaponState->IsComponentTickEnabled());
+
+	return true;
+}
+
+// Counts the ticks of the weapon state component of a character and checks that there are none while unarmed or
+// while the equipped weapon is idle, and that firing or moving wakes it up until the weapon settles again
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraWeaponStateDormancyTest, "Lyra.Weapons.WeaponState.Dormancy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FLyraWeaponStateDormancyTest::RunTest(const FString& Parameters)
+{
+	const int32 MaxFramesToSettle = 600;
+	const int32 NumIdleFrames = 120;
+
+	FLyraScopedTestWorld TestWorld;
+
+	// A character hovering in place, whose movement still updates without a controller
+	ACharacter* Character = TestWorld.SpawnActor<ACharacter>();
+	UCharacterMovementComponent* CharacterMovement = Character->GetCharacterMovement();
+	CharacterMovement->bRunPhysicsWithNoController = true;
+	CharacterMovement->SetMovementMode(MOVE_Flying);
+
+	ULyraEquipmentManagerComponent* EquipmentManager = NewObject<ULyraEquipmentManagerComponent>(Character);
+	EquipmentManager->RegisterComponent();
+
+	APlayerController* Controller = TestWorld.SpawnActor<APlayerController>();
+	ULyraWeaponStateComponent* WeaponState = NewObject<ULyraWeaponStateComponent>(Controller);
+	WeaponState->RegisterComponent();
+	WeaponState->BindToPawnForTesting(Character);
+
+	// Ticks the world until the weapon state component disables its tick, returns false if it never does
+	auto TickUntilDormant = [&]()
+	{
+		for (int32 Frame = 0; (Frame < MaxFramesToSettle) && WeaponState->IsComponentTickEnabled(); ++Frame)
+		{
+			TestWorld.Tick();
+		}
+		return !WeaponState->IsComponentTickEnabled();
+	};
+
+	auto TickFrames = [&](int32 NumFrames)
+	{
+		const int32 NumTicksBefore = WeaponState->GetNumTicksForTesting();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TestWorld.Tick();
+		}
+		return WeaponState->GetNumTicksForTesting() - NumTicksBefore;
+	};
+
+	// Unarmed
+	TestFalse(TEXT("Tick enabled while unarmed"), WeaponState->IsComponentTickEnabled());
+	TestEqual(TEXT("Ticks while unarmed"), TickFrames(NumIdleFrames), 0);
+
+	// Armed, ticks until the heat and spread multipliers settle
+	const int32 EntryIndex = EquipmentManager->AddReplicatedEntryForTesting();
+	ULyraRangedWeaponInstance* Weapon = NewObject<ULyraRangedWeaponInstance>(Character);
+	EquipmentManager->ResolveReplicatedEntryForTesting(EntryIndex, Weapon);
+	TestTrue(TEXT("Tick enabled once armed"), WeaponState->IsComponentTickEnabled());
+
+	if (!TestTrue(TEXT("Weapon state goes dormant once the weapon settled"), TickUntilDormant()))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Weapon at steady state"), Weapon->IsAtSteadyState());
+
+	// Idle
+	TestEqual(TEXT("Ticks while idle"), TickFrames(NumIdleFrames), 0);
+
+	// Firing wakes it up
+	Weapon->UpdateFiringTime();
+	Weapon->AddSpread();
+	TestTrue(TEXT("Tick enabled after firing"), WeaponState->IsComponentTickEnabled());
+	TestTrue(TEXT("Ticks after firing"), TickFrames(1) > 0);
+	TestTrue(TEXT("Weapon state goes dormant again after firing"), TickUntilDormant());
+	TestEqual(TEXT("Ticks while idle after firing"), TickFrames(NumIdleFrames), 0);
+
+	// So does moving
+	CharacterMovement->Velocity = FVector(600.0f, 0.0f, 0.0f);
+	TestTrue(TEXT("Ticks after starting to move"), TickFrames(2) > 0);
+
+	// Unarmed again
+	EquipmentManager->RemoveReplicatedEntryForTesting(EntryIndex);
+	TestFalse(TEXT("Tick enabled after unequipping"), WeaponState->IsComponentTickEnabled());
+	TestEqual(TEXT("Ticks after unequipping"), TickFrames(NumIdleFrames), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -43,6 +43,15 @@ void ULyraFrontendStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReas
 	Super::EndPlay(EndPlayReason);
 }
 
+void ULyraFrontendStateComponent::SetShouldShowLoadingScreen(bool bNewShouldShowLoadingScreen)
+{
+	if (bShouldShowLoadingScreen != bNewShouldShowLoadingScreen)
+	{
+		bShouldShowLoadingScreen = bNewShouldShowLoadingScreen;
+		ILoadingProcessInterface::NotifyLoadingStateChanged(this);
+	}
+}
+
 bool ULyraFrontendStateComponent::ShouldShowLoadingScreen(FString& OutReason) const
 {
 	if (bShouldShowLoadingScreen)
@@ -145,13 +154,13 @@ void ULyraFrontendStateComponent::FlowStep_TryShowPressStartScreen(FControlFlowN
 			switch (State)
 			{
 			case EAsyncWidgetLayerState::AfterPush:
-				bShouldShowLoadingScreen = false;
+				SetShouldShowLoadingScreen(false);
 				Screen->OnDeactivated().AddWeakLambda(this, [this, SubFlow]() {
 					SubFlow->ContinueFlow();
 				});
 				break;
 			case EAsyncWidgetLayerState::Canceled:
-				bShouldShowLoadingScreen = false;
+				SetShouldShowLoadingScreen(false);
 				SubFlow->ContinueFlow();
 				return;
 			}
@@ -229,11 +238,11 @@ void ULyraFrontendStateComponent::FlowStep_TryShowMainScreen(FControlFlowNodeRef
 			switch (State)
 			{
 			case EAsyncWidgetLayerState::AfterPush:
-				bShouldShowLoadingScreen = false;
+				SetShouldShowLoadingScreen(false);
 				SubFlow->ContinueFlow();
 				return;
 			case EAsyncWidgetLayerState::Canceled:
-				bShouldShowLoadingScreen = false;
+				SetShouldShowLoadingScreen(false);
 				SubFlow->ContinueFlow();
 				return;
 			}
@@ -49,6 +49,9 @@ private:
 	void FlowStep_TryJoinRequestedSession(FControlFlowNodeRef SubFlow);
 	void FlowStep_TryShowMainScreen(FControlFlowNodeRef SubFlow);
 
+	// Updates bShouldShowLoadingScreen, notifying the loading screen manager if it changed
+	void SetShouldShowLoadingScreen(bool bNewShouldShowLoadingScreen);
+
 	bool bShouldShowLoadingScreen = true;
 
 	UPROPERTY(EditAnywhere, Category = UI)
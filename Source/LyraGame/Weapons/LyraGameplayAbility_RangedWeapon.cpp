@@ -8,8 +8,14 @@
 #include "NativeGameplayTags.h"
 #include "Weapons/LyraWeaponStateComponent.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
 #include "AbilitySystem/LyraGameplayAbilityTargetData_SingleTargetHit.h"
+#include "AbilitySystem/LyraGameplayEffectContext.h"
 #include "DrawDebugHelpers.h"
+#include "LyraGameplayTags.h"
+#include "Physics/PhysicalMaterialWithTags.h"
+#include "System/LyraAssetManager.h"
+#include "System/LyraGameData.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayAbility_RangedWeapon)
 
@@ -535,6 +541,15 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			check(WeaponData);
 			WeaponData->AddSpread();
 
+			if (bApplyBatchedDamage && CurrentActorInfo->IsNetAuthority())
+			{
+				if (const TSubclassOf<UGameplayEffect> DamageEffect = GetBatchedDamageEffect())
+				{
+					const float EffectLevel = (BatchedDamageEffectLevel > 0.0f) ? BatchedDamageEffectLevel : static_cast<float>(GetAbilityLevel());
+					ApplyBatchedDamageToTargets(LocalTargetDataHandle, DamageEffect, EffectLevel);
+				}
+			}
+
 			// Let the blueprint do stuff like apply effects to the targets
 			OnRangedWeaponTargetDataReady(LocalTargetDataHandle);
 		}
@@ -549,6 +564,99 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 	MyAbilityComponent->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
 }
 
+TSubclassOf<UGameplayEffect> ULyraGameplayAbility_RangedWeapon::GetBatchedDamageEffect() const
+{
+	if (BatchedDamageEffect)
+	{
+		return BatchedDamageEffect;
+	}
+
+	return ULyraAssetManager::GetSubclass(ULyraGameData::Get().WeaponDamageGameplayEffect);
+}
+
+void ULyraGameplayAbility_RangedWeapon::ApplyBatchedDamageToTargets(const FGameplayAbilityTargetDataHandle& TargetData, TSubclassOf<UGameplayEffect> DamageEffectClass, float EffectLevel)
+{
+	check(CurrentActorInfo);
+
+	UAbilitySystemComponent* MyAbilityComponent = CurrentActorInfo->AbilitySystemComponent.Get();
+	if ((MyAbilityComponent == nullptr) || (DamageEffectClass == nullptr) || !CurrentActorInfo->IsNetAuthority() || (TargetData.Num() == 0))
+	{
+		return;
+	}
+
+	// Build the spec (and capture the source attributes) once for the whole cartridge
+	const FGameplayEffectSpecHandle BaseSpecHandle = MakeOutgoingGameplayEffectSpec(DamageEffectClass, EffectLevel);
+	if (!BaseSpecHandle.IsValid())
+	{
+		return;
+	}
+
+	ApplyBatchedDamageSpecToTargets(MyAbilityComponent, *BaseSpecHandle.Data.Get(), TargetData, GetWeaponInstance(), CurrentActivationInfo.GetActivationPredictionKey());
+}
+
+void ULyraGameplayAbility_RangedWeapon::ApplyBatchedDamageSpecToTargets(UAbilitySystemComponent* SourceASC, const FGameplayEffectSpec& BaseSpec, const FGameplayAbilityTargetDataHandle& TargetData, const ULyraRangedWeaponInstance* WeaponData, FPredictionKey PredictionKey)
+{
+	check(SourceASC);
+
+	// All hits on the same target are merged together, remembering the first hit for the effect context (cues, hit location, etc...)
+	struct FBatchedTarget
+	{
+		UAbilitySystemComponent* TargetASC = nullptr;
+		const FGameplayAbilityTargetData* FirstHitTargetData = nullptr;
+		float SummedAttenuation = 0.0f;
+	};
+	TArray<FBatchedTarget, TInlineAllocator<8>> BatchedTargets;
+
+	for (int32 DataIndex = 0; DataIndex < TargetData.Num(); ++DataIndex)
+	{
+		const FGameplayAbilityTargetData* Data = TargetData.Get(DataIndex);
+		const FHitResult* Hit = Data ? Data->GetHitResult() : nullptr;
+		AActor* HitActor = Hit ? Hit->HitObjectHandle.FetchActor() : nullptr;
+		UAbilitySystemComponent* TargetASC = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor);
+		if (TargetASC == nullptr)
+		{
+			continue;
+		}
+
+		// Same rules as ULyraDamageExecution for a single hit, with the distance measured from the trace start
+		float HitAttenuation = 1.0f;
+		if (WeaponData != nullptr)
+		{
+			const float DistanceAttenuation = FMath::Max(WeaponData->GetDistanceAttenuation(FVector::Dist(Hit->TraceStart, Hit->ImpactPoint)), 0.0f);
+			const float PhysicalMaterialAttenuation = Hit->PhysMaterial.IsValid() ? WeaponData->GetPhysicalMaterialAttenuation(Hit->PhysMaterial.Get()) : 1.0f;
+			HitAttenuation = FMath::Max(DistanceAttenuation * PhysicalMaterialAttenuation, 0.0f);
+		}
+
+		FBatchedTarget* BatchedTarget = BatchedTargets.FindByPredicate([TargetASC](const FBatchedTarget& Entry) { return Entry.TargetASC == TargetASC; });
+		if (BatchedTarget == nullptr)
+		{
+			BatchedTarget = &BatchedTargets.AddDefaulted_GetRef();
+			BatchedTarget->TargetASC = TargetASC;
+			BatchedTarget->FirstHitTargetData = Data;
+		}
+		BatchedTarget->SummedAttenuation += HitAttenuation;
+	}
+
+	for (const FBatchedTarget& BatchedTarget : BatchedTargets)
+	{
+		FGameplayEffectSpec TargetSpec(BaseSpec);
+
+		FGameplayEffectContextHandle TargetContext = TargetSpec.GetContext().Duplicate();
+		BatchedTarget.FirstHitTargetData->AddTargetDataToContext(TargetContext, /*bIncludeActorArray=*/ false);
+		TargetSpec.SetContext(TargetContext, /*bSkipRecaptureSourceActorTags=*/ true);
+
+		const FHitResult* FirstHit = BatchedTarget.FirstHitTargetData->GetHitResult();
+		if (const UPhysicalMaterialWithTags* PhysMatWithTags = Cast<const UPhysicalMaterialWithTags>(FirstHit->PhysMaterial.Get()))
+		{
+			TargetSpec.CapturedTargetTags.GetSpecTags().AppendTags(PhysMatWithTags->Tags);
+		}
+
+		TargetSpec.SetSetByCallerMagnitude(LyraGameplayTags::SetByCaller_DamageAttenuation, BatchedTarget.SummedAttenuation);
+
+		SourceASC->ApplyGameplayEffectSpecToTarget(TargetSpec, BatchedTarget.TargetASC, PredictionKey);
+	}
+}
+
 void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 {
 	check(CurrentActorInfo);
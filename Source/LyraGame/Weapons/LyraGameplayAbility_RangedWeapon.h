@@ -9,11 +9,14 @@
 enum ECollisionChannel : int;
 
 class APawn;
+class UAbilitySystemComponent;
+class UGameplayEffect;
 class ULyraRangedWeaponInstance;
 class UObject;
 struct FCollisionQueryParams;
 struct FFrame;
 struct FGameplayAbilityActorInfo;
+struct FGameplayEffectSpec;
 struct FGameplayEventData;
 struct FGameplayTag;
 struct FGameplayTagContainer;
@@ -61,6 +64,10 @@ public:
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 	//~End of UGameplayAbility interface
 
+	// Applies a copy of BaseSpec to every target in the target data, with the attenuation of all the hits on that target
+	// summed up (the batching part of ApplyBatchedDamageToTargets)
+	static void ApplyBatchedDamageSpecToTargets(UAbilitySystemComponent* SourceASC, const FGameplayEffectSpec& BaseSpec, const FGameplayAbilityTargetDataHandle& TargetData, const ULyraRangedWeaponInstance* WeaponData, FPredictionKey PredictionKey = FPredictionKey());
+
 protected:
 	struct FRangedWeaponFiringInput
 	{
@@ -118,6 +125,31 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnRangedWeaponTargetDataReady(const FGameplayAbilityTargetDataHandle& TargetData);
 
+	// Applies a damage effect to every target in the target data, resolving all the hits of a cartridge together:
+	// the source attributes are captured once, the attenuation of every hit is computed up front and summed per target,
+	// and each target receives a single effect (see SetByCaller.DamageAttenuation in ULyraDamageExecution)
+	// instead of one effect per hit
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Lyra|Ability")
+	void ApplyBatchedDamageToTargets(const FGameplayAbilityTargetDataHandle& TargetData, TSubclassOf<UGameplayEffect> DamageEffectClass, float EffectLevel = 1.0f);
+
+	// Returns the damage effect applied to the targets of every fired cartridge, BatchedDamageEffect or the
+	// weapon damage effect of the game data when it is not set
+	TSubclassOf<UGameplayEffect> GetBatchedDamageEffect() const;
+
+protected:
+	// Should the damage effect be applied to the targets of every fired cartridge with ApplyBatchedDamageToTargets,
+	// before OnRangedWeaponTargetDataReady is called? Disable this if the blueprint applies damage itself.
+	UPROPERTY(EditDefaultsOnly, Category="Lyra|Damage")
+	bool bApplyBatchedDamage = true;
+
+	// Damage effect applied when bApplyBatchedDamage is set, the weapon damage effect of the game data is used when this is empty
+	UPROPERTY(EditDefaultsOnly, Category="Lyra|Damage", meta=(EditCondition="bApplyBatchedDamage"))
+	TSubclassOf<UGameplayEffect> BatchedDamageEffect;
+
+	// Level of the BatchedDamageEffect, the ability level is used when this is zero or less
+	UPROPERTY(EditDefaultsOnly, Category="Lyra|Damage", meta=(EditCondition="bApplyBatchedDamage"))
+	float BatchedDamageEffectLevel = 0.0f;
+
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
 };
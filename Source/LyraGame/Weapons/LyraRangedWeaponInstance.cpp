@@ -6,12 +6,67 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Camera/LyraCameraComponent.h"
 #include "Physics/PhysicalMaterialWithTags.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
 #include "Weapons/LyraWeaponInstance.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraRangedWeaponInstance)
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Weapon_SteadyAimingCamera, "Lyra.Weapon.SteadyAimingCamera");
 
+namespace LyraWeaponHeatCurveCache
+{
+	// Baked heat curves per weapon instance class, instances only differ from their class defaults at runtime in their current state
+	static TMap<FObjectKey, TSharedPtr<const FLyraWeaponHeatCurveTables>> TablesByClass;
+
+	// Bumped every time the cache is reset, so instances holding on to tables from before pick up the new ones
+	static uint32 Generation = 1;
+
+#if WITH_EDITOR
+	// Blueprint compiles and live coding reinstance classes, which leaves entries for the old classes behind
+	// and changes the curves of the new ones
+	static void RegisterReinstancingCallback()
+	{
+		static FDelegateHandle ReinstancedHandle;
+		if (!ReinstancedHandle.IsValid())
+		{
+			ReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+			{
+				if (TablesByClass.Num() > 0)
+				{
+					TablesByClass.Reset();
+					++Generation;
+				}
+			});
+		}
+	}
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraWeaponHeatCurveTables
+
+void FLyraWeaponHeatCurveTables::Bake(float InMinHeat, float InMaxHeat, const FRichCurve& HeatToHeatPerShotCurve, const FRichCurve& HeatToCoolDownPerSecondCurve, const FRichCurve& HeatToSpreadCurve)
+{
+	MinHeat = InMinHeat;
+	MaxHeat = InMaxHeat;
+	HeatToSpreadCurve.GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
+
+	const float HeatStep = (MaxHeat - MinHeat) / (float)(NumSamples - 1);
+	SamplesPerHeat = (HeatStep > UE_SMALL_NUMBER) ? (1.0f / HeatStep) : 0.0f;
+
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const float Heat = MinHeat + (HeatStep * (float)Index);
+		HeatToHeatPerShot[Index] = HeatToHeatPerShotCurve.Eval(Heat);
+		HeatToCoolDownPerSecond[Index] = HeatToCoolDownPerSecondCurve.Eval(Heat);
+		HeatToSpread[Index] = HeatToSpreadCurve.Eval(Heat);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraRangedWeaponInstance
+
 ULyraRangedWeaponInstance::ULyraRangedWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -32,6 +87,10 @@ void ULyraRangedWeaponInstance::PostLoad()
 void ULyraRangedWeaponInstance::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The curves may have changed, rebake them next time they are needed (for subclasses as well, which may inherit them)
+	ResetHeatCurveTableCache();
+
 	UpdateDebugVisualization();
 }
 
@@ -49,20 +108,24 @@ void ULyraRangedWeaponInstance::OnEquipped()
 {
 	Super::OnEquipped();
 
+	const FLyraWeaponHeatCurveTables& Tables = GetHeatCurveTables();
+
 	// Start heat in the middle
-	float MinHeatRange;
-	float MaxHeatRange;
-	ComputeHeatRange(/*out*/ MinHeatRange, /*out*/ MaxHeatRange);
-	CurrentHeat = (MinHeatRange + MaxHeatRange) * 0.5f;
+	CurrentHeat = (Tables.MinHeat + Tables.MaxHeat) * 0.5f;
 
 	// Derive spread
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = Tables.EvalSpread(CurrentHeat);
+	bSpreadAtSteadyState = false;
 
 	// Default the multipliers to 1x
 	CurrentSpreadAngleMultiplier = 1.0f;
 	StandingStillMultiplier = 1.0f;
 	JumpFallMultiplier = 1.0f;
 	CrouchingMultiplier = 1.0f;
+	AimingMultiplier = 1.0f;
+	bMultipliersAtSteadyState = false;
+
+	OnLeftSteadyState.Broadcast();
 }
 
 void ULyraRangedWeaponInstance::OnUnequipped()
@@ -108,14 +171,56 @@ void ULyraRangedWeaponInstance::ComputeSpreadRange(float& MinSpread, float& MaxS
 	HeatToSpreadCurve.GetRichCurveConst()->GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 }
 
+void ULyraRangedWeaponInstance::ResetHeatCurveTableCache()
+{
+	LyraWeaponHeatCurveCache::TablesByClass.Reset();
+	++LyraWeaponHeatCurveCache::Generation;
+}
+
+const FLyraWeaponHeatCurveTables& ULyraRangedWeaponInstance::GetHeatCurveTables()
+{
+	if (!HeatCurveTables.IsValid() || (HeatCurveTablesGeneration != LyraWeaponHeatCurveCache::Generation))
+	{
+#if WITH_EDITOR
+		LyraWeaponHeatCurveCache::RegisterReinstancingCallback();
+#endif
+
+		TSharedPtr<const FLyraWeaponHeatCurveTables>& CachedTables = LyraWeaponHeatCurveCache::TablesByClass.FindOrAdd(FObjectKey(GetClass()));
+		if (!CachedTables.IsValid())
+		{
+			float MinHeat;
+			float MaxHeat;
+			ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
+
+			TSharedRef<FLyraWeaponHeatCurveTables> NewTables = MakeShared<FLyraWeaponHeatCurveTables>();
+			NewTables->Bake(MinHeat, MaxHeat, *HeatToHeatPerShotCurve.GetRichCurveConst(), *HeatToCoolDownPerSecondCurve.GetRichCurveConst(), *HeatToSpreadCurve.GetRichCurveConst());
+			CachedTables = NewTables;
+		}
+
+		HeatCurveTables = CachedTables;
+		HeatCurveTablesGeneration = LyraWeaponHeatCurveCache::Generation;
+	}
+
+	return *HeatCurveTables;
+}
+
 void ULyraRangedWeaponInstance::AddSpread()
 {
+	const FLyraWeaponHeatCurveTables& Tables = GetHeatCurveTables();
+
 	// Sample the heat up curve
-	const float HeatPerShot = HeatToHeatPerShotCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	const float HeatPerShot = Tables.EvalHeatPerShot(CurrentHeat);
 	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot);
 
 	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = Tables.EvalSpread(CurrentHeat);
+
+	const bool bWasAtSteadyState = IsAtSteadyState();
+	bSpreadAtSteadyState = false;
+	if (bWasAtSteadyState)
+	{
+		OnLeftSteadyState.Broadcast();
+	}
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
@@ -147,50 +252,48 @@ float ULyraRangedWeaponInstance::GetPhysicalMaterialAttenuation(const UPhysicalM
 
 bool ULyraRangedWeaponInstance::UpdateSpread(float DeltaSeconds)
 {
+	// Once fully cooled down nothing changes until the weapon is fired again (see AddSpread)
+	if (bSpreadAtSteadyState)
+	{
+		return bSpreadAtMin;
+	}
+
+	const FLyraWeaponHeatCurveTables& Tables = GetHeatCurveTables();
 	const float TimeSinceFired = GetWorld()->TimeSince(LastFireTime);
 
 	if (TimeSinceFired > SpreadRecoveryCooldownDelay)
 	{
-		const float CooldownRate = HeatToCoolDownPerSecondCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		const float CooldownRate = Tables.EvalCoolDownPerSecond(CurrentHeat);
 		CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds));
-		CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		CurrentSpreadAngle = Tables.EvalSpread(CurrentHeat);
+
+		bSpreadAtSteadyState = (CurrentHeat <= Tables.MinHeat) && (CooldownRate >= 0.0f);
 	}
-	
-	float MinSpread;
-	float MaxSpread;
-	ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 
-	return FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
+	bSpreadAtMin = FMath::IsNearlyEqual(CurrentSpreadAngle, Tables.MinSpread, KINDA_SMALL_NUMBER);
+	return bSpreadAtMin;
 }
 
-bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
+void ULyraRangedWeaponInstance::ComputeMultiplierTargets(float& OutMovementTargetValue, float& OutCrouchingTargetValue, float& OutJumpFallTargetValue, float& OutAimingMultiplier) const
 {
-	const float MultiplierNearlyEqualThreshold = 0.05f;
-
 	APawn* Pawn = GetPawn();
 	check(Pawn != nullptr);
 	UCharacterMovementComponent* CharMovementComp = Cast<UCharacterMovementComponent>(Pawn->GetMovementComponent());
 
 	// See if we are standing still, and if so, smoothly apply the bonus
 	const float PawnSpeed = Pawn->GetVelocity().Size();
-	const float MovementTargetValue = FMath::GetMappedRangeValueClamped(
+	OutMovementTargetValue = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(StandingStillSpeedThreshold, StandingStillSpeedThreshold + StandingStillToMovingSpeedRange),
 		/*OutputRange=*/ FVector2D(SpreadAngleMultiplier_StandingStill, 1.0f),
 		/*Alpha=*/ PawnSpeed);
-	StandingStillMultiplier = FMath::FInterpTo(StandingStillMultiplier, MovementTargetValue, DeltaSeconds, TransitionRate_StandingStill);
-	const bool bStandingStillMultiplierAtMin = FMath::IsNearlyEqual(StandingStillMultiplier, SpreadAngleMultiplier_StandingStill, SpreadAngleMultiplier_StandingStill*0.1f);
 
 	// See if we are crouching, and if so, smoothly apply the bonus
 	const bool bIsCrouching = (CharMovementComp != nullptr) && CharMovementComp->IsCrouching();
-	const float CrouchingTargetValue = bIsCrouching ? SpreadAngleMultiplier_Crouching : 1.0f;
-	CrouchingMultiplier = FMath::FInterpTo(CrouchingMultiplier, CrouchingTargetValue, DeltaSeconds, TransitionRate_Crouching);
-	const bool bCrouchingMultiplierAtTarget = FMath::IsNearlyEqual(CrouchingMultiplier, CrouchingTargetValue, MultiplierNearlyEqualThreshold);
+	OutCrouchingTargetValue = bIsCrouching ? SpreadAngleMultiplier_Crouching : 1.0f;
 
 	// See if we are in the air (jumping/falling), and if so, smoothly apply the penalty
 	const bool bIsJumpingOrFalling = (CharMovementComp != nullptr) && CharMovementComp->IsFalling();
-	const float JumpFallTargetValue = bIsJumpingOrFalling ? SpreadAngleMultiplier_JumpingOrFalling : 1.0f;
-	JumpFallMultiplier = FMath::FInterpTo(JumpFallMultiplier, JumpFallTargetValue, DeltaSeconds, TransitionRate_JumpingOrFalling);
-	const bool bJumpFallMultiplerIs1 = FMath::IsNearlyEqual(JumpFallMultiplier, 1.0f, MultiplierNearlyEqualThreshold);
+	OutJumpFallTargetValue = bIsJumpingOrFalling ? SpreadAngleMultiplier_JumpingOrFalling : 1.0f;
 
 	// Determine if we are aiming down sights, and apply the bonus based on how far into the camera transition we are
 	float AimingAlpha = 0.0f;
@@ -202,17 +305,74 @@ bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
 
 		AimingAlpha = (TopCameraTag == TAG_Lyra_Weapon_SteadyAimingCamera) ? TopCameraWeight : 0.0f;
 	}
-	const float AimingMultiplier = FMath::GetMappedRangeValueClamped(
+	OutAimingMultiplier = FMath::GetMappedRangeValueClamped(
 		/*InputRange=*/ FVector2D(0.0f, 1.0f),
 		/*OutputRange=*/ FVector2D(1.0f, SpreadAngleMultiplier_Aiming),
 		/*Alpha=*/ AimingAlpha);
+}
+
+bool ULyraRangedWeaponInstance::HaveMultiplierTargetsChanged() const
+{
+	float MovementTargetValue;
+	float CrouchingTargetValue;
+	float JumpFallTargetValue;
+	float NewAimingMultiplier;
+	ComputeMultiplierTargets(/*out*/ MovementTargetValue, /*out*/ CrouchingTargetValue, /*out*/ JumpFallTargetValue, /*out*/ NewAimingMultiplier);
+
+	return (MovementTargetValue != LastMovementTargetValue) ||
+		(CrouchingTargetValue != LastCrouchingTargetValue) ||
+		(JumpFallTargetValue != LastJumpFallTargetValue) ||
+		(NewAimingMultiplier != AimingMultiplier);
+}
+
+bool ULyraRangedWeaponInstance::UpdateMultipliers(float DeltaSeconds)
+{
+	const float MultiplierNearlyEqualThreshold = 0.05f;
+
+	float MovementTargetValue;
+	float CrouchingTargetValue;
+	float JumpFallTargetValue;
+	float NewAimingMultiplier;
+	ComputeMultiplierTargets(/*out*/ MovementTargetValue, /*out*/ CrouchingTargetValue, /*out*/ JumpFallTargetValue, /*out*/ NewAimingMultiplier);
+
+	// If every multiplier already reached its target and none of the targets moved, the result is the same as last time
+	if (bMultipliersAtSteadyState &&
+		(MovementTargetValue == LastMovementTargetValue) &&
+		(CrouchingTargetValue == LastCrouchingTargetValue) &&
+		(JumpFallTargetValue == LastJumpFallTargetValue) &&
+		(NewAimingMultiplier == AimingMultiplier))
+	{
+		return bMultipliersAtMin;
+	}
+
+	LastMovementTargetValue = MovementTargetValue;
+	LastCrouchingTargetValue = CrouchingTargetValue;
+	LastJumpFallTargetValue = JumpFallTargetValue;
+	AimingMultiplier = NewAimingMultiplier;
+
+	StandingStillMultiplier = FMath::FInterpTo(StandingStillMultiplier, MovementTargetValue, DeltaSeconds, TransitionRate_StandingStill);
+	const bool bStandingStillMultiplierAtMin = FMath::IsNearlyEqual(StandingStillMultiplier, SpreadAngleMultiplier_StandingStill, SpreadAngleMultiplier_StandingStill*0.1f);
+
+	CrouchingMultiplier = FMath::FInterpTo(CrouchingMultiplier, CrouchingTargetValue, DeltaSeconds, TransitionRate_Crouching);
+	const bool bCrouchingMultiplierAtTarget = FMath::IsNearlyEqual(CrouchingMultiplier, CrouchingTargetValue, MultiplierNearlyEqualThreshold);
+
+	JumpFallMultiplier = FMath::FInterpTo(JumpFallMultiplier, JumpFallTargetValue, DeltaSeconds, TransitionRate_JumpingOrFalling);
+	const bool bJumpFallMultiplerIs1 = FMath::IsNearlyEqual(JumpFallMultiplier, 1.0f, MultiplierNearlyEqualThreshold);
+
 	const bool bAimingMultiplierAtTarget = FMath::IsNearlyEqual(AimingMultiplier, SpreadAngleMultiplier_Aiming, KINDA_SMALL_NUMBER);
 
 	// Combine all the multipliers
 	const float CombinedMultiplier = AimingMultiplier * StandingStillMultiplier * CrouchingMultiplier * JumpFallMultiplier;
 	CurrentSpreadAngleMultiplier = CombinedMultiplier;
 
+	// FInterpTo snaps exactly onto the target once close enough, after which the multipliers stop changing
+	bMultipliersAtSteadyState =
+		(StandingStillMultiplier == MovementTargetValue) &&
+		(CrouchingMultiplier == CrouchingTargetValue) &&
+		(JumpFallMultiplier == JumpFallTargetValue);
+
 	// need to handle these spread multipliers indicating we are not at min spread
-	return bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 && bAimingMultiplierAtTarget;
+	bMultipliersAtMin = bStandingStillMultiplierAtMin && bCrouchingMultiplierAtTarget && bJumpFallMultiplerIs1 && bAimingMultiplierAtTarget;
+	return bMultipliersAtMin;
 }
 
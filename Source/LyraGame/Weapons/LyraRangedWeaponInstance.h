@@ -11,6 +11,41 @@
 
 class UPhysicalMaterial;
 
+/**
+ * FLyraWeaponHeatCurveTables
+ *
+ * The heat curves of a ranged weapon baked into uniformly sampled lookup tables over the weapon's heat range,
+ * evaluated with linear interpolation. Shared by all the instances of the same weapon instance class.
+ */
+struct FLyraWeaponHeatCurveTables
+{
+	static constexpr int32 NumSamples = 128;
+
+	void Bake(float InMinHeat, float InMaxHeat, const FRichCurve& HeatToHeatPerShotCurve, const FRichCurve& HeatToCoolDownPerSecondCurve, const FRichCurve& HeatToSpreadCurve);
+
+	float EvalHeatPerShot(float Heat) const { return Sample(HeatToHeatPerShot, Heat); }
+	float EvalCoolDownPerSecond(float Heat) const { return Sample(HeatToCoolDownPerSecond, Heat); }
+	float EvalSpread(float Heat) const { return Sample(HeatToSpread, Heat); }
+
+	float MinHeat = 0.0f;
+	float MaxHeat = 0.0f;
+	float MinSpread = 0.0f;
+	float MaxSpread = 0.0f;
+
+private:
+	float Sample(const float (&Table)[NumSamples], float Heat) const
+	{
+		const float Position = FMath::Clamp((Heat - MinHeat) * SamplesPerHeat, 0.0f, (float)(NumSamples - 1));
+		const int32 Index = FMath::Min((int32)Position, NumSamples - 2);
+		return FMath::Lerp(Table[Index], Table[Index + 1], Position - (float)Index);
+	}
+
+	float SamplesPerHeat = 0.0f;
+	float HeatToHeatPerShot[NumSamples] = {};
+	float HeatToCoolDownPerSecond[NumSamples] = {};
+	float HeatToSpread[NumSamples] = {};
+};
+
 /**
  * ULyraRangedWeaponInstance
  *
@@ -214,9 +249,48 @@ private:
 	// The current crouching multiplier
 	float CrouchingMultiplier = 1.0f;
 
+	// The aiming multiplier used last update
+	float AimingMultiplier = 1.0f;
+
+	// Targets the multipliers were interpolating towards last update
+	float LastMovementTargetValue = -1.0f;
+	float LastCrouchingTargetValue = -1.0f;
+	float LastJumpFallTargetValue = -1.0f;
+
+	// Is the heat at its minimum and can no longer change until the weapon is fired again?
+	bool bSpreadAtSteadyState = false;
+
+	// Result of UpdateSpread while at steady state
+	bool bSpreadAtMin = false;
+
+	// Have the multipliers reached their targets (which have not changed since)?
+	bool bMultipliersAtSteadyState = false;
+
+	// Result of UpdateMultipliers while at steady state
+	bool bMultipliersAtMin = false;
+
+	// Baked heat curves, shared with the other instances of this class
+	TSharedPtr<const FLyraWeaponHeatCurveTables> HeatCurveTables;
+
+	// Generation of the shared cache HeatCurveTables came from, they are picked up again once the cache is reset
+	uint32 HeatCurveTablesGeneration = 0;
+
 public:
 	void Tick(float DeltaSeconds);
 
+	// Returns true once Tick can no longer change the heat, spread or multipliers until the weapon is fired again
+	// or the targets of the multipliers move (see HaveMultiplierTargetsChanged)
+	bool IsAtSteadyState() const
+	{
+		return bSpreadAtSteadyState && bMultipliersAtSteadyState;
+	}
+
+	// Returns true if the pawn's movement, stance or aim changed the targets the multipliers interpolate towards since the last Tick
+	bool HaveMultiplierTargetsChanged() const;
+
+	// Broadcast when the weapon leaves its steady state outside of Tick (e.g., when fired or equipped)
+	FSimpleMulticastDelegate OnLeftSteadyState;
+
 	//~ULyraEquipmentInstance interface
 	virtual void OnEquipped();
 	virtual void OnUnequipped();
@@ -229,22 +303,39 @@ public:
 	virtual float GetPhysicalMaterialAttenuation(const UPhysicalMaterial* PhysicalMaterial, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr) const override;
 	//~End of ILyraAbilitySourceInterface interface
 
+#if WITH_DEV_AUTOMATION_TESTS
+	// Lets tests configure the damage falloff and material multipliers of a weapon without a data asset
+	FRuntimeFloatCurve& GetDistanceDamageFalloffForTesting() { return DistanceDamageFalloff; }
+	TMap<FGameplayTag, float>& GetMaterialDamageMultiplierForTesting() { return MaterialDamageMultiplier; }
+
+	// Lets tests edit the spread curve and check which baked tables the instance picks up
+	FRuntimeFloatCurve& GetHeatToSpreadCurveForTesting() { return HeatToSpreadCurve; }
+	const FLyraWeaponHeatCurveTables& GetHeatCurveTablesForTesting() { return GetHeatCurveTables(); }
+	static void ResetHeatCurveTableCacheForTesting() { ResetHeatCurveTableCache(); }
+#endif
+
 private:
+	// Drops the baked heat curves of every class, e.g. after curves were edited or classes were reinstanced
+	static void ResetHeatCurveTableCache();
+
 	void ComputeSpreadRange(float& MinSpread, float& MaxSpread);
 	void ComputeHeatRange(float& MinHeat, float& MaxHeat);
 
+	// Returns the baked heat curves, baking them (or picking them up from the shared cache) if needed
+	const FLyraWeaponHeatCurveTables& GetHeatCurveTables();
+
 	inline float ClampHeat(float NewHeat)
 	{
-		float MinHeat;
-		float MaxHeat;
-		ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
-
-		return FMath::Clamp(NewHeat, MinHeat, MaxHeat);
+		const FLyraWeaponHeatCurveTables& Tables = GetHeatCurveTables();
+		return FMath::Clamp(NewHeat, Tables.MinHeat, Tables.MaxHeat);
 	}
 
 	// Updates the spread and returns true if the spread is at minimum
 	bool UpdateSpread(float DeltaSeconds);
 
+	// Computes the values the multipliers interpolate towards, from the pawn's current movement, stance and aim
+	void ComputeMultiplierTargets(float& OutMovementTargetValue, float& OutCrouchingTargetValue, float& OutJumpFallTargetValue, float& OutAimingMultiplier) const;
+
 	// Updates the multipliers and returns true if they are at minimum
 	bool UpdateMultipliers(float DeltaSeconds);
 };
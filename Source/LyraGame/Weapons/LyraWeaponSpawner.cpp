@@ -16,6 +16,7 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraSystem.h"
 #include "TimerManager.h"
+#include "Weapons/LyraWeaponSpawnerSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWeaponSpawner)
 
@@ -27,8 +28,8 @@ struct FHitResult;
 // Sets default values
 ALyraWeaponSpawner::ALyraWeaponSpawner()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+ 	// Rotation and cooldown updates are batched across all spawners by ULyraWeaponSpawnerSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	RootComponent = CollisionVolume = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CollisionVolume"));
 	CollisionVolume->InitCapsuleSize(80.f, 80.f);
@@ -63,6 +64,11 @@ void ALyraWeaponSpawner::BeginPlay()
 			UE_LOG(LogLyra, Error, TEXT("'%s' does not have a valid weapon definition! Make sure to set this data on the instance!"), *GetNameSafe(this));	
 		}
 	}
+
+	if (ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<ULyraWeaponSpawnerSubsystem>(GetWorld()))
+	{
+		SpawnerSubsystem->RegisterSpawner(this);
+	}
 }
 
 void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -72,23 +78,13 @@ void ALyraWeaponSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
 		World->GetTimerManager().ClearTimer(CheckOverlapsDelayTimerHandle);
 	}
-	
-	Super::EndPlay(EndPlayReason);
-}
-
-// Called every frame
-void ALyraWeaponSpawner::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
 
-	//Update the CoolDownPercentage property to drive respawn time indicators
-	UWorld* World = GetWorld();
-	if (World->GetTimerManager().IsTimerActive(CoolDownTimerHandle))
+	if (ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<ULyraWeaponSpawnerSubsystem>(GetWorld()))
 	{
-		CoolDownPercentage = 1.0f - World->GetTimerManager().GetTimerRemaining(CoolDownTimerHandle)/CoolDownTime;
+		SpawnerSubsystem->UnregisterSpawner(this);
 	}
-
-	WeaponMesh->AddRelativeRotation(FRotator(0.0f, World->GetDeltaSeconds() * WeaponMeshRotationSpeed, 0.0f));
+	
+	Super::EndPlay(EndPlayReason);
 }
 
 void ALyraWeaponSpawner::OnConstruction(const FTransform& Transform)
@@ -146,6 +142,11 @@ void ALyraWeaponSpawner::StartCoolDown()
 	if (UWorld* World = GetWorld())
 	{
 		World->GetTimerManager().SetTimer(CoolDownTimerHandle, this, &ALyraWeaponSpawner::OnCoolDownTimerComplete, CoolDownTime);
+
+		if (ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = World->GetSubsystem<ULyraWeaponSpawnerSubsystem>())
+		{
+			SpawnerSubsystem->StartCoolDown(this, CoolDownTime);
+		}
 	}
 }
 
@@ -156,6 +157,11 @@ void ALyraWeaponSpawner::ResetCoolDown()
 	if (World)
 	{
 		World->GetTimerManager().ClearTimer(CoolDownTimerHandle);
+
+		if (ULyraWeaponSpawnerSubsystem* SpawnerSubsystem = World->GetSubsystem<ULyraWeaponSpawnerSubsystem>())
+		{
+			SpawnerSubsystem->ClearCoolDown(this);
+		}
 	}
 
 	if (GetLocalRole() == ROLE_Authority)
@@ -34,11 +34,14 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	void OnConstruction(const FTransform& Transform) override;
 
+	// Returns the time between a weapon pickup and the weapon respawning, in seconds
+	float GetCoolDownTime() const { return CoolDownTime; }
+
+	// Returns the progress of the current respawn cooldown (0-1), or 0 if not cooling down
+	float GetCoolDownPercentage() const { return CoolDownPercentage; }
+
 protected:
 	//Data asset used to configure a Weapon Spawner
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
@@ -55,7 +58,7 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Lyra|WeaponPickup")
 	float CheckExistingOverlapDelay;
 
-	//Used to drive weapon respawn time indicators 0-1
+	//Used to drive weapon respawn time indicators 0-1, updated by ULyraWeaponSpawnerSubsystem while cooling down
 	UPROPERTY(BlueprintReadOnly, Transient, Category = "Lyra|WeaponPickup")
 	float CoolDownPercentage;
 
@@ -111,4 +114,10 @@ public:
 	/** Searches an item definition type for a matching stat and returns the value, or 0 if not found */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lyra|WeaponPickup")
 	static int32 GetDefaultStatFromItemDef(const TSubclassOf<ULyraInventoryItemDefinition> WeaponItemClass, FGameplayTag StatTag);
+
+private:
+	friend class ULyraWeaponSpawnerSubsystem;
+
+	// Index of this spawner in the packed arrays of ULyraWeaponSpawnerSubsystem, or INDEX_NONE if not registered
+	int32 SpawnerSubsystemIndex = INDEX_NONE;
 };
@@ -0,0 +1,292 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraWeaponSpawnerSubsystem.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraLogChannels.h"
+#include "TimerManager.h"
+#include "Weapons/LyraWeaponSpawner.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraWeaponSpawnerSubsystem)
+
+namespace LyraWeaponSpawnerCVars
+{
+	static float SignificanceRange = 5000.0f;
+	static FAutoConsoleVariableRef CVarSignificanceRange(
+		TEXT("Lyra.WeaponSpawner.SignificanceRange"),
+		SignificanceRange,
+		TEXT("Distance from the nearest local viewer beyond which weapon spawners stop updating their cosmetic pad rotation (<= 0 means always update)"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraWeaponSpawnerSubsystem
+
+ULyraWeaponSpawnerSubsystem::ULyraWeaponSpawnerSubsystem()
+{
+}
+
+bool ULyraWeaponSpawnerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+TStatId ULyraWeaponSpawnerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraWeaponSpawnerSubsystem, STATGROUP_Tickables);
+}
+
+void ULyraWeaponSpawnerSubsystem::RegisterSpawner(ALyraWeaponSpawner* Spawner)
+{
+	check(Spawner);
+	if (Spawner->SpawnerSubsystemIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Spawner->SpawnerSubsystemIndex = Spawners.Add(Spawner);
+	WeaponMeshes.Add(Spawner->WeaponMesh);
+	Locations.Add(Spawner->GetActorLocation());
+	RotationSpeeds.Add(Spawner->WeaponMeshRotationSpeed);
+	CoolDownStartTimes.Add(0.0);
+	CoolDownDurations.Add(0.0f);
+}
+
+void ULyraWeaponSpawnerSubsystem::UnregisterSpawner(ALyraWeaponSpawner* Spawner)
+{
+	check(Spawner);
+	const int32 Index = Spawner->SpawnerSubsystemIndex;
+	if (Spawners.IsValidIndex(Index) && (Spawners[Index] == Spawner))
+	{
+		RemoveSpawnerAt(Index);
+	}
+	Spawner->SpawnerSubsystemIndex = INDEX_NONE;
+}
+
+void ULyraWeaponSpawnerSubsystem::RemoveSpawnerAt(int32 Index)
+{
+	if (CoolDownDurations[Index] > 0.0f)
+	{
+		--NumActiveCoolDowns;
+	}
+
+	Spawners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	WeaponMeshes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RotationSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CoolDownStartTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CoolDownDurations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// Fix up the index of the entry that was swapped into the removed slot
+	if (Spawners.IsValidIndex(Index))
+	{
+		if (ALyraWeaponSpawner* MovedSpawner = Spawners[Index])
+		{
+			MovedSpawner->SpawnerSubsystemIndex = Index;
+		}
+	}
+}
+
+void ULyraWeaponSpawnerSubsystem::StartCoolDown(ALyraWeaponSpawner* Spawner, float Duration)
+{
+	const int32 Index = Spawner ? Spawner->SpawnerSubsystemIndex : INDEX_NONE;
+	if (Spawners.IsValidIndex(Index))
+	{
+		if (CoolDownDurations[Index] <= 0.0f)
+		{
+			++NumActiveCoolDowns;
+		}
+
+		CoolDownStartTimes[Index] = GetWorld()->GetTimeSeconds();
+		CoolDownDurations[Index] = FMath::Max(Duration, UE_KINDA_SMALL_NUMBER);
+	}
+}
+
+void ULyraWeaponSpawnerSubsystem::ClearCoolDown(ALyraWeaponSpawner* Spawner)
+{
+	const int32 Index = Spawner ? Spawner->SpawnerSubsystemIndex : INDEX_NONE;
+	if (Spawners.IsValidIndex(Index) && (CoolDownDurations[Index] > 0.0f))
+	{
+		--NumActiveCoolDowns;
+		CoolDownDurations[Index] = 0.0f;
+	}
+}
+
+bool ULyraWeaponSpawnerSubsystem::GatherViewLocations(TArray<FVector, TInlineAllocator<4>>& OutViewLocations) const
+{
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PC = Iterator->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+			OutViewLocations.Add(ViewLocation);
+		}
+	}
+
+	return OutViewLocations.Num() > 0;
+}
+
+void ULyraWeaponSpawnerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const int32 NumSpawners = Spawners.Num();
+	if (NumSpawners == 0)
+	{
+		return;
+	}
+
+	// Update the CoolDownPercentage property to drive respawn time indicators
+	if (NumActiveCoolDowns > 0)
+	{
+		const double CurrentTime = GetWorld()->GetTimeSeconds();
+		for (int32 Index = 0; Index < NumSpawners; ++Index)
+		{
+			const float Duration = CoolDownDurations[Index];
+			if (Duration > 0.0f)
+			{
+				const float Percentage = FMath::Min((float)((CurrentTime - CoolDownStartTimes[Index]) / Duration), 1.0f);
+				Spawners[Index]->CoolDownPercentage = Percentage;
+			}
+		}
+	}
+
+	// Rotate the weapon meshes of spawners close enough to a local viewer to be noticed
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	if (!GatherViewLocations(/*out*/ ViewLocations))
+	{
+		return;
+	}
+
+	const float RangeSquared = FMath::Square(LyraWeaponSpawnerCVars::SignificanceRange);
+	const bool bCheckRange = LyraWeaponSpawnerCVars::SignificanceRange > 0.0f;
+
+	for (int32 Index = 0; Index < NumSpawners; ++Index)
+	{
+		if (bCheckRange)
+		{
+			const FVector& Location = Locations[Index];
+			bool bIsSignificant = false;
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				if (FVector::DistSquared(Location, ViewLocation) <= RangeSquared)
+				{
+					bIsSignificant = true;
+					break;
+				}
+			}
+
+			if (!bIsSignificant)
+			{
+				continue;
+			}
+		}
+
+		if (UStaticMeshComponent* WeaponMesh = WeaponMeshes[Index])
+		{
+			WeaponMesh->AddRelativeRotation(FRotator(0.0f, DeltaTime * RotationSpeeds[Index], 0.0f));
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if !UE_BUILD_SHIPPING
+
+static void BenchmarkWeaponSpawners(const TArray<FString>& Args, UWorld* World)
+{
+	ULyraWeaponSpawnerSubsystem* Subsystem = UWorld::GetSubsystem<ULyraWeaponSpawnerSubsystem>(World);
+	if (Subsystem == nullptr)
+	{
+		UE_LOG(LogLyra, Warning, TEXT("Lyra.WeaponSpawner.Benchmark requires a game world"));
+		return;
+	}
+
+	const int32 NumToSpawn = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 200;
+	const int32 NumFrames = (Args.Num() > 1) ? FCString::Atoi(*Args[1]) : 300;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// Use an existing spawner as a template so the new ones share its configuration
+	ALyraWeaponSpawner* Template = nullptr;
+	for (TActorIterator<ALyraWeaponSpawner> It(World); It; ++It)
+	{
+		Template = *It;
+		break;
+	}
+
+	FVector Origin = FVector::ZeroVector;
+	if (APlayerController* PC = World->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(/*out*/ Origin, /*out*/ ViewRotation);
+	}
+
+	TArray<ALyraWeaponSpawner*> SpawnedSpawners;
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumToSpawn));
+	for (int32 SpawnIndex = 0; SpawnIndex < NumToSpawn; ++SpawnIndex)
+	{
+		const FVector Offset((SpawnIndex % GridSize) * 300.0f, (SpawnIndex / GridSize) * 300.0f, 0.0f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Template = Template;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		UClass* SpawnClass = Template ? Template->GetClass() : ALyraWeaponSpawner::StaticClass();
+		if (ALyraWeaponSpawner* Spawner = World->SpawnActor<ALyraWeaponSpawner>(SpawnClass, FTransform(Origin + Offset), SpawnParams))
+		{
+			// Put every other spawner in cooldown so both halves of the update are exercised
+			if ((SpawnIndex % 2) == 0)
+			{
+				Spawner->StartCoolDown();
+			}
+			SpawnedSpawners.Add(Spawner);
+		}
+	}
+
+	// Per-actor update, equivalent to what each spawner used to do in its own Tick
+	FTimerManager& TimerManager = World->GetTimerManager();
+	const double PerActorStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (ALyraWeaponSpawner* Spawner : SpawnedSpawners)
+		{
+			if (TimerManager.IsTimerActive(Spawner->CoolDownTimerHandle))
+			{
+				volatile float Percentage = 1.0f - TimerManager.GetTimerRemaining(Spawner->CoolDownTimerHandle) / Spawner->GetCoolDownTime();
+			}
+			Spawner->WeaponMesh->AddRelativeRotation(FRotator(0.0f, DeltaTime * Spawner->WeaponMeshRotationSpeed, 0.0f));
+		}
+	}
+	const double PerActorTime = FPlatformTime::Seconds() - PerActorStartTime;
+
+	// Batched update
+	const double BatchedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Subsystem->Tick(DeltaTime);
+	}
+	const double BatchedTime = FPlatformTime::Seconds() - BatchedStartTime;
+
+	UE_LOG(LogLyra, Log, TEXT("Weapon spawner update over %d frames with %d spawned (%d registered): per-actor %.4f ms/frame, batched %.4f ms/frame"),
+		NumFrames, SpawnedSpawners.Num(), Subsystem->GetNumSpawners(),
+		(PerActorTime * 1000.0) / FMath::Max(NumFrames, 1),
+		(BatchedTime * 1000.0) / FMath::Max(NumFrames, 1));
+
+	for (ALyraWeaponSpawner* Spawner : SpawnedSpawners)
+	{
+		Spawner->Destroy();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchmarkWeaponSpawners(
+	TEXT("Lyra.WeaponSpawner.Benchmark"),
+	TEXT("Spawns [NumSpawners=200] weapon spawners and compares the game thread cost of per-actor vs batched updates over [NumFrames=300] frames"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(BenchmarkWeaponSpawners));
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "LyraWeaponSpawnerSubsystem.generated.h"
+
+class ALyraWeaponSpawner;
+class UStaticMeshComponent;
+class UObject;
+
+/**
+ * ULyraWeaponSpawnerSubsystem
+ *
+ * Owns the per-frame state of every weapon spawner in the world in packed arrays and updates
+ * the pad rotation and respawn cooldown of all of them in a single batched pass, so the
+ * individual spawner actors do not need to tick.
+ *
+ * Rotation is purely cosmetic, so it is skipped for spawners outside of the significance range
+ * of every local viewer (and entirely on dedicated servers).
+ */
+UCLASS()
+class LYRAGAME_API ULyraWeaponSpawnerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULyraWeaponSpawnerSubsystem();
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Adds a spawner to the batched update, called when the spawner begins play
+	void RegisterSpawner(ALyraWeaponSpawner* Spawner);
+
+	// Removes a spawner from the batched update, called when the spawner ends play
+	void UnregisterSpawner(ALyraWeaponSpawner* Spawner);
+
+	// Starts tracking a cooldown of the specified duration for the spawner, driving its CoolDownPercentage
+	void StartCoolDown(ALyraWeaponSpawner* Spawner, float Duration);
+
+	// Stops tracking the cooldown for the spawner
+	void ClearCoolDown(ALyraWeaponSpawner* Spawner);
+
+	// Returns the number of spawners currently registered
+	int32 GetNumSpawners() const { return Spawners.Num(); }
+
+protected:
+	//~UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~End of UWorldSubsystem interface
+
+private:
+	// Gathers the view locations of all local players, returns false if there are none (e.g., on a dedicated server)
+	bool GatherViewLocations(TArray<FVector, TInlineAllocator<4>>& OutViewLocations) const;
+
+	void RemoveSpawnerAt(int32 Index);
+
+private:
+	// Packed spawner state, all arrays are kept parallel to each other
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ALyraWeaponSpawner>> Spawners;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UStaticMeshComponent>> WeaponMeshes;
+
+	TArray<FVector> Locations;
+	TArray<float> RotationSpeeds;
+
+	// World time at which the cooldown started, and its duration (a duration of 0 means not cooling down)
+	TArray<double> CoolDownStartTimes;
+	TArray<float> CoolDownDurations;
+
+	// Number of entries with an active cooldown, so the cooldown pass can be skipped when there are none
+	int32 NumActiveCoolDowns = 0;
+};
@@ -4,6 +4,8 @@
 
 #include "Abilities/GameplayAbilityTargetTypes.h"
 #include "Equipment/LyraEquipmentManagerComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "GameplayEffectTypes.h"
 #include "Kismet/GameplayStatics.h"
@@ -21,24 +23,184 @@ ULyraWeaponStateComponent::ULyraWeaponStateComponent(const FObjectInitializer& O
 {
 	SetIsReplicatedByDefault(true);
 
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	// Only ticks while an equipped ranged weapon has heat or spread to update, see SetActiveRangedWeapon and EnterDormancy
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	PrimaryComponentTick.bCanEverTick = true;
 }
 
+void ULyraWeaponStateComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (AController* OwningController = GetController<AController>())
+	{
+		OwningController->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::OnPossessedPawnChanged);
+	}
+
+	BindToEquipmentManager(GetPawn<APawn>());
+}
+
+void ULyraWeaponStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AController* OwningController = GetController<AController>())
+	{
+		OwningController->OnPossessedPawnChanged.RemoveAll(this);
+	}
+
+	BindToEquipmentManager(nullptr);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ULyraWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (APawn* Pawn = GetPawn<APawn>())
+#if WITH_DEV_AUTOMATION_TESTS
+	++NumTicksForTesting;
+#endif
+
+	if (ULyraRangedWeaponInstance* CurrentWeapon = ActiveRangedWeapon.Get())
+	{
+		if (CurrentWeapon->GetPawn() != nullptr)
+		{
+			CurrentWeapon->Tick(DeltaTime);
+
+			if (CurrentWeapon->IsAtSteadyState())
+			{
+				EnterDormancy();
+			}
+		}
+	}
+	else
+	{
+		// The weapon went away without an unequip notification (e.g., the pawn was destroyed)
+		SetActiveRangedWeapon(nullptr);
+	}
+}
+
+void ULyraWeaponStateComponent::OnPossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+	BindToEquipmentManager(NewPawn);
+}
+
+void ULyraWeaponStateComponent::BindToEquipmentManager(APawn* Pawn)
+{
+	ULyraEquipmentManagerComponent* NewEquipmentManager = Pawn ? Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>() : nullptr;
+
+	if (NewEquipmentManager != BoundEquipmentManager.Get())
+	{
+		if (ULyraEquipmentManagerComponent* OldEquipmentManager = BoundEquipmentManager.Get())
+		{
+			OldEquipmentManager->OnEquipmentChanged.Remove(EquipmentChangedHandle);
+		}
+		EquipmentChangedHandle.Reset();
+
+		BoundEquipmentManager = NewEquipmentManager;
+
+		if (NewEquipmentManager != nullptr)
+		{
+			EquipmentChangedHandle = NewEquipmentManager->OnEquipmentChanged.AddUObject(this, &ThisClass::OnEquipmentChanged);
+		}
+	}
+
+	SetActiveRangedWeapon(FindActiveRangedWeapon());
+}
+
+void ULyraWeaponStateComponent::OnEquipmentChanged(ULyraEquipmentInstance* Instance, bool bEquipped)
+{
+	// Refresh from the equipment manager rather than trusting the event alone, so the cache also picks up weapons
+	// whose instance only resolved on a client after the entry was added (the instance is still in the equipment
+	// list while it is being unequipped)
+	SetActiveRangedWeapon(FindActiveRangedWeapon(/*IgnoredInstance=*/ bEquipped ? nullptr : Instance));
+}
+
+ULyraRangedWeaponInstance* ULyraWeaponStateComponent::FindActiveRangedWeapon(const ULyraEquipmentInstance* IgnoredInstance) const
+{
+	if (ULyraEquipmentManagerComponent* EquipmentManager = BoundEquipmentManager.Get())
 	{
-		if (ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>())
+		TArray<ULyraEquipmentInstance*, TInlineAllocator<4>> RangedWeapons;
+		EquipmentManager->GetEquipmentInstancesOfType(ULyraRangedWeaponInstance::StaticClass(), /*out*/ RangedWeapons);
+
+		for (ULyraEquipmentInstance* Instance : RangedWeapons)
 		{
-			if (ULyraRangedWeaponInstance* CurrentWeapon = Cast<ULyraRangedWeaponInstance>(EquipmentManager->GetFirstInstanceOfType(ULyraRangedWeaponInstance::StaticClass())))
+			if (Instance != IgnoredInstance)
 			{
-				CurrentWeapon->Tick(DeltaTime);
+				return CastChecked<ULyraRangedWeaponInstance>(Instance);
 			}
 		}
 	}
+
+	return nullptr;
+}
+
+void ULyraWeaponStateComponent::SetActiveRangedWeapon(ULyraRangedWeaponInstance* NewWeapon)
+{
+	ULyraRangedWeaponInstance* OldWeapon = ActiveRangedWeapon.Get();
+	if (NewWeapon != OldWeapon)
+	{
+		if (OldWeapon != nullptr)
+		{
+			OldWeapon->OnLeftSteadyState.Remove(WeaponLeftSteadyStateHandle);
+		}
+		WeaponLeftSteadyStateHandle.Reset();
+
+		ActiveRangedWeapon = NewWeapon;
+
+		if (NewWeapon != nullptr)
+		{
+			WeaponLeftSteadyStateHandle = NewWeapon->OnLeftSteadyState.AddUObject(this, &ThisClass::OnWeaponLeftSteadyState);
+		}
+	}
+
+	// Always tick at least once after a change, the weapon goes dormant again from TickComponent if it is settled
+	LeaveDormancy();
+	SetComponentTickEnabled(NewWeapon != nullptr);
+}
+
+void ULyraWeaponStateComponent::EnterDormancy()
+{
+	// Spread multipliers follow the pawn's movement, which we can only observe without ticking for characters
+	ULyraRangedWeaponInstance* CurrentWeapon = ActiveRangedWeapon.Get();
+	ACharacter* Character = CurrentWeapon ? Cast<ACharacter>(CurrentWeapon->GetPawn()) : nullptr;
+	if (Character == nullptr)
+	{
+		return;
+	}
+
+	if (DormantCharacter.Get() != Character)
+	{
+		LeaveDormancy();
+		Character->OnCharacterMovementUpdated.AddDynamic(this, &ThisClass::OnCharacterMovementUpdated);
+		DormantCharacter = Character;
+	}
+
+	SetComponentTickEnabled(false);
+}
+
+void ULyraWeaponStateComponent::LeaveDormancy()
+{
+	if (ACharacter* Character = DormantCharacter.Get())
+	{
+		Character->OnCharacterMovementUpdated.RemoveDynamic(this, &ThisClass::OnCharacterMovementUpdated);
+	}
+	DormantCharacter.Reset();
+}
+
+void ULyraWeaponStateComponent::OnWeaponLeftSteadyState()
+{
+	LeaveDormancy();
+	SetComponentTickEnabled(ActiveRangedWeapon.IsValid());
+}
+
+void ULyraWeaponStateComponent::OnCharacterMovementUpdated(float DeltaSeconds, FVector OldLocation, FVector OldVelocity)
+{
+	// Wake up when moving, crouching, falling or aiming would change the spread multipliers
+	ULyraRangedWeaponInstance* CurrentWeapon = ActiveRangedWeapon.Get();
+	if ((CurrentWeapon == nullptr) || CurrentWeapon->HaveMultiplierTargetsChanged())
+	{
+		OnWeaponLeftSteadyState();
+	}
 }
 
 bool ULyraWeaponStateComponent::ShouldShowHitAsSuccess(const FHitResult& Hit) const
@@ -7,6 +7,11 @@
 
 #include "LyraWeaponStateComponent.generated.h"
 
+class ACharacter;
+class APawn;
+class ULyraEquipmentInstance;
+class ULyraEquipmentManagerComponent;
+class ULyraRangedWeaponInstance;
 class UObject;
 struct FFrame;
 struct FGameplayAbilityTargetDataHandle;
@@ -46,7 +51,11 @@ public:
 
 	ULyraWeaponStateComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	//~UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
 
 	UFUNCTION(Client, Reliable)
 	void ClientConfirmTargetData(uint16 UniqueId, bool bSuccess, const TArray<uint8>& HitReplaces);
@@ -70,6 +79,18 @@ public:
 		return UnconfirmedServerSideHitMarkers.Num();
 	}
 
+	/** Returns the equipped ranged weapon this component keeps updated, if any */
+	ULyraRangedWeaponInstance* GetActiveRangedWeapon() const
+	{
+		return ActiveRangedWeapon.Get();
+	}
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// Binds to the equipment of a pawn without possessing it, and counts ticks so tests can check that we stay dormant
+	void BindToPawnForTesting(APawn* Pawn) { BindToEquipmentManager(Pawn); }
+	int32 GetNumTicksForTesting() const { return NumTicksForTesting; }
+#endif
+
 protected:
 	// This is called to filter hit results to determine whether they should be considered as a successful hit or not
 	// The default behavior is to treat it as a success if being done to a team actor that belongs to a different team
@@ -81,6 +102,43 @@ protected:
 	void ActuallyUpdateDamageInstigatedTime();
 
 private:
+	UFUNCTION()
+	void OnPossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
+	void OnEquipmentChanged(ULyraEquipmentInstance* Instance, bool bEquipped);
+
+	// Listens for equipment changes on the specified pawn (unbinding from the previous one)
+	void BindToEquipmentManager(APawn* Pawn);
+
+	// Finds the first equipped ranged weapon, optionally ignoring one that is about to be unequipped
+	ULyraRangedWeaponInstance* FindActiveRangedWeapon(const ULyraEquipmentInstance* IgnoredInstance = nullptr) const;
+
+	// Changes the cached weapon and only leaves our tick enabled while there is one to update
+	void SetActiveRangedWeapon(ULyraRangedWeaponInstance* NewWeapon);
+
+	// Disables our tick once the weapon reached its steady state, until it is fired or the pawn's movement changes
+	void EnterDormancy();
+	void LeaveDormancy();
+
+	void OnWeaponLeftSteadyState();
+
+	UFUNCTION()
+	void OnCharacterMovementUpdated(float DeltaSeconds, FVector OldLocation, FVector OldVelocity);
+
+private:
+	/** Equipment manager of the controlled pawn that we are listening to */
+	TWeakObjectPtr<ULyraEquipmentManagerComponent> BoundEquipmentManager;
+
+	FDelegateHandle EquipmentChangedHandle;
+
+	/** The equipped ranged weapon that needs heat and spread updates, if any */
+	TWeakObjectPtr<ULyraRangedWeaponInstance> ActiveRangedWeapon;
+
+	FDelegateHandle WeaponLeftSteadyStateHandle;
+
+	/** While dormant, the character whose movement updates we listen to in order to wake up */
+	TWeakObjectPtr<ACharacter> DormantCharacter;
+
 	/** Last time this controller instigated weapon damage */
 	double LastWeaponDamageInstigatedTime = 0.0;
 
@@ -89,4 +147,8 @@ private:
 
 	/** The unconfirmed hits */
 	TArray<FLyraServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	int32 NumTicksForTesting = 0;
+#endif
 };